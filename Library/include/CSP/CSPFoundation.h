@@ -163,6 +163,24 @@ public:
     csp::common::String CHSEnvironment;
 };
 
+/// @brief Limits on how many web requests Foundation has in flight at once. Requests beyond them are queued per host, in the order they were made.
+/// @details The service systems and the multiplayer connection each have their own web client, and each applies these limits separately.
+/// Before these settings existed every request ran on a fixed pool of 4 threads per client, so an application that relied on that to
+/// throttle its requests should set MaxConcurrentRequests to 4.
+class CSP_API WebRequestSettings
+{
+public:
+    /// @brief Number of requests that can be in flight across all hosts. Defaults to 16.
+    uint32_t MaxConcurrentRequests = 16;
+
+    /// @brief Number of requests that can be in flight to any one host, unless overridden in MaxConcurrentRequestsByHost. Defaults to 8.
+    uint32_t MaxConcurrentRequestsPerHost = 8;
+
+    /// @brief Per-host overrides of MaxConcurrentRequestsPerHost, keyed by host and, if not the default for the scheme, port.
+    /// e.g. "localhost:8081".
+    csp::common::Map<csp::common::String, uint32_t> MaxConcurrentRequestsByHost;
+};
+
 /// @brief Main entry point for interacting with Foundation.
 /// Provides functionality for initialising, shutting down and managing essential information for the Foundation instance to run.
 class CSP_API CSPFoundation
@@ -203,6 +221,16 @@ public:
         const csp::ClientUserAgent& ClientUserAgentHeader, csp::multiplayer::ISignalRConnection* SignalRInject,
         const csp::common::Optional<csp::common::Array<FeatureFlag>>& FeatureFlagOverrides);
 
+    /// @brief Sets the limits on concurrent web requests.
+    /// @details The web clients are created during initialisation, so this must be called before Initialise to take effect.
+    /// The settings are kept across Shutdown, and apply to every later Initialise until they are set again.
+    /// @param Settings const WebRequestSettings& : The limits to apply.
+    static void SetWebRequestSettings(const WebRequestSettings& Settings);
+
+    /// @brief Gets the limits on concurrent web requests that the next Initialise will use.
+    /// @return const WebRequestSettings&
+    static const WebRequestSettings& GetWebRequestSettings();
+
     /// @brief This should be used at the end of the application lifecycle.
     /// Clears event queues and destroys foundation systems.
     /// After shutdown, no other Foundation functions should be called until Initialise is called again.
@@ -289,6 +317,7 @@ private:
     static csp::common::String* DeviceId;
     static csp::common::String* ClientUserAgentString;
     static csp::common::String* Tenant;
+    static WebRequestSettings WebRequests;
 
     // Developer feature flags should be defined in the cpp
     static csp::common::Array<FeatureFlag> FeatureFlags;
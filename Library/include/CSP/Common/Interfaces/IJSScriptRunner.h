@@ -18,6 +18,7 @@
 #include "CSP/CSPCommon.h"
 #include "CSP/Common/Interfaces/InvalidInterfaceUserError.h"
 #include "CSP/Common/String.h"
+#include "CSP/Common/StringFormat.h"
 
 namespace csp::common
 {
@@ -159,6 +160,23 @@ public:
         throw InvalidInterfaceUseError("Illegal use of \"abstract\" type.");
     }
 
+    /**
+     * @brief Calls a global callback function in a given context, passing it a message and its parameters.
+     * This is the path used to deliver subscribed script messages, such as the per-frame entity tick.
+     * Implementations are free to cache the resolved callback, so it should be preferred to RunScript for frequently posted messages.
+     * The default implementation formats a call expression and runs it via RunScript.
+     * @param ContextId int64_t : The Id of the CSP script context in which to call the function.
+     * @param CallbackName String& : The name of the global function to call.
+     * @param Message String& : The message being posted. Passed as the first argument.
+     * @param MessageParamsJson String& : JSON formatted parameters for the message. Passed as the second argument.
+     * @return Whether the callback was successfully called.
+     */
+    CSP_NO_EXPORT virtual bool CallMessageCallback(
+        int64_t ContextId, const String& CallbackName, const String& Message, const String& MessageParamsJson)
+    {
+        return RunScript(ContextId, StringFormat("%s('%s','%s')", CallbackName.c_str(), Message.c_str(), MessageParamsJson.c_str()));
+    }
+
 protected:
     IJSScriptRunner() = default;
 };
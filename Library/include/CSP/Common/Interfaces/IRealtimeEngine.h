@@ -22,12 +22,14 @@
 #include "CSP/Common/Optional.h"
 #include "CSP/Common/SharedEnums.h"
 #include "CSP/Common/String.h"
+#include "CSP/Common/Vector.h"
 
 namespace csp::multiplayer
 {
 class SpaceTransform;
 class SpaceEntity;
 class SpaceEntityStatePatcher;
+enum class ComponentType;
 }
 
 namespace csp::multiplayer
@@ -267,6 +269,28 @@ public:
         (void)Name;
     }
 
+    /// @brief Finds every SpaceEntity with a matching Name.
+    /// @param Name csp::common::String : The name to search for.
+    /// @return A list of non-owning pointers to the matching entities, in the order they were added to the realtime engine.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesByName(const csp::common::String& Name)
+    {
+        throw InvalidInterfaceUseError("Illegal use of \"abstract\" type.");
+
+        // Avoiding unused params, see comment in top method
+        (void)Name;
+    }
+
+    /// @brief Finds every SpaceEntity that has at least one component of the given type.
+    /// @param Type csp::multiplayer::ComponentType : The type of component to search for.
+    /// @return A list of non-owning pointers to the matching entities, in the order they were added to the realtime engine.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesWithComponent(csp::multiplayer::ComponentType Type)
+    {
+        throw InvalidInterfaceUseError("Illegal use of \"abstract\" type.");
+
+        // Avoiding unused params, see comment in top method
+        (void)Type;
+    }
+
     /// @brief Get an Entity by its index.
     ///
     /// @param EntityIndex size_t : The index of the entity to get.
@@ -330,6 +354,47 @@ public:
         throw InvalidInterfaceUseError("Illegal use of \"abstract\" type.");
     }
 
+    /// @brief Finds all entities whose global position is within Radius of Position.
+    /// @param Position csp::common::Vector3 : The centre of the search, in world space.
+    /// @param Radius float : The distance from Position to search within. A negative radius finds no entities.
+    /// @return A list of non-owning pointers to the entities found, in no particular order.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesInRadius(
+        const csp::common::Vector3& Position, float Radius)
+    {
+        throw InvalidInterfaceUseError("Illegal use of \"abstract\" type.");
+
+        // Avoiding unused params, see comment in top method
+        (void)Position;
+        (void)Radius;
+    }
+
+    /// @brief Finds the entities whose global positions are nearest to Position.
+    /// @param Position csp::common::Vector3 : The point to measure from, in world space.
+    /// @param Count size_t : The maximum number of entities to find.
+    /// @return A list of non-owning pointers to up to Count entities, nearest first.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindNearestSpaceEntities(
+        const csp::common::Vector3& Position, size_t Count)
+    {
+        throw InvalidInterfaceUseError("Illegal use of \"abstract\" type.");
+
+        // Avoiding unused params, see comment in top method
+        (void)Position;
+        (void)Count;
+    }
+
+    /// @brief Finds all entities whose global position is inside a frustum, or any other convex volume, given as a set of planes.
+    /// @param Planes csp::common::List<csp::common::Vector4> : The planes bounding the volume. Each plane is (Normal.X, Normal.Y, Normal.Z,
+    /// Distance) with the normal pointing into the volume, so a position P is inside the plane when Dot(Normal, P) + Distance >= 0.
+    /// @return A list of non-owning pointers to the entities found, in no particular order.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesInFrustum(
+        const csp::common::List<csp::common::Vector4>& Planes)
+    {
+        throw InvalidInterfaceUseError("Illegal use of \"abstract\" type.");
+
+        // Avoiding unused params, see comment in top method
+        (void)Planes;
+    }
+
     /// @brief "Resolves" the entity heirarchy for the given entity, setting all internal parent/child buffers correctly.
     /// This method is called whenever parent/child relationships are changed for a given entity, including when one is first created.
     /// @param Entity csp::multiplayer::SpaceEntity* : The Entity to resolve
@@ -140,6 +140,7 @@ public:
 
     /// @brief Returns a copy of all keys in this map.
     ///        This copy should be disposed by the caller once it is no longer needed.
+    ///        Internal code should iterate the map directly instead, which doesn't allocate.
     /// @return const csp::common::Array<TKey>* : Array of keys
     const Array<TKey>* Keys() const
     {
@@ -28,6 +28,8 @@ namespace csp::common
 {
 
 /// @brief Custom string class that we can use safely across a DLL boundary.
+/// @details The characters are stored in a single reference counted buffer. Copies of long strings share it until one of them is modified.
+/// Empty strings don't allocate. The string itself is a single pointer, and its buffer is only ever allocated and freed inside the library.
 class CSP_API String
 {
 public:
@@ -44,8 +46,7 @@ public:
     explicit String(char const* const Text, size_t Length);
 
     /// @brief Constructs a string with a given length.
-    /// Buffer is set to 0 for debug builds.
-    /// Buffer isn't guaranteed to be set to a particular value for release builds.
+    /// Buffer isn't guaranteed to be set to a particular value, and should be written through Data().
     /// @param Length size_t : Size of buffer
     explicit String(size_t Length);
 
@@ -86,6 +87,12 @@ public:
     /// @return char const*
     char const* c_str() const { return Get(); }
 
+    /// @brief Returns a writable pointer to the internal buffer.
+    /// If the buffer is shared with copies of this string, it is copied first. From then on, copies of this string get a buffer of their own,
+    /// so writes through the pointer never affect them.
+    /// @return char*
+    char* Data();
+
     // TODO: Possibly switch this to returning an array of StringView
 
     /// @brief Splits current string by a given delimiter into individual elements.
@@ -100,12 +107,12 @@ public:
     bool operator<(const String& Other) const;
 
     /// @brief Appends given string.
-    /// This will resize the buffer of the current string.
+    /// The buffer grows geometrically, so repeated appends take amortised linear time.
     /// @param Other const String& : String to append
     void Append(const String& Other);
 
     /// @brief Appends given cstring.
-    /// This will resize the buffer of the current string.
+    /// The buffer grows geometrically, so repeated appends take amortised linear time.
     /// @param Other const char* : Cstring to append
     void Append(const char* Other);
 
@@ -150,6 +157,7 @@ public:
     size_t Length() const;
 
     /// @brief Returns the length of the string including the terminator.
+    /// This is the number of bytes that may be written through Data(), and may be less than the capacity of the buffer.
     /// @return size_t
     size_t AllocatedMemorySize() const;
 
@@ -204,9 +212,20 @@ private:
     /// @return const char*
     const char* Get() const;
 
+    // Sets up uninitialised storage for Length characters, returning where they should be written.
+    char* InitialiseStorage(size_t Length);
+    void ReleaseStorage();
+    // Sets the length of a buffer that is unique to this string and has room for Length characters, and terminates it.
+    void SetLength(size_t Length);
+    // Makes the buffer unique to this string, with room for at least NewLength characters, keeping the current contents.
+    void Reserve(size_t NewLength);
+    void Append(const char* Other, size_t OtherLength);
+
 private:
-    class Impl;
-    Impl* ImplPtr;
+    // Points at the characters of a buffer, which is preceded by its reference count, length and capacity, or is null if the string is empty.
+    // This keeps String the size of a single pointer, so its layout matches earlier versions. Variant relies on a null pointer being a valid
+    // empty string when assigning into its zeroed union.
+    char* Text;
 };
 
 } // namespace csp::common
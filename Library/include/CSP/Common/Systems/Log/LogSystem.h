@@ -19,7 +19,10 @@
 #include "CSP/CSPCommon.h"
 #include "CSP/Common/String.h"
 #include "CSP/Common/Systems/Log/LogLevels.h"
+
+#include <atomic>
 #include <functional>
+#include <mutex>
 
 namespace csp::common
 {
@@ -63,9 +66,23 @@ public:
     csp::common::LogLevel GetSystemLevel();
 
     /// @brief Check if we currently log a specified log verbosity level.
+    /// This is cheap and thread safe, so should be checked before building any message that may be filtered out.
+    /// Internally, the CSP_LOG_LAZY macro does this for you.
     /// @param Level The level to check.
     bool LoggingEnabled(const csp::common::LogLevel Level);
 
+    /// @brief Enables or disables asynchronous logging.
+    /// When enabled, LogMsg only queues the message, and file logging and the log callback are run on a dedicated thread,
+    /// so that logging never blocks the calling thread. If messages are logged faster than they can be handled, the excess is dropped,
+    /// and a warning reporting how many were dropped is logged.
+    /// Asynchronous logging is not supported on WASM, where this does nothing.
+    /// @param Enabled Whether log messages should be handled asynchronously.
+    void SetAsyncLoggingEnabled(bool Enabled);
+
+    /// @brief Blocks until all queued log messages have been handled. Does nothing if asynchronous logging is disabled.
+    /// When called from a log callback, returns without waiting, as the callback is itself handling the queued messages.
+    void FlushLogs();
+
     /// @brief Log a message at a specific verbosity level.
     /// @param Level The level to log this message at.
     /// @param InMessage The message to be logged.
@@ -83,10 +100,19 @@ public:
     void ClearAllCallbacks();
 
 private:
-    csp::common::LogLevel SystemLevel = LogLevel::All;
+    CSP_START_IGNORE
+    std::atomic<csp::common::LogLevel> SystemLevel { LogLevel::All };
+    std::atomic_bool AsyncLoggingEnabled { false };
+    // Only created once asynchronous logging is first enabled.
+    std::atomic<struct AsyncLogSink*> AsyncSink { nullptr };
+    std::once_flag AsyncSinkCreated;
+    CSP_END_IGNORE
 
     void LogToFile(const csp::common::LogLevel Level, const csp::common::String& InMessage);
 
+    // Sends a message that has passed the level check to the log file and callback.
+    void DispatchMsg(const csp::common::LogLevel Level, const csp::common::String& InMessage);
+
     // Allocate internally to avoid warning C4251 'needs to have dll-interface to be used by clients'
     struct LogCallbacks* Callbacks;
 };
@@ -18,25 +18,47 @@
 #include "CSP/Common/Interfaces/IRealtimeEngine.h"
 #include "CSP/Multiplayer/SpaceEntity.h"
 
+#include <vector>
+
 namespace csp::multiplayer
 {
 /// @brief CSPSceneDescription which represents all entities that exists for a scene.
 /// @details This data structure is created through the deserialization of a CSPSceneDescription Json which is retrieved externally.
 /// The json file used to create this structure is also used to create a systems::CSPSceneData object.
 /// The reason these are seperated is to break dependencies between our multiplayer and corer modules.
+/// A CSPSceneDescription can also be created from a binary checkpoint, see OfflineRealtimeEngine::CreateCheckpoint.
 class CSP_API CSPSceneDescription
 {
 public:
     /// @brief Constructor for CSPSceneDescription by deserializing a SceneDescription json file.
     /// @param SceneDescriptionJson csp::common::String : The SceneDescription to parse.
-    /// @warning The expression of this interface as a list is a wrapper generator workaround, so
-    /// whilst you may split your string into many elements, it is not advisable. You should prefer
-    /// inserting your entire string as the first, single, and only element of the list.
+    /// @note The expression of this interface as a list is a wrapper generator workaround. The elements are parsed
+    /// as one continuous string without being joined, so large scenes may be split into as many elements as is convenient.
     CSPSceneDescription(const csp::common::List<csp::common::String>& SceneDescriptionJson);
 
+    /// @brief Constructor for CSPSceneDescription from a binary checkpoint, as created by OfflineRealtimeEngine::CreateCheckpoint.
+    /// @details The data is copied, so it only needs to remain valid for the duration of this call.
+    /// @param CheckpointData const void* : The checkpoint to load.
+    /// @param CheckpointDataLength size_t : The size of the checkpoint in bytes.
+    CSPSceneDescription(const void* CheckpointData, size_t CheckpointDataLength);
+
     CSPSceneDescription() { }
 
+    /// @brief Whether this was created from a binary checkpoint, rather than json.
+    /// @return bool
+    bool IsCheckpoint() const;
+
+    /// @brief Gets the binary checkpoint this was created from, for writing out. Null if this was created from json.
+    /// @return const void*
+    const void* GetCheckpointData() const;
+
+    /// @brief Gets the size of the binary checkpoint in bytes, or 0 if this was created from json.
+    /// @return size_t
+    size_t GetCheckpointDataLength() const;
+
     /// @brief Generates an array of entities from the SceneDescription Json
+    /// The Json is streamed, and each entity is created as soon as its object has been read, so the whole scene is never held in memory
+    /// as a parsed document.
     /// This function exists because the construction of SpaceEntites relies on a RealtimeEngine, and the OfflineRealtimeEngine requires a
     /// CSPSceneDescription for construction.
     /// @param RealtimeEngine csp::common::IRealtimeEngine& : The RealtimeEngine for this session.
@@ -45,8 +67,17 @@ public:
     CSP_NO_EXPORT csp::common::Array<csp::multiplayer::SpaceEntity*> CreateEntities(
         csp::common::IRealtimeEngine& RealtimeEngine, csp::common::LogSystem& LogSystem, csp::common::IJSScriptRunner& RemoteScriptRunner) const;
 
+    CSP_START_IGNORE
+    /// @brief Takes ownership of an already built binary checkpoint, avoiding a copy.
+    CSP_NO_EXPORT CSPSceneDescription(std::vector<char>&& CheckpointData);
+    CSP_END_IGNORE
+
 private:
-    csp::common::String SceneDescriptionJson;
+    csp::common::List<csp::common::String> SceneDescriptionJson;
+
+    CSP_START_IGNORE
+    std::vector<char> CheckpointData;
+    CSP_END_IGNORE
 };
 
 }
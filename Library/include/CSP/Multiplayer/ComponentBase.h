@@ -167,6 +167,12 @@ public:
     // Used for handling behavior when a client first deletes the component.
     CSP_NO_EXPORT virtual void OnLocalDelete();
 
+    /// @brief Get the properties that have been set locally since the component was last replicated, keyed by property key.
+    CSP_NO_EXPORT const csp::common::Map<uint32_t, csp::common::ReplicatedValue>& GetDirtyProperties() const;
+
+    /// @brief Clears the record of locally set properties, once they have been replicated.
+    CSP_NO_EXPORT void ClearDirtyProperties();
+
 protected:
     ComponentBase();
 
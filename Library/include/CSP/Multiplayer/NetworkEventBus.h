@@ -23,7 +23,9 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace csp::common
 {
@@ -182,6 +184,11 @@ public:
     /// @brief NetworkEventBus destructor
     CSP_NO_EXPORT ~NetworkEventBus();
 
+    /// @brief Deserialises an OnEventMessage received from the multiplayer connection and calls the callbacks registered for it.
+    /// @details Events that nothing is listening to are discarded without being deserialised.
+    /// @param Result const signalr::value& : The arguments of the OnEventMessage, the first of which is the event message.
+    CSP_NO_EXPORT void DispatchEventMessage(const signalr::value& Result);
+
     CSP_START_IGNORE
     /*
      * @brief Network events CSP sends over the network to facilitate its internal functionality.
@@ -232,7 +239,33 @@ private:
     CSP_NO_EXPORT std::unique_ptr<csp::common::NetworkEventData> DeserialiseForEventType(
         NetworkEvent EventType, const std::vector<signalr::value>& EventValues);
 
-    std::unordered_map<NetworkEventRegistration, NetworkEventCallback> RegisteredEvents = {};
+    CSP_START_IGNORE
+    struct EventListener
+    {
+        csp::common::String EventReceiverId;
+        // Shared so that a callback stays alive while it runs, even if it deregisters itself.
+        std::shared_ptr<NetworkEventCallback> Callback;
+        // Set instead of erasing when a listener is deregistered during dispatch, so the list being dispatched doesn't shift.
+        bool Removed = false;
+    };
+
+    struct EventListeners
+    {
+        // Resolved once at registration, rather than from the event name of each message.
+        NetworkEvent EventType;
+        std::vector<EventListener> Listeners;
+    };
+
+    static std::vector<EventListener>::iterator FindListener(std::vector<EventListener>& Listeners, const csp::common::String& EventReceiverId);
+    void RemoveListener(EventListeners& Entry, std::vector<EventListener>::iterator Listener);
+    void RemoveDeregisteredListeners();
+
+    // Listeners by event name, in the order they were registered.
+    std::unordered_map<std::string, EventListeners> RegisteredEvents;
+
+    int DispatchDepth = 0;
+    bool HasDeregisteredListeners = false;
+    CSP_END_IGNORE
 };
 
 } // namespace csp::multiplayer
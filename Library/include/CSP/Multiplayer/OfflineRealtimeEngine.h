@@ -26,8 +26,12 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <unordered_set>
+#include <vector>
 
 class CSPEngine_OfflineRealtimeEngineTests_SelectEntity_Test;
+class CSPEngine_OfflineRealtimeEngineTests_EntityIndexTest_Test;
+class CSPEngine_OfflineRealtimeEngineTests_EntitySelectionIndexTest_Test;
 
 namespace csp::common
 {
@@ -39,6 +43,8 @@ namespace csp::multiplayer
 {
 class CSPSceneDescription;
 class EntityScriptBinding;
+class SpaceEntityIndex;
+class SpaceEntitySpatialIndex;
 class SpaceEntityStatePatcher;
 
 /// @brief Class for creating and managing objects in an offline context.
@@ -50,6 +56,8 @@ class CSP_API OfflineRealtimeEngine : public csp::common::IRealtimeEngine
     CSP_START_IGNORE
     /** @cond DO_NOT_DOCUMENT */
     friend class ::CSPEngine_OfflineRealtimeEngineTests_SelectEntity_Test;
+    friend class ::CSPEngine_OfflineRealtimeEngineTests_EntityIndexTest_Test;
+    friend class ::CSPEngine_OfflineRealtimeEngineTests_EntitySelectionIndexTest_Test;
     /** @endcond */
     CSP_END_IGNORE
 
@@ -146,6 +154,16 @@ public:
     /// @return A pointer to the first found matching SpaceEntity.
     [[nodiscard]] virtual csp::multiplayer::SpaceEntity* FindSpaceObject(const csp::common::String& Name) override;
 
+    /// @brief Finds every SpaceEntity with a matching Name.
+    /// @param Name csp::common::String : The name to search for.
+    /// @return A list of non-owning pointers to the matching entities, in the order they were added to the realtime engine.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesByName(const csp::common::String& Name) override;
+
+    /// @brief Finds every SpaceEntity that has at least one component of the given type.
+    /// @param Type csp::multiplayer::ComponentType : The type of component to search for.
+    /// @return A list of non-owning pointers to the matching entities, in the order they were added to the realtime engine.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesWithComponent(ComponentType Type) override;
+
     /// @brief Get an Entity by its index.
     ///
     /// @param EntityIndex size_t : The index of the entity to get.
@@ -185,6 +203,27 @@ public:
     /// @return A list of root entities containing non-owning pointers to entities.
     [[nodiscard]] virtual const csp::common::List<csp::multiplayer::SpaceEntity*>* GetRootHierarchyEntities() const override;
 
+    /// @brief Finds all entities whose global position is within Radius of Position.
+    /// @param Position csp::common::Vector3 : The centre of the search, in world space.
+    /// @param Radius float : The distance from Position to search within. A negative radius finds no entities.
+    /// @return A list of non-owning pointers to the entities found, in no particular order.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesInRadius(
+        const csp::common::Vector3& Position, float Radius) override;
+
+    /// @brief Finds the entities whose global positions are nearest to Position.
+    /// @param Position csp::common::Vector3 : The point to measure from, in world space.
+    /// @param Count size_t : The maximum number of entities to find.
+    /// @return A list of non-owning pointers to up to Count entities, nearest first.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindNearestSpaceEntities(
+        const csp::common::Vector3& Position, size_t Count) override;
+
+    /// @brief Finds all entities whose global position is inside a frustum, or any other convex volume, given as a set of planes.
+    /// @param Planes csp::common::List<csp::common::Vector4> : The planes bounding the volume. Each plane is (Normal.X, Normal.Y, Normal.Z,
+    /// Distance) with the normal pointing into the volume, so a position P is inside the plane when Dot(Normal, P) + Distance >= 0.
+    /// @return A list of non-owning pointers to the entities found, in no particular order.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesInFrustum(
+        const csp::common::List<csp::common::Vector4>& Planes) override;
+
     /// @brief "Resolves" the entity heirarchy for the given entity, setting all internal parent/child buffers correctly.
     /// This method is called whenever parent/child relationships are changed for a given entity, including when one is first created.
     /// @param Entity csp::multiplayer::SpaceEntity* : The Entity to resolve
@@ -233,6 +272,43 @@ public:
 
     CSP_NO_EXPORT std::recursive_mutex& GetEntitiesLock();
 
+    /// @brief Called by a SpaceEntity when its selecting client changes, to keep the selection index in sync.
+    /// @param Entity SpaceEntity* : The entity whose selection state changed.
+    /// @param PreviousClientId uint64_t : The id of the client that was previously selecting the entity, or 0 if none.
+    CSP_NO_EXPORT void OnEntitySelectionChanged(SpaceEntity* Entity, uint64_t PreviousClientId);
+
+    /// @brief Called by a SpaceEntity when its name changes, to keep the name index in sync.
+    /// @param Entity SpaceEntity* : The renamed entity.
+    CSP_NO_EXPORT void OnEntityNameChanged(SpaceEntity* Entity);
+
+    /// @brief Called by a SpaceEntity when it gains or loses a component, to keep the component type index in sync.
+    /// @param Entity SpaceEntity* : The entity whose components changed.
+    /// @param Type ComponentType : The type of the component that was added or removed.
+    CSP_NO_EXPORT void OnEntityComponentAdded(SpaceEntity* Entity, ComponentType Type);
+    CSP_NO_EXPORT void OnEntityComponentRemoved(SpaceEntity* Entity, ComponentType Type);
+
+    /// @brief Called by a SpaceEntity when its global transform changes, to keep the spatial index in sync and record where UpdateGlobalTransforms
+    /// should start from.
+    /// @param Entity SpaceEntity* : The entity that moved.
+    CSP_NO_EXPORT void OnEntityTransformInvalidated(SpaceEntity* Entity);
+
+    /// @brief Brings the cached global transform of every entity up to date, walking down from the entities that moved since the last call.
+    /// Global transforms are otherwise computed when first queried after a change. Calling this after moving a large hierarchy,
+    /// such as an imported glTF scene, avoids that cost landing on whichever query comes first.
+    void UpdateGlobalTransforms();
+
+    /// @brief Captures the state of every entity, including the hierarchy, as a binary checkpoint.
+    /// @details The checkpoint is much faster to write and load than json, and holds the same information as CreateSceneDescriptionJson,
+    /// so either form can be converted to the other by loading it into an OfflineRealtimeEngine.
+    /// To restore it, pass the result to the OfflineRealtimeEngine constructor. To save it, use CSPSceneDescription::GetCheckpointData.
+    /// @return CSPSceneDescription : A scene description holding the checkpoint.
+    CSPSceneDescription CreateCheckpoint();
+
+    /// @brief Captures the state of every entity, including the hierarchy, as SceneDescription json.
+    /// @details Only data.objectMessages is written, as that is all a CSPSceneDescription reads.
+    /// @return csp::common::String : The json.
+    csp::common::String CreateSceneDescriptionJson();
+
     /// @brief The client ID of the local client. An arbitrary unchanging value.
     /// @return INT53_MAX, the maximum number expressible in all our interop languages (you can thank javascript for the weird sizing).
     static uint64_t LocalClientId();
@@ -258,6 +334,21 @@ private:
 
     std::recursive_mutex EntitiesLock;
 
+    // Id and selecting-client lookup for everything in Entities.
+    CSP_START_IGNORE
+    std::unique_ptr<SpaceEntityIndex> EntityIndex;
+
+    // Position lookup for everything in Entities.
+    std::unique_ptr<SpaceEntitySpatialIndex> SpatialIndex;
+
+    // Reused by UpdateGlobalTransforms.
+    std::vector<SpaceEntity*> GlobalTransformUpdateOrder;
+    // Entities whose global transform was invalidated while their parent's was up to date, so the tops of the moved subtrees.
+    // Entities report these without the entities lock held, so they are guarded by their own leaf mutex.
+    std::unordered_set<SpaceEntity*> DirtyTransformRoots;
+    std::mutex DirtyTransformRootsLock;
+    CSP_END_IGNORE
+
     std::unique_ptr<class OfflineSpaceEntityEventHandler> EventHandler;
     EntityScriptBinding* ScriptBinding;
 };
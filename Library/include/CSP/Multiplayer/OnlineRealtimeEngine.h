@@ -34,6 +34,8 @@
 #include <mutex>
 #include <optional>
 #include <set>
+#include <unordered_set>
+#include <vector>
 
 namespace async
 {
@@ -55,6 +57,8 @@ class CSPEngine_OnlineRealtimeEngineTests_TestErrorInSendNewAvatarObjectMessage_
 class CSPEngine_OnlineRealtimeEngineTests_TestSuccessInSendNewAvatarObjectMessage_Test;
 class CSPEngine_OnlineRealtimeEngineTests_TestSuccessInCreateNewLocalAvatar_Test;
 class CSPEngine_MultiplayerTests_ManyEntitiesTest_Test;
+class CSPEngine_OnlineRealtimeEngineTests_TestRetrieveAllEntitiesCommitsPagesInOrder_Test;
+class CSPEngine_OnlineRealtimeEngineTests_TestRetrieveAllEntitiesCompletesWhenAPageFails_Test;
 
 namespace csp::common
 {
@@ -76,6 +80,73 @@ class MultiplayerConnection;
 class ISignalRConnection;
 class NetworkEventBus;
 class ScopeLeadershipManager;
+class SpaceEntityIndex;
+class IncomingPatchCoalescer;
+class OutgoingPatchScheduler;
+class SpaceEntitySpatialIndex;
+class EntityInterestManager;
+
+/// @brief How urgently an entity's patches are sent, relative to the other entities with patches waiting to be sent.
+enum class EntityPatchPriority
+{
+    Low,
+    Normal,
+    High,
+    Critical
+};
+
+CSP_START_IGNORE
+namespace mcs
+{
+class MessagePackReader;
+class MessagePackWriter;
+class ObjectPatch;
+}
+
+/// @brief Timings for the initial fetch of all entities in a space, split by phase.
+/// @details Decode runs on worker threads, so its time is wall-clock per page, summed over all pages.
+/// Network wait is the time between requesting a page and receiving it, which overlaps with the materialisation of the previous page.
+struct EntityFetchMetrics
+{
+    uint32_t PageCount = 0;
+    uint64_t EntityCount = 0;
+    std::chrono::microseconds Total { 0 };
+    std::chrono::microseconds NetworkWait { 0 };
+    std::chrono::microseconds Decode { 0 };
+    std::chrono::microseconds Construct { 0 };
+    std::chrono::microseconds Insert { 0 };
+};
+
+/// @brief Counts of the patches received from other clients since the engine was created.
+/// @details Patches for the same entity that arrive between ticks are merged before being applied,
+/// so Received minus Applied is the number of patches that were coalesced away, or held back by interest management.
+struct IncomingPatchMetrics
+{
+    uint64_t Received = 0;
+    uint64_t Applied = 0;
+    uint64_t Coalesced = 0;
+};
+
+/// @brief Counts of the patches sent to other clients since the engine was created.
+struct OutgoingPatchMetrics
+{
+    uint64_t Sent = 0;
+    uint64_t Bytes = 0;
+    // Patches that were ready to send but held back to a later tick by the patch byte budget.
+    uint64_t DeferredByBudget = 0;
+};
+
+/// @brief Counts of the updates for entities outside the interest radius that were held back, since the engine was created.
+/// @details The patches held for an entity are merged before being applied, so DeferredPatches minus CaughtUpPatches is the number of patch
+/// applications avoided, plus any patches still held.
+struct InterestManagementMetrics
+{
+    uint64_t DeferredPatches = 0;
+    // Held patches applied when their entity came back into range, or at the catch-up interval.
+    uint64_t CaughtUpPatches = 0;
+    uint64_t SkippedScriptTicks = 0;
+};
+CSP_END_IGNORE
 
 /// @brief Class for creating and managing multiplayer objects known as space entities.
 ///
@@ -93,6 +164,8 @@ class CSP_API OnlineRealtimeEngine : public csp::common::IRealtimeEngine
     friend class CSPEngine_OnlineRealtimeEngineTests_TestSuccessInSendNewAvatarObjectMessage_Test;
     friend class CSPEngine_OnlineRealtimeEngineTests_TestSuccessInCreateNewLocalAvatar_Test;
     friend class CSPEngine_MultiplayerTests_ManyEntitiesTest_Test;
+    friend class CSPEngine_OnlineRealtimeEngineTests_TestRetrieveAllEntitiesCommitsPagesInOrder_Test;
+    friend class CSPEngine_OnlineRealtimeEngineTests_TestRetrieveAllEntitiesCompletesWhenAPageFails_Test;
     /** @endcond */
     CSP_END_IGNORE
 
@@ -182,6 +255,16 @@ public:
     /// @return A pointer to the first found matching SpaceEntity.
     [[nodiscard]] virtual csp::multiplayer::SpaceEntity* FindSpaceObject(const csp::common::String& Name) override;
 
+    /// @brief Finds every SpaceEntity with a matching Name.
+    /// @param Name csp::common::String : The name to search for.
+    /// @return A list of non-owning pointers to the matching entities, in the order they were added to the realtime engine.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesByName(const csp::common::String& Name) override;
+
+    /// @brief Finds every SpaceEntity that has at least one component of the given type.
+    /// @param Type csp::multiplayer::ComponentType : The type of component to search for.
+    /// @return A list of non-owning pointers to the matching entities, in the order they were added to the realtime engine.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesWithComponent(ComponentType Type) override;
+
     /// @brief Get an Entity by its index.
     ///
     /// @param EntityIndex size_t : The index of the entity to get.
@@ -221,6 +304,27 @@ public:
     /// @return A list of root entities containing non-owning pointers to entities.
     [[nodiscard]] virtual const csp::common::List<csp::multiplayer::SpaceEntity*>* GetRootHierarchyEntities() const override;
 
+    /// @brief Finds all entities whose global position is within Radius of Position.
+    /// @param Position csp::common::Vector3 : The centre of the search, in world space.
+    /// @param Radius float : The distance from Position to search within. A negative radius finds no entities.
+    /// @return A list of non-owning pointers to the entities found, in no particular order.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesInRadius(
+        const csp::common::Vector3& Position, float Radius) override;
+
+    /// @brief Finds the entities whose global positions are nearest to Position.
+    /// @param Position csp::common::Vector3 : The point to measure from, in world space.
+    /// @param Count size_t : The maximum number of entities to find.
+    /// @return A list of non-owning pointers to up to Count entities, nearest first.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindNearestSpaceEntities(
+        const csp::common::Vector3& Position, size_t Count) override;
+
+    /// @brief Finds all entities whose global position is inside a frustum, or any other convex volume, given as a set of planes.
+    /// @param Planes csp::common::List<csp::common::Vector4> : The planes bounding the volume. Each plane is (Normal.X, Normal.Y, Normal.Z,
+    /// Distance) with the normal pointing into the volume, so a position P is inside the plane when Dot(Normal, P) + Distance >= 0.
+    /// @return A list of non-owning pointers to the entities found, in no particular order.
+    [[nodiscard]] virtual csp::common::List<csp::multiplayer::SpaceEntity*> FindSpaceEntitiesInFrustum(
+        const csp::common::List<csp::common::Vector4>& Planes) override;
+
     /// @brief "Resolves" the entity heirarchy for the given entity, setting all internal parent/child buffers correctly.
     /// This method is called whenever parent/child relationships are changed for a given entity, including when one is first created.
     /// @param Entity csp::multiplayer::SpaceEntity* : The Entity to resolve
@@ -336,6 +440,79 @@ public:
     /// \endrst
     void SetEntityPatchRateLimitEnabled(bool Enabled);
 
+    /// @brief Sets the priority used when deciding which entities' patches to send first.
+    /// By default, the local client's avatar is Critical, entities selected by the local client are High, and all others are Normal.
+    /// @param Entity SpaceEntity : The entity to set the priority of.
+    /// @param Priority EntityPatchPriority : The priority to use in place of the default.
+    void SetEntityPatchPriority(SpaceEntity* Entity, EntityPatchPriority Priority);
+
+    /// @brief Sets the minimum time between patches for an entity, in place of the interval for its priority or component types.
+    /// @param Entity SpaceEntity : The entity to set the interval of.
+    /// @param IntervalMilliseconds uint32_t : The minimum time between patches.
+    void SetEntityPatchInterval(SpaceEntity* Entity, uint32_t IntervalMilliseconds);
+
+    /// @brief Clears any priority or interval set for the entity with SetEntityPatchPriority or SetEntityPatchInterval.
+    /// @param Entity SpaceEntity : The entity to reset.
+    void ResetEntityPatchSettings(SpaceEntity* Entity);
+
+    /// @brief Sets the minimum time between patches for entities of the given priority. Defaults to 90ms for all priorities.
+    /// @param Priority EntityPatchPriority : The priority to set the interval of.
+    /// @param IntervalMilliseconds uint32_t : The minimum time between patches.
+    void SetPatchIntervalForPriority(EntityPatchPriority Priority, uint32_t IntervalMilliseconds);
+
+    /// @brief Sets the minimum time between patches for entities with a pending change to a component of the given type.
+    /// If an entity has changes to several such components, the shortest interval is used. This is not used for entities with an interval
+    /// set by SetEntityPatchInterval.
+    /// @param Type ComponentType : The component type to set the interval of.
+    /// @param IntervalMilliseconds uint32_t : The minimum time between patches.
+    void SetPatchIntervalForComponentType(ComponentType Type, uint32_t IntervalMilliseconds);
+
+    /// @brief Sets the most patch data to send each tick. Patches that don't fit are sent on a later tick, in priority order.
+    /// At least one patch is always sent per tick, however large.
+    /// @param BytesPerTick uint32_t : The budget in bytes, or 0 for no limit. Defaults to 0.
+    void SetPatchByteBudget(uint32_t BytesPerTick);
+
+    /// @brief Retrieve whether patches that only move an entity are sent with the compact transform encoding.
+    /// @return True if enabled, false otherwise.
+    bool GetCompactTransformEncodingEnabled() const;
+
+    /// @brief Set whether patches that only move an entity are sent with the compact transform encoding.
+    /// This quantizes positions to 1mm within 524m of the space origin, coarser beyond that, compresses rotations to 20 bits per component,
+    /// and sends uniform scales as a single value. Patches that change anything other than the transform are sent as usual.
+    ///
+    /// The encoding is only used for entities that aren't persistent, such as avatars, so that it never reaches stored space state.
+    /// Clients that have enabled it announce that they can decode it when they enter a space, or when enabling it while in one. It is only used
+    /// while every other client with an avatar in the space has done so. When a client that hasn't appears, the transforms of our entities are
+    /// sent again with the usual encoding.
+    ///
+    /// This feature is disabled by default.
+    ///
+    /// @param Enabled : sets if the feature should be enabled or not.
+    /// \rst
+    ///.. note::
+    ///   Clients without an avatar in the space, such as tools that only observe it, are not waited for, and cannot read these patches if they
+    ///   predate the encoding.
+    /// \endrst
+    void SetCompactTransformEncodingEnabled(bool Enabled);
+
+    /// @brief Retrieve the radius around the local avatar outside which updates from other clients are applied less often.
+    /// @return The radius in meters, or 0 if interest management is disabled.
+    float GetInterestRadius() const;
+
+    /// @brief Sets the radius around the local avatar outside which updates from other clients are applied less often.
+    /// Patches for entities outside the radius are held back and merged, then applied once the catch-up interval has passed, or as soon as
+    /// the entity comes back into range. Their script ticks are skipped in the same way. Deletes and parent changes are always applied straight
+    /// away.
+    ///
+    /// This feature is disabled by default.
+    ///
+    /// @param Radius float : The radius in meters, or 0 to disable. For spaces with an object scope, this is typically the scope's SolveRadius.
+    void SetInterestRadius(float Radius);
+
+    /// @brief Sets the longest time that updates for an entity outside the interest radius are held back for. Defaults to 1000ms.
+    /// @param IntervalMilliseconds uint32_t : The catch-up interval.
+    void SetInterestCatchUpInterval(uint32_t IntervalMilliseconds);
+
     /// @brief "Refreshes" (ie, turns on an off again), the multiplayer connection, in order to refresh scopes.
     /// This shouldn't be neccesary, we should devote some effort to checking if it still is at some point
     /// @param SpaceId csp::Common:String& : The Id of the space to refresh
@@ -367,6 +544,11 @@ public:
     // Will only tick scrips if EnableEntityTick is enabled, which it should be if entity fetch has completed.
     CSP_NO_EXPORT void TickEntities();
 
+    /// @brief Brings the cached global transform of every entity up to date, walking down from the entities that moved since the last call.
+    /// Global transforms are otherwise computed when first queried after a change. Calling this after moving a large hierarchy,
+    /// such as an imported glTF scene, avoids that cost landing on whichever query comes first.
+    void UpdateGlobalTransforms();
+
     CSP_START_IGNORE
     CSP_NO_EXPORT void RegisterDefaultScope(const std::string& ScopeId, const std::optional<uint64_t>& LeaderId);
 
@@ -387,6 +569,50 @@ public:
     CSP_NO_EXPORT void OnElectedScopeLeader(const signalr::value& Params);
     CSP_NO_EXPORT void OnVacatedAsScopeLeader(const signalr::value& Params);
 
+    /// @brief Called by a SpaceEntity when its selecting client changes, to keep the selection index in sync.
+    /// @param Entity SpaceEntity* : The entity whose selection state changed.
+    /// @param PreviousClientId uint64_t : The id of the client that was previously selecting the entity, or 0 if none.
+    CSP_NO_EXPORT void OnEntitySelectionChanged(SpaceEntity* Entity, uint64_t PreviousClientId);
+
+    /// @brief Called by a SpaceEntity when its name changes, to keep the name index in sync.
+    /// @param Entity SpaceEntity* : The renamed entity.
+    CSP_NO_EXPORT void OnEntityNameChanged(SpaceEntity* Entity);
+
+    /// @brief Called by a SpaceEntity when it gains or loses a component, to keep the component type index in sync.
+    /// @param Entity SpaceEntity* : The entity whose components changed.
+    /// @param Type ComponentType : The type of the component that was added or removed.
+    CSP_NO_EXPORT void OnEntityComponentAdded(SpaceEntity* Entity, ComponentType Type);
+    CSP_NO_EXPORT void OnEntityComponentRemoved(SpaceEntity* Entity, ComponentType Type);
+
+    /// @brief Called by a SpaceEntity when its global transform changes, to keep the spatial index in sync and record where UpdateGlobalTransforms
+    /// should start from.
+    /// @param Entity SpaceEntity* : The entity that moved.
+    CSP_NO_EXPORT void OnEntityTransformInvalidated(SpaceEntity* Entity);
+
+    /// @brief Gets the per-phase timings of the most recent initial entity fetch, for diagnosing slow space joins.
+    /// @return EntityFetchMetrics : Default values if no fetch has completed yet.
+    CSP_START_IGNORE
+    CSP_NO_EXPORT EntityFetchMetrics GetLastEntityFetchMetrics() const;
+    CSP_END_IGNORE
+
+    /// @brief Gets the number of patches received from other clients, and how many of them were coalesced.
+    /// @return IncomingPatchMetrics : Totals since the engine was created.
+    CSP_START_IGNORE
+    CSP_NO_EXPORT IncomingPatchMetrics GetIncomingPatchMetrics() const;
+    CSP_END_IGNORE
+
+    /// @brief Gets the number of patches sent to other clients, and how many were held back by the patch byte budget.
+    /// @return OutgoingPatchMetrics : Totals since the engine was created.
+    CSP_START_IGNORE
+    CSP_NO_EXPORT OutgoingPatchMetrics GetOutgoingPatchMetrics() const;
+    CSP_END_IGNORE
+
+    /// @brief Gets the number of patches and script ticks that interest management held back.
+    /// @return InterestManagementMetrics : Totals since the engine was created.
+    CSP_START_IGNORE
+    CSP_NO_EXPORT InterestManagementMetrics GetInterestManagementMetrics() const;
+    CSP_END_IGNORE
+
 protected:
     csp::common::List<SpaceEntity*> Entities;
     csp::common::List<SpaceEntity*> Avatars;
@@ -396,6 +622,11 @@ protected:
 
     std::recursive_mutex* EntitiesLock;
 
+    // Id and selecting-client lookup for everything in Entities.
+    CSP_START_IGNORE
+    std::unique_ptr<SpaceEntityIndex> EntityIndex;
+    CSP_END_IGNORE
+
 private:
     OnlineRealtimeEngine(); // needed for the wrapper generator
 
@@ -416,8 +647,18 @@ private:
     CallbackHandler ScriptSystemReadyCallback;
 
     void GetEntitiesPaged(int Skip, int Limit, const std::function<void(const signalr::value&, std::exception_ptr)>& Callback);
-    std::function<void(const signalr::value&, std::exception_ptr)> CreateRetrieveAllEntitiesCallback(
-        int Skip, csp::common::EntityFetchCompleteCallback FetchCompleteCallback);
+
+    // Shared between the page callbacks of a single RetrieveAllEntities call. Defined in the cpp.
+    CSP_START_IGNORE
+    struct EntityFetchState;
+
+    // Requests the page at Skip. When it arrives, the next page is requested straight away, while this one is decoded on the worker pool.
+    // Pages are then turned into entities and committed to the entity lists in order by CommitFetchedEntityPages, on a single thread.
+    // A page that fails ends the fetch early, with the entities fetched so far.
+    void RequestEntityPage(int Skip, const std::shared_ptr<EntityFetchState>& FetchState);
+    void CommitFetchedEntityPages(EntityFetchState& FetchState);
+    void CompleteEntityFetch(int EntityCount, const csp::common::EntityFetchCompleteCallback& FetchCompleteCallback);
+    CSP_END_IGNORE
 
     // Calls GetEntitiesPaged to start off a paged recursive fetch of all the entities in the space
     void RetrieveAllEntities(csp::common::EntityFetchCompleteCallback FetchCompleteCallback);
@@ -429,7 +670,9 @@ private:
 
     void AddPendingEntity(SpaceEntity* EntityToAdd);
     void RemovePendingEntity(SpaceEntity* EntityToRemove);
-    void ApplyIncomingPatch(const signalr::value*);
+    CSP_START_IGNORE
+    void ApplyIncomingPatch(const mcs::ObjectPatch& Patch);
+    CSP_END_IGNORE
     void HandleException(const std::exception_ptr& Except, const std::string& ExceptionDescription);
 
     bool EntityIsInRootHierarchy(SpaceEntity* Entity);
@@ -443,13 +686,26 @@ private:
 
     bool IsLocalClientLeader() const;
 
+    // Returns nullptr if the local client has no avatar.
+    SpaceEntity* FindLocalAvatar() const;
+
     // These are used for client-side leader eleciton and can be removed as part of OF-1785.
     void OnAvatarAdd(const SpaceEntity* Avatar, const csp::common::List<SpaceEntity*>& Avatars);
     void OnAvatarRemove(const SpaceEntity* Avatar, const csp::common::List<SpaceEntity*>& Avatars);
     void OnObjectAdd(const SpaceEntity* Object, const csp::common::List<SpaceEntity*>& Entities);
     void OnObjectRemove(const SpaceEntity* Object, const csp::common::List<SpaceEntity*>& Entities);
 
-    void SendPatches(const csp::common::List<SpaceEntity*> PendingEntities);
+    // Returns how many of the entities, from the front of the list, had their patches sent. The rest did not fit in the byte budget.
+    size_t SendPatches(const csp::common::List<SpaceEntity*>& PendingEntities, bool AllowCompactTransforms);
+
+    // Tells other clients that we can decode the compact transform encoding. Sent to everyone on entering a space, or to one client in reply to
+    // its own announcement.
+    void AnnounceCompactTransformSupport(std::optional<uint64_t> ReplyToClientId);
+    void OnCompactTransformSupportEvent(const csp::common::NetworkEventData& EventData);
+    // True if the compact transform encoding is enabled, and every other client with an avatar in the space has announced it can decode it.
+    bool CanSendCompactTransforms() const;
+    // Queues the transforms of the transient entities we own to be sent again, with the usual encoding.
+    void ResendTransientTransforms();
 
     // Used in OnObjectMessage as well as in the initial entity fetch. Uses CreateEntity to make entities when instructed to from the server, via
     // signalR message.
@@ -466,6 +722,25 @@ private:
         LocomotionModel LocomotionModel, EntityCreatedCallback Callback);
     CSP_END_IGNORE
 
+    // Reused by SendPatches, so that once it has grown to fit a typical batch, patches are encoded without allocating.
+    CSP_START_IGNORE
+    std::unique_ptr<mcs::MessagePackWriter> PatchWriter;
+    // Reused by ProcessPendingEntityOperations to decode incoming patches, which the connection hands over still encoded.
+    std::unique_ptr<mcs::MessagePackReader> PatchReader;
+
+    // Merges the incoming patches for each entity in ProcessPendingEntityOperations. Kept between ticks to reuse its storage.
+    std::unique_ptr<IncomingPatchCoalescer> PatchCoalescer;
+
+    // Decides which of PendingOutgoingUpdateUniqueSet are sent each tick.
+    std::unique_ptr<OutgoingPatchScheduler> PatchScheduler;
+    // Patches are encoded here first, so that the batch can be cut at the byte budget before its size is written to PatchWriter.
+    std::unique_ptr<mcs::MessagePackWriter> PatchBudgetWriter;
+
+    // Global positions of everything in Entities, used to find the entities within the interest radius.
+    std::unique_ptr<SpaceEntitySpatialIndex> SpatialIndex;
+    std::unique_ptr<EntityInterestManager> InterestManager;
+    CSP_END_IGNORE
+
     class EntityScriptBinding* ScriptBinding;
     class SpaceEntityEventHandler* EventHandler;
 
@@ -498,10 +773,30 @@ private:
     bool EnableEntityTick;
     std::list<SpaceEntity*> TickUpdateEntities;
 
+    CSP_START_IGNORE
+    EntityFetchMetrics LastEntityFetchMetrics;
+    IncomingPatchMetrics PatchMetrics;
+    OutgoingPatchMetrics OutgoingMetrics;
+    // Reused by ProcessPendingEntityOperations.
+    std::vector<SpaceEntity*> ReadyOutgoingEntities;
+    // Reused by UpdateGlobalTransforms.
+    std::vector<SpaceEntity*> GlobalTransformUpdateOrder;
+    // Entities whose global transform was invalidated while their parent's was up to date, so the tops of the moved subtrees.
+    // Entities report these without the entities lock held, so they are guarded by their own leaf mutex.
+    std::unordered_set<SpaceEntity*> DirtyTransformRoots;
+    std::mutex DirtyTransformRootsLock;
+    CSP_END_IGNORE
+
     std::chrono::system_clock::time_point LastTickTime;
-    std::chrono::milliseconds EntityPatchRate;
 
     bool EntityPatchRateLimitEnabled = true;
+    bool CompactTransformEncodingEnabled = false;
+    // Whether the compact transform encoding was allowed when patches were last sent.
+    bool CompactTransformsAllowed = false;
+
+    // Clients that have announced they can decode the compact transform encoding. Written from network event callbacks.
+    std::unordered_set<uint64_t> CompactTransformClients;
+    mutable std::mutex CompactTransformClientsLock;
 
     // May not be null
     csp::common::IJSScriptRunner* ScriptRunner;
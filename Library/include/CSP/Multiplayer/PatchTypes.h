@@ -15,6 +15,11 @@
  */
 #pragma once
 
+#include "CSP/CSPCommon.h"
+#include "CSP/Common/Array.h"
+
+#include <cstdint>
+
 namespace csp::multiplayer
 {
 
@@ -35,7 +40,8 @@ enum SpaceEntityUpdateFlags
 };
 
 /// @brief This Enum should be used to determine what kind of operation the component update represents.
-/// Update means properties on the component have updated, all need to be checked as we do not provide reference of specific property updates.
+/// Update means properties on the component have updated. ComponentUpdateInfo::PropertyInfo lists the properties that changed, if it is empty all
+/// properties need to be checked.
 /// Add means the component is newly added, clients should ensure that this triggers appropriate instantiation of wrapping objects.
 /// All properties for the component should be included.
 /// Delete means the component has been marked for deletion. It is likely that some other clients will not have the component at the point this is
@@ -48,6 +54,17 @@ enum class ComponentUpdateType
     Delete,
 };
 
+/// @brief Info class that specifies a type of update and the ID of a component property the update is applied to.
+class CSP_API ComponentPropertyUpdateInfo
+{
+public:
+    uint32_t PropertyId;
+    ComponentUpdateType UpdateType;
+
+    bool operator==(const ComponentPropertyUpdateInfo& Other) const { return PropertyId == Other.PropertyId && UpdateType == Other.UpdateType; }
+    bool operator!=(const ComponentPropertyUpdateInfo& Other) const { return !(*this == Other); }
+};
+
 /// @brief Info class that specifies a type of update and the ID of a component the update is applied to.
 class CSP_API ComponentUpdateInfo
 {
@@ -55,7 +72,15 @@ public:
     uint16_t ComponentId;
     ComponentUpdateType UpdateType;
 
-    bool operator==(const ComponentUpdateInfo& Other) const { return ComponentId == Other.ComponentId && UpdateType == Other.UpdateType; }
+    /// @brief The properties that changed, for updates of type ComponentUpdateType::Update.
+    /// Empty for other update types, or if no property could be identified as changed, in which case all properties need to be checked.
+    csp::common::Array<ComponentPropertyUpdateInfo> PropertyInfo;
+
+    bool operator==(const ComponentUpdateInfo& Other) const
+    {
+        return ComponentId == Other.ComponentId && UpdateType == Other.UpdateType && PropertyInfo == Other.PropertyInfo;
+    }
+
     bool operator!=(const ComponentUpdateInfo& Other) const { return !(*this == Other); }
 };
 
@@ -113,6 +113,11 @@ public:
     /// @param MessageParamsJson csp::common::String : A JSON formatted string of parameters to be passed to the callback.
     void PostMessageToScript(const csp::common::String Message, const csp::common::String MessageParamsJson = "");
 
+    /// @brief Checks whether the script has subscribed a callback to the given message.
+    /// @param Message csp::common::String : The message to check.
+    /// @return True if posting the message would run a callback, false otherwise.
+    CSP_NO_EXPORT bool IsSubscribedToMessage(const csp::common::String& Message) const;
+
     /// @brief Resets binding, context and subscriptions when the source is changed for the script.
     /// @param InScriptSource csp::common::String : The new source for the script.
     void OnSourceChanged(const csp::common::String& InScriptSource);
@@ -139,6 +144,8 @@ private:
 
     void CheckBinding();
 
+    bool ShouldRunScriptsLocally() const;
+
     SpaceEntity* Entity;
     ScriptSpaceComponent* EntityScriptComponent;
 
@@ -151,6 +151,8 @@ public:
     const SpaceTransform& GetTransform() const;
 
     /// @brief Get the Global SpaceTransform of the SpaceEntity, derived from it's parent.
+    /// The result is cached until this entity or one of its ancestors is moved or reparented. The cache is guarded by its own lock,
+    /// so this can be called from any thread.
     /// @return SpaceTransform.
     SpaceTransform GetGlobalTransform() const;
 
@@ -415,6 +417,10 @@ public:
     /// @brief Remove child entities from parent.
     CSP_NO_EXPORT void RemoveAsChildFromParent();
 
+    /// @brief Whether the cached global transform needs recomputing, as this entity or one of its ancestors has moved or been reparented.
+    /// @return bool
+    CSP_NO_EXPORT bool IsGlobalTransformDirty() const;
+
     /// @brief Sets the internal ParentId to nullptr
     CSP_NO_EXPORT void RemoveParentId();
 
@@ -454,6 +460,20 @@ private:
 
     void AddChildEntity(SpaceEntity* ChildEntity);
 
+    // Sets the selecting client id and informs the owning realtime engine, so its selection index stays current.
+    void SetSelectedIdDirect(uint64_t Value, bool CallNotifyingCallback = false);
+
+    // Marks the cached global transform of this entity and all its descendants as needing recomputing.
+    void InvalidateGlobalTransform();
+    // Recomputes the cached global transform from the parent's, which is brought up to date first if needed.
+    // Must be called with GlobalTransformLock held.
+    void UpdateGlobalTransform() const;
+
+    // Inform the owning realtime engine of changes to the name and component types, so its entity index stays current.
+    void NotifyNameChanged();
+    void NotifyComponentAdded(ComponentType Type);
+    void NotifyComponentRemoved(ComponentType Type);
+
     csp::common::IRealtimeEngine* EntitySystem;
 
     SpaceEntityType Type;
@@ -471,6 +491,11 @@ private:
     SpaceEntity* Parent = nullptr;
     csp::common::List<SpaceEntity*> ChildEntities;
 
+    // Our transform in world space. Only valid while GlobalTransformDirty is false. Both are guarded by GlobalTransformLock.
+    // If an entity is dirty, all its descendants are too, as a cache is only ever refreshed after its parent's.
+    mutable SpaceTransform GlobalTransform;
+    mutable bool GlobalTransformDirty = true;
+
     LockType EntityLock;
 
     UpdateCallback EntityUpdateCallback;
@@ -495,6 +520,10 @@ private:
     std::recursive_mutex EntityMutexLock;
     std::recursive_mutex PropertiesLock;
     std::recursive_mutex ComponentsLock;
+
+    // A refresh holds this while taking its parent's, and invalidation releases it before moving on to its children,
+    // so locks are only ever nested from child to parent.
+    mutable std::mutex GlobalTransformLock;
     CSP_END_IGNORE
 
     /// @brief Setter for the parent entity
@@ -519,6 +548,17 @@ void SpaceEntity::SetPropertyDirect(P& Property, const V& Value, SpaceEntityUpda
     // as ReplicatedValues can only hold specific types.
     // This is quite brittle, so we are finding a better way to handle this.
     Property = static_cast<P>(Value);
+
+    if (Flag & (UPDATE_FLAGS_POSITION | UPDATE_FLAGS_ROTATION | UPDATE_FLAGS_SCALE))
+    {
+        InvalidateGlobalTransform();
+    }
+
+    if (Flag & UPDATE_FLAGS_NAME)
+    {
+        NotifyNameChanged();
+    }
+
     if (CallNotifyingCallback && EntityUpdateCallback)
     {
         csp::common::Array<ComponentUpdateInfo> Empty;
@@ -62,6 +62,8 @@ public:
     bool DestroyContext(int64_t ContextId) override;
     bool BindContext(int64_t ContextId) override;
     bool ResetContext(int64_t ContextId) override;
+    bool CallMessageCallback(int64_t ContextId, const csp::common::String& CallbackName, const csp::common::String& Message,
+        const csp::common::String& MessageParamsJson) override;
     bool ExistsInContext(int64_t ContextId, const csp::common::String& ObjectName);
     void* GetContext(int64_t ContextId) override;
     void* GetModule(int64_t ContextId, const csp::common::String& ModuleName) override;
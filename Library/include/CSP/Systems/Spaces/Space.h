@@ -24,6 +24,7 @@
 #include "CSP/Systems/SystemsResult.h"
 #include "CSP/Systems/WebService.h"
 
+#include <chrono>
 #include <functional>
 
 namespace csp::multiplayer
@@ -170,6 +171,29 @@ private:
     csp::common::String Id;
 };
 
+CSP_START_IGNORE
+/// @brief When a phase of entering a space started, relative to the call to SpaceSystem::EnterSpace, and how long it took.
+struct EnterSpacePhaseTiming
+{
+    std::chrono::microseconds Start { 0 };
+    std::chrono::microseconds Duration { 0 };
+};
+
+/// @brief Timings for the phases of SpaceSystem::EnterSpace.
+/// @details Once the user has been added to the space, looking up its scopes runs alongside refreshing the multiplayer connection,
+/// so those phases overlap. Phases that don't apply, such as the network phases when entering an offline space, are left at zero.
+/// StartEntityFetch only covers starting the fetch, which continues after EnterSpace completes. See OnlineRealtimeEngine::GetLastEntityFetchMetrics.
+struct EnterSpaceMetrics
+{
+    EnterSpacePhaseTiming DiscoverSpace;
+    EnterSpacePhaseTiming AddUser;
+    EnterSpacePhaseTiming LookupScopes;
+    EnterSpacePhaseTiming RefreshConnection;
+    EnterSpacePhaseTiming StartEntityFetch;
+    std::chrono::microseconds Total { 0 };
+};
+CSP_END_IGNORE
+
 /// @ingroup Space System
 /// @brief Data class used to contain information when attempting to get a space.
 class CSP_API SpaceResult : public csp::systems::ResultBase
@@ -191,6 +215,10 @@ public:
     /// @return csp::common::String : the space code
     const csp::common::String& GetSpaceCode() const;
 
+    /// @brief Retrieves the timings of the phases of entering the space. Only set on the successful result of SpaceSystem::EnterSpace.
+    /// @return EnterSpaceMetrics : the phase timings
+    CSP_NO_EXPORT const EnterSpaceMetrics& GetEnterSpaceMetrics() const;
+
     CSP_NO_EXPORT SpaceResult(csp::systems::EResultCode ResCode, uint16_t HttpResCode)
         : csp::systems::ResultBase(ResCode, HttpResCode) {};
 
@@ -203,6 +231,7 @@ private:
     SpaceResult(void*) {};
 
     void SetSpace(const Space& InSpace);
+    CSP_NO_EXPORT void SetEnterSpaceMetrics(const EnterSpaceMetrics& InMetrics);
 
     CSP_NO_EXPORT void OnResponse(const csp::services::ApiResponseBase* ApiResponse) override;
 
@@ -212,6 +241,10 @@ private:
     // as a result they offer minimal value to fdn's users, and so we treat them separately
     // from the far more heavily used `Space` type
     csp::common::String SpaceCode;
+
+    CSP_START_IGNORE
+    EnterSpaceMetrics Metrics;
+    CSP_END_IGNORE
 };
 
 /// @ingroup Space System
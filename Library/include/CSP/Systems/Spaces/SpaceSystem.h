@@ -443,14 +443,26 @@ private:
         const std::shared_ptr<SpaceResult>& Space, const csp::systems::BufferAssetDataSource& Data);
     std::function<async::task<NullResult>()> BulkInviteUsersToSpaceIfNeccesary(
         SpaceSystem* SpaceSystem, const std::shared_ptr<SpaceResult>& Space, const csp::common::Optional<InviteUserRoleInfoCollection>& InviteUsers);
-    // This currently checks if the default scope has leader election enabled, if so will enable server-side leader election in the
-    // OnlineRealtimeEngine and register the scope to keep track of its leader.
-    std::function<async::task<SpaceResult>(const SpaceResult& SpaceResult)> RegisterScopesInSpace(csp::common::IRealtimeEngine* RealtimeEngine);
 
     // EnterSpace Continuations
     auto AddUserToSpaceIfNecessary(SpaceResultCallback Callback, SpaceSystem& SpaceSystem);
     auto FireEnterSpaceEvent(Space& OutCurrentSpace);
 
+    struct DefaultScopeInfo
+    {
+        csp::common::String Id;
+        bool ManagedLeaderElection = false;
+        // Zero if the scope has no leader, or ManagedLeaderElection is disabled.
+        uint64_t LeaderClientId = 0;
+    };
+
+    // Finds the default scope of the space, and its leader if it has ManagedLeaderElection enabled. This only needs the space id, so it runs
+    // alongside adding the user to the space.
+    async::task<DefaultScopeInfo> LookupDefaultScope(const csp::common::String& SpaceId);
+    // If the default scope has ManagedLeaderElection enabled, enables server-side leader election in the OnlineRealtimeEngine and registers the
+    // scope to keep track of its leader. Otherwise, enables client leader election.
+    static void RegisterDefaultScope(csp::common::IRealtimeEngine* RealtimeEngine, const DefaultScopeInfo& DefaultScope);
+
     UserSystem* UserSystem;
 
     csp::services::ApiBase* GroupAPI;
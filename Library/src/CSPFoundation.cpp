@@ -243,6 +243,7 @@ ClientUserAgent* CSPFoundation::ClientUserAgentInfo = nullptr;
 csp::common::String* CSPFoundation::DeviceId = nullptr;
 csp::common::String* CSPFoundation::ClientUserAgentString = nullptr;
 csp::common::String* CSPFoundation::Tenant = nullptr;
+WebRequestSettings CSPFoundation::WebRequests;
 
 // Default Feature Flag values should be defined here. Example shown below:
 csp::common::Array<csp::FeatureFlag> csp::CSPFoundation::FeatureFlags;
@@ -546,6 +547,10 @@ const csp::common::String& CSPFoundation::GetClientUserAgentString() { return *C
 
 const csp::common::String& CSPFoundation::GetTenant() { return *Tenant; }
 
+void CSPFoundation::SetWebRequestSettings(const WebRequestSettings& Settings) { WebRequests = Settings; }
+
+const WebRequestSettings& CSPFoundation::GetWebRequestSettings() { return WebRequests; }
+
 bool CSPFoundation::IsFeatureEnabled(EFeatureFlag Flag)
 {
     auto it = std::find_if(FeatureFlags.begin(), FeatureFlags.end(), [Flag](const FeatureFlag& FeatureFlag) { return FeatureFlag.Type == Flag; });
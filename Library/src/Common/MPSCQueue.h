@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic_queue/atomic_queue.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace csp
+{
+
+/// @brief Multiple producer, single consumer queue, for work that is handed to the thread calling CSPFoundation::Tick.
+/// @details Values are pushed to a bounded lock-free ring, so producers never wait on each other or on the consumer.
+/// If the ring is full, values go to a mutex guarded overflow list instead of blocking, as the consumer may itself be a producer
+/// (e.g. an event listener enqueuing another event). Once anything has overflowed, producers keep using the overflow list until the consumer
+/// has caught up, so values from a single producer are always dequeued in the order they were enqueued.
+/// Enqueue may be called from any thread. TryDequeue and IsEmpty must only be called from the consumer thread.
+template <typename T> class MPSCQueue
+{
+public:
+    /// @param Capacity unsigned : Size of the lock-free ring. This is rounded up to a power of two.
+    explicit MPSCQueue(unsigned Capacity)
+        : Ring(Capacity)
+    {
+    }
+
+    void Enqueue(T Value)
+    {
+        if (!Overflowing.load(std::memory_order_acquire) && Ring.try_push(std::move(Value)))
+        {
+            return;
+        }
+
+        std::scoped_lock OverflowLocker(OverflowMutex);
+        Overflow.push_back(std::move(Value));
+        Overflowing.store(true, std::memory_order_release);
+    }
+
+    /// @brief Takes the next value, if there is one.
+    /// @return bool : False if the queue was empty.
+    bool TryDequeue(T& OutValue)
+    {
+        if (Overflowing.load(std::memory_order_acquire))
+        {
+            // Everything still in the ring was pushed before the overflowed values, so it is moved out first to keep the order.
+            std::scoped_lock OverflowLocker(OverflowMutex);
+
+            T Next;
+
+            while (Ring.try_pop(Next))
+            {
+                Spilled.push_back(std::move(Next));
+            }
+
+            std::move(Overflow.begin(), Overflow.end(), std::back_inserter(Spilled));
+            Overflow.clear();
+            Overflowing.store(false, std::memory_order_release);
+        }
+
+        if (!Spilled.empty())
+        {
+            OutValue = std::move(Spilled.front());
+            Spilled.pop_front();
+
+            return true;
+        }
+
+        return Ring.try_pop(OutValue);
+    }
+
+    /// @brief Whether the queue had no values when checked. Values enqueued concurrently may not be seen.
+    bool IsEmpty() const { return Spilled.empty() && !Overflowing.load(std::memory_order_acquire) && Ring.was_empty(); }
+
+private:
+    atomic_queue::AtomicQueueB2<T> Ring;
+
+    std::atomic<bool> Overflowing { false };
+    std::mutex OverflowMutex;
+    std::vector<T> Overflow;
+
+    // Only touched by the consumer
+    std::deque<T> Spilled;
+};
+
+} // namespace csp
@@ -15,6 +15,9 @@
  */
 #include "Common/Scheduler.h"
 
+#include <algorithm>
+#include <assert.h>
+
 namespace csp
 {
 
@@ -37,4 +40,279 @@ void DestroyScheduler()
     SchedulerPtr = nullptr;
 }
 
+Scheduler::Scheduler(size_t WorkerCount)
+    : WorkerCount(std::max<size_t>(WorkerCount, 1))
+    , IdCounter(1)
+    , ShouldExit(false)
+{
+}
+
+Scheduler::~Scheduler() { Shutdown(); }
+
+void Scheduler::Initialise()
+{
+    assert(!TimerThread.joinable());
+
+    {
+        std::scoped_lock<std::mutex> TasksLocker(TasksLock);
+        ShouldExit = false;
+    }
+
+    TimerThread = std::thread([this]() { TimerLoop(); });
+
+    for (size_t i = 0; i < WorkerCount; ++i)
+    {
+        WorkerThreads.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+void Scheduler::Shutdown()
+{
+    if (!TimerThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock<std::mutex> TasksLocker(TasksLock);
+        ShouldExit = true;
+    }
+
+    TimerCondition.notify_all();
+    WorkerCondition.notify_all();
+
+    TimerThread.join();
+
+    for (std::thread& Worker : WorkerThreads)
+    {
+        Worker.join();
+    }
+
+    WorkerThreads.clear();
+
+    // Put tasks that were due but not started back in the timeline, so they run if the scheduler is restarted.
+    std::scoped_lock<std::mutex> TasksLocker(TasksLock);
+
+    for (const ScheduledTaskId Id : ReadyTasks)
+    {
+        const auto It = Tasks.find(Id);
+
+        if (It != Tasks.end() && !It->second->InTimeline)
+        {
+            AddToTimeline(Id, *It->second);
+        }
+    }
+
+    ReadyTasks.clear();
+}
+
+ScheduledTaskId Scheduler::ScheduleAt(const std::chrono::system_clock::time_point& Time, std::function<void()> Func)
+{
+    return Schedule(Time, std::chrono::system_clock::duration::zero(), std::move(Func));
+}
+
+ScheduledTaskId Scheduler::ScheduleAt(const csp::common::DateTime& Time, std::function<void()> Func)
+{
+    return ScheduleAt(Time.GetTimePoint(), std::move(Func));
+}
+
+ScheduledTaskId Scheduler::ScheduleEvery(std::chrono::system_clock::duration Interval, std::function<void()> Func)
+{
+    assert(Interval > std::chrono::system_clock::duration::zero());
+
+    return Schedule(std::chrono::system_clock::now() + Interval, Interval, std::move(Func));
+}
+
+void Scheduler::CancelTask(ScheduledTaskId Id)
+{
+    std::unique_lock<std::mutex> TasksLocker(TasksLock);
+
+    const auto It = Tasks.find(Id);
+
+    if (It == Tasks.end())
+    {
+        return;
+    }
+
+    const std::shared_ptr<ScheduledTask> Task = It->second;
+
+    if (Task->InTimeline)
+    {
+        PendingTasks.erase(Task->TimelineEntry);
+    }
+
+    // Queued and running tasks check they are still scheduled before starting and before being rescheduled.
+    Tasks.erase(It);
+
+    // A task cancelling itself can't wait for its own run to finish.
+    if (Task->RunningOn != std::thread::id() && Task->RunningOn != std::this_thread::get_id())
+    {
+        RunCondition.wait(TasksLocker, [&Task]() { return Task->RunningOn == std::thread::id(); });
+    }
+}
+
+size_t Scheduler::GetTaskCount() const
+{
+    std::scoped_lock<std::mutex> TasksLocker(TasksLock);
+
+    return Tasks.size();
+}
+
+ScheduledTaskId Scheduler::Schedule(
+    const std::chrono::system_clock::time_point& Time, std::chrono::system_clock::duration Interval, std::function<void()>&& Func)
+{
+    const ScheduledTaskId Id = IdCounter++;
+    bool IsEarliest = false;
+
+    {
+        std::scoped_lock<std::mutex> TasksLocker(TasksLock);
+
+        auto Task = std::make_shared<ScheduledTask>();
+        Task->Func = std::move(Func);
+        Task->Time = Time;
+        Task->Interval = Interval;
+
+        AddToTimeline(Id, *Task);
+        IsEarliest = PendingTasks.begin() == Task->TimelineEntry;
+
+        Tasks.emplace(Id, std::move(Task));
+    }
+
+    // The timer thread only needs waking if it is sleeping until a later deadline.
+    if (IsEarliest)
+    {
+        TimerCondition.notify_one();
+    }
+
+    return Id;
+}
+
+void Scheduler::AddToTimeline(ScheduledTaskId Id, ScheduledTask& Task)
+{
+    // Tasks with the same deadline are inserted after each other, so they start in the order they were scheduled.
+    Task.TimelineEntry = PendingTasks.emplace(Task.Time, Id);
+    Task.InTimeline = true;
+}
+
+void Scheduler::TimerLoop()
+{
+    std::unique_lock<std::mutex> TasksLocker(TasksLock);
+
+    while (!ShouldExit)
+    {
+        if (PendingTasks.empty())
+        {
+            TimerCondition.wait(TasksLocker);
+            continue;
+        }
+
+        const auto Now = std::chrono::system_clock::now();
+        bool QueuedAny = false;
+
+        while (!PendingTasks.empty() && PendingTasks.begin()->first <= Now)
+        {
+            const ScheduledTaskId Id = PendingTasks.begin()->second;
+            Tasks[Id]->InTimeline = false;
+            PendingTasks.erase(PendingTasks.begin());
+
+            ReadyTasks.push_back(Id);
+            QueuedAny = true;
+        }
+
+        if (QueuedAny)
+        {
+            WorkerCondition.notify_all();
+        }
+
+        if (!PendingTasks.empty())
+        {
+            // Woken early by an earlier task being scheduled, or by shutdown, after which the deadlines are checked again.
+            TimerCondition.wait_until(TasksLocker, PendingTasks.begin()->first);
+        }
+    }
+}
+
+void Scheduler::WorkerLoop()
+{
+    std::unique_lock<std::mutex> TasksLocker(TasksLock);
+
+    while (true)
+    {
+        WorkerCondition.wait(TasksLocker, [this]() { return ShouldExit || !ReadyTasks.empty(); });
+
+        if (ShouldExit)
+        {
+            return;
+        }
+
+        const ScheduledTaskId Id = ReadyTasks.front();
+        ReadyTasks.pop_front();
+
+        TasksLocker.unlock();
+        RunTask(Id);
+        TasksLocker.lock();
+    }
+}
+
+void Scheduler::RunTask(ScheduledTaskId Id)
+{
+    std::shared_ptr<ScheduledTask> Task;
+
+    {
+        std::scoped_lock<std::mutex> TasksLocker(TasksLock);
+
+        const auto It = Tasks.find(Id);
+
+        // Cancelled after it was queued.
+        if (It == Tasks.end())
+        {
+            return;
+        }
+
+        Task = It->second;
+        Task->RunningOn = std::this_thread::get_id();
+    }
+
+    // The task is kept alive by our reference if it cancels itself while it runs.
+    Task->Func();
+
+    bool IsEarliest = false;
+
+    {
+        std::scoped_lock<std::mutex> TasksLocker(TasksLock);
+
+        Task->RunningOn = std::thread::id();
+        RunCondition.notify_all();
+
+        const auto It = Tasks.find(Id);
+
+        if (It == Tasks.end())
+        {
+            return;
+        }
+
+        if (Task->Interval == std::chrono::system_clock::duration::zero())
+        {
+            Tasks.erase(It);
+            return;
+        }
+
+        const auto Now = std::chrono::system_clock::now();
+        Task->Time += Task->Interval;
+
+        if (Task->Time + Task->Interval < Now)
+        {
+            Task->Time = Now + Task->Interval;
+        }
+
+        AddToTimeline(Id, *Task);
+        IsEarliest = PendingTasks.begin() == Task->TimelineEntry;
+    }
+
+    if (IsEarliest)
+    {
+        TimerCondition.notify_one();
+    }
+}
+
 } // namespace csp
@@ -17,168 +17,97 @@
 
 #include "Common/DateTime.h"
 
-#include <assert.h>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
-#include <future>
-#include <list>
+#include <map>
 #include <memory>
-#include <queue>
-#include <sstream>
+#include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace csp
 {
 
 using ScheduledTaskId = uint32_t;
 
-struct FunctionTimer
-{
-    std::function<void()> Func;
-    std::chrono::system_clock::time_point Time;
-    ScheduledTaskId Id;
-
-    FunctionTimer() { }
-
-    FunctionTimer(std::function<void()>&& InFunc, const std::chrono::system_clock::time_point& InTime, ScheduledTaskId InId)
-        : Func(InFunc)
-        , Time(InTime)
-        , Id(InId)
-    {
-    }
-
-    bool operator<(const FunctionTimer& Rhs) const { return Time > Rhs.Time; }
-
-    bool operator==(const FunctionTimer& Rhs) const { return Id == Rhs.Id; }
-
-    void Get() { Func(); }
-
-    void operator()() { Func(); }
-
-    uint32_t GetId() const { return Id; }
-};
-
+/// @brief Runs tasks at a given time, or repeatedly at an interval.
+/// @details Pending tasks are ordered by deadline in a timeline, so scheduling and cancelling are O(log n). A timer thread sleeps until the
+/// earliest deadline, or until an earlier task is scheduled, and hands due tasks to a fixed pool of worker threads to run.
+/// Once CancelTask returns, the task will not be started again, and any run of it on another thread has finished. A task may cancel itself,
+/// in which case its current run carries on to the end. Tasks that could be running at the same time must not cancel each other, as each
+/// would wait for the other to finish.
+/// A repeating task is rescheduled when its run finishes, one interval after the deadline it ran for, so it does not drift. If it has fallen
+/// more than an interval behind, it is rescheduled from the current time instead, rather than running back to back to catch up.
 class Scheduler
 {
 public:
-    Scheduler()
-        : Thread(nullptr)
-        , IdCounter(1)
-        , ShouldExit(false)
-    {
-    }
-
-    ~Scheduler() { Shutdown(); }
-
-    void Initialise()
-    {
-        assert(Thread == nullptr);
-        ShouldExit = false;
-        Thread = new std::thread([this]() { ThreadLoop(); });
-    }
-
-    void Shutdown()
-    {
-        if (Thread != nullptr)
-        {
-            ShouldExit = true;
-            Thread->join();
-            delete (Thread);
-            Thread = nullptr;
-        }
-    }
-
-    ScheduledTaskId ScheduleAt(const std::chrono::system_clock::time_point& Time, std::function<void()> Func)
-    {
-        std::function<void()> threadFunc = [Func]()
-        {
-            std::thread Thread(Func);
-            Thread.detach();
-        };
+    static constexpr size_t DEFAULT_WORKER_COUNT = 4;
 
-        return ScheduleAtIntern(Time, std::move(threadFunc));
-    }
+    explicit Scheduler(size_t WorkerCount = DEFAULT_WORKER_COUNT);
+    ~Scheduler();
 
-    void ScheduleEvery(std::chrono::system_clock::duration Interval, std::function<void()> Func)
-    {
-        std::function<void()> threadFunc = [Func]()
-        {
-            std::thread Thread(Func);
-            Thread.detach();
-        };
+    void Initialise();
 
-        this->ScheduleEveryIntern(Interval, threadFunc);
-    }
+    // Stops the timer and worker threads, waiting for any running tasks to finish. Tasks that are still pending stay scheduled, and run once the
+    // scheduler is initialised again.
+    void Shutdown();
 
-    ScheduledTaskId ScheduleAt(const csp::common::DateTime& Time, std::function<void()> Func)
-    {
-        return ScheduleAt(Time.GetTimePoint(), std::move(Func));
-    }
+    ScheduledTaskId ScheduleAt(const std::chrono::system_clock::time_point& Time, std::function<void()> Func);
+    ScheduledTaskId ScheduleAt(const csp::common::DateTime& Time, std::function<void()> Func);
 
-    void CancelTask(ScheduledTaskId Id)
-    {
-        std::scoped_lock<std::mutex> ListLocker(ListLock);
+    ScheduledTaskId ScheduleEvery(std::chrono::system_clock::duration Interval, std::function<void()> Func);
 
-        auto it = std::remove_if(Tasks.begin(), Tasks.end(), [Id](const FunctionTimer& Func) { return Func.Id == Id; });
+    void CancelTask(ScheduledTaskId Id);
 
-        Tasks.erase(it, Tasks.end());
-    }
+    // The number of tasks that are scheduled, including any that are queued or running.
+    size_t GetTaskCount() const;
 
 private:
-    ScheduledTaskId ScheduleAtIntern(const std::chrono::system_clock::time_point& Time, std::function<void()>&& Func)
-    {
-        ScheduledTaskId Id = IdCounter++;
+    using Timeline = std::multimap<std::chrono::system_clock::time_point, ScheduledTaskId>;
 
-        {
-            std::scoped_lock<std::mutex> ListLocker(ListLock);
-            Tasks.push_back(FunctionTimer(std::move(Func), Time, Id));
-            Tasks.sort();
-        }
-
-        return Id;
-    }
-
-    void ScheduleEveryIntern(std::chrono::system_clock::duration Interval, std::function<void()> Func)
+    struct ScheduledTask
     {
-        std::function<void()> waitFunc = [this, Interval, Func]()
-        {
-            Func();
-            this->ScheduleEveryIntern(Interval, Func);
-        };
-
-        ScheduleAtIntern(std::chrono::system_clock::now() + Interval, std::move(waitFunc));
-    }
-
-    void ThreadLoop()
-    {
-        while (!ShouldExit)
-        {
-            {
-                std::scoped_lock<std::mutex> ListLocker(ListLock);
-
-                auto now = std::chrono::system_clock::now();
-
-                if (Tasks.size() > 0 && Tasks.front().Time <= now)
-                {
-                    FunctionTimer Func;
-
-                    {
-                        Func = Tasks.front();
-                        Tasks.pop_front();
-                    }
-
-                    Func.Get();
-                }
-            }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
-    }
-
-private:
-    std::mutex ListLock;
-    std::list<FunctionTimer> Tasks;
-    std::thread* Thread;
+        std::function<void()> Func;
+        std::chrono::system_clock::time_point Time;
+        // Zero for tasks that only run once.
+        std::chrono::system_clock::duration Interval;
+        // Only valid while the task is waiting for its deadline, rather than queued or running.
+        Timeline::iterator TimelineEntry;
+        bool InTimeline = false;
+        // The worker running the task, set under TasksLock before the run starts, so CancelTask can wait for it. Default while not running.
+        std::thread::id RunningOn;
+    };
+
+    ScheduledTaskId Schedule(
+        const std::chrono::system_clock::time_point& Time, std::chrono::system_clock::duration Interval, std::function<void()>&& Func);
+
+    // Must be called with TasksLock held.
+    void AddToTimeline(ScheduledTaskId Id, ScheduledTask& Task);
+
+    void TimerLoop();
+    void WorkerLoop();
+    void RunTask(ScheduledTaskId Id);
+
+    size_t WorkerCount;
+
+    mutable std::mutex TasksLock;
+    std::condition_variable TimerCondition;
+    std::condition_variable WorkerCondition;
+    // Notified whenever a run finishes, for CancelTask to wait on.
+    std::condition_variable RunCondition;
+
+    std::unordered_map<ScheduledTaskId, std::shared_ptr<ScheduledTask>> Tasks;
+    Timeline PendingTasks;
+    // Due tasks waiting for a worker. Cancelled tasks are left in here, and skipped when they are reached.
+    std::deque<ScheduledTaskId> ReadyTasks;
+
+    std::thread TimerThread;
+    std::vector<std::thread> WorkerThreads;
     std::atomic_uint32_t IdCounter;
     bool ShouldExit;
 
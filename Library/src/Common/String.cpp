@@ -17,7 +17,10 @@
 #include "CSP/Common/String.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstring>
+#include <new>
 
 namespace csp::common
 {
@@ -26,256 +29,273 @@ namespace csp::common
                 Custom string class that we can use safely across a DLL boundary
  */
 
-/// @brief Internal implementation for DLL safe string class
-class String::Impl
+namespace
 {
-public:
-    ~Impl() { delete[] Text; }
 
-    explicit Impl(char const* const InText)
-        : Text(nullptr)
-        , Length(0)
-    {
-        const char* _InText = InText;
-
-        if (InText == nullptr)
-        {
-            _InText = "";
-        }
+// Strings up to this long are copied rather than shared. Copying them costs little more than sharing would, and keeps copies that end up on
+// other threads from contending on the same reference count.
+constexpr size_t MaxUnsharedLength = 31;
 
-        const size_t Len = strlen(_InText);
+// Buffers are allocated with this header immediately before their characters, so a string only needs to hold a pointer to the text.
+struct TextHeader
+{
+    std::atomic<uint32_t> RefCount;
+    // Cleared once a writable pointer to the buffer has been handed out, after which copies can no longer share it.
+    bool Shareable;
+    size_t Length;
+    size_t Capacity;
+};
 
-        char* NewText = new char[Len + 1];
+char* AllocateText(size_t Capacity)
+{
+    void* Memory = ::operator new(sizeof(TextHeader) + Capacity + 1);
+    TextHeader* Header = new (Memory) TextHeader { { 1 }, true, 0, Capacity };
 
-        if (Len > 0)
-        {
-            memcpy((void*)NewText, _InText, Len * sizeof(char));
-        }
+    return reinterpret_cast<char*>(Header + 1);
+}
 
-        NewText[Len] = 0;
+TextHeader* GetHeader(char* Text) { return reinterpret_cast<TextHeader*>(Text) - 1; }
 
-        Text = NewText;
-        Length = Len;
-    }
+const TextHeader* GetHeader(const char* Text) { return reinterpret_cast<const TextHeader*>(Text) - 1; }
 
-    Impl(char const* const InText, size_t Len)
-        : Text(nullptr)
-        , Length(0)
-    {
-        const char* _InText = InText;
+void RetainText(char* Text) { GetHeader(Text)->RefCount.fetch_add(1, std::memory_order_relaxed); }
 
-        if (InText == nullptr || Len == 0)
-        {
-            _InText = "";
-            Len = 0;
-        }
+void ReleaseText(char* Text)
+{
+    TextHeader* Header = GetHeader(Text);
 
-        char* NewText = new char[Len + 1];
+    if (Header->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        Header->~TextHeader();
+        ::operator delete(Header);
+    }
+}
 
-        if (Len > 0)
-        {
-            memcpy((void*)NewText, _InText, Len * sizeof(char));
-        }
+bool IsTextShared(const char* Text) { return GetHeader(Text)->RefCount.load(std::memory_order_acquire) > 1; }
 
-        NewText[Len] = 0;
+List<String> SplitText(const char* Text, char Separator)
+{
+    List<String> Parts;
 
-        Text = NewText;
-        Length = Len;
-    }
+    // NOTE: Don't use strtok here because it ignores empty entries!
+    auto Index = strchr(Text, Separator);
 
-    explicit Impl(size_t Len)
-        : Text(nullptr)
-        , Length(0)
+    if (Index == nullptr)
     {
-        char* NewText = new char[Len + 1];
+        Parts.Append(Text);
 
-        NewText[Len] = 0;
-        Text = NewText;
-        Length = Len;
+        return Parts;
     }
 
-    Impl* Clone() const { return new Impl(Text, Length); }
+    auto Start = Text;
 
-    inline void Append(const char* Other, size_t OtherLength)
+    for (;;)
     {
-        if (Other == nullptr || OtherLength == 0)
+        Parts.Append(String(Start, Index - Start));
+        Start = Index + 1;
+        Index = strchr(Start, Separator);
+
+        // Also look for null-terminator
+        if (Index == nullptr)
         {
-            return;
+            Index = strchr(Start, '\0');
+            Parts.Append(String(Start, Index - Start));
+            break;
         }
-
-        auto NewLength = Length + OtherLength;
-        auto NewText = new char[NewLength + 1];
-        memcpy(NewText, Text, Length);
-        memcpy(NewText + Length, Other, OtherLength);
-        NewText[NewLength] = '\0';
-
-        delete[] Text;
-        Text = NewText;
-        Length = NewLength;
     }
 
-    void Append(const Impl& Other) { Append(Other.Text, Other.Length); }
+    return Parts;
+}
 
-    void Append(const char* Other)
-    {
-        if (Other == nullptr)
-        {
-            return;
-        }
+template <typename PartsT> size_t GetJoinedLength(const PartsT& Parts, size_t PartCount, Optional<char> Separator)
+{
+    size_t Length = 0;
 
-        auto OtherLength = strlen(Other);
-        Append(Other, OtherLength);
+    for (const String& Part : Parts)
+    {
+        Length += Part.Length();
     }
 
-    List<String> Split(char Separator)
+    // Room is left for a separator after every part, the one after the last part goes where the terminator will be written.
+    // Empty parts don't get a separator, so fewer characters than this may be written.
+    if (Length > 0 && Separator.HasValue())
     {
-        List<String> Parts;
+        Length += PartCount - 1;
+    }
 
-        // NOTE: Don't use strtok here because it ignores empty entries!
-        auto Index = strchr(Text, Separator);
+    return Length;
+}
 
-        if (Index == nullptr)
-        {
-            Parts.Append(Text);
+template <typename PartsT> size_t WriteJoinedParts(char* Buffer, const PartsT& Parts, Optional<char> Separator)
+{
+    size_t Pos = 0;
+
+    for (const String& Part : Parts)
+    {
+        auto PartLength = Part.Length();
 
-            return Parts;
+        if (PartLength == 0)
+        {
+            continue;
         }
 
-        auto Start = Text;
+        memcpy(Buffer + Pos, Part.c_str(), PartLength);
+        Pos += PartLength;
 
-        for (;;)
+        if (Separator.HasValue())
         {
-            Parts.Append(String(Start, Index - Start));
-            Start = Index + 1;
-            Index = strchr(Start, Separator);
-
-            // Also look for null-terminator
-            if (Index == nullptr)
-            {
-                Index = strchr(Start, '\0');
-                Parts.Append(String(Start, Index - Start));
-                break;
-            }
+            Buffer[Pos++] = *Separator;
         }
-
-        return Parts;
     }
 
-    char* Text;
-    size_t Length;
-};
+    return Pos;
+}
+
+} // namespace
 
 String::String()
-    : ImplPtr(new Impl(""))
+    : Text(nullptr)
 {
 }
 
-String::String(char const* const Text, size_t Length)
-    : ImplPtr(new Impl(Text, Length))
+String::String(char const* const InText, size_t Length)
+    : Text(nullptr)
 {
+    if (InText != nullptr && Length > 0)
+    {
+        memcpy(InitialiseStorage(Length), InText, Length);
+    }
 }
 
 String::String(size_t Length)
-    : ImplPtr(new Impl(Length))
+    : Text(nullptr)
 {
+    InitialiseStorage(Length);
 }
 
-String::String(const char* Text)
-    : ImplPtr(new Impl(Text))
+String::String(const char* InText)
+    : Text(nullptr)
 {
+    const size_t Length = InText != nullptr ? strlen(InText) : 0;
+
+    if (Length > 0)
+    {
+        memcpy(InitialiseStorage(Length), InText, Length);
+    }
 }
 
 String::String(String const& Other)
-    : ImplPtr(Other.ImplPtr->Clone())
+    : Text(nullptr)
 {
+    if (Other.Text == nullptr)
+    {
+        return;
+    }
+
+    // A buffer that may be written through a pointer from Data() is never shared, so those writes can't show up in this copy.
+    if (GetHeader(Other.Text)->Shareable && Other.Length() > MaxUnsharedLength)
+    {
+        Text = Other.Text;
+        RetainText(Text);
+    }
+    else
+    {
+        const size_t Length = Other.Length();
+        memcpy(InitialiseStorage(Length), Other.Text, Length);
+    }
 }
 
 String::String(String&& Other)
+    : Text(Other.Text)
 {
-    ImplPtr = Other.ImplPtr;
-    Other.ImplPtr = nullptr;
+    Other.Text = nullptr;
 }
 
-List<String> String::Split(char Separator) const { return ImplPtr->Split(Separator); }
+List<String> String::Split(char Separator) const { return SplitText(Get(), Separator); }
 
 String& String::swap(String& Other)
 {
-    std::swap(ImplPtr, Other.ImplPtr);
+    std::swap(Text, Other.Text);
     return *this;
 }
 
 String& String::operator=(const String& Rhs)
 {
-    if (ImplPtr != nullptr)
+    if (this != &Rhs)
     {
-        delete (ImplPtr);
+        String Copy(Rhs);
+        swap(Copy);
     }
 
-    ImplPtr = Rhs.ImplPtr->Clone();
     return *this;
 }
 
 String& String::operator=(String&& Rhs)
 {
-    if (ImplPtr != nullptr)
+    if (this != &Rhs)
     {
-        delete (ImplPtr);
+        ReleaseStorage();
+
+        Text = Rhs.Text;
+        Rhs.Text = nullptr;
     }
 
-    ImplPtr = Rhs.ImplPtr;
-    Rhs.ImplPtr = nullptr;
     return *this;
 }
 
-String& String::operator=(char const* const Text)
+String& String::operator=(char const* const InText)
 {
-    if (ImplPtr != nullptr)
-    {
-        delete (ImplPtr);
-    }
-
-    ImplPtr = new Impl(Text);
+    // Copied before releasing our storage, as InText may point into it.
+    String Copy(InText);
+    swap(Copy);
     return *this;
 }
 
-const char* String::Get() const { return ImplPtr->Text; }
+const char* String::Get() const { return Text != nullptr ? Text : ""; }
+
+char* String::Data()
+{
+    // Even an empty string needs a buffer of its own, as the terminator may be written through the returned pointer.
+    Reserve(Length());
+    GetHeader(Text)->Shareable = false;
+
+    return Text;
+}
 
-size_t String::Length() const { return ImplPtr->Length; }
+size_t String::Length() const { return Text != nullptr ? GetHeader(Text)->Length : 0; }
 
-size_t String::AllocatedMemorySize() const { return ImplPtr->Length + 1; }
+size_t String::AllocatedMemorySize() const { return Length() + 1; }
 
-bool String::IsEmpty() const { return ImplPtr->Length == 0; }
+bool String::IsEmpty() const { return Length() == 0; }
 
 bool String::operator==(const String& Other) const
 {
-    if (ImplPtr->Length == 0 && Other.Length() == 0)
+    const size_t TextLength = Length();
+
+    if (TextLength != Other.Length())
     {
-        return true;
+        return false;
     }
 
-    if (ImplPtr->Length == 0 || Other.Length() == 0)
+    // Copies share their buffer.
+    if (Text == Other.Text)
     {
-        return false;
+        return true;
     }
 
-    return strcmp(Get(), Other.Get()) == 0;
+    return memcmp(Get(), Other.Get(), TextLength) == 0;
 }
 
 bool String::operator==(const char* Other) const
 {
     auto OtherLength = strlen(Other);
 
-    if (ImplPtr->Length == 0 && OtherLength == 0)
-    {
-        return true;
-    }
-
-    if (ImplPtr->Length == 0 || OtherLength == 0)
+    if (Length() != OtherLength)
     {
         return false;
     }
 
-    return strcmp(Get(), Other) == 0;
+    return memcmp(Get(), Other, OtherLength) == 0;
 }
 
 bool String::operator!=(const String& Other) const { return !(*this == Other); }
@@ -284,17 +304,94 @@ bool String::operator!=(const char* Other) const { return !(*this == Other); }
 
 bool String::operator<(const String& Other) const { return strcmp(Get(), Other.Get()) < 0; }
 
-String::~String()
+String::~String() { ReleaseStorage(); }
+
+char* String::InitialiseStorage(size_t Length)
+{
+    if (Length == 0)
+    {
+        Text = nullptr;
+        return nullptr;
+    }
+
+    Text = AllocateText(Length);
+    SetLength(Length);
+
+    return Text;
+}
+
+void String::ReleaseStorage()
+{
+    if (Text != nullptr)
+    {
+        ReleaseText(Text);
+        Text = nullptr;
+    }
+}
+
+void String::SetLength(size_t Length)
+{
+    GetHeader(Text)->Length = Length;
+    Text[Length] = '\0';
+}
+
+void String::Reserve(size_t NewLength)
 {
-    if (ImplPtr != nullptr)
+    const size_t Capacity = Text != nullptr ? GetHeader(Text)->Capacity : 0;
+    const bool IsUnique = Text != nullptr && !IsTextShared(Text);
+
+    if (NewLength <= Capacity && IsUnique)
     {
-        delete (ImplPtr);
+        return;
     }
+
+    // Grow geometrically, so that strings built up from many appends only reallocate a logarithmic number of times.
+    const size_t NewCapacity = NewLength <= Capacity ? Capacity : std::max(NewLength, Capacity * 2);
+    const size_t TextLength = Length();
+    char* NewText = AllocateText(NewCapacity);
+    memcpy(NewText, Get(), TextLength);
+
+    ReleaseStorage();
+
+    Text = NewText;
+    SetLength(TextLength);
 }
 
-void String::Append(const String& Other) { ImplPtr->Append(*Other.ImplPtr); }
+void String::Append(const char* Other, size_t OtherLength)
+{
+    if (Other == nullptr || OtherLength == 0)
+    {
+        return;
+    }
+
+    // Other may point into our own buffer, which reserving can free, so it is copied first.
+    const char* OldText = Get();
+    const size_t TextLength = Length();
+
+    if (Other >= OldText && Other <= OldText + TextLength)
+    {
+        const String OtherCopy(Other, OtherLength);
+        Append(OtherCopy.Get(), OtherLength);
+        return;
+    }
+
+    Reserve(TextLength + OtherLength);
+
+    memcpy(Text + TextLength, Other, OtherLength);
+    SetLength(TextLength + OtherLength);
+}
 
-void String::Append(const char* Other) { ImplPtr->Append(Other); }
+void String::Append(const String& Other) { Append(Other.Get(), Other.Length()); }
+
+void String::Append(const char* Other)
+{
+    if (Other == nullptr)
+    {
+        return;
+    }
+
+    Append(Other, strlen(Other));
+}
 
 String& String::operator+=(const String& Other)
 {
@@ -314,8 +411,8 @@ String String::Trim() const
 {
     static char Whitespace[] = { ' ', '\r', '\n', '\t' };
 
-    auto Length = ImplPtr->Length;
-    auto Text = ImplPtr->Text;
+    auto Length = this->Length();
+    auto Text = Get();
 
     // Trim leading whitespace
     while (Length > 0)
@@ -345,70 +442,29 @@ String String::Trim() const
 
 String String::ToLower() const
 {
-    String Copy = *this;
-    auto Length = Copy.ImplPtr->Length;
-    auto Text = Copy.ImplPtr->Text;
+    const size_t TextLength = Length();
 
-    for (size_t i = 0; i < Length; ++i)
+    // Written straight into the result's buffer, rather than through Data(), so that copies of the result can still share it.
+    String Lower(TextLength);
+
+    for (size_t i = 0; i < TextLength; ++i)
     {
-        Text[i] = static_cast<char>(std::tolower(Text[i]));
+        Lower.Text[i] = static_cast<char>(std::tolower(Text[i]));
     }
 
-    return Copy;
+    return Lower;
 }
 
 String String::Join(const List<String>& Parts, Optional<char> Separator)
 {
-    if (Parts.Size() == 0)
-    {
-        return String();
-    }
-
-    size_t Length = 0;
-
-    for (size_t i = 0; i < Parts.Size(); ++i)
-    {
-        Length += Parts[i].Length();
-    }
-
-    if (Length == 0)
-    {
-        return String();
-    }
-
-    if (Separator.HasValue())
-    {
-        Length += Parts.Size() - 1;
-    }
-
-    auto Buffer = new char[Length + 1]();
-    size_t Pos = 0;
+    String Joined(GetJoinedLength(Parts, Parts.Size(), Separator));
 
-    for (size_t i = 0; i < Parts.Size(); ++i)
+    if (!Joined.IsEmpty())
     {
-        auto PartLength = Parts[i].Length();
-
-        if (PartLength == 0)
-        {
-            continue;
-        }
-
-        memcpy(Buffer + Pos, Parts[i].c_str(), PartLength);
-        Pos += PartLength;
-
-        if (Separator.HasValue())
-        {
-            Buffer[Pos++] = *Separator;
-        }
+        Joined.SetLength(std::min(WriteJoinedParts(Joined.Text, Parts, Separator), Joined.Length()));
     }
 
-    Buffer[Length] = '\0';
-
-    String JoinedString(Buffer);
-
-    delete[] Buffer;
-
-    return JoinedString;
+    return Joined;
 }
 
 bool String::Contains(const String& Substring) const
@@ -423,7 +479,7 @@ bool String::Contains(const String& Substring) const
 
 bool String::StartsWith(const String& Prefix) const
 {
-    if (Prefix.Length() == 0 || Prefix.Length() > ImplPtr->Length)
+    if (Prefix.Length() == 0 || Prefix.Length() > Length())
     {
         return false;
     }
@@ -433,80 +489,40 @@ bool String::StartsWith(const String& Prefix) const
 
 bool String::EndsWith(const String& Postfix) const
 {
-    if (Postfix.Length() == 0 || Postfix.Length() > ImplPtr->Length)
+    if (Postfix.Length() == 0 || Postfix.Length() > Length())
     {
         return false;
     }
 
-    return std::memcmp(Get() + (ImplPtr->Length - Postfix.Length()), Postfix.Get(), Postfix.Length()) == 0;
+    return std::memcmp(Get() + (Length() - Postfix.Length()), Postfix.Get(), Postfix.Length()) == 0;
 }
 
 String String::SubString(size_t Offset, Optional<size_t> Length)
 {
-    if (Offset >= ImplPtr->Length)
+    const size_t TextLength = this->Length();
+
+    if (Offset >= TextLength)
     {
         return "";
     }
 
-    size_t MaxSubStringLength = ImplPtr->Length - Offset;
+    size_t MaxSubStringLength = TextLength - Offset;
 
     size_t SubstringLength = Length.HasValue() ? std::min(*Length, MaxSubStringLength) : MaxSubStringLength;
 
-    return String(ImplPtr->Text + Offset, SubstringLength);
+    return String(Get() + Offset, SubstringLength);
 }
 
 String String::Join(const std::initializer_list<String>& Parts, Optional<char> Separator)
 {
-    if (Parts.size() == 0)
-    {
-        return String();
-    }
+    String Joined(GetJoinedLength(Parts, Parts.size(), Separator));
 
-    size_t Length = 0;
-
-    for (size_t i = 0; i < Parts.size(); ++i)
-    {
-        Length += (Parts.begin() + i)->Length();
-    }
-
-    if (Length == 0)
+    if (!Joined.IsEmpty())
     {
-        return String();
+        Joined.SetLength(std::min(WriteJoinedParts(Joined.Text, Parts, Separator), Joined.Length()));
     }
 
-    if (Separator.HasValue())
-    {
-        Length += Parts.size() - 1;
-    }
-
-    auto Buffer = new char[Length + 1]();
-    size_t Pos = 0;
-
-    for (size_t i = 0; i < Parts.size(); ++i)
-    {
-        auto PartLength = (Parts.begin() + i)->Length();
-
-        if (PartLength == 0)
-        {
-            continue;
-        }
-
-        memcpy(Buffer + Pos, (Parts.begin() + i)->c_str(), PartLength);
-        Pos += PartLength;
-
-        if (Separator.HasValue())
-        {
-            Buffer[Pos++] = *Separator;
-        }
-    }
-
-    Buffer[Length] = '\0';
-
-    String JoinedString(Buffer);
-
-    delete[] Buffer;
-
-    return JoinedString;
+    return Joined;
 }
 
 } // namespace csp::common
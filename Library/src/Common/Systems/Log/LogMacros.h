@@ -0,0 +1,38 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "CSP/Common/Systems/Log/LogSystem.h"
+
+#include <fmt/format.h>
+
+/// @brief Formats and logs a message, but only if the log system is set and logging at the given level.
+/// The level is checked before the format arguments are evaluated, so a message that is filtered out costs no formatting or allocation.
+/// This should be preferred over calling LogMsg with fmt::format directly, particularly on hot paths.
+/// @param LOG_SYSTEM csp::common::LogSystem* : The log system to log to. May be null, in which case nothing is logged.
+/// @param LEVEL csp::common::LogLevel : The level to log the message at.
+/// @param ... : The fmt format string followed by its arguments.
+#define CSP_LOG_LAZY(LOG_SYSTEM, LEVEL, ...)                                                                                                         \
+    do                                                                                                                                               \
+    {                                                                                                                                                \
+        csp::common::LogSystem* const CSPLazyLogSystem = (LOG_SYSTEM);                                                                               \
+        const csp::common::LogLevel CSPLazyLogLevel = (LEVEL);                                                                                       \
+                                                                                                                                                     \
+        if (CSPLazyLogSystem != nullptr && CSPLazyLogSystem->LoggingEnabled(CSPLazyLogLevel))                                                        \
+        {                                                                                                                                            \
+            CSPLazyLogSystem->LogMsg(CSPLazyLogLevel, fmt::format(__VA_ARGS__).c_str());                                                             \
+        }                                                                                                                                            \
+    } while (false)
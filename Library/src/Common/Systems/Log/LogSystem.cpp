@@ -17,6 +17,15 @@
 
 #include "Common/Logger.h"
 
+#include <atomic_queue/atomic_queue.h>
+#include <fmt/format.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #if defined(CSP_ANDROID)
 #include <android/log.h>
 #endif
@@ -40,13 +49,142 @@ struct LogCallbacks
     LogSystem::EndMarkerCallbackHandler EndMarkerCallback;
 };
 
+// Ring buffer of messages logged while asynchronous logging is enabled, which are dispatched in order on a worker thread.
+// Pushing never waits for the worker: if the buffer is full the message is dropped, and the worker reports how many were lost.
+// The worker sleeps until a message is pushed or the sink is destroyed.
+struct AsyncLogSink
+{
+    using DispatchFunction = std::function<void(LogLevel, const csp::common::String&)>;
+
+    struct Entry
+    {
+        LogLevel Level = LogLevel::Log;
+        std::string Message;
+    };
+
+    static constexpr unsigned Capacity = 4096;
+
+    explicit AsyncLogSink(DispatchFunction InDispatch)
+        : Queue(Capacity)
+        , Dispatch(std::move(InDispatch))
+        , Worker([this]() { Run(); })
+    {
+    }
+
+    ~AsyncLogSink()
+    {
+        {
+            std::scoped_lock WakeLocker(WakeMutex);
+            Running = false;
+        }
+
+        Wake.notify_one();
+        Worker.join();
+    }
+
+    void Push(LogLevel Level, const char* Message)
+    {
+        if (Queue.try_push(Entry { Level, Message }))
+        {
+            Pushed.fetch_add(1);
+
+            // The mutex is only taken when the worker may be going to sleep, so it can't check the queue, miss this message and then wait
+            // for good. Pairs with the fence in Run: either we see WorkerWaiting set, or the worker sees the message.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (WorkerWaiting.load(std::memory_order_relaxed))
+            {
+                {
+                    std::scoped_lock WakeLocker(WakeMutex);
+                }
+
+                Wake.notify_one();
+            }
+        }
+        else
+        {
+            Dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void Flush()
+    {
+        // A log callback that flushes is running on the worker, which would otherwise wait on itself.
+        if (std::this_thread::get_id() == Worker.get_id())
+        {
+            return;
+        }
+
+        const uint64_t Target = Pushed.load();
+
+        std::unique_lock WakeLocker(WakeMutex);
+        Flushed.wait(WakeLocker, [this, Target]() { return Dispatched.load() >= Target; });
+    }
+
+private:
+    void Run()
+    {
+        Entry Next;
+
+        while (true)
+        {
+            while (Queue.try_pop(Next))
+            {
+                Dispatch(Next.Level, Next.Message.c_str());
+                Dispatched.fetch_add(1);
+            }
+
+            if (const uint64_t DroppedCount = Dropped.exchange(0, std::memory_order_relaxed); DroppedCount > 0)
+            {
+                Dispatch(LogLevel::Warning, fmt::format("Asynchronous logging dropped {} messages, as the log queue was full.", DroppedCount).c_str());
+            }
+
+            std::unique_lock WakeLocker(WakeMutex);
+            Flushed.notify_all();
+
+            if (!Running && Queue.was_empty())
+            {
+                return;
+            }
+
+            WorkerWaiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            Wake.wait(WakeLocker, [this]() { return !Running || !Queue.was_empty(); });
+
+            WorkerWaiting.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    atomic_queue::AtomicQueueB2<Entry> Queue;
+    DispatchFunction Dispatch;
+
+    std::atomic<uint64_t> Pushed { 0 };
+    std::atomic<uint64_t> Dispatched { 0 };
+    std::atomic<uint64_t> Dropped { 0 };
+    std::atomic<bool> WorkerWaiting { false };
+
+    std::mutex WakeMutex;
+    std::condition_variable Wake;
+    std::condition_variable Flushed;
+    bool Running = true;
+
+    // Declared last, so everything the worker uses is constructed before it starts.
+    std::thread Worker;
+};
+
 LogSystem::LogSystem()
 {
     // Allocate internally to avoid warning C425 'needs to have dll-interface to be used by clients'
     Callbacks = new LogCallbacks();
 }
 
-LogSystem::~LogSystem() { delete Callbacks; }
+LogSystem::~LogSystem()
+{
+    // Drains any queued messages before the callbacks go away.
+    delete AsyncSink.load();
+    delete Callbacks;
+}
 
 void LogSystem::SetLogCallback(LogCallbackHandler InLogCallback) { Callbacks->LogCallback = std::move(InLogCallback); }
 
@@ -56,11 +194,44 @@ void LogSystem::SetBeginMarkerCallback(BeginMarkerCallbackHandler InBeginCallbac
 
 void LogSystem::SetEndMarkerCallback(EndMarkerCallbackHandler InEndCallback) { Callbacks->EndMarkerCallback = std::move(InEndCallback); }
 
-void LogSystem::SetSystemLevel(const csp::common::LogLevel InSystemLevel) { SystemLevel = InSystemLevel; }
+void LogSystem::SetSystemLevel(const csp::common::LogLevel InSystemLevel) { SystemLevel.store(InSystemLevel, std::memory_order_relaxed); }
+
+csp::common::LogLevel LogSystem::GetSystemLevel() { return SystemLevel.load(std::memory_order_relaxed); }
+
+bool LogSystem::LoggingEnabled(const csp::common::LogLevel Level) { return Level <= SystemLevel.load(std::memory_order_relaxed); }
+
+void LogSystem::SetAsyncLoggingEnabled(bool Enabled)
+{
+#if defined(CSP_WASM)
+    (void)Enabled;
+#else
+    if (Enabled)
+    {
+        // Several threads may enable asynchronous logging at once, and only one sink must be created.
+        std::call_once(AsyncSinkCreated,
+            [this]()
+            {
+                AsyncSink = new AsyncLogSink([this](LogLevel Level, const csp::common::String& InMessage) { DispatchMsg(Level, InMessage); });
+            });
+    }
+
+    AsyncLoggingEnabled.store(Enabled, std::memory_order_release);
 
-csp::common::LogLevel LogSystem::GetSystemLevel() { return SystemLevel; }
+    if (!Enabled)
+    {
+        // Anything queued before disabling should still be handled before anything logged afterwards.
+        FlushLogs();
+    }
+#endif
+}
 
-bool LogSystem::LoggingEnabled(const csp::common::LogLevel Level) { return Level <= SystemLevel; }
+void LogSystem::FlushLogs()
+{
+    if (AsyncLogSink* Sink = AsyncSink.load(); Sink != nullptr)
+    {
+        Sink->Flush();
+    }
+}
 
 void LogSystem::LogMsg(const csp::common::LogLevel Level, const csp::common::String& InMessage)
 {
@@ -69,6 +240,17 @@ void LogSystem::LogMsg(const csp::common::LogLevel Level, const csp::common::Str
         return;
     }
 
+    if (AsyncLoggingEnabled.load(std::memory_order_acquire))
+    {
+        AsyncSink.load(std::memory_order_relaxed)->Push(Level, InMessage.c_str());
+        return;
+    }
+
+    DispatchMsg(Level, InMessage);
+}
+
+void LogSystem::DispatchMsg(const csp::common::LogLevel Level, const csp::common::String& InMessage)
+{
     // Log to our Connected Spaces Platform file system.
     LogToFile(Level, InMessage);
 
@@ -77,7 +77,7 @@ void HttpPayload::WriteContent(size_t Offset, const char* Data, size_t DataLengt
         return;
     }
 
-    char* ContentPtr = (char*)Content.c_str() + Offset;
+    char* ContentPtr = Content.Data() + Offset;
 
     const size_t AvailableLength = Length - Offset;
     const size_t LengthToCopy = std::min(DataLength, AvailableLength);
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "POCOSessionPool.h"
+
+#include "Debug/Logging.h"
+
+#include <Poco/Net/HTTPSessionFactory.h>
+#include <Poco/Net/Socket.h>
+#include <Poco/Timespan.h>
+
+namespace csp::web
+{
+
+POCOSessionPool::Lease::Lease(std::shared_ptr<POCOSessionPool> Pool, std::string HostKey, std::unique_ptr<Poco::Net::HTTPClientSession> Session)
+    : Pool(std::move(Pool))
+    , HostKey(std::move(HostKey))
+    , Session(std::move(Session))
+    , Reusable(false)
+{
+}
+
+POCOSessionPool::Lease::~Lease()
+{
+    if (Pool && Session)
+    {
+        Pool->Release(HostKey, std::move(Session), Reusable);
+    }
+}
+
+POCOSessionPool::POCOSessionPool(size_t MaxIdleSessionsPerHost, std::chrono::milliseconds IdleTimeout)
+    : MaxIdleSessionsPerHost(MaxIdleSessionsPerHost)
+    , IdleTimeout(IdleTimeout)
+    , Hits(0)
+    , Misses(0)
+    , Evictions(0)
+    , Discards(0)
+{
+}
+
+POCOSessionPool::Lease POCOSessionPool::Acquire(const Poco::URI& Uri)
+{
+    CSP_PROFILE_SCOPED();
+
+    std::string HostKey = MakeHostKey(Uri);
+    const auto Now = std::chrono::steady_clock::now();
+
+    // Sessions we evict are destroyed outside of the lock, as closing a TLS session can block on the socket
+    std::vector<std::unique_ptr<Poco::Net::HTTPClientSession>> EvictedSessions;
+    std::unique_ptr<Poco::Net::HTTPClientSession> Session;
+
+    {
+        std::scoped_lock Lock(PoolMutex);
+
+        auto HostIt = IdleSessions.find(HostKey);
+
+        if (HostIt != IdleSessions.end())
+        {
+            auto& HostSessions = HostIt->second;
+
+            while (!HostSessions.empty())
+            {
+                IdleSession Candidate = std::move(HostSessions.back());
+                HostSessions.pop_back();
+
+                if (Now - Candidate.IdleSince < IdleTimeout && IsHealthy(*Candidate.Session))
+                {
+                    Session = std::move(Candidate.Session);
+                    break;
+                }
+
+                EvictedSessions.push_back(std::move(Candidate.Session));
+            }
+        }
+    }
+
+    Evictions += EvictedSessions.size();
+
+    if (Session)
+    {
+        ++Hits;
+    }
+    else
+    {
+        ++Misses;
+
+        Session.reset(Poco::Net::HTTPSessionFactory::defaultFactory().createClientSession(Uri));
+        Session->setKeepAlive(true);
+        Session->setKeepAliveTimeout(Poco::Timespan(std::chrono::duration_cast<std::chrono::microseconds>(IdleTimeout).count()));
+    }
+
+    return Lease(shared_from_this(), std::move(HostKey), std::move(Session));
+}
+
+void POCOSessionPool::Release(const std::string& HostKey, std::unique_ptr<Poco::Net::HTTPClientSession> Session, bool Reusable)
+{
+    if (Reusable && Session->connected())
+    {
+        std::scoped_lock Lock(PoolMutex);
+
+        auto& HostSessions = IdleSessions[HostKey];
+
+        if (HostSessions.size() < MaxIdleSessionsPerHost)
+        {
+            HostSessions.push_back({ std::move(Session), std::chrono::steady_clock::now() });
+
+            return;
+        }
+    }
+
+    ++Discards;
+}
+
+void POCOSessionPool::Clear()
+{
+    std::unordered_map<std::string, std::vector<IdleSession>> ClearedSessions;
+
+    {
+        std::scoped_lock Lock(PoolMutex);
+        std::swap(ClearedSessions, IdleSessions);
+    }
+}
+
+POCOSessionPool::Metrics POCOSessionPool::GetMetrics() const
+{
+    Metrics Result;
+    Result.Hits = Hits;
+    Result.Misses = Misses;
+    Result.Evictions = Evictions;
+    Result.Discards = Discards;
+
+    return Result;
+}
+
+size_t POCOSessionPool::GetIdleSessionCount() const
+{
+    std::scoped_lock Lock(PoolMutex);
+
+    size_t Count = 0;
+
+    for (const auto& HostSessions : IdleSessions)
+    {
+        Count += HostSessions.second.size();
+    }
+
+    return Count;
+}
+
+std::string POCOSessionPool::MakeHostKey(const Poco::URI& Uri) { return Uri.getScheme() + "://" + Uri.getHost() + ":" + std::to_string(Uri.getPort()); }
+
+bool POCOSessionPool::IsHealthy(Poco::Net::HTTPClientSession& Session)
+{
+    if (!Session.connected())
+    {
+        return false;
+    }
+
+    try
+    {
+        // An idle keep-alive connection should have nothing to read. If it is readable, the server has either closed it or sent
+        // something we'd misinterpret as the response to our next request, so it can't be reused.
+        return !Session.socket().poll(Poco::Timespan(0), Poco::Net::Socket::SELECT_READ | Poco::Net::Socket::SELECT_ERROR);
+    }
+    catch (const Poco::Exception&)
+    {
+        return false;
+    }
+}
+
+} // namespace csp::web
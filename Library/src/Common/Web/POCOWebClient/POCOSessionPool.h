@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Poco/Net/HTTPClientSession.h>
+#include <Poco/URI.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace csp::web
+{
+
+/// @brief Keeps idle keep-alive HTTP(S) sessions per host, so that requests can reuse an already open TCP connection and TLS session
+/// instead of paying for a new handshake each time.
+/// @details The pool is shared by all WebClient worker threads. A session is only ever used by one request at a time: it is removed from
+/// the pool by Acquire and handed back when its Lease goes out of scope, provided the request marked it as reusable.
+class POCOSessionPool : public std::enable_shared_from_this<POCOSessionPool>
+{
+public:
+    /// Number of idle sessions kept for each host. Sessions released beyond this are closed.
+    static constexpr size_t DEFAULT_MAX_IDLE_SESSIONS_PER_HOST = 8;
+
+    /// How long a session may sit unused in the pool before it is closed rather than reused.
+    /// Kept below the idle timeout of the load balancers in front of our services.
+    static constexpr std::chrono::seconds DEFAULT_IDLE_TIMEOUT = std::chrono::seconds(30);
+
+    struct Metrics
+    {
+        /// Requests that reused a pooled session.
+        uint64_t Hits = 0;
+        /// Requests that had to open a new session.
+        uint64_t Misses = 0;
+        /// Pooled sessions closed because they timed out or failed their health check.
+        uint64_t Evictions = 0;
+        /// Sessions closed on release because they weren't reusable or the pool was full.
+        uint64_t Discards = 0;
+    };
+
+    /// @brief Exclusive use of a session for the duration of a single request.
+    /// @details The session is returned to the pool on destruction only if MarkReusable was called, which a request should do once it
+    /// has fully consumed the response on a connection the server agreed to keep alive. Otherwise the session is closed.
+    class Lease
+    {
+    public:
+        Lease(Lease&& Other) noexcept = default;
+        Lease& operator=(Lease&& Other) noexcept = default;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        Poco::Net::HTTPClientSession& GetSession() const { return *Session; }
+
+        void MarkReusable() { Reusable = true; }
+
+    private:
+        friend class POCOSessionPool;
+
+        Lease(std::shared_ptr<POCOSessionPool> Pool, std::string HostKey, std::unique_ptr<Poco::Net::HTTPClientSession> Session);
+
+        std::shared_ptr<POCOSessionPool> Pool;
+        std::string HostKey;
+        std::unique_ptr<Poco::Net::HTTPClientSession> Session;
+        bool Reusable;
+    };
+
+    explicit POCOSessionPool(
+        size_t MaxIdleSessionsPerHost = DEFAULT_MAX_IDLE_SESSIONS_PER_HOST, std::chrono::milliseconds IdleTimeout = DEFAULT_IDLE_TIMEOUT);
+
+    POCOSessionPool(const POCOSessionPool&) = delete;
+    POCOSessionPool& operator=(const POCOSessionPool&) = delete;
+
+    /// @brief Takes a pooled session for the scheme, host and port of the given Uri, or opens a new one if none are available.
+    /// @note The pool must be owned by a std::shared_ptr, so that outstanding leases can safely outlive the owner's reference.
+    Lease Acquire(const Poco::URI& Uri);
+
+    /// @brief Closes all idle sessions.
+    void Clear();
+
+    Metrics GetMetrics() const;
+
+    size_t GetIdleSessionCount() const;
+
+private:
+    struct IdleSession
+    {
+        std::unique_ptr<Poco::Net::HTTPClientSession> Session;
+        std::chrono::steady_clock::time_point IdleSince;
+    };
+
+    void Release(const std::string& HostKey, std::unique_ptr<Poco::Net::HTTPClientSession> Session, bool Reusable);
+
+    static std::string MakeHostKey(const Poco::URI& Uri);
+    static bool IsHealthy(Poco::Net::HTTPClientSession& Session);
+
+    const size_t MaxIdleSessionsPerHost;
+    const std::chrono::milliseconds IdleTimeout;
+
+    mutable std::mutex PoolMutex;
+    // Most recently released sessions are at the back, so they are reused first and older ones age out
+    std::unordered_map<std::string, std::vector<IdleSession>> IdleSessions;
+
+    std::atomic<uint64_t> Hits;
+    std::atomic<uint64_t> Misses;
+    std::atomic<uint64_t> Evictions;
+    std::atomic<uint64_t> Discards;
+};
+
+} // namespace csp::web
@@ -39,6 +39,7 @@
 #include <codecvt>
 #include <iostream>
 #include <istream>
+#include <limits>
 #include <string>
 #include <thread>
 
@@ -60,6 +61,25 @@ void LogHttpResponseIfLoglevelVeryVerbose(
     }
 }
 
+// A session can only go back into the pool if the server agreed to keep the connection open and nothing of this response is left
+// unread on it, otherwise the leftovers would be read as the response to the next request.
+void ReleaseSessionIfReusable(csp::web::POCOSessionPool::Lease& Session, csp::web::HttpRequest& Request,
+    const Poco::Net::HTTPResponse& PocoResponse, std::istream& ResponseStream)
+{
+    if (Request.Cancelled() || !PocoResponse.getKeepAlive())
+    {
+        return;
+    }
+
+    // Error bodies and responses without a known length aren't read by the verb handlers, so drain whatever is left
+    ResponseStream.ignore(std::numeric_limits<std::streamsize>::max());
+
+    if (ResponseStream.eof() && !ResponseStream.bad())
+    {
+        Session.MarkReusable();
+    }
+}
+
 } // namespace
 
 namespace csp::web
@@ -70,8 +90,9 @@ const uint32_t kPOCOAsyncBufferSize = 2 * 1024;
 
 EResponseCodes GetOlyResponseCode(Poco::Net::HTTPResponse::HTTPStatus PocoResponseCode) { return (EResponseCodes)PocoResponseCode; }
 
-POCOWebClient::POCOWebClient(const Port InPort, const ETransferProtocol Tp, csp::common::LogSystem* LogSystem, bool AutoRefresh) 
-: WebClient(InPort, Tp, LogSystem, AutoRefresh)
+POCOWebClient::POCOWebClient(
+    const Port InPort, const ETransferProtocol Tp, csp::common::LogSystem* LogSystem, bool AutoRefresh, const WebClientSettings& Settings)
+    : WebClient(InPort, Tp, LogSystem, AutoRefresh, Settings)
 {
     Poco::Net::initializeSSL();
 
@@ -88,16 +109,26 @@ POCOWebClient::POCOWebClient(const Port InPort, const ETransferProtocol Tp, csp:
     Poco::Net::SSLManager::instance().initializeClient(PrivateKeyHandler, CertHandler, PocoContext);
 
     Cookies = new std::remove_pointer_t<decltype(Cookies)>();
+
+    SessionPool = std::make_shared<POCOSessionPool>();
 }
 
-POCOWebClient::POCOWebClient(
-    const Port InPort, const ETransferProtocol Tp, csp::common::IAuthContext& AuthContext, csp::common::LogSystem* LogSystem, bool AutoRefresh)
-    : POCOWebClient(InPort, Tp, LogSystem, AutoRefresh)
+POCOWebClient::POCOWebClient(const Port InPort, const ETransferProtocol Tp, csp::common::IAuthContext& AuthContext,
+    csp::common::LogSystem* LogSystem, bool AutoRefresh, const WebClientSettings& Settings)
+    : POCOWebClient(InPort, Tp, LogSystem, AutoRefresh, Settings)
 {
     SetAuthContext(AuthContext);
 }
 
-POCOWebClient::~POCOWebClient() { delete Cookies; }
+POCOWebClient::~POCOWebClient()
+{
+    delete Cookies;
+
+    // Requests still in flight hold a reference to the pool, and will close their sessions when they finish
+    SessionPool->Clear();
+}
+
+POCOSessionPool::Metrics POCOWebClient::GetSessionPoolMetrics() const { return SessionPool->GetMetrics(); }
 
 void POCOWebClient::Send(HttpRequest& Request)
 {
@@ -138,7 +169,8 @@ void POCOWebClient::Get(HttpRequest& Request)
 
     Poco::URI Uri(Request.GetUri().GetAsStdString());
 
-    Poco::Net::HTTPClientSession* ClientSession = Poco::Net::HTTPSessionFactory::defaultFactory().createClientSession(Uri);
+    POCOSessionPool::Lease Session = SessionPool->Acquire(Uri);
+    Poco::Net::HTTPClientSession* ClientSession = &Session.GetSession();
     Poco::Net::HTTPRequest PocoRequest(Poco::Net::HTTPRequest::HTTP_GET, Uri.getPathAndQuery(), Poco::Net::HTTPRequest::HTTP_1_1);
 
     for (auto Header : Request.GetPayload().GetHeaders())
@@ -165,6 +197,8 @@ void POCOWebClient::Get(HttpRequest& Request)
         ProcessResponseAsync(*ClientSession, PocoResponse, ResponseStream, Request);
     }
 
+    ReleaseSessionIfReusable(Session, Request, PocoResponse, ResponseStream);
+
     LogHttpResponseIfLoglevelVeryVerbose(LogSystem, "GET", Request, PocoResponse);
 }
 
@@ -202,7 +236,8 @@ void POCOWebClient::Post(HttpRequest& Request)
 
     Poco::URI Uri(Request.GetUri().GetAsStdString());
 
-    Poco::Net::HTTPClientSession* ClientSession = Poco::Net::HTTPSessionFactory::defaultFactory().createClientSession(Uri);
+    POCOSessionPool::Lease Session = SessionPool->Acquire(Uri);
+    Poco::Net::HTTPClientSession* ClientSession = &Session.GetSession();
     Poco::Net::HTTPRequest PocoRequest(Poco::Net::HTTPRequest::HTTP_POST, Uri.getPathAndQuery(), Poco::Net::HTTPRequest::HTTP_1_1);
 
     for (auto Header : Request.GetPayload().GetHeaders())
@@ -250,6 +285,8 @@ void POCOWebClient::Post(HttpRequest& Request)
         Payload.AddHeader(Key.c_str(), Val.c_str());
     }
 
+    ReleaseSessionIfReusable(Session, Request, PocoResponse, ResponseStream);
+
     LogHttpResponseIfLoglevelVeryVerbose(LogSystem, "POST", Request, PocoResponse);
 }
 
@@ -259,7 +296,8 @@ void POCOWebClient::Put(HttpRequest& Request)
 
     Poco::URI Uri(Request.GetUri().GetAsStdString());
 
-    Poco::Net::HTTPClientSession* ClientSession = Poco::Net::HTTPSessionFactory::defaultFactory().createClientSession(Uri);
+    POCOSessionPool::Lease Session = SessionPool->Acquire(Uri);
+    Poco::Net::HTTPClientSession* ClientSession = &Session.GetSession();
     Poco::Net::HTTPRequest PocoRequest(Poco::Net::HTTPRequest::HTTP_PUT, Uri.getPathAndQuery(), Poco::Net::HTTPRequest::HTTP_1_1);
 
     for (auto Header : Request.GetPayload().GetHeaders())
@@ -296,6 +334,8 @@ void POCOWebClient::Put(HttpRequest& Request)
         Request.SetResponseData(ResponseString.c_str(), ResponseString.length());
     }
 
+    ReleaseSessionIfReusable(Session, Request, PocoResponse, ResponseStream);
+
     LogHttpResponseIfLoglevelVeryVerbose(LogSystem, "PUT", Request, PocoResponse);
 }
 
@@ -305,7 +345,8 @@ void POCOWebClient::Delete(HttpRequest& Request)
 
     Poco::URI Uri(Request.GetUri().GetAsStdString());
 
-    Poco::Net::HTTPClientSession* ClientSession = Poco::Net::HTTPSessionFactory::defaultFactory().createClientSession(Uri);
+    POCOSessionPool::Lease Session = SessionPool->Acquire(Uri);
+    Poco::Net::HTTPClientSession* ClientSession = &Session.GetSession();
     Poco::Net::HTTPRequest PocoRequest(Poco::Net::HTTPRequest::HTTP_DELETE, Uri.getPathAndQuery(), Poco::Net::HTTPRequest::HTTP_1_1);
 
     for (auto Header : Request.GetPayload().GetHeaders())
@@ -336,6 +377,8 @@ void POCOWebClient::Delete(HttpRequest& Request)
         Request.SetResponseData(ResponseString.c_str(), ResponseString.length());
     }
 
+    ReleaseSessionIfReusable(Session, Request, PocoResponse, ResponseStream);
+
     LogHttpResponseIfLoglevelVeryVerbose(LogSystem, "DELETE", Request, PocoResponse);
 }
 
@@ -345,7 +388,8 @@ void POCOWebClient::Head(HttpRequest& Request)
 
     Poco::URI Uri(Request.GetUri().GetAsStdString());
 
-    Poco::Net::HTTPClientSession* ClientSession = Poco::Net::HTTPSessionFactory::defaultFactory().createClientSession(Uri);
+    POCOSessionPool::Lease Session = SessionPool->Acquire(Uri);
+    Poco::Net::HTTPClientSession* ClientSession = &Session.GetSession();
     Poco::Net::HTTPRequest PocoRequest(Poco::Net::HTTPRequest::HTTP_HEAD, Uri.getPathAndQuery(), Poco::Net::HTTPRequest::HTTP_1_1);
 
     for (auto Header : Request.GetPayload().GetHeaders())
@@ -372,6 +416,8 @@ void POCOWebClient::Head(HttpRequest& Request)
         ProcessResponseAsync(*ClientSession, PocoResponse, ResponseStream, Request);
     }
 
+    ReleaseSessionIfReusable(Session, Request, PocoResponse, ResponseStream);
+
     LogHttpResponseIfLoglevelVeryVerbose(LogSystem, "HEAD", Request, PocoResponse);
 }
 
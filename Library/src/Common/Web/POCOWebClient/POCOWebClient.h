@@ -16,6 +16,7 @@
 #pragma once
 
 #include "Common/Web/WebClient.h"
+#include "POCOSessionPool.h"
 
 #include <Poco/Net/HTTPCookie.h>
 #include <Poco/Net/HTTPSClientSession.h>
@@ -56,8 +57,13 @@ public:
         const char* Version, const csp::common::String& MediaType) override;
 
     // Instances of POCOWebClient should not be created. You should instead rely on the instance that `csp::systems::SystemsManager` holds.
-    POCOWebClient(const Port InPort, const ETransferProtocol Tp, csp::common::LogSystem* LogSystem, bool AutoRefresh = true);
-    POCOWebClient(const Port InPort, const ETransferProtocol Tp, csp::common::IAuthContext& AuthContext, csp::common::LogSystem* LogSystem, bool AutoRefresh = true);
+    POCOWebClient(const Port InPort, const ETransferProtocol Tp, csp::common::LogSystem* LogSystem, bool AutoRefresh = true,
+        const WebClientSettings& Settings = WebClientSettings());
+    POCOWebClient(const Port InPort, const ETransferProtocol Tp, csp::common::IAuthContext& AuthContext, csp::common::LogSystem* LogSystem,
+        bool AutoRefresh = true, const WebClientSettings& Settings = WebClientSettings());
+
+    /// @brief Hit and miss counts for the keep-alive session pool shared by all requests made through this client.
+    POCOSessionPool::Metrics GetSessionPoolMetrics() const;
 
 protected:
     void SetFileUploadContent(HttpPayload* Payload, Poco::Net::PartSource* Source, const char* Version);
@@ -78,6 +84,8 @@ protected:
 
     Poco::Net::Context::Ptr PocoContext;
 
+    std::shared_ptr<POCOSessionPool> SessionPool;
+
     std::vector<Poco::Net::HTTPCookie>* Cookies;
     std::mutex CookiesMutex;
 };
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "RequestExecutor.h"
+
+#include "Debug/Logging.h"
+
+#include <algorithm>
+
+namespace csp::web
+{
+
+RequestExecutor::RequestExecutor(
+    size_t WorkerCount, size_t MaxConcurrentTasksPerHost, std::unordered_map<std::string, size_t> MaxConcurrentTasksByHost)
+    : MaxConcurrentTasksPerHost(std::max<size_t>(MaxConcurrentTasksPerHost, 1))
+    , MaxConcurrentTasksByHost(std::move(MaxConcurrentTasksByHost))
+    , NextTimerSequence(0)
+    , ShutdownFlag(false)
+{
+    WorkerCount = std::max<size_t>(WorkerCount, 1);
+    Workers.reserve(WorkerCount);
+
+    for (size_t i = 0; i < WorkerCount; ++i)
+    {
+        Workers.emplace_back(&RequestExecutor::WorkerThreadFunc, this);
+    }
+}
+
+RequestExecutor::~RequestExecutor() { Shutdown(); }
+
+void RequestExecutor::Enqueue(const std::string& HostKey, Task Work)
+{
+    {
+        std::scoped_lock Lock(Mutex);
+        PushTask(HostKey, std::move(Work));
+    }
+
+    Condition.notify_one();
+}
+
+void RequestExecutor::EnqueueDelayed(const std::string& HostKey, Task Work, std::chrono::milliseconds Delay)
+{
+    if (Delay <= std::chrono::milliseconds(0))
+    {
+        Enqueue(HostKey, std::move(Work));
+        return;
+    }
+
+    {
+        std::scoped_lock Lock(Mutex);
+        Timers.push({ std::chrono::steady_clock::now() + Delay, NextTimerSequence++, HostKey, std::move(Work) });
+    }
+
+    // A waiting worker may need to shorten its wait to this timer's due time
+    Condition.notify_one();
+}
+
+void RequestExecutor::Shutdown()
+{
+    {
+        std::scoped_lock Lock(Mutex);
+
+        if (ShutdownFlag)
+        {
+            return;
+        }
+
+        ShutdownFlag = true;
+    }
+
+    Condition.notify_all();
+
+    for (auto& Worker : Workers)
+    {
+        Worker.join();
+    }
+
+    Workers.clear();
+}
+
+std::string RequestExecutor::GetHostKey(const std::string& Uri)
+{
+    const size_t SchemeEnd = Uri.find("://");
+    const size_t AuthorityStart = (SchemeEnd == std::string::npos) ? 0 : SchemeEnd + 3;
+    const size_t AuthorityEnd = Uri.find_first_of("/?#", AuthorityStart);
+
+    return Uri.substr(AuthorityStart, AuthorityEnd == std::string::npos ? std::string::npos : AuthorityEnd - AuthorityStart);
+}
+
+void RequestExecutor::WorkerThreadFunc()
+{
+    std::unique_lock Lock(Mutex);
+
+    for (;;)
+    {
+        // Once shutting down, outstanding timers are run straight away, as the owner is waiting on them to finish
+        PromoteDueTimers(ShutdownFlag ? std::chrono::steady_clock::time_point::max() : std::chrono::steady_clock::now());
+
+        if (!ReadyHosts.empty())
+        {
+            const std::string HostKey = std::move(ReadyHosts.front());
+            ReadyHosts.pop_front();
+
+            HostQueue& Queue = Hosts[HostKey];
+            Queue.InReadyList = false;
+
+            Task Work = std::move(Queue.Tasks.front());
+            Queue.Tasks.pop_front();
+            ++Queue.InFlight;
+
+            // Go to the back of the line, so other hosts get a turn before this host's next task
+            MarkReadyIfRunnable(HostKey, Queue);
+
+            Lock.unlock();
+
+            {
+                CSP_PROFILE_SCOPED_TAG("RequestExecutor Task");
+                Work();
+            }
+
+            Lock.lock();
+
+            HostQueue& FinishedQueue = Hosts[HostKey];
+            --FinishedQueue.InFlight;
+
+            // If the host was at its limit it has a free slot again. This worker is about to look for work, so no need to wake another.
+            MarkReadyIfRunnable(HostKey, FinishedQueue);
+
+            continue;
+        }
+
+        if (ShutdownFlag && Timers.empty())
+        {
+            // Other workers may be finishing tasks that could unblock more of a host's queue, but whichever worker finishes them
+            // will pick that work up itself, so it's safe to exit here
+            break;
+        }
+
+        if (Timers.empty())
+        {
+            Condition.wait(Lock);
+        }
+        else
+        {
+            Condition.wait_until(Lock, Timers.top().Due);
+        }
+    }
+}
+
+RequestExecutor::HostQueue& RequestExecutor::GetHostQueue(const std::string& HostKey)
+{
+    auto It = Hosts.find(HostKey);
+
+    if (It == Hosts.end())
+    {
+        const auto Override = MaxConcurrentTasksByHost.find(HostKey);
+
+        It = Hosts.emplace(HostKey, HostQueue()).first;
+        It->second.MaxInFlight = (Override != MaxConcurrentTasksByHost.end()) ? std::max<size_t>(Override->second, 1) : MaxConcurrentTasksPerHost;
+    }
+
+    return It->second;
+}
+
+void RequestExecutor::PushTask(const std::string& HostKey, Task Work)
+{
+    HostQueue& Queue = GetHostQueue(HostKey);
+    Queue.Tasks.push_back(std::move(Work));
+
+    MarkReadyIfRunnable(HostKey, Queue);
+}
+
+void RequestExecutor::MarkReadyIfRunnable(const std::string& HostKey, HostQueue& Queue)
+{
+    if (!Queue.InReadyList && !Queue.Tasks.empty() && Queue.InFlight < Queue.MaxInFlight)
+    {
+        ReadyHosts.push_back(HostKey);
+        Queue.InReadyList = true;
+    }
+}
+
+void RequestExecutor::PromoteDueTimers(std::chrono::steady_clock::time_point Now)
+{
+    bool Promoted = false;
+
+    while (!Timers.empty() && Timers.top().Due <= Now)
+    {
+        // priority_queue only exposes a const top, but we are about to pop it so moving out is safe
+        DelayedTask& Timer = const_cast<DelayedTask&>(Timers.top());
+        PushTask(Timer.HostKey, std::move(Timer.Work));
+        Timers.pop();
+
+        Promoted = true;
+    }
+
+    if (Promoted)
+    {
+        // This worker will take one task, let the others know about the rest
+        Condition.notify_all();
+    }
+}
+
+} // namespace csp::web
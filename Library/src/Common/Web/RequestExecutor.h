@@ -0,0 +1,109 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace csp::web
+{
+
+/// @brief Runs web requests on a configurable number of worker threads, keeping a separate queue for each host.
+/// @details Idle workers take work from hosts in round-robin order, so one host with a long backlog (e.g. a bulk asset download) cannot
+/// starve requests to other services, and no host ever has more than its concurrency limit of requests in flight.
+/// Delayed work, such as request retries, is held in a timer queue rather than occupying a worker for the duration of the delay:
+/// workers sleep until either new work arrives or the next timer falls due.
+class RequestExecutor
+{
+public:
+    using Task = std::function<void()>;
+
+    /// @param WorkerCount size_t : Number of worker threads, and so the maximum number of requests in flight across all hosts.
+    /// @param MaxConcurrentTasksPerHost size_t : Default limit on in-flight requests to a single host.
+    /// @param MaxConcurrentTasksByHost std::unordered_map<std::string, size_t> : Per-host overrides of the above, keyed by host as
+    /// returned from GetHostKey.
+    RequestExecutor(
+        size_t WorkerCount, size_t MaxConcurrentTasksPerHost, std::unordered_map<std::string, size_t> MaxConcurrentTasksByHost = {});
+    ~RequestExecutor();
+
+    RequestExecutor(const RequestExecutor&) = delete;
+    RequestExecutor& operator=(const RequestExecutor&) = delete;
+
+    /// @brief Queues work for the given host, to run as soon as a worker is free and the host is below its concurrency limit.
+    void Enqueue(const std::string& HostKey, Task Work);
+
+    /// @brief Queues work for the given host once Delay has elapsed.
+    void EnqueueDelayed(const std::string& HostKey, Task Work, std::chrono::milliseconds Delay);
+
+    /// @brief Runs all queued work, including delayed work whose timers haven't yet fired, then stops and joins the workers.
+    void Shutdown();
+
+    /// @brief Returns the host and port of a URI, which is what requests are queued by.
+    static std::string GetHostKey(const std::string& Uri);
+
+private:
+    struct HostQueue
+    {
+        std::deque<Task> Tasks;
+        size_t MaxInFlight = 0;
+        size_t InFlight = 0;
+        bool InReadyList = false;
+    };
+
+    struct DelayedTask
+    {
+        std::chrono::steady_clock::time_point Due;
+        uint64_t Sequence;
+        std::string HostKey;
+        Task Work;
+
+        // Orders the priority queue so the earliest timer, then the earliest added, is on top
+        bool operator>(const DelayedTask& Other) const { return Due != Other.Due ? Due > Other.Due : Sequence > Other.Sequence; }
+    };
+
+    void WorkerThreadFunc();
+
+    // The following all require Mutex to be held
+    HostQueue& GetHostQueue(const std::string& HostKey);
+    void PushTask(const std::string& HostKey, Task Work);
+    void MarkReadyIfRunnable(const std::string& HostKey, HostQueue& Queue);
+    void PromoteDueTimers(std::chrono::steady_clock::time_point Now);
+
+    const size_t MaxConcurrentTasksPerHost;
+    const std::unordered_map<std::string, size_t> MaxConcurrentTasksByHost;
+
+    std::mutex Mutex;
+    std::condition_variable Condition;
+
+    std::unordered_map<std::string, HostQueue> Hosts;
+    // Hosts that have queued work and spare capacity, in the order they will be served
+    std::deque<std::string> ReadyHosts;
+    std::priority_queue<DelayedTask, std::vector<DelayedTask>, std::greater<DelayedTask>> Timers;
+    uint64_t NextTimerSequence;
+
+    bool ShutdownFlag;
+    std::vector<std::thread> Workers;
+};
+
+} // namespace csp::web
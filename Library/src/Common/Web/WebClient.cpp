@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "WebClient.h"
+#include "CSP/CSPFoundation.h"
 #include "CSP/Common/Interfaces/IAuthContext.h"
 #include "CSP/Common/Systems/Log/LogSystem.h"
 #include "CSP/Common/fmt_Formatters.h"
@@ -28,8 +29,36 @@ using namespace std::chrono_literals;
 namespace csp::web
 {
 
-WebClient::WebClient(
-    const Port InPort, const ETransferProtocol /*Tp*/, csp::common::IAuthContext& AuthContext, csp::common::LogSystem* LogSystem, bool AutoRefresh)
+#ifndef CSP_WASM
+namespace
+{
+
+std::unordered_map<std::string, size_t> GetMaxConcurrentRequestsByHost(const WebClientSettings& Settings)
+{
+    return { Settings.MaxConcurrentRequestsByHost.begin(), Settings.MaxConcurrentRequestsByHost.end() };
+}
+
+} // namespace
+
+WebClientSettings GetConfiguredWebClientSettings()
+{
+    const csp::WebRequestSettings& Configured = csp::CSPFoundation::GetWebRequestSettings();
+
+    WebClientSettings Settings;
+    Settings.MaxConcurrentRequests = Configured.MaxConcurrentRequests;
+    Settings.MaxConcurrentRequestsPerHost = Configured.MaxConcurrentRequestsPerHost;
+
+    for (const auto& [Host, MaxConcurrentRequests] : Configured.MaxConcurrentRequestsByHost)
+    {
+        Settings.MaxConcurrentRequestsByHost.emplace(Host.c_str(), MaxConcurrentRequests);
+    }
+
+    return Settings;
+}
+#endif
+
+WebClient::WebClient(const Port InPort, const ETransferProtocol /*Tp*/, csp::common::IAuthContext& AuthContext, csp::common::LogSystem* LogSystem,
+    bool AutoRefresh, [[maybe_unused]] const WebClientSettings& Settings)
     : RootPort(InPort)
     , AuthContext { &AuthContext }
     , LogSystem(LogSystem)
@@ -38,12 +67,14 @@ WebClient::WebClient(
     , AutoRefreshEnabled(AutoRefresh)
 #ifndef CSP_WASM
     , RequestCount(0)
-    , ThreadPool(CSP_MAX_CONCURRENT_REQUESTS)
+    , Executor(Settings.MaxConcurrentRequests, Settings.MaxConcurrentRequestsPerHost, GetMaxConcurrentRequestsByHost(Settings))
+    , PollRequests(PollRequestsCapacity)
 #endif
 {
 }
 
-WebClient::WebClient(const Port InPort, const ETransferProtocol /*Tp*/, csp::common::LogSystem* LogSystem, bool AutoRefresh)
+WebClient::WebClient(const Port InPort, const ETransferProtocol /*Tp*/, csp::common::LogSystem* LogSystem, bool AutoRefresh,
+    [[maybe_unused]] const WebClientSettings& Settings)
     : RootPort(InPort)
     , AuthContext(nullptr)
     , LogSystem(LogSystem)
@@ -52,7 +83,8 @@ WebClient::WebClient(const Port InPort, const ETransferProtocol /*Tp*/, csp::com
     , AutoRefreshEnabled(AutoRefresh)
 #ifndef CSP_WASM
     , RequestCount(0)
-    , ThreadPool(CSP_MAX_CONCURRENT_REQUESTS)
+    , Executor(Settings.MaxConcurrentRequests, Settings.MaxConcurrentRequestsPerHost, GetMaxConcurrentRequestsByHost(Settings))
+    , PollRequests(PollRequestsCapacity)
 #endif
 {
 }
@@ -112,9 +144,7 @@ WebClient::~WebClient()
         CSP_LOG_WARN_MSG("Web client timed out waiting for outstanding request on exit\n");
     }
 
-    PollRequests.Close();
-
-    ThreadPool.Shutdown();
+    Executor.Shutdown();
 #endif
 }
 
@@ -155,18 +185,22 @@ void WebClient::RefreshIfExpired()
                         RefreshNeeded = false;
                     }
                     WasmRequestsMutex.unlock();
+                    RefreshStarted = false;
 #else
-                    RefreshNeeded = false;
+                    SetRefreshState(false, false);
 #endif
-                    RefreshStarted = false;
                 }
                 else
                 {
                     CSP_LOG_MSG(csp::common::LogLevel::Fatal, "User authentication token refresh failed!");
 
                     // reset the state of the web client to prevent indefinite freeze when enqueuing a request
+#ifdef CSP_WASM
                     RefreshNeeded = true;
                     RefreshStarted = false;
+#else
+                    SetRefreshState(true, false);
+#endif
                 }
             });
     }
@@ -235,25 +269,18 @@ void WebClient::AddRequest(HttpRequest* Request, [[maybe_unused]] std::chrono::m
         ++RequestCount;
         Request->IncRefCount();
         Request->SetSendDelay(SendDelay);
-        ThreadPool.Enqueue(
-            [this, Request](void*)
-            {
-                while (RefreshStarted)
-                {
-                    std::this_thread::sleep_for(10ns);
-                }
 
-                if (RefreshNeeded && !RefreshStarted)
-                {
-                    RefreshStarted = true;
-                }
+        // Delayed requests (e.g. retries) sit on the executor's timer queue rather than holding up a worker
+        Executor.EnqueueDelayed(RequestExecutor::GetHostKey(Request->GetUri().GetAsStdString()),
+            [this, Request]()
+            {
+                WaitForTokenRefresh();
 
                 Request->RefreshAccessToken();
 
                 ProcessRequest(Request);
-
-                return nullptr;
-            });
+            },
+            SendDelay);
 #endif
     }
 }
@@ -262,12 +289,10 @@ void WebClient::AddRequest(HttpRequest* Request, [[maybe_unused]] std::chrono::m
 void WebClient::ProcessResponses(const uint32_t MaxNumResponses)
 {
     uint32_t ResponseCount = 0;
+    HttpRequest* Request = nullptr;
 
-    while ((PollRequests.IsEmpty() == false) && (ResponseCount < MaxNumResponses))
+    while ((ResponseCount < MaxNumResponses) && PollRequests.TryDequeue(Request))
     {
-        auto PollRequest = PollRequests.Dequeue();
-
-        HttpRequest* Request = PollRequest.value();
         IHttpResponseHandler* Callback = Request->GetCallback();
 
         if (!Request->Cancelled() && Callback)
@@ -291,14 +316,6 @@ void WebClient::ProcessRequest(HttpRequest* Request)
         auto& Payload = Request->GetMutablePayload();
         Payload.SetBearerToken();
 
-        const std::chrono::milliseconds SendDelay = Request->GetSendDelay();
-
-        if (SendDelay > std::chrono::milliseconds(0))
-        {
-            // Wait before sending if required (e.g. for Retries)
-            std::this_thread::sleep_for(SendDelay);
-        }
-
         try
         {
             if (!Request->Cancelled())
@@ -360,7 +377,7 @@ void WebClient::ProcessRequest(HttpRequest* Request)
 
                     // This request is marked to be polled, so add to the queue
                     // to be issued on the next call to WebClient::ProcessResponses()
-                    PollRequests.Enqueue({ Request });
+                    PollRequests.Enqueue(Request);
                 }
             }
         }
@@ -372,6 +389,28 @@ void WebClient::ProcessRequest(HttpRequest* Request)
     }
 }
 
+void WebClient::WaitForTokenRefresh()
+{
+    std::unique_lock Lock(RefreshMutex);
+    RefreshCondition.wait(Lock, [this]() { return !RefreshStarted; });
+
+    if (RefreshNeeded)
+    {
+        RefreshStarted = true;
+    }
+}
+
+void WebClient::SetRefreshState(bool InRefreshNeeded, bool InRefreshStarted)
+{
+    {
+        std::scoped_lock Lock(RefreshMutex);
+        RefreshNeeded = InRefreshNeeded;
+        RefreshStarted = InRefreshStarted;
+    }
+
+    RefreshCondition.notify_all();
+}
+
 void WebClient::DestroyRequest(HttpRequest* Request)
 {
     RequestsMutex.lock();
@@ -16,18 +16,22 @@
 #pragma once
 
 #include "CSP/Common/CancellationToken.h"
+#include "Common/MPSCQueue.h"
 #include "Common/Queue.h"
 #include "HttpAuth.h"
 #include "HttpRequest.h"
 #include "Uri.h"
 
 #ifndef CSP_WASM
-#include "Common/ThreadPool.h"
+#include "RequestExecutor.h"
 #endif
 
 #include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace csp::common
@@ -51,8 +55,30 @@ namespace csp::web
                 @details    Abstracts web requests and their responses from underlying platform implementation
  */
 
-/// Maximum concurrent requests supported by the Web Request system
-constexpr int CSP_MAX_CONCURRENT_REQUESTS = 4;
+/// Default maximum concurrent requests supported by the Web Request system
+constexpr int CSP_MAX_CONCURRENT_REQUESTS = 16;
+
+/// Default maximum concurrent requests the Web Request system will make to a single host
+constexpr int CSP_MAX_CONCURRENT_REQUESTS_PER_HOST = 8;
+
+/// @brief Configuration of how many requests a WebClient runs at once.
+struct WebClientSettings
+{
+    /// Number of requests that can be in flight across all hosts.
+    uint32_t MaxConcurrentRequests = CSP_MAX_CONCURRENT_REQUESTS;
+
+    /// Number of requests that can be in flight to any one host, unless overridden below.
+    uint32_t MaxConcurrentRequestsPerHost = CSP_MAX_CONCURRENT_REQUESTS_PER_HOST;
+
+    /// Per-host overrides of MaxConcurrentRequestsPerHost, keyed by host and, if not the default for the scheme, port. e.g. "localhost:8081".
+    std::unordered_map<std::string, uint32_t> MaxConcurrentRequestsByHost;
+};
+
+#ifndef CSP_WASM
+/// @brief Gets the settings configured through CSPFoundation::SetWebRequestSettings, for the web clients Foundation creates.
+/// @details Only the POCO web client takes these settings. The browser manages request concurrency itself.
+WebClientSettings GetConfiguredWebClientSettings();
+#endif
 
 using Port = uint32_t;
 
@@ -73,9 +99,10 @@ class WebClient
     friend class HttpRequest;
 
 public:
-    WebClient(const Port InPort, const ETransferProtocol Tp, csp::common::LogSystem* LogSystem, bool AutoRefresh = true);
+    WebClient(const Port InPort, const ETransferProtocol Tp, csp::common::LogSystem* LogSystem, bool AutoRefresh = true,
+        const WebClientSettings& Settings = WebClientSettings());
     WebClient(const Port InPort, const ETransferProtocol Tp, csp::common::IAuthContext& AuthContext, csp::common::LogSystem* LogSystem,
-        bool AutoRefresh = true);
+        bool AutoRefresh = true, const WebClientSettings& Settings = WebClientSettings());
     virtual ~WebClient();
 
     /// @brief Main method for sending a Http Request
@@ -131,16 +158,24 @@ private:
     std::atomic_bool RefreshNeeded, RefreshStarted;
     bool AutoRefreshEnabled;
 
+    // Requests that arrive while a token refresh is in progress wait on this until it completes
+    std::mutex RefreshMutex;
+    std::condition_variable RefreshCondition;
+
 #ifdef CSP_WASM
     csp::Queue<HttpRequest*> WasmRequests;
     std::mutex WasmRequestsMutex;
 #else
     void ProcessRequest(HttpRequest* Request);
     void DestroyRequest(HttpRequest* Request);
+    void WaitForTokenRefresh();
+    void SetRefreshState(bool InRefreshNeeded, bool InRefreshStarted);
 
     std::atomic_uint32_t RequestCount;
-    csp::ThreadPool ThreadPool;
-    csp::Queue<HttpRequest*> PollRequests;
+    RequestExecutor Executor;
+    // Filled by executor threads as responses arrive, and drained by ProcessResponses on the tick thread
+    static constexpr unsigned PollRequestsCapacity = 1024;
+    csp::MPSCQueue<HttpRequest*> PollRequests;
     std::unordered_set<HttpRequest*> Requests;
     std::mutex RequestsMutex;
 #endif
@@ -16,7 +16,10 @@
 #include "Events/Event.h"
 #include "Common/Wrappers.h"
 
-#include <map>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace csp::events
 {
@@ -37,6 +40,8 @@ public:
     float GetFloat(const char* Key) const;
     bool GetBool(const char* Key) const;
 
+    void Clear();
+
 private:
     enum EParamType
     {
@@ -53,6 +58,37 @@ private:
         {
         }
 
+        EventParam(EventParam&& Other) noexcept
+        {
+            ParamType = Other.ParamType;
+
+            switch (ParamType)
+            {
+            case TypeInt:
+                IntParam = Other.IntParam;
+                break;
+
+            case TypeFloat:
+                FloatParam = Other.FloatParam;
+                break;
+
+            case TypeBool:
+                BoolParam = Other.BoolParam;
+                break;
+
+            case TypeString:
+                // Take ownership of the string, leaving nothing for the moved-from param to free.
+                StringParam = Other.StringParam;
+                Other.StringParam = nullptr;
+                break;
+
+            default:
+                break; // Unknown type
+            }
+        }
+
+        EventParam& operator=(const EventParam&) = delete;
+
         EventParam(const EventParam& Other)
         {
             ParamType = Other.ParamType;
@@ -107,9 +143,14 @@ private:
         };
     };
 
-    using ParamMap = std::map<std::string, EventParam>;
+    void AddParam(const char* Key, EventParam&& Param);
+    const EventParam* FindParam(const char* Key) const;
+
+    // A flat list rather than a map, as events only carry a handful of parameters. Clearing it keeps its storage,
+    // so a pooled event only allocates for string values and keys too long for the small string buffer.
+    using ParamList = std::vector<std::pair<std::string, EventParam>>;
 
-    ParamMap Parameters;
+    ParamList Parameters;
 };
 
 EventPayloadImpl::EventPayloadImpl() { }
@@ -120,37 +161,61 @@ void EventPayloadImpl::AddInt(const char* Key, const int Value)
 {
     EventParam Param(TypeInt);
     Param.IntParam = Value;
-    Parameters.insert(ParamMap::value_type(Key, Param));
+    AddParam(Key, std::move(Param));
 }
 
 void EventPayloadImpl::AddString(const char* Key, const char* Value)
 {
     EventParam Param(TypeString);
     Param.SetString(Value);
-    Parameters.insert(ParamMap::value_type(Key, Param));
+    AddParam(Key, std::move(Param));
 }
 
 void EventPayloadImpl::AddFloat(const char* Key, const float Value)
 {
     EventParam Param(TypeFloat);
     Param.FloatParam = Value;
-    Parameters.insert(ParamMap::value_type(Key, Param));
+    AddParam(Key, std::move(Param));
 }
 
 void EventPayloadImpl::AddBool(const char* Key, const bool Value)
 {
     EventParam Param(TypeBool);
     Param.BoolParam = Value;
-    Parameters.insert(ParamMap::value_type(Key, Param));
+    AddParam(Key, std::move(Param));
+}
+
+void EventPayloadImpl::AddParam(const char* Key, EventParam&& Param)
+{
+    // As with the map this replaced, the first value added for a key is kept.
+    if (FindParam(Key) == nullptr)
+    {
+        Parameters.emplace_back(Key, std::move(Param));
+    }
 }
 
+const EventPayloadImpl::EventParam* EventPayloadImpl::FindParam(const char* Key) const
+{
+    for (const auto& Parameter : Parameters)
+    {
+        if (Parameter.first == Key)
+        {
+            return &Parameter.second;
+        }
+    }
+
+    return nullptr;
+}
+
+void EventPayloadImpl::Clear() { Parameters.clear(); }
+
 int EventPayloadImpl::GetInt(const char* Key) const
 {
-    ParamMap::const_iterator it = Parameters.find(Key);
-    if (it != Parameters.end())
+    const EventParam* Param = FindParam(Key);
+    if (Param != nullptr)
     {
-        assert(it->second.ParamType == TypeInt);
-        return it->second.IntParam;
+        assert(Param->ParamType == TypeInt);
+        return Param->IntParam;
     }
 
     return 0;
@@ -158,11 +223,11 @@ int EventPayloadImpl::GetInt(const char* Key) const
 
 const char* EventPayloadImpl::GetString(const char* Key) const
 {
-    ParamMap::const_iterator it = Parameters.find(Key);
-    if (it != Parameters.end())
+    const EventParam* Param = FindParam(Key);
+    if (Param != nullptr)
     {
-        assert(it->second.ParamType == TypeString);
-        return it->second.StringParam;
+        assert(Param->ParamType == TypeString);
+        return Param->StringParam;
     }
 
     return nullptr;
@@ -170,11 +235,11 @@ const char* EventPayloadImpl::GetString(const char* Key) const
 
 float EventPayloadImpl::GetFloat(const char* Key) const
 {
-    ParamMap::const_iterator it = Parameters.find(Key);
-    if (it != Parameters.end())
+    const EventParam* Param = FindParam(Key);
+    if (Param != nullptr)
     {
-        assert(it->second.ParamType == TypeFloat);
-        return it->second.FloatParam;
+        assert(Param->ParamType == TypeFloat);
+        return Param->FloatParam;
     }
 
     return 0.0f;
@@ -182,11 +247,11 @@ float EventPayloadImpl::GetFloat(const char* Key) const
 
 bool EventPayloadImpl::GetBool(const char* Key) const
 {
-    ParamMap::const_iterator it = Parameters.find(Key);
-    if (it != Parameters.end())
+    const EventParam* Param = FindParam(Key);
+    if (Param != nullptr)
     {
-        assert(it->second.ParamType == TypeBool);
-        return it->second.BoolParam;
+        assert(Param->ParamType == TypeBool);
+        return Param->BoolParam;
     }
 
     return false;
@@ -200,6 +265,12 @@ Event::Event(const EventId& InId)
 
 Event::~Event() { delete (Impl); }
 
+void Event::Reset(const EventId& InId)
+{
+    Id = InId;
+    Impl->Clear();
+}
+
 void Event::AddInt(const char* Key, const int Value) { Impl->AddInt(Key, Value); }
 
 void Event::AddString(const char* Key, const char* Value) { Impl->AddString(Key, Value); }
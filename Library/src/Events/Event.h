@@ -27,6 +27,7 @@ namespace csp::events
 class CSP_API Event
 {
     friend class EventSystem;
+    friend class EventSystemImpl;
 
 public:
     ~Event();
@@ -48,6 +49,9 @@ public:
 private:
     Event(const EventId& InId);
 
+    // Clears the payload so a pooled event can be reused for a new id. The payload keeps its storage for the next use.
+    void Reset(const EventId& InId);
+
     EventId Id;
     class EventPayloadImpl* Impl;
 };
@@ -15,9 +15,11 @@
  */
 #include "Events/EventSystem.h"
 
-#include "Common/Queue.h"
+#include "Common/MPSCQueue.h"
 #include "Events/EventDispatcher.h"
 
+#include <atomic_queue/atomic_queue.h>
+
 #include <unordered_map>
 
 namespace std
@@ -52,6 +54,7 @@ public:
 
     EventDispatcher& GetDispatcher(const EventId& Id);
 
+    Event* AllocateEvent(const EventId& Id);
     void EnqueueEvent(const Event* InEvent);
 
     void RegisterListener(const EventId& Id, EventListener* InListener);
@@ -60,7 +63,15 @@ public:
     void ProcessEvents();
 
 private:
-    csp::Queue<const Event*> EventQueue;
+    void ReleaseEvent(const Event* InEvent);
+
+    static constexpr unsigned EventQueueCapacity = 4096;
+    static constexpr unsigned EventPoolCapacity = 256;
+
+    MPSCQueue<const Event*> EventQueue;
+
+    // Processed events are kept here for reuse, as events are allocated from many threads but always released on the thread processing them
+    atomic_queue::AtomicQueueB2<Event*> EventPool;
 
     // Define eastl map using above defined hasher and our custom allocator
     using DispatcherMap = std::unordered_map<EventId, EventDispatcher, std::hash<EventId>, std::equal_to<EventId>>;
@@ -68,9 +79,28 @@ private:
     DispatcherMap Dispatchers;
 };
 
-EventSystemImpl::EventSystemImpl() { }
+EventSystemImpl::EventSystemImpl()
+    : EventQueue(EventQueueCapacity)
+    , EventPool(EventPoolCapacity)
+{
+}
 
-EventSystemImpl::~EventSystemImpl() { }
+EventSystemImpl::~EventSystemImpl()
+{
+    const Event* QueuedEvent = nullptr;
+
+    while (EventQueue.TryDequeue(QueuedEvent))
+    {
+        delete (QueuedEvent);
+    }
+
+    Event* PooledEvent = nullptr;
+
+    while (EventPool.try_pop(PooledEvent))
+    {
+        delete (PooledEvent);
+    }
+}
 
 EventDispatcher& EventSystemImpl::GetDispatcher(const EventId& Id)
 {
@@ -88,6 +118,29 @@ EventDispatcher& EventSystemImpl::GetDispatcher(const EventId& Id)
     }
 }
 
+Event* EventSystemImpl::AllocateEvent(const EventId& Id)
+{
+    Event* PooledEvent = nullptr;
+
+    if (EventPool.try_pop(PooledEvent))
+    {
+        PooledEvent->Reset(Id);
+        return PooledEvent;
+    }
+
+    return new Event(Id);
+}
+
+void EventSystemImpl::ReleaseEvent(const Event* InEvent)
+{
+    Event* ReleasedEvent = const_cast<Event*>(InEvent);
+
+    if (!EventPool.try_push(ReleasedEvent))
+    {
+        delete (ReleasedEvent);
+    }
+}
+
 void EventSystemImpl::EnqueueEvent(const Event* InEvent) { EventQueue.Enqueue(InEvent); }
 
 void EventSystemImpl::RegisterListener(const EventId& Id, EventListener* InListener)
@@ -106,15 +159,14 @@ void EventSystemImpl::UnRegisterAllListeners() { Dispatchers.clear(); }
 
 void EventSystemImpl::ProcessEvents()
 {
-    while (EventQueue.IsEmpty() == false)
-    {
-        auto QueuedItem = EventQueue.Dequeue();
+    const Event* QueuedEvent = nullptr;
 
-        const Event* QueuedEvent = QueuedItem.value();
+    while (EventQueue.TryDequeue(QueuedEvent))
+    {
         const EventId& Id = QueuedEvent->GetId();
         GetDispatcher(Id).Dispatch(*QueuedEvent);
 
-        delete (QueuedEvent);
+        ReleaseEvent(QueuedEvent);
     }
 }
 
@@ -133,7 +185,15 @@ EventSystem::EventSystem()
 
 EventSystem::~EventSystem() { delete (Impl); }
 
-Event* EventSystem::AllocateEvent(const EventId& Id) { return new Event(Id); }
+Event* EventSystem::AllocateEvent(const EventId& Id)
+{
+    if (Impl)
+    {
+        return Impl->AllocateEvent(Id);
+    }
+
+    return new Event(Id);
+}
 
 void EventSystem::EnqueueEvent(const Event* InEvent)
 {
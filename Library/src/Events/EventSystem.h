@@ -30,8 +30,8 @@ public:
 
     static EventSystem& Get();
 
-    /// @brief Create a new event instance
-    /// @note The event will be deleted after it has been processed in ProcessEvents
+    /// @brief Create a new event instance, reusing a previously processed event where possible
+    /// @note This call is thread safe. The event is owned by the event system, and is recycled after it has been processed in ProcessEvents
     Event* AllocateEvent(const EventId& Id);
 
     /// @brief Enqueue an event to be sent later
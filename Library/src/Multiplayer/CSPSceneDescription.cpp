@@ -15,39 +15,77 @@
  */
 
 #include "CSP/Multiplayer/CSPSceneDescription.h"
+#include "CSP/Common/Systems/Log/LogSystem.h"
+#include "Multiplayer/MCS/MCSSceneCheckpoint.h"
 #include "Multiplayer/MCS/MCSSceneDescription.h"
 #include "Multiplayer/MCS/MCSTypes.h"
 #include "Multiplayer/SpaceEntityStatePatcher.h"
-#include "Json/JsonSerializer.h"
-#include <numeric>
+
+#include <fmt/format.h>
+#include <vector>
 
 namespace csp::multiplayer
 {
 CSPSceneDescription::CSPSceneDescription(const csp::common::List<csp::common::String>& SceneDescriptionJson)
-
-{
-    // Unpack the list into a single JSON string.
     // The reason this JSON is packed into a list _at all_ is merely a wrapper generator workaround,
     // csp::common::Strings cannot be passed as heap objects, and these SceneDescriptions can be large
-    // enough to blow the stack
-    this->SceneDescriptionJson = std::accumulate(SceneDescriptionJson.begin(), SceneDescriptionJson.end(), csp::common::String {});
+    // enough to blow the stack.
+    // The list is kept as it is, rather than joined, as the reader parses across the elements.
+    : SceneDescriptionJson { SceneDescriptionJson }
+{
 }
 
+CSPSceneDescription::CSPSceneDescription(const void* CheckpointData, size_t CheckpointDataLength)
+    : CheckpointData(static_cast<const char*>(CheckpointData), static_cast<const char*>(CheckpointData) + CheckpointDataLength)
+{
+}
+
+CSPSceneDescription::CSPSceneDescription(std::vector<char>&& CheckpointData)
+    : CheckpointData { std::move(CheckpointData) }
+{
+}
+
+bool CSPSceneDescription::IsCheckpoint() const { return CheckpointData.empty() == false; }
+
+const void* CSPSceneDescription::GetCheckpointData() const { return IsCheckpoint() ? CheckpointData.data() : nullptr; }
+
+size_t CSPSceneDescription::GetCheckpointDataLength() const { return CheckpointData.size(); }
+
 csp::common::Array<csp::multiplayer::SpaceEntity*> CSPSceneDescription::CreateEntities(
     csp::common::IRealtimeEngine& RealtimeEngine, csp::common::LogSystem& LogSystem, csp::common::IJSScriptRunner& RemoteScriptRunner) const
 {
-    mcs::SceneDescription SceneDescription;
-    csp::json::JsonDeserializer::Deserialize(SceneDescriptionJson.c_str(), SceneDescription);
+    // A default constructed description has no data, which just means an empty scene.
+    if (SceneDescriptionJson.Size() == 0 && IsCheckpoint() == false)
+    {
+        return {};
+    }
 
-    csp::common::Array<csp::multiplayer::SpaceEntity*> Entities { SceneDescription.Objects.size() };
+    std::vector<csp::multiplayer::SpaceEntity*> CreatedEntities;
 
-    size_t ObjectsIndex = 0;
-    for (const auto& Object : SceneDescription.Objects)
+    // Create each entity as soon as its object has been read, so that the parsed objects are never all held at once.
+    const auto OnObjectRead = [&](mcs::ObjectMessage&& Object)
     {
         auto Entity = SpaceEntityStatePatcher::NewFromObjectMessage(Object, RealtimeEngine, RemoteScriptRunner, LogSystem);
+        CreatedEntities.push_back(Entity.release());
+    };
+
+    csp::common::String Error;
+
+    const bool Succeeded = IsCheckpoint() ? mcs::SceneCheckpoint::Read(CheckpointData.data(), CheckpointData.size(), OnObjectRead, Error)
+                                          : mcs::SceneDescriptionReader::Read(SceneDescriptionJson, OnObjectRead, Error);
 
-        Entities[ObjectsIndex] = Entity.release();
-        ObjectsIndex++;
+    if (!Succeeded)
+    {
+        LogSystem.LogMsg(csp::common::LogLevel::Error,
+            fmt::format("Failed to parse SceneDescription: {}. {} entities were read before the error.", Error.c_str(), CreatedEntities.size())
+                .c_str());
+    }
+
+    csp::common::Array<csp::multiplayer::SpaceEntity*> Entities { CreatedEntities.size() };
+
+    for (size_t i = 0; i < CreatedEntities.size(); ++i)
+    {
+        Entities[i] = CreatedEntities[i];
     }
 
     return Entities;
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Multiplayer/CompactTransform.h"
+
+#include "Multiplayer/MCSComponentPacker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <variant>
+
+namespace csp::multiplayer::CompactTransform
+{
+
+namespace
+{
+    constexpr int POSITION_AXIS_BITS = 20;
+    constexpr int POSITION_EXPONENT_BITS = 3;
+    constexpr int64_t POSITION_AXIS_MAX = (1 << (POSITION_AXIS_BITS - 1)) - 1;
+    constexpr uint64_t POSITION_AXIS_MASK = (1ull << POSITION_AXIS_BITS) - 1;
+    constexpr int POSITION_MAX_EXPONENT = (1 << POSITION_EXPONENT_BITS) - 1;
+    constexpr double POSITION_BASE_STEP = 0.001;
+
+    constexpr int ROTATION_COMPONENT_BITS = 20;
+    constexpr uint64_t ROTATION_COMPONENT_MASK = (1ull << ROTATION_COMPONENT_BITS) - 1;
+    // The three smallest components of a unit quaternion are all within this range
+    constexpr double ROTATION_COMPONENT_RANGE = 0.70710678118654752440;
+
+    double PositionStep(int Exponent) { return POSITION_BASE_STEP * static_cast<double>(1 << Exponent); }
+}
+
+bool TryEncodePosition(const csp::common::Vector3& Position, uint64_t& OutEncoded)
+{
+    const double Axes[3] = { Position.X, Position.Y, Position.Z };
+
+    double Largest = 0.0;
+
+    for (const double Axis : Axes)
+    {
+        if (!std::isfinite(Axis))
+        {
+            return false;
+        }
+
+        Largest = std::max(Largest, std::abs(Axis));
+    }
+
+    for (int Exponent = 0; Exponent <= POSITION_MAX_EXPONENT; ++Exponent)
+    {
+        const double Step = PositionStep(Exponent);
+
+        if (std::llround(Largest / Step) > POSITION_AXIS_MAX)
+        {
+            continue;
+        }
+
+        uint64_t Encoded = static_cast<uint64_t>(Exponent) << (3 * POSITION_AXIS_BITS);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            const int64_t Quantized = std::llround(Axes[i] / Step) + POSITION_AXIS_MAX;
+            Encoded |= static_cast<uint64_t>(Quantized) << (i * POSITION_AXIS_BITS);
+        }
+
+        OutEncoded = Encoded;
+        return true;
+    }
+
+    return false;
+}
+
+csp::common::Vector3 DecodePosition(uint64_t Encoded)
+{
+    const double Step = PositionStep(static_cast<int>(Encoded >> (3 * POSITION_AXIS_BITS)) & POSITION_MAX_EXPONENT);
+
+    float Axes[3];
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const int64_t Quantized = static_cast<int64_t>((Encoded >> (i * POSITION_AXIS_BITS)) & POSITION_AXIS_MASK) - POSITION_AXIS_MAX;
+        Axes[i] = static_cast<float>(static_cast<double>(Quantized) * Step);
+    }
+
+    return csp::common::Vector3 { Axes[0], Axes[1], Axes[2] };
+}
+
+bool TryEncodeRotation(const csp::common::Vector4& Rotation, uint64_t& OutEncoded)
+{
+    double Components[4] = { Rotation.X, Rotation.Y, Rotation.Z, Rotation.W };
+
+    const double Length = std::sqrt(
+        Components[0] * Components[0] + Components[1] * Components[1] + Components[2] * Components[2] + Components[3] * Components[3]);
+
+    if (!std::isfinite(Length) || Length < 1e-6)
+    {
+        return false;
+    }
+
+    size_t LargestIndex = 0;
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        Components[i] /= Length;
+
+        if (std::abs(Components[i]) > std::abs(Components[LargestIndex]))
+        {
+            LargestIndex = i;
+        }
+    }
+
+    // q and -q are the same rotation, so flip the quaternion to make the dropped component positive, and its sign implied
+    const double Sign = Components[LargestIndex] < 0.0 ? -1.0 : 1.0;
+
+    uint64_t Encoded = LargestIndex;
+    int Shift = 2;
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        if (i == LargestIndex)
+        {
+            continue;
+        }
+
+        const double Normalised = (Components[i] * Sign + ROTATION_COMPONENT_RANGE) / (2.0 * ROTATION_COMPONENT_RANGE);
+        const int64_t Quantized = std::llround(std::clamp(Normalised, 0.0, 1.0) * ROTATION_COMPONENT_MASK);
+
+        Encoded |= static_cast<uint64_t>(Quantized) << Shift;
+        Shift += ROTATION_COMPONENT_BITS;
+    }
+
+    OutEncoded = Encoded;
+    return true;
+}
+
+csp::common::Vector4 DecodeRotation(uint64_t Encoded)
+{
+    const size_t LargestIndex = Encoded & 0x3;
+
+    double Components[4];
+    double SumOfSquares = 0.0;
+    int Shift = 2;
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+        if (i == LargestIndex)
+        {
+            continue;
+        }
+
+        const double Normalised = static_cast<double>((Encoded >> Shift) & ROTATION_COMPONENT_MASK) / ROTATION_COMPONENT_MASK;
+        Components[i] = Normalised * 2.0 * ROTATION_COMPONENT_RANGE - ROTATION_COMPONENT_RANGE;
+        SumOfSquares += Components[i] * Components[i];
+        Shift += ROTATION_COMPONENT_BITS;
+    }
+
+    Components[LargestIndex] = std::sqrt(std::max(0.0, 1.0 - SumOfSquares));
+
+    return csp::common::Vector4 { static_cast<float>(Components[0]), static_cast<float>(Components[1]), static_cast<float>(Components[2]),
+        static_cast<float>(Components[3]) };
+}
+
+void WriteValue(MCSComponentPacker& Packer, SpaceEntityComponentKey Key, const csp::common::ReplicatedValue& Value)
+{
+    uint64_t Encoded = 0;
+
+    switch (Key)
+    {
+    case SpaceEntityComponentKey::Position:
+        if (TryEncodePosition(Value.GetVector3(), Encoded))
+        {
+            Packer.WriteValue(Key, Encoded);
+            return;
+        }
+        break;
+
+    case SpaceEntityComponentKey::Rotation:
+        if (TryEncodeRotation(Value.GetVector4(), Encoded))
+        {
+            Packer.WriteValue(Key, Encoded);
+            return;
+        }
+        break;
+
+    case SpaceEntityComponentKey::Scale:
+    {
+        const csp::common::Vector3& Scale = Value.GetVector3();
+
+        if (Scale.X == Scale.Y && Scale.X == Scale.Z)
+        {
+            Packer.WriteValue(Key, Scale.X);
+            return;
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+
+    Packer.WriteValue(Key, Value);
+}
+
+bool TryReadValue(uint16_t Key, const mcs::ItemComponentData& ComponentData, csp::common::ReplicatedValue& OutValue)
+{
+    const mcs::ItemComponentDataVariant& Data = ComponentData.GetValue();
+
+    switch (static_cast<SpaceEntityComponentKey>(Key))
+    {
+    case SpaceEntityComponentKey::Position:
+        if (const uint64_t* Encoded = std::get_if<uint64_t>(&Data))
+        {
+            OutValue = csp::common::ReplicatedValue { DecodePosition(*Encoded) };
+            return true;
+        }
+        break;
+
+    case SpaceEntityComponentKey::Rotation:
+        if (const uint64_t* Encoded = std::get_if<uint64_t>(&Data))
+        {
+            OutValue = csp::common::ReplicatedValue { DecodeRotation(*Encoded) };
+            return true;
+        }
+        break;
+
+    case SpaceEntityComponentKey::Scale:
+        if (const float* UniformScale = std::get_if<float>(&Data))
+        {
+            OutValue = csp::common::ReplicatedValue { csp::common::Vector3 { *UniformScale, *UniformScale, *UniformScale } };
+            return true;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "CSP/Common/ReplicatedValue.h"
+#include "CSP/Common/Vector.h"
+#include "MCS/MCSTypes.h"
+#include "Multiplayer/SpaceEntityKeys.h"
+
+#include <cstdint>
+
+namespace csp::multiplayer
+{
+class MCSComponentPacker;
+}
+
+/*
+    A compact, lossy encoding of the transform entity properties, used for patches that only move an entity.
+
+    The values are written under the usual Position, Rotation and Scale keys, but with a different MCS type, so the server stores them
+    like any other value and the latest write always wins. Decoding picks the format from the type, so both formats can be read at any time.
+    As clients that predate the encoding can't read it, it is only used for entities that aren't persistent, so that it never reaches stored
+    space state, and only while every client in the space has announced that it can decode it with SUPPORT_MESSAGE.
+
+    - Position : uint64. Three 20-bit axes, quantized relative to the space origin, plus a 3-bit exponent in the top bits.
+                 The step between values is 1mm << exponent, and the smallest exponent that fits the position is used, so positions
+                 within 524m of the origin are exact to 0.5mm, and the coarsest step of 128mm reaches 67km.
+    - Rotation : uint64. Smallest-three quaternion compression. The largest component is dropped and rebuilt from the unit length,
+                 the 2-bit index of it is stored, and the other three are stored in 20 bits each.
+    - Scale    : float, when the scale is uniform. Non-uniform scales are written as floats as usual.
+*/
+namespace csp::multiplayer::CompactTransform
+{
+
+/// @brief Network event that clients which can decode the encoding send when they enter a space, and in reply to the same event from a client
+/// that enters later. Its values are the encoding version, and whether it is a reply.
+constexpr const char* SUPPORT_MESSAGE = "CompactTransformSupportMessage";
+constexpr int64_t ENCODING_VERSION = 1;
+
+/// @brief Quantizes a position. Returns false if it is outside the range of the encoding, or not finite.
+bool TryEncodePosition(const csp::common::Vector3& Position, uint64_t& OutEncoded);
+csp::common::Vector3 DecodePosition(uint64_t Encoded);
+
+/// @brief Compresses a rotation quaternion. Returns false if it is too close to zero length to be normalised, or not finite.
+bool TryEncodeRotation(const csp::common::Vector4& Rotation, uint64_t& OutEncoded);
+csp::common::Vector4 DecodeRotation(uint64_t Encoded);
+
+/// @brief Writes a transform property using the compact encoding where the value allows it, and the usual encoding otherwise.
+void WriteValue(MCSComponentPacker& Packer, SpaceEntityComponentKey Key, const csp::common::ReplicatedValue& Value);
+
+/// @brief Decodes a transform property if it was written with the compact encoding.
+/// @return False if the key isn't a transform property, or the value uses the usual encoding.
+bool TryReadValue(uint16_t Key, const mcs::ItemComponentData& ComponentData, csp::common::ReplicatedValue& OutValue);
+
+}
@@ -254,6 +254,10 @@ void ComponentBase::SetProperty(uint32_t Key, const csp::common::ReplicatedValue
         // Note how `UpdateComponent` dosen't actually set the data, just does notification in this case. :(
         // TODO, fix. Look at `SetPropertyFromPatch` below, it's basically a `SetPropetyDirect`
         Properties[Key] = Value;
+
+        // Record the change so that only the properties that actually changed are replicated
+        DirtyProperties[Key] = Value;
+
         Parent->UpdateComponent(this);
 
         // Hack alert
@@ -268,6 +272,12 @@ void ComponentBase::RemoveProperty(uint32_t Key)
 {
     // Weird that this is instant and dosen't go through the regular lock/patch flow
     Properties.Remove(Key);
+
+    if (DirtyProperties.HasKey(Key))
+    {
+        DirtyProperties.Remove(Key);
+    }
+
     Parent->UpdateComponent(this);
 }
 
@@ -283,6 +293,10 @@ SpaceEntity* ComponentBase::GetParent() { return Parent; }
 
 void ComponentBase::OnLocalDelete() { }
 
+const csp::common::Map<uint32_t, csp::common::ReplicatedValue>& ComponentBase::GetDirtyProperties() const { return DirtyProperties; }
+
+void ComponentBase::ClearDirtyProperties() { DirtyProperties.Clear(); }
+
 void ComponentBase::SetScriptInterface(ComponentScriptInterface* InScriptInterface) { ScriptInterface = InScriptInterface; }
 
 ComponentScriptInterface* ComponentBase::GetScriptInterface() { return ScriptInterface; }
@@ -68,17 +68,14 @@ void StaticModelSpaceComponent::SetExternalResourceAssetCollectionId(const csp::
 csp::common::Map<csp::common::String, csp::common::String> StaticModelSpaceComponent::GetMaterialOverrides() const
 {
     // Convert replicated values map to string values
-    common::Map<common::String, common::ReplicatedValue> ReplicatedOverrides
+    const common::Map<common::String, common::ReplicatedValue>& ReplicatedOverrides
         = GetStringMapProperty(static_cast<uint32_t>(StaticModelPropertyKeys::MaterialOverrides));
 
     csp::common::Map<csp::common::String, csp::common::String> Overrides;
 
-    std::unique_ptr<common::Array<common::String>> Keys(const_cast<common::Array<common::String>*>(ReplicatedOverrides.Keys()));
-
-    for (size_t i = 0; i < Keys->Size(); ++i)
+    for (const auto& [ModelPath, MaterialId] : ReplicatedOverrides)
     {
-        const auto& CurrentKey = (*Keys)[i];
-        Overrides[CurrentKey] = ReplicatedOverrides[CurrentKey].GetString();
+        Overrides[ModelPath] = MaterialId.GetString();
     }
 
     return Overrides;
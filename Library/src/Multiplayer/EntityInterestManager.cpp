@@ -0,0 +1,188 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Multiplayer/EntityInterestManager.h"
+
+#include "CSP/Common/ReplicatedValue.h"
+#include "CSP/Multiplayer/SpaceEntity.h"
+#include "Multiplayer/IncomingPatchCoalescer.h"
+#include "Multiplayer/MCSComponentPacker.h"
+#include "Multiplayer/SpaceEntityKeys.h"
+#include "Multiplayer/SpaceEntitySpatialIndex.h"
+
+namespace csp::multiplayer
+{
+
+void EntityInterestManager::SetRadius(float InRadius) { Radius = InRadius; }
+
+float EntityInterestManager::GetRadius() const { return Radius; }
+
+void EntityInterestManager::SetCatchUpInterval(std::chrono::milliseconds Interval) { CatchUpInterval = Interval; }
+
+void EntityInterestManager::Update(const SpaceEntitySpatialIndex& SpatialIndex, const SpaceEntity* Centre,
+    std::chrono::system_clock::time_point Now, std::vector<mcs::ObjectPatch>& OutDuePatches)
+{
+    Active = Radius > 0.0f && Centre != nullptr;
+    CurrentTime = Now;
+    InRangeEntities.clear();
+
+    if (Active)
+    {
+        if (!SpatialIndex.TryGetPosition(Centre, CentrePosition))
+        {
+            CentrePosition = Centre->GetGlobalPosition();
+        }
+
+        QueryResults.clear();
+        SpatialIndex.QueryRadius(CentrePosition, Radius, QueryResults);
+        InRangeEntities.insert(QueryResults.begin(), QueryResults.end());
+    }
+
+    for (auto It = HeldPatches.begin(); It != HeldPatches.end();)
+    {
+        if (IsInRange(It->second.Entity) || Now - It->second.HeldSince >= CatchUpInterval)
+        {
+            OutDuePatches.push_back(std::move(It->second.Patch));
+            ++Metrics.CaughtUpPatches;
+            It = HeldPatches.erase(It);
+        }
+        else
+        {
+            ++It;
+        }
+    }
+}
+
+bool EntityInterestManager::IsInRange(const SpaceEntity* Entity) const { return !Active || InRangeEntities.count(Entity) != 0; }
+
+bool EntityInterestManager::TryDefer(const SpaceEntity& Entity, mcs::ObjectPatch& Patch)
+{
+    if (IsInRange(&Entity) || Patch.GetDestroy() || Patch.GetShouldUpdateParent() || MovesIntoRange(Entity, Patch))
+    {
+        return false;
+    }
+
+    const auto It = HeldPatches.find(Patch.GetId());
+
+    if (It == HeldPatches.end())
+    {
+        const uint64_t EntityId = Patch.GetId();
+        HeldPatches.emplace(EntityId, HeldPatch { std::move(Patch), &Entity, CurrentTime });
+    }
+    else if (!IncomingPatchCoalescer::TryMerge(It->second.Patch, Patch))
+    {
+        return false;
+    }
+
+    ++Metrics.DeferredPatches;
+
+    return true;
+}
+
+bool EntityInterestManager::TakeHeldPatch(uint64_t EntityId, mcs::ObjectPatch& OutPatch)
+{
+    const auto It = HeldPatches.find(EntityId);
+
+    if (It == HeldPatches.end())
+    {
+        return false;
+    }
+
+    OutPatch = std::move(It->second.Patch);
+    HeldPatches.erase(It);
+    ++Metrics.CaughtUpPatches;
+
+    return true;
+}
+
+std::optional<std::chrono::system_clock::duration> EntityInterestManager::GetScriptTickDelta(
+    const SpaceEntity* Entity, std::chrono::system_clock::time_point LastTickTime, std::chrono::system_clock::time_point Now)
+{
+    const auto It = LastScriptTicks.find(Entity);
+
+    if (IsInRange(Entity))
+    {
+        if (It == LastScriptTicks.end())
+        {
+            return Now - LastTickTime;
+        }
+
+        const auto Delta = Now - It->second;
+        LastScriptTicks.erase(It);
+
+        return Delta;
+    }
+
+    if (It == LastScriptTicks.end())
+    {
+        LastScriptTicks.emplace(Entity, LastTickTime);
+        ++Metrics.SkippedScriptTicks;
+
+        return std::nullopt;
+    }
+
+    if (Now - It->second < CatchUpInterval)
+    {
+        ++Metrics.SkippedScriptTicks;
+
+        return std::nullopt;
+    }
+
+    const auto Delta = Now - It->second;
+    It->second = Now;
+
+    return Delta;
+}
+
+void EntityInterestManager::RemoveEntity(const SpaceEntity* Entity)
+{
+    HeldPatches.erase(Entity->GetId());
+    LastScriptTicks.erase(Entity);
+    InRangeEntities.erase(Entity);
+}
+
+void EntityInterestManager::Clear()
+{
+    HeldPatches.clear();
+    LastScriptTicks.clear();
+    InRangeEntities.clear();
+}
+
+const InterestManagementMetrics& EntityInterestManager::GetMetrics() const { return Metrics; }
+
+bool EntityInterestManager::MovesIntoRange(const SpaceEntity& Entity, const mcs::ObjectPatch& Patch) const
+{
+    // The position of a child is relative to its parent, so only root entities can be checked without applying the patch.
+    if (Entity.GetParentEntity() != nullptr || !Patch.GetComponents().has_value())
+    {
+        return false;
+    }
+
+    csp::common::ReplicatedValue Position;
+    MCSComponentUnpacker Unpacker { *Patch.GetComponents() };
+
+    if (!Unpacker.TryReadValue(static_cast<uint16_t>(SpaceEntityComponentKey::Position), Position)
+        || Position.GetReplicatedValueType() != csp::common::ReplicatedValueType::Vector3)
+    {
+        return false;
+    }
+
+    const csp::common::Vector3 Offset = Position.GetVector3() - CentrePosition;
+
+    return Offset.X * Offset.X + Offset.Y * Offset.Y + Offset.Z * Offset.Z <= Radius * Radius;
+}
+
+}
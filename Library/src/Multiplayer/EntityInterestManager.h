@@ -0,0 +1,107 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "CSP/Common/Vector.h"
+#include "CSP/Multiplayer/OnlineRealtimeEngine.h"
+#include "Multiplayer/MCS/MCSTypes.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace csp::multiplayer
+{
+class SpaceEntity;
+class SpaceEntitySpatialIndex;
+
+/// @brief Decides how often each entity is updated from other clients, based on its distance from the local avatar.
+/// @details Entities within the interest radius are updated every tick. Patches for entities outside it are held back, merged into one
+/// patch per entity, and applied once the catch-up interval has passed since the first of them arrived, or as soon as the entity comes
+/// back into range. Script ticks for out-of-range entities are skipped in the same way, and the tick they do get carries the full time
+/// since their last one, so scripts that integrate over time still catch up.
+/// Destroy and parent changes are never held back, as other entities may depend on them. Neither is a patch that moves a root entity
+/// into range, so entities appear as they arrive rather than at the next catch-up.
+/// Interest management is disabled while the radius is 0, or when there is no local avatar to measure from.
+class EntityInterestManager
+{
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_CATCH_UP_INTERVAL { 1000 };
+
+    void SetRadius(float Radius);
+    float GetRadius() const;
+
+    void SetCatchUpInterval(std::chrono::milliseconds Interval);
+
+    /// @brief Works out which entities are in range of Centre this tick, and collects the held patches that are now due into OutDuePatches.
+    /// @param Centre const SpaceEntity* : The local avatar, or null if there isn't one.
+    void Update(const SpaceEntitySpatialIndex& SpatialIndex, const SpaceEntity* Centre, std::chrono::system_clock::time_point Now,
+        std::vector<mcs::ObjectPatch>& OutDuePatches);
+
+    /// @brief Whether the entity was within range at the last Update. Always true while interest management is inactive.
+    bool IsInRange(const SpaceEntity* Entity) const;
+
+    /// @brief Holds the patch back if its entity is out of range, merging it into any patch already held for the entity.
+    /// @return False if the patch should be applied now. Any patch already held for the entity must be applied before it.
+    bool TryDefer(const SpaceEntity& Entity, mcs::ObjectPatch& Patch);
+
+    /// @brief Moves the patch held for the entity into OutPatch.
+    /// @return False if no patch is held for the entity.
+    bool TakeHeldPatch(uint64_t EntityId, mcs::ObjectPatch& OutPatch);
+
+    /// @brief Returns the time to tick the entity's script by, or nothing if its tick should be skipped this frame.
+    /// @param LastTickTime : When scripts were last ticked, which is used for entities that were ticked last frame.
+    std::optional<std::chrono::system_clock::duration> GetScriptTickDelta(
+        const SpaceEntity* Entity, std::chrono::system_clock::time_point LastTickTime, std::chrono::system_clock::time_point Now);
+
+    void RemoveEntity(const SpaceEntity* Entity);
+    void Clear();
+
+    const InterestManagementMetrics& GetMetrics() const;
+
+private:
+    struct HeldPatch
+    {
+        mcs::ObjectPatch Patch;
+        const SpaceEntity* Entity;
+        std::chrono::system_clock::time_point HeldSince;
+    };
+
+    bool MovesIntoRange(const SpaceEntity& Entity, const mcs::ObjectPatch& Patch) const;
+
+    float Radius = 0.0f;
+    std::chrono::milliseconds CatchUpInterval = DEFAULT_CATCH_UP_INTERVAL;
+
+    // Set by Update.
+    bool Active = false;
+    csp::common::Vector3 CentrePosition;
+    std::chrono::system_clock::time_point CurrentTime;
+    std::unordered_set<const SpaceEntity*> InRangeEntities;
+
+    std::unordered_map<uint64_t, HeldPatch> HeldPatches;
+    // When each out-of-range entity with a skipped script tick was last ticked.
+    std::unordered_map<const SpaceEntity*, std::chrono::system_clock::time_point> LastScriptTicks;
+
+    // Reused by Update.
+    std::vector<SpaceEntity*> QueryResults;
+
+    InterestManagementMetrics Metrics;
+};
+
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Multiplayer/IncomingPatchCoalescer.h"
+
+#include "Multiplayer/SpaceEntityKeys.h"
+
+#include <variant>
+
+namespace csp::multiplayer
+{
+
+namespace
+{
+    const mcs::ItemComponentData* FindComponentType(const mcs::ItemComponentData& Component)
+    {
+        const auto* ComponentProperties = std::get_if<mcs::ComponentMap>(&Component.GetValue());
+
+        if (ComponentProperties == nullptr)
+        {
+            return nullptr;
+        }
+
+        auto It = ComponentProperties->find(COMPONENT_KEY_COMPONENTTYPE);
+        return It != ComponentProperties->end() ? &It->second : nullptr;
+    }
+
+    bool IsSameComponentType(const mcs::ItemComponentData& Component, const mcs::ItemComponentData& OtherComponent)
+    {
+        const mcs::ItemComponentData* Type = FindComponentType(Component);
+        const mcs::ItemComponentData* OtherType = FindComponentType(OtherComponent);
+
+        return Type != nullptr && OtherType != nullptr && *Type == *OtherType;
+    }
+}
+
+void IncomingPatchCoalescer::Add(mcs::ObjectPatch&& Patch)
+{
+    const uint64_t Id = Patch.GetId();
+
+    if (Patch.GetDestroy())
+    {
+        OpenPatches.erase(Id);
+        Patches.push_back(std::move(Patch));
+        return;
+    }
+
+    auto OpenIt = OpenPatches.find(Id);
+
+    if (OpenIt != OpenPatches.end() && TryMerge(Patches[OpenIt->second], Patch))
+    {
+        ++CoalescedCount;
+        return;
+    }
+
+    OpenPatches[Id] = Patches.size();
+    Patches.push_back(std::move(Patch));
+}
+
+std::vector<mcs::ObjectPatch>& IncomingPatchCoalescer::GetPatches() { return Patches; }
+
+void IncomingPatchCoalescer::Clear()
+{
+    Patches.clear();
+    OpenPatches.clear();
+    CoalescedCount = 0;
+}
+
+uint64_t IncomingPatchCoalescer::GetCoalescedCount() const { return CoalescedCount; }
+
+bool IncomingPatchCoalescer::TryMerge(mcs::ObjectPatch& Into, mcs::ObjectPatch& Newer)
+{
+    if (Newer.Components.has_value() && Into.Components.has_value())
+    {
+        for (const auto& NewerPair : *Newer.Components)
+        {
+            if (NewerPair.first >= COMPONENT_KEY_END_COMPONENTS)
+            {
+                continue;
+            }
+
+            auto IntoIt = Into.Components->find(NewerPair.first);
+
+            if (IntoIt != Into.Components->end() && !IsSameComponentType(IntoIt->second, NewerPair.second))
+            {
+                return false;
+            }
+        }
+    }
+
+    Into.OwnerId = Newer.OwnerId;
+    Into.ParentId = Newer.ParentId;
+    Into.ShouldUpdateParent = Into.ShouldUpdateParent || Newer.ShouldUpdateParent;
+
+    if (!Newer.Components.has_value())
+    {
+        return true;
+    }
+
+    if (!Into.Components.has_value())
+    {
+        Into.Components = std::move(Newer.Components);
+        return true;
+    }
+
+    for (auto& NewerPair : *Newer.Components)
+    {
+        auto [IntoIt, Inserted] = Into.Components->try_emplace(NewerPair.first, std::move(NewerPair.second));
+
+        if (Inserted)
+        {
+            continue;
+        }
+
+        if (NewerPair.first >= COMPONENT_KEY_END_COMPONENTS)
+        {
+            // Entity properties are replaced outright
+            IntoIt->second = std::move(NewerPair.second);
+            continue;
+        }
+
+        // Components of the same type only carry the properties that changed, so the newer properties are layered over the earlier ones
+        auto& IntoProperties = std::get<mcs::ComponentMap>(IntoIt->second.GetMutableValue());
+
+        for (auto& NewerProperty : std::get<mcs::ComponentMap>(NewerPair.second.GetMutableValue()))
+        {
+            IntoProperties.insert_or_assign(NewerProperty.first, std::move(NewerProperty.second));
+        }
+    }
+
+    return true;
+}
+
+} // namespace csp::multiplayer
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "Multiplayer/MCS/MCSTypes.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace csp::multiplayer
+{
+
+/// @brief Merges the patches received for each entity during a tick, so each entity is patched, and its update callback fired, once per tick.
+/// @details Patches are merged into the earlier patch for the same entity, with the newest value winning for each entity property and
+/// component property. The owner and parent are taken from the newest patch, and a parent update is kept if any patch carried one.
+/// A patch that changes the type of a component already in the merged patch, which is how component deletes are sent, cannot be merged
+/// without losing the delete. These start a new patch for the entity instead, so deletes and re-adds are still applied in the order received.
+/// Destroy patches are never merged, and any patches for the entity that arrive after one are kept separate.
+class IncomingPatchCoalescer
+{
+public:
+    /// @brief Adds the next patch, in the order it was received.
+    void Add(mcs::ObjectPatch&& Patch);
+
+    /// @brief The patches to apply, in the order their first patch was received.
+    std::vector<mcs::ObjectPatch>& GetPatches();
+
+    /// @brief Removes all patches, keeping the storage for the next tick.
+    void Clear();
+
+    /// @brief Number of patches that were merged into an earlier patch since the last Clear.
+    uint64_t GetCoalescedCount() const;
+
+    /// @brief Merges Newer into Into, the earlier patch for the same entity, by the rules above.
+    /// @return False, leaving both patches untouched, if Newer cannot be merged into Into.
+    static bool TryMerge(mcs::ObjectPatch& Into, mcs::ObjectPatch& Newer);
+
+private:
+    std::vector<mcs::ObjectPatch> Patches;
+
+    // Index into Patches of the patch that later patches for each entity are merged into
+    std::unordered_map<uint64_t, size_t> OpenPatches;
+
+    uint64_t CoalescedCount = 0;
+};
+
+} // namespace csp::multiplayer
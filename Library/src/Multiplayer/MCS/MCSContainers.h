@@ -0,0 +1,276 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace csp::multiplayer::mcs
+{
+
+/// @brief An ordered map stored as a sorted vector of key-value pairs.
+/// @details Provides the subset of the std::map interface used by the MCS types, so it can be used as a drop-in replacement.
+/// Elements are contiguous, so iteration is cache friendly and the whole map is a single allocation, rather than one per node.
+/// Inserting in ascending key order, which is how MCS and our serializers produce maps, appends without searching.
+/// As with std::vector, inserting or erasing invalidates iterators and references.
+template <typename K, typename V> class FlatMap
+{
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = size_t;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    FlatMap() = default;
+
+    /// @brief Constructs the map from a list of pairs. As with std::map, only the first of any duplicate keys is kept.
+    FlatMap(std::initializer_list<value_type> Values);
+
+    iterator begin() { return Elements.begin(); }
+    iterator end() { return Elements.end(); }
+    const_iterator begin() const { return Elements.begin(); }
+    const_iterator end() const { return Elements.end(); }
+
+    size_type size() const { return Elements.size(); }
+    bool empty() const { return Elements.empty(); }
+    void clear() { Elements.clear(); }
+    void reserve(size_type Capacity) { Elements.reserve(Capacity); }
+
+    iterator find(const K& Key);
+    const_iterator find(const K& Key) const;
+    size_type count(const K& Key) const { return find(Key) != end() ? 1 : 0; }
+
+    /// @brief Gets the value for the given key.
+    /// @throws std::out_of_range if the key is not in the map.
+    V& at(const K& Key);
+    const V& at(const K& Key) const;
+
+    /// @brief Gets the value for the given key, inserting a default constructed value if it is not in the map.
+    V& operator[](const K& Key);
+
+    /// @brief Inserts a value if the key is not already in the map.
+    /// @return An iterator to the element with the given key, and whether the value was inserted.
+    template <typename... Args> std::pair<iterator, bool> try_emplace(const K& Key, Args&&... ValueArgs);
+
+    /// @brief Inserts a value, or replaces the existing value for the given key.
+    template <typename T> std::pair<iterator, bool> insert_or_assign(const K& Key, T&& Value);
+
+    size_type erase(const K& Key);
+    iterator erase(const_iterator Position) { return Elements.erase(Position); }
+
+    bool operator==(const FlatMap& Other) const { return Elements == Other.Elements; }
+    bool operator!=(const FlatMap& Other) const { return Elements != Other.Elements; }
+
+private:
+    iterator LowerBound(const K& Key);
+    const_iterator LowerBound(const K& Key) const;
+
+    std::vector<value_type> Elements;
+};
+
+/// @brief An array of floats that stores up to InlineCapacity elements without allocating.
+/// @details MCS float arrays are almost always 2, 3 or 4 element vectors, such as entity and component transforms.
+/// Holding these inline keeps them inside their ItemComponentData, rather than in a separate allocation.
+/// Larger arrays fall back to heap storage.
+class FloatArray
+{
+public:
+    static constexpr size_t InlineCapacity = 4;
+
+    using value_type = float;
+    using size_type = size_t;
+    using iterator = float*;
+    using const_iterator = const float*;
+
+    FloatArray() = default;
+    FloatArray(std::initializer_list<float> Values);
+    explicit FloatArray(const std::vector<float>& Values);
+    explicit FloatArray(size_type Size);
+
+    float* data() { return Size > InlineCapacity ? HeapValues.data() : InlineValues.data(); }
+    const float* data() const { return Size > InlineCapacity ? HeapValues.data() : InlineValues.data(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + Size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + Size; }
+
+    size_type size() const { return Size; }
+    bool empty() const { return Size == 0; }
+
+    float& operator[](size_type Index) { return data()[Index]; }
+    const float& operator[](size_type Index) const { return data()[Index]; }
+
+    /// @brief Resizes the array, value-initializing any new elements.
+    void resize(size_type NewSize);
+
+    std::vector<float> ToVector() const { return std::vector<float>(begin(), end()); }
+
+    bool operator==(const FloatArray& Other) const { return std::equal(begin(), end(), Other.begin(), Other.end()); }
+    bool operator!=(const FloatArray& Other) const { return !(*this == Other); }
+
+private:
+    size_type Size = 0;
+    std::array<float, InlineCapacity> InlineValues {};
+    std::vector<float> HeapValues;
+};
+
+template <typename K, typename V> FlatMap<K, V>::FlatMap(std::initializer_list<value_type> Values)
+{
+    Elements.reserve(Values.size());
+
+    for (const auto& Value : Values)
+    {
+        try_emplace(Value.first, Value.second);
+    }
+}
+
+template <typename K, typename V> typename FlatMap<K, V>::iterator FlatMap<K, V>::LowerBound(const K& Key)
+{
+    // Maps are usually built in key order, so check the back first to make appending constant time.
+    if (Elements.empty() || Elements.back().first < Key)
+    {
+        return Elements.end();
+    }
+
+    return std::lower_bound(Elements.begin(), Elements.end(), Key, [](const value_type& Element, const K& Value) { return Element.first < Value; });
+}
+
+template <typename K, typename V> typename FlatMap<K, V>::const_iterator FlatMap<K, V>::LowerBound(const K& Key) const
+{
+    return const_cast<FlatMap*>(this)->LowerBound(Key);
+}
+
+template <typename K, typename V> typename FlatMap<K, V>::iterator FlatMap<K, V>::find(const K& Key)
+{
+    auto It = LowerBound(Key);
+    return (It != Elements.end() && !(Key < It->first)) ? It : Elements.end();
+}
+
+template <typename K, typename V> typename FlatMap<K, V>::const_iterator FlatMap<K, V>::find(const K& Key) const
+{
+    auto It = LowerBound(Key);
+    return (It != Elements.end() && !(Key < It->first)) ? It : Elements.end();
+}
+
+template <typename K, typename V> V& FlatMap<K, V>::at(const K& Key)
+{
+    auto It = find(Key);
+
+    if (It == Elements.end())
+    {
+        throw std::out_of_range("FlatMap::at: Key not found");
+    }
+
+    return It->second;
+}
+
+template <typename K, typename V> const V& FlatMap<K, V>::at(const K& Key) const { return const_cast<FlatMap*>(this)->at(Key); }
+
+template <typename K, typename V> V& FlatMap<K, V>::operator[](const K& Key) { return try_emplace(Key).first->second; }
+
+template <typename K, typename V>
+template <typename... Args>
+std::pair<typename FlatMap<K, V>::iterator, bool> FlatMap<K, V>::try_emplace(const K& Key, Args&&... ValueArgs)
+{
+    auto It = LowerBound(Key);
+
+    if (It != Elements.end() && !(Key < It->first))
+    {
+        return { It, false };
+    }
+
+    It = Elements.emplace(It, std::piecewise_construct, std::forward_as_tuple(Key), std::forward_as_tuple(std::forward<Args>(ValueArgs)...));
+    return { It, true };
+}
+
+template <typename K, typename V>
+template <typename T>
+std::pair<typename FlatMap<K, V>::iterator, bool> FlatMap<K, V>::insert_or_assign(const K& Key, T&& Value)
+{
+    auto Result = try_emplace(Key, std::forward<T>(Value));
+
+    if (Result.second == false)
+    {
+        Result.first->second = std::forward<T>(Value);
+    }
+
+    return Result;
+}
+
+template <typename K, typename V> typename FlatMap<K, V>::size_type FlatMap<K, V>::erase(const K& Key)
+{
+    auto It = find(Key);
+
+    if (It == Elements.end())
+    {
+        return 0;
+    }
+
+    Elements.erase(It);
+    return 1;
+}
+
+inline FloatArray::FloatArray(std::initializer_list<float> Values)
+{
+    resize(Values.size());
+    std::copy(Values.begin(), Values.end(), begin());
+}
+
+inline FloatArray::FloatArray(const std::vector<float>& Values)
+{
+    resize(Values.size());
+    std::copy(Values.begin(), Values.end(), begin());
+}
+
+inline FloatArray::FloatArray(size_type Size) { resize(Size); }
+
+inline void FloatArray::resize(size_type NewSize)
+{
+    if (NewSize > InlineCapacity)
+    {
+        if (Size <= InlineCapacity)
+        {
+            HeapValues.assign(InlineValues.begin(), InlineValues.begin() + Size);
+        }
+
+        HeapValues.resize(NewSize);
+    }
+    else
+    {
+        if (Size > InlineCapacity)
+        {
+            std::copy(HeapValues.begin(), HeapValues.begin() + NewSize, InlineValues.begin());
+            HeapValues.clear();
+            HeapValues.shrink_to_fit();
+        }
+
+        std::fill(InlineValues.begin() + std::min(Size, NewSize), InlineValues.end(), 0.0f);
+    }
+
+    Size = NewSize;
+}
+
+}
@@ -0,0 +1,463 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Multiplayer/MCS/MCSMessagePack.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace csp::multiplayer::mcs
+{
+namespace
+{
+    using Packer = msgpack::packer<msgpack::sbuffer>;
+
+    // Writing ----------------------------------------------------------------------------------------------------------
+    // These mirror how SignalRSerializer converts each type to a signalr::value, and how the hub protocol then packs that value.
+
+    void PackComponentData(Packer& Packer, const ItemComponentData& ComponentData);
+
+    void PackString(Packer& Packer, const std::string& Value)
+    {
+        Packer.pack_str(static_cast<uint32_t>(Value.size()));
+        Packer.pack_str_body(Value.data(), static_cast<uint32_t>(Value.size()));
+    }
+
+    void PackOptional(Packer& Packer, const std::optional<uint64_t>& Value)
+    {
+        if (Value.has_value())
+        {
+            Packer.pack_uint64(*Value);
+        }
+        else
+        {
+            Packer.pack_nil();
+        }
+    }
+
+    void PackComponentValue(Packer& Packer, bool Value) { Value ? Packer.pack_true() : Packer.pack_false(); }
+    void PackComponentValue(Packer& Packer, int64_t Value) { Packer.pack_int64(Value); }
+    void PackComponentValue(Packer& Packer, uint64_t Value) { Packer.pack_uint64(Value); }
+    // signalr values only hold doubles, so floats go over the wire as float64.
+    void PackComponentValue(Packer& Packer, float Value) { Packer.pack_double(static_cast<double>(Value)); }
+    void PackComponentValue(Packer& Packer, double Value) { Packer.pack_double(Value); }
+    void PackComponentValue(Packer& Packer, const std::string& Value) { PackString(Packer, Value); }
+
+    void PackComponentValue(Packer& Packer, const FloatArray& Value)
+    {
+        Packer.pack_array(static_cast<uint32_t>(Value.size()));
+
+        for (const float Element : Value)
+        {
+            Packer.pack_double(static_cast<double>(Element));
+        }
+    }
+
+    void PackComponentValue(Packer& Packer, const ComponentMap& Value)
+    {
+        Packer.pack_map(static_cast<uint32_t>(Value.size()));
+
+        for (const auto& Pair : Value)
+        {
+            Packer.pack_uint64(Pair.first);
+            PackComponentData(Packer, Pair.second);
+        }
+    }
+
+    void PackComponentValue(Packer& Packer, const StringComponentMap& Value)
+    {
+        Packer.pack_map(static_cast<uint32_t>(Value.size()));
+
+        for (const auto& Pair : Value)
+        {
+            PackString(Packer, Pair.first);
+            PackComponentData(Packer, Pair.second);
+        }
+    }
+
+    void PackComponentData(Packer& Packer, const ItemComponentData& ComponentData)
+    {
+        // Type-value pair, with the value inside its own array. See ItemComponentData::Serialize.
+        Packer.pack_array(2);
+        Packer.pack_uint64(static_cast<uint64_t>(ComponentData.GetType()));
+        Packer.pack_array(1);
+
+        std::visit([&Packer](const auto& Value) { PackComponentValue(Packer, Value); }, ComponentData.GetValue());
+    }
+
+    // Reading ----------------------------------------------------------------------------------------------------------
+    // These mirror how the hub protocol converts MessagePack to a signalr::value, and how SignalRDeserializer then reads that value.
+
+    ItemComponentData ReadComponentData(const msgpack::object& Object);
+
+    // The hub protocol turns empty maps into null, and MCS sends null for empty containers, so both are treated the same.
+    bool IsNull(const msgpack::object& Object)
+    {
+        return Object.type == msgpack::type::NIL || (Object.type == msgpack::type::MAP && Object.via.map.size == 0);
+    }
+
+    const msgpack::object_array& ReadArray(const msgpack::object& Object, uint32_t MinSize)
+    {
+        if (Object.type != msgpack::type::ARRAY)
+        {
+            throw std::runtime_error("Unexpected value: Value isn't an array");
+        }
+
+        if (Object.via.array.size < MinSize)
+        {
+            throw std::runtime_error("Unexpected value: Array has too few elements");
+        }
+
+        return Object.via.array;
+    }
+
+    uint64_t ReadUint(const msgpack::object& Object)
+    {
+        if (Object.type != msgpack::type::POSITIVE_INTEGER)
+        {
+            throw std::runtime_error("Invalid call: Value was not a uinteger");
+        }
+
+        return Object.via.u64;
+    }
+
+    int64_t ReadInt(const msgpack::object& Object)
+    {
+        if (Object.type != msgpack::type::NEGATIVE_INTEGER)
+        {
+            throw std::runtime_error("Invalid call: Value was not an integer");
+        }
+
+        return Object.via.i64;
+    }
+
+    bool ReadBool(const msgpack::object& Object)
+    {
+        if (Object.type != msgpack::type::BOOLEAN)
+        {
+            throw std::runtime_error("Invalid call: Value was not a bool");
+        }
+
+        return Object.via.boolean;
+    }
+
+    double ReadDouble(const msgpack::object& Object)
+    {
+        if (Object.type != msgpack::type::FLOAT64 && Object.type != msgpack::type::FLOAT32)
+        {
+            throw std::runtime_error("Invalid call: Value was not a double");
+        }
+
+        return Object.via.f64;
+    }
+
+    std::string ReadString(const msgpack::object& Object)
+    {
+        if (Object.type != msgpack::type::STR)
+        {
+            throw std::runtime_error("Invalid call: Value was not a string");
+        }
+
+        return std::string { Object.via.str.ptr, Object.via.str.size };
+    }
+
+    std::optional<uint64_t> ReadOptionalUint(const msgpack::object& Object)
+    {
+        if (Object.type == msgpack::type::NIL)
+        {
+            return std::nullopt;
+        }
+
+        return ReadUint(Object);
+    }
+
+    ItemComponentDataVariant ReadComponentValue(ItemComponentDataType Type, const msgpack::object& Object)
+    {
+        switch (Type)
+        {
+        case ItemComponentDataType::BOOL:
+            return ReadBool(Object);
+        case ItemComponentDataType::INT64:
+            // We can't guarantee MCS will give us back a signed integer, even if one is sent.
+            if (Object.type == msgpack::type::NEGATIVE_INTEGER)
+            {
+                return ReadInt(Object);
+            }
+
+            return ReadUint(Object);
+        case ItemComponentDataType::UINT64:
+            // Due to us changing some of our types from int64->uint64, we may receive some unexpected int64 values here.
+            if (Object.type == msgpack::type::POSITIVE_INTEGER)
+            {
+                return ReadUint(Object);
+            }
+
+            return ReadInt(Object);
+        case ItemComponentDataType::DOUBLE:
+            return ReadDouble(Object);
+        case ItemComponentDataType::FLOAT:
+            return static_cast<float>(ReadDouble(Object));
+        case ItemComponentDataType::FLOAT_ARRAY:
+        {
+            const msgpack::object_array& Array = ReadArray(Object, 0);
+
+            FloatArray Value(Array.size);
+
+            for (uint32_t i = 0; i < Array.size; ++i)
+            {
+                Value[i] = static_cast<float>(ReadDouble(Array.ptr[i]));
+            }
+
+            return Value;
+        }
+        case ItemComponentDataType::STRING:
+            return ReadString(Object);
+        case ItemComponentDataType::UINT16_DICTIONARY:
+        {
+            ComponentMap Value;
+
+            if (IsNull(Object) == false)
+            {
+                if (Object.type != msgpack::type::MAP)
+                {
+                    throw std::runtime_error("Unexpected value: Value isn't a uint map");
+                }
+
+                Value.reserve(Object.via.map.size);
+
+                for (uint32_t i = 0; i < Object.via.map.size; ++i)
+                {
+                    const msgpack::object_kv& Pair = Object.via.map.ptr[i];
+                    const uint64_t Key = ReadUint(Pair.key);
+
+                    if (Key > std::numeric_limits<uint16_t>::max())
+                    {
+                        throw std::runtime_error("Invalid uinteger type: Value being deserialized is larger than the maximum value of the input type");
+                    }
+
+                    Value.try_emplace(static_cast<uint16_t>(Key), ReadComponentData(Pair.val));
+                }
+            }
+
+            return Value;
+        }
+        case ItemComponentDataType::STRING_DICTIONARY:
+        {
+            StringComponentMap Value;
+
+            if (IsNull(Object) == false)
+            {
+                if (Object.type != msgpack::type::MAP)
+                {
+                    throw std::runtime_error("Unexpected value: Value isn't a string map");
+                }
+
+                Value.reserve(Object.via.map.size);
+
+                for (uint32_t i = 0; i < Object.via.map.size; ++i)
+                {
+                    const msgpack::object_kv& Pair = Object.via.map.ptr[i];
+                    Value.try_emplace(ReadString(Pair.key), ReadComponentData(Pair.val));
+                }
+            }
+
+            return Value;
+        }
+        default:
+            throw std::invalid_argument("Trying to deserialize unsupported ItemComponentDataType");
+        }
+    }
+
+    ItemComponentData ReadComponentData(const msgpack::object& Object)
+    {
+        const msgpack::object_array& Pair = ReadArray(Object, 2);
+        const auto Type = static_cast<ItemComponentDataType>(ReadUint(Pair.ptr[0]));
+        const msgpack::object_array& ValueArray = ReadArray(Pair.ptr[1], 1);
+
+        return ItemComponentData { ReadComponentValue(Type, ValueArray.ptr[0]) };
+    }
+
+    std::optional<ComponentMap> ReadComponents(const msgpack::object& Object)
+    {
+        if (IsNull(Object))
+        {
+            return std::nullopt;
+        }
+
+        if (Object.type != msgpack::type::MAP)
+        {
+            throw std::runtime_error("Unexpected value: Value isn't a uint map");
+        }
+
+        ComponentMap Components;
+        Components.reserve(Object.via.map.size);
+
+        for (uint32_t i = 0; i < Object.via.map.size; ++i)
+        {
+            const msgpack::object_kv& Pair = Object.via.map.ptr[i];
+
+            // As with the SignalRDeserializer path, components we can't read are skipped so the rest of the object still loads.
+            try
+            {
+                const uint64_t Key = ReadUint(Pair.key);
+
+                if (Key <= std::numeric_limits<PropertyKeyType>::max())
+                {
+                    Components.try_emplace(static_cast<PropertyKeyType>(Key), ReadComponentData(Pair.val));
+                }
+            }
+            catch (const std::exception&)
+            {
+            }
+        }
+
+        return Components;
+    }
+}
+
+MessagePackWriter::MessagePackWriter()
+    : Packer { Buffer }
+{
+}
+
+void MessagePackWriter::Reset() { Buffer.clear(); }
+
+void MessagePackWriter::WriteArrayHeader(uint32_t Size) { Packer.pack_array(Size); }
+
+void MessagePackWriter::Write(const ObjectPatch& Patch)
+{
+    // See ObjectPatch::Serialize.
+    Packer.pack_array(5);
+    Packer.pack_uint64(Patch.GetId());
+    Packer.pack_uint64(Patch.GetOwnerId());
+    Patch.GetDestroy() ? Packer.pack_true() : Packer.pack_false();
+
+    // Parent changes need to be in a vector.
+    Packer.pack_array(2);
+    Patch.GetShouldUpdateParent() ? Packer.pack_true() : Packer.pack_false();
+    PackOptional(Packer, Patch.GetParentId());
+
+    WriteComponents(Patch.GetComponents());
+}
+
+void MessagePackWriter::Write(const ObjectMessage& Message)
+{
+    // See ObjectMessage::Serialize.
+    Packer.pack_array(7);
+    Packer.pack_uint64(Message.GetId());
+    Packer.pack_uint64(Message.GetType());
+    Message.GetIsTransferable() ? Packer.pack_true() : Packer.pack_false();
+    Message.GetIsPersistent() ? Packer.pack_true() : Packer.pack_false();
+    Packer.pack_uint64(Message.GetOwnerId());
+    PackOptional(Packer, Message.GetParentId());
+
+    WriteComponents(Message.GetComponents());
+}
+
+void MessagePackWriter::Write(const ItemComponentData& ComponentData) { PackComponentData(Packer, ComponentData); }
+
+void MessagePackWriter::WriteRaw(const char* Data, size_t Size) { Buffer.write(Data, Size); }
+
+const char* MessagePackWriter::GetData() const { return Buffer.data(); }
+
+size_t MessagePackWriter::GetSize() const { return Buffer.size(); }
+
+signalr::value MessagePackWriter::ToSignalRValue() const { return signalr::value::from_messagepack(Buffer.data(), Buffer.size()); }
+
+void MessagePackWriter::WriteComponents(const std::optional<ComponentMap>& Components)
+{
+    if (Components.has_value() == false)
+    {
+        Packer.pack_nil();
+        return;
+    }
+
+    Packer.pack_map(static_cast<uint32_t>(Components->size()));
+
+    for (const auto& Pair : *Components)
+    {
+        Packer.pack_uint64(Pair.first);
+        PackComponentData(Packer, Pair.second);
+    }
+}
+
+void MessagePackReader::Read(const char* Data, size_t Size, ObjectPatch& OutPatch) { ReadPatch(Parse(Data, Size), OutPatch); }
+
+void MessagePackReader::Read(const char* Data, size_t Size, ObjectMessage& OutMessage) { ReadMessage(Parse(Data, Size), OutMessage); }
+
+void MessagePackReader::Read(const char* Data, size_t Size, std::vector<ObjectPatch>& OutPatches)
+{
+    const msgpack::object_array& Array = ReadArray(Parse(Data, Size), 0);
+
+    OutPatches.resize(Array.size);
+
+    for (uint32_t i = 0; i < Array.size; ++i)
+    {
+        ReadPatch(Array.ptr[i], OutPatches[i]);
+    }
+}
+
+void MessagePackReader::ReadPatch(const msgpack::object& Object, ObjectPatch& OutPatch)
+{
+    // See ObjectPatch::Deserialize.
+    const msgpack::object_array& Array = ReadArray(Object, 5);
+
+    OutPatch.Id = ReadUint(Array.ptr[0]);
+    OutPatch.OwnerId = ReadUint(Array.ptr[1]);
+    OutPatch.Destroy = ReadBool(Array.ptr[2]);
+
+    // Array will be null from MCS if there is no parent update.
+    if (Array.ptr[3].type != msgpack::type::NIL)
+    {
+        const msgpack::object_array& ParentArray = ReadArray(Array.ptr[3], 2);
+
+        OutPatch.ShouldUpdateParent = ReadBool(ParentArray.ptr[0]);
+        OutPatch.ParentId = ReadOptionalUint(ParentArray.ptr[1]);
+    }
+
+    OutPatch.Components = ReadComponents(Array.ptr[4]);
+}
+
+void MessagePackReader::ReadMessage(const msgpack::object& Object, ObjectMessage& OutMessage)
+{
+    // See ObjectMessage::Deserialize.
+    const msgpack::object_array& Array = ReadArray(Object, 7);
+
+    OutMessage.Id = ReadUint(Array.ptr[0]);
+    OutMessage.Type = ReadUint(Array.ptr[1]);
+    OutMessage.IsTransferable = ReadBool(Array.ptr[2]);
+    OutMessage.IsPersistent = ReadBool(Array.ptr[3]);
+    OutMessage.OwnerId = ReadUint(Array.ptr[4]);
+    OutMessage.ParentId = ReadOptionalUint(Array.ptr[5]);
+    OutMessage.Components = ReadComponents(Array.ptr[6]);
+}
+
+msgpack::object MessagePackReader::Parse(const char* Data, size_t Size)
+{
+    // Clearing keeps the zone's first chunk, so steady-state reads of similarly sized messages don't allocate here.
+    Zone.clear();
+
+    try
+    {
+        return msgpack::unpack(Zone, Data, Size);
+    }
+    catch (const msgpack::unpack_error& Error)
+    {
+        throw std::runtime_error(Error.what());
+    }
+}
+
+}
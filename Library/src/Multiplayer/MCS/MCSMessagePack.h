@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Multiplayer/MCS/MCSTypes.h"
+
+#include <msgpack.hpp>
+#include <signalrclient/signalr_value.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace csp::multiplayer::mcs
+{
+
+/// @brief Encodes MCS types straight into MessagePack, producing the same bytes the messagepack hub protocol
+/// would write for the signalr::value tree built by SignalRSerializer.
+/// @details The buffer is kept between uses, so once it has grown to fit a typical batch, encoding does not allocate.
+/// Multiple objects can be written one after another, with WriteArrayHeader used to group them into an array.
+class MessagePackWriter
+{
+public:
+    MessagePackWriter();
+
+    /// @brief Clears the encoded data, keeping the buffer for reuse.
+    void Reset();
+
+    /// @brief Starts an array of the given size. The next Size values written become its elements.
+    void WriteArrayHeader(uint32_t Size);
+
+    void Write(const ObjectPatch& Patch);
+    void Write(const ObjectMessage& Message);
+    void Write(const ItemComponentData& ComponentData);
+
+    /// @brief Appends data that has already been encoded, e.g. by another writer.
+    void WriteRaw(const char* Data, size_t Size);
+
+    const char* GetData() const;
+    size_t GetSize() const;
+
+    /// @brief Wraps the encoded data in a signalr value, which the messagepack hub protocol will write as is.
+    /// @pre The writer should hold exactly one complete value, e.g. a single object or a completed array.
+    /// @return signalr::value
+    signalr::value ToSignalRValue() const;
+
+private:
+    void WriteComponents(const std::optional<ComponentMap>& Components);
+
+    msgpack::sbuffer Buffer;
+    msgpack::packer<msgpack::sbuffer> Packer;
+};
+
+/// @brief Decodes MCS types from MessagePack, accepting the same data as the SignalRDeserializer path.
+/// @details Values are parsed into a zone that is reused between reads, so decoding only allocates for the decoded objects themselves.
+/// Throws std::runtime_error if the data does not match the expected layout, in the same way as SignalRDeserializer.
+class MessagePackReader
+{
+public:
+    void Read(const char* Data, size_t Size, ObjectPatch& OutPatch);
+    void Read(const char* Data, size_t Size, ObjectMessage& OutMessage);
+    void Read(const char* Data, size_t Size, std::vector<ObjectPatch>& OutPatches);
+
+private:
+    msgpack::object Parse(const char* Data, size_t Size);
+
+    static void ReadPatch(const msgpack::object& Object, ObjectPatch& OutPatch);
+    static void ReadMessage(const msgpack::object& Object, ObjectMessage& OutMessage);
+
+    msgpack::zone Zone;
+};
+
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Multiplayer/MCS/MCSSceneCheckpoint.h"
+
+#include <cstring>
+#include <fmt/format.h>
+#include <stdexcept>
+
+namespace csp::multiplayer::mcs
+{
+
+namespace
+{
+    constexpr char Magic[4] = { 'C', 'S', 'P', 'C' };
+
+    // Integers are always stored little endian, so checkpoints can be moved between platforms.
+    template <typename T> void WriteLittleEndian(char* Destination, T Value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            Destination[i] = static_cast<char>((Value >> (i * 8)) & 0xFF);
+        }
+    }
+
+    template <typename T> T ReadLittleEndian(const char* Source)
+    {
+        T Value = 0;
+
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            Value |= static_cast<T>(static_cast<uint8_t>(Source[i])) << (i * 8);
+        }
+
+        return Value;
+    }
+}
+
+bool SceneCheckpoint::IsCheckpoint(const char* Data, size_t Size)
+{
+    return Size >= HeaderSize && std::memcmp(Data, Magic, sizeof(Magic)) == 0 && ReadLittleEndian<uint32_t>(Data + 4) == Version;
+}
+
+bool SceneCheckpoint::Read(const char* Data, size_t Size, const SceneDescriptionReader::ObjectCallback& Callback, csp::common::String& OutError)
+{
+    if (IsCheckpoint(Data, Size) == false)
+    {
+        OutError = "Data is not a supported checkpoint";
+        return false;
+    }
+
+    const uint64_t ObjectCount = ReadLittleEndian<uint64_t>(Data + 8);
+
+    MessagePackReader ObjectReader;
+    size_t Offset = HeaderSize;
+
+    for (uint64_t i = 0; i < ObjectCount; ++i)
+    {
+        if (Size - Offset < sizeof(uint32_t))
+        {
+            OutError = fmt::format("Checkpoint ends before object {} of {}", i, ObjectCount).c_str();
+            return false;
+        }
+
+        const uint32_t RecordSize = ReadLittleEndian<uint32_t>(Data + Offset);
+        Offset += sizeof(uint32_t);
+
+        if (Size - Offset < RecordSize)
+        {
+            OutError = fmt::format("Checkpoint ends part way through object {} of {}", i, ObjectCount).c_str();
+            return false;
+        }
+
+        ObjectMessage Object;
+
+        try
+        {
+            ObjectReader.Read(Data + Offset, RecordSize, Object);
+        }
+        // Malformed MessagePack is reported as runtime_error, but the reader can throw others, such as invalid_argument for a value it
+        // doesn't support, and none of them should escape.
+        catch (const std::exception& Error)
+        {
+            OutError = fmt::format("Failed to read object {} of {}: {}", i, ObjectCount, Error.what()).c_str();
+            return false;
+        }
+
+        Offset += RecordSize;
+
+        Callback(std::move(Object));
+    }
+
+    return true;
+}
+
+SceneCheckpointWriter::SceneCheckpointWriter()
+    : Data(SceneCheckpoint::HeaderSize)
+{
+    std::memcpy(Data.data(), Magic, sizeof(Magic));
+    WriteLittleEndian(Data.data() + 4, SceneCheckpoint::Version);
+    WriteLittleEndian(Data.data() + 8, ObjectCount);
+}
+
+void SceneCheckpointWriter::Write(const ObjectMessage& Object)
+{
+    ObjectWriter.Reset();
+    ObjectWriter.Write(Object);
+
+    const size_t RecordOffset = Data.size();
+    Data.resize(RecordOffset + sizeof(uint32_t) + ObjectWriter.GetSize());
+
+    WriteLittleEndian(Data.data() + RecordOffset, static_cast<uint32_t>(ObjectWriter.GetSize()));
+    std::memcpy(Data.data() + RecordOffset + sizeof(uint32_t), ObjectWriter.GetData(), ObjectWriter.GetSize());
+
+    ++ObjectCount;
+    WriteLittleEndian(Data.data() + 8, ObjectCount);
+}
+
+const std::vector<char>& SceneCheckpointWriter::GetData() const { return Data; }
+
+std::vector<char> SceneCheckpointWriter::TakeData() { return std::move(Data); }
+
+}
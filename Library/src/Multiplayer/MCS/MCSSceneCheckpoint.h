@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "CSP/Common/String.h"
+#include "Multiplayer/MCS/MCSMessagePack.h"
+#include "Multiplayer/MCS/MCSSceneDescription.h"
+#include "Multiplayer/MCS/MCSTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace csp::multiplayer::mcs
+{
+
+/// @brief Binary equivalent of the objects in a SceneDescription json, for quickly saving and loading offline scenes.
+/// @details The layout is a fixed header followed by one record per object, with all integers little endian:
+///     - Header: the characters "CSPC", a uint32 format version, and a uint64 object count.
+///     - Record: a uint32 byte length, followed by the object encoded as MessagePack, exactly as it is sent to MCS.
+/// The parent of each object is part of its record, so the hierarchy is preserved without any further data.
+/// Records are length prefixed so that Read can walk them in place, decoding each object straight from the buffer it is given.
+/// CSPSceneDescription copies the checkpoint once when it is constructed, and it is that copy which is read in place.
+class SceneCheckpoint
+{
+public:
+    static constexpr uint32_t Version = 1;
+    static constexpr size_t HeaderSize = 16;
+
+    /// @brief Checks whether the data starts with a checkpoint header, of a version that can be read.
+    static bool IsCheckpoint(const char* Data, size_t Size);
+
+    /// @brief Reads each object in the checkpoint, in the order they were written.
+    /// @param Data const char* : The checkpoint, which is only read from and not copied.
+    /// @param Size size_t : The size of the checkpoint in bytes.
+    /// @param Callback SceneDescriptionReader::ObjectCallback : Called with each object once it has been read.
+    /// @param OutError csp::common::String& : Set to a description of the problem, if the checkpoint is invalid.
+    /// @return bool : False if the checkpoint is invalid. Objects before the invalid record will already have been passed to the callback.
+    static bool Read(const char* Data, size_t Size, const SceneDescriptionReader::ObjectCallback& Callback, csp::common::String& OutError);
+};
+
+/// @brief Builds a SceneCheckpoint one object at a time.
+/// @details The header is kept up to date as objects are written, so the data is a complete checkpoint at any point.
+class SceneCheckpointWriter
+{
+public:
+    SceneCheckpointWriter();
+
+    void Write(const ObjectMessage& Object);
+
+    const std::vector<char>& GetData() const;
+
+    /// @brief Moves the checkpoint out of the writer, which should not be used afterwards.
+    std::vector<char> TakeData();
+
+private:
+    std::vector<char> Data;
+    uint64_t ObjectCount = 0;
+    MessagePackWriter ObjectWriter;
+};
+
+}
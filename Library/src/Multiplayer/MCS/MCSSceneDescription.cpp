@@ -18,8 +18,12 @@
 #include "Services/ApiBase/ApiBase.h"
 #include "Json/JsonSerializer.h"
 
+#include <fmt/format.h>
 #include <map>
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace csp::multiplayer::mcs
@@ -40,24 +44,28 @@ namespace
     std::string GetComponentString(int64_t) { return Int64Type; }
     std::string GetComponentString(uint64_t) { return UInt64Type; }
     std::string GetComponentString(float) { return SinglePrecisionType; }
-    std::string GetComponentString(const std::vector<float>&) { return SinglePrecisionArrayType; }
+    std::string GetComponentString(const FloatArray&) { return SinglePrecisionArrayType; }
     std::string GetComponentString(double) { return DoubleType; }
     std::string GetComponentString(const std::string&) { return StringType; }
-    std::string GetComponentString(const std::map<uint16_t, csp::multiplayer::mcs::ItemComponentData>&) { return UInt16DictionaryType; }
-    std::string GetComponentString(const std::map<std::string, csp::multiplayer::mcs::ItemComponentData>&) { return StringDictionaryType; }
+    std::string GetComponentString(const ComponentMap&) { return UInt16DictionaryType; }
+    std::string GetComponentString(const StringComponentMap&) { return StringDictionaryType; }
 
     void SerializeComponentData(csp::json::JsonSerializer& Serializer, bool Value) { Serializer.SerializeMember("item", Value); }
     void SerializeComponentData(csp::json::JsonSerializer& Serializer, int64_t Value) { Serializer.SerializeMember("item", Value); }
     void SerializeComponentData(csp::json::JsonSerializer& Serializer, uint64_t Value) { Serializer.SerializeMember("item", Value); }
     void SerializeComponentData(csp::json::JsonSerializer& Serializer, float Value) { Serializer.SerializeMember("item", Value); }
-    void SerializeComponentData(csp::json::JsonSerializer& Serializer, const std::vector<float>& Value) { Serializer.SerializeMember("item", Value); }
+    void SerializeComponentData(csp::json::JsonSerializer& Serializer, const FloatArray& Value)
+    {
+        Serializer.SerializeMember("item", Value.ToVector());
+    }
     void SerializeComponentData(csp::json::JsonSerializer& Serializer, double Value) { Serializer.SerializeMember("item", Value); }
     void SerializeComponentData(csp::json::JsonSerializer& Serializer, const std::string& Value)
     {
         Serializer.SerializeMember("item", csp::common::String { Value.c_str() });
     }
 
-    void SerializeComponentData(csp::json::JsonSerializer& Serializer, const std::map<uint16_t, csp::multiplayer::mcs::ItemComponentData>& Value)
+    // The json serializer only supports std::map with string keys, so flat maps are converted to one first.
+    void SerializeComponentData(csp::json::JsonSerializer& Serializer, const ComponentMap& Value)
     {
         std::map<std::string, csp::multiplayer::mcs::ItemComponentData> StringMap;
 
@@ -69,12 +77,12 @@ namespace
         Serializer.SerializeMember("item", StringMap);
     }
 
-    void SerializeComponentData(csp::json::JsonSerializer& Serializer, const std::map<std::string, csp::multiplayer::mcs::ItemComponentData>& Value)
+    void SerializeComponentData(csp::json::JsonSerializer& Serializer, const StringComponentMap& Value)
     {
-        Serializer.SerializeMember("item", Value);
+        Serializer.SerializeMember("item", std::map<std::string, csp::multiplayer::mcs::ItemComponentData>(Value.begin(), Value.end()));
     }
 
-    void SerializeComponents(csp::json::JsonSerializer& Serializer, const std::map<uint16_t, csp::multiplayer::mcs::ItemComponentData>& Value)
+    void SerializeComponents(csp::json::JsonSerializer& Serializer, const ComponentMap& Value)
     {
         std::map<std::string, csp::multiplayer::mcs::ItemComponentData> StringMap;
 
@@ -92,7 +100,28 @@ namespace
     {
         T Val;
         Deserializer.SafeDeserializeMember("item", Val);
-        OutVal = Val;
+        OutVal = std::move(Val);
+    }
+
+    // The json deserializer only supports std::map with string keys, so maps are read into one and then converted.
+    template <class K> FlatMap<K, ItemComponentData> ToComponentMap(std::map<std::string, ItemComponentData>&& StringMap)
+    {
+        FlatMap<K, ItemComponentData> Map;
+        Map.reserve(StringMap.size());
+
+        for (auto& Pair : StringMap)
+        {
+            if constexpr (std::is_same_v<K, std::string>)
+            {
+                Map.try_emplace(Pair.first, std::move(Pair.second));
+            }
+            else
+            {
+                Map.try_emplace(static_cast<K>(std::stoi(Pair.first)), std::move(Pair.second));
+            }
+        }
+
+        return Map;
     }
 
     void DeserializeComponentDataFromTypeString(
@@ -116,7 +145,9 @@ namespace
         }
         else if (Type == SinglePrecisionArrayType)
         {
-            DeserializeComponentDataFromTypeStringInternal<std::vector<float>>(Deserializer, OutVal);
+            std::vector<float> Val;
+            Deserializer.SafeDeserializeMember("item", Val);
+            OutVal = FloatArray { Val };
         }
         else if (Type == DoubleType)
         {
@@ -128,22 +159,15 @@ namespace
         }
         else if (Type == UInt16DictionaryType)
         {
-            DeserializeComponentDataFromTypeStringInternal<std::map<std::string, csp::multiplayer::mcs::ItemComponentData>>(Deserializer, OutVal);
-
-            // We can only deserialize string maps, so we need to convert to int afterwards.
-            const auto& StringMap = std::get<std::map<std::string, csp::multiplayer::mcs::ItemComponentData>>(OutVal);
-            std::map<uint16_t, csp::multiplayer::mcs::ItemComponentData> UIntMap;
-
-            for (const auto& Val : StringMap)
-            {
-                UIntMap[static_cast<uint16_t>(std::stoi(Val.first))] = Val.second;
-            }
-
-            OutVal = UIntMap;
+            std::map<std::string, ItemComponentData> StringMap;
+            Deserializer.SafeDeserializeMember("item", StringMap);
+            OutVal = ToComponentMap<uint16_t>(std::move(StringMap));
         }
         else if (Type == StringDictionaryType)
         {
-            DeserializeComponentDataFromTypeStringInternal<std::map<std::string, csp::multiplayer::mcs::ItemComponentData>>(Deserializer, OutVal);
+            std::map<std::string, ItemComponentData> StringMap;
+            Deserializer.SafeDeserializeMember("item", StringMap);
+            OutVal = ToComponentMap<std::string>(std::move(StringMap));
         }
         else
         {
@@ -152,22 +176,288 @@ namespace
     }
 }
 
-void DeserializeComponents(const csp::json::JsonDeserializer& Deserializer, std::optional<std::map<uint16_t, ItemComponentData>>& OutComponents)
+void DeserializeComponents(const csp::json::JsonDeserializer& Deserializer, std::optional<ComponentMap>& OutComponents)
 {
     std::map<std::string, ItemComponentData> Components;
     Deserializer.SafeDeserializeMember("components", Components);
 
     if (Components.size() > 0)
     {
-        std::map<uint16_t, ItemComponentData> UIntComponents;
+        OutComponents = ToComponentMap<PropertyKeyType>(std::move(Components));
+    }
+}
+
+namespace
+{
+    // Presents a list of strings to rapidjson as a single read-only stream, so the strings don't need to be joined.
+    class ChunkedStringStream
+    {
+    public:
+        typedef char Ch;
+
+        explicit ChunkedStringStream(const csp::common::List<csp::common::String>& InChunks)
+            : Chunks { InChunks }
+        {
+            NextChunk();
+        }
+
+        Ch Peek() const { return Current != End ? *Current : '\0'; }
+
+        Ch Take()
+        {
+            if (Current == End)
+            {
+                return '\0';
+            }
+
+            const Ch Char = *Current++;
+            ++Offset;
+
+            if (Current == End)
+            {
+                NextChunk();
+            }
+
+            return Char;
+        }
+
+        size_t Tell() const { return Offset; }
+
+        // Only used for in situ parsing, which this stream doesn't support.
+        Ch* PutBegin()
+        {
+            RAPIDJSON_ASSERT(false);
+            return nullptr;
+        }
+        void Put(Ch) { RAPIDJSON_ASSERT(false); }
+        void Flush() { RAPIDJSON_ASSERT(false); }
+        size_t PutEnd(Ch*)
+        {
+            RAPIDJSON_ASSERT(false);
+            return 0;
+        }
+
+    private:
+        void NextChunk()
+        {
+            while (ChunkIndex < Chunks.Size())
+            {
+                const csp::common::String& Chunk = Chunks[ChunkIndex++];
+
+                if (Chunk.Length() > 0)
+                {
+                    Current = Chunk.c_str();
+                    End = Current + Chunk.Length();
+                    return;
+                }
+            }
+
+            Current = nullptr;
+            End = nullptr;
+        }
+
+        const csp::common::List<csp::common::String>& Chunks;
+        size_t ChunkIndex = 0;
+        const Ch* Current = nullptr;
+        const Ch* End = nullptr;
+        size_t Offset = 0;
+    };
+
+    // SAX handler that skips everything outside of data.objectMessages, and builds each entry of it into a value of its own.
+    class SceneDescriptionHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, SceneDescriptionHandler>
+    {
+    public:
+        explicit SceneDescriptionHandler(const SceneDescriptionReader::ObjectCallback& InCallback)
+            : Callback { InCallback }
+            , ObjectBuffer(ObjectBufferSize)
+            , Allocator { ObjectBuffer.data(), ObjectBuffer.size() }
+        {
+        }
+
+        bool Null() { return IsBuilding() ? AddValue(rapidjson::Value {}) : SkipValue(); }
+        bool Bool(bool Value) { return IsBuilding() ? AddValue(rapidjson::Value { Value }) : SkipValue(); }
+        bool Int(int Value) { return IsBuilding() ? AddValue(rapidjson::Value { Value }) : SkipValue(); }
+        bool Uint(unsigned Value) { return IsBuilding() ? AddValue(rapidjson::Value { Value }) : SkipValue(); }
+        bool Int64(int64_t Value) { return IsBuilding() ? AddValue(rapidjson::Value { Value }) : SkipValue(); }
+        bool Uint64(uint64_t Value) { return IsBuilding() ? AddValue(rapidjson::Value { Value }) : SkipValue(); }
+        bool Double(double Value) { return IsBuilding() ? AddValue(rapidjson::Value { Value }) : SkipValue(); }
+
+        bool String(const char* Value, rapidjson::SizeType Length, bool)
+        {
+            return IsBuilding() ? AddValue(rapidjson::Value { Value, Length, Allocator }) : SkipValue();
+        }
+
+        bool Key(const char* Value, rapidjson::SizeType Length, bool)
+        {
+            if (IsBuilding())
+            {
+                Keys.emplace_back(Value, Length, Allocator);
+                return true;
+            }
+
+            const std::string_view Name { Value, Length };
+            KeyMatches = Depth == MatchedDepth && ((Depth == 1 && Name == "data") || (Depth == 2 && Name == "objectMessages"));
+
+            return true;
+        }
+
+        bool StartObject()
+        {
+            // Every object directly within objectMessages is the start of a new entry.
+            if (IsBuilding() || (Depth == ObjectMessagesDepth && MatchedDepth == ObjectMessagesDepth))
+            {
+                Stack.emplace_back(rapidjson::kObjectType);
+                return true;
+            }
+
+            return EnterContainer(false);
+        }
+
+        bool EndObject(rapidjson::SizeType)
+        {
+            if (IsBuilding())
+            {
+                rapidjson::Value Object { std::move(Stack.back()) };
+                Stack.pop_back();
+
+                return AddValue(std::move(Object));
+            }
+
+            return ExitContainer();
+        }
+
+        bool StartArray()
+        {
+            if (IsBuilding())
+            {
+                Stack.emplace_back(rapidjson::kArrayType);
+                return true;
+            }
+
+            return EnterContainer(true);
+        }
+
+        bool EndArray(rapidjson::SizeType)
+        {
+            if (IsBuilding())
+            {
+                rapidjson::Value Array { std::move(Stack.back()) };
+                Stack.pop_back();
+
+                return AddValue(std::move(Array));
+            }
+
+            return ExitContainer();
+        }
+
+    private:
+        // The depth of the entries, root object -> data -> objectMessages.
+        static constexpr int ObjectMessagesDepth = 3;
+
+        // Entries that fit within this are built without allocating. Larger ones fall back to the heap, which is released after each entry.
+        static constexpr size_t ObjectBufferSize = 64 * 1024;
+
+        bool IsBuilding() const { return !Stack.empty(); }
+
+        bool SkipValue()
+        {
+            KeyMatches = false;
+            return true;
+        }
+
+        bool EnterContainer(bool IsArray)
+        {
+            const bool Matches = Depth == MatchedDepth
+                && ((Depth == 0 && !IsArray) || (Depth == 1 && KeyMatches && !IsArray) || (Depth == 2 && KeyMatches && IsArray));
+
+            if (Matches)
+            {
+                ++MatchedDepth;
+            }
+
+            ++Depth;
+            KeyMatches = false;
+
+            return true;
+        }
+
+        bool ExitContainer()
+        {
+            if (Depth == MatchedDepth)
+            {
+                --MatchedDepth;
+            }
+
+            --Depth;
+            KeyMatches = false;
+
+            return true;
+        }
+
+        bool AddValue(rapidjson::Value&& Value)
+        {
+            if (Stack.empty())
+            {
+                CompleteObject(Value);
+                return true;
+            }
+
+            rapidjson::Value& Parent = Stack.back();
+
+            if (Parent.IsObject())
+            {
+                Parent.AddMember(Keys.back(), Value, Allocator);
+                Keys.pop_back();
+            }
+            else
+            {
+                Parent.PushBack(Value, Allocator);
+            }
 
-        for (const auto& ComponentPair : Components)
+            return true;
+        }
+
+        void CompleteObject(const rapidjson::Value& Object)
         {
-            UIntComponents[static_cast<uint16_t>(stoi(ComponentPair.first))] = ComponentPair.second;
+            ObjectMessage Message;
+            csp::json::JsonDeserializer::Deserialize(Object, Message);
+
+            // Nothing refers to the built entry anymore, so its memory can be reused for the next one.
+            Allocator.Clear();
+
+            Callback(std::move(Message));
         }
 
-        OutComponents = UIntComponents;
+        const SceneDescriptionReader::ObjectCallback& Callback;
+
+        // Nesting outside of any entry, and how much of it matches the path to objectMessages.
+        int Depth = 0;
+        int MatchedDepth = 0;
+        bool KeyMatches = false;
+
+        std::vector<char> ObjectBuffer;
+        rapidjson::MemoryPoolAllocator<> Allocator;
+        std::vector<rapidjson::Value> Stack;
+        std::vector<rapidjson::Value> Keys;
+    };
+}
+
+bool SceneDescriptionReader::Read(
+    const csp::common::List<csp::common::String>& SceneDescriptionJson, const ObjectCallback& Callback, csp::common::String& OutError)
+{
+    ChunkedStringStream Stream { SceneDescriptionJson };
+    SceneDescriptionHandler Handler { Callback };
+
+    rapidjson::Reader Reader;
+    const rapidjson::ParseResult Result = Reader.Parse(Stream, Handler);
+
+    if (Result.IsError())
+    {
+        OutError = fmt::format("{} (offset {})", rapidjson::GetParseError_En(Result.Code()), Result.Offset()).c_str();
+        return false;
     }
+
+    return true;
 }
 
 }
@@ -231,7 +521,7 @@ void FromJson(const csp::json::JsonDeserializer& Deserializer, csp::multiplayer:
     bool IsPersistent = false;
     uint64_t OwnerId = 0;
     std::optional<uint64_t> ParentId;
-    std::optional<std::map<csp::multiplayer::mcs::PropertyKeyType, csp::multiplayer::mcs::ItemComponentData>> Components;
+    std::optional<csp::multiplayer::mcs::ComponentMap> Components;
 
     Deserializer.SafeDeserializeMember("id", Id);
     Deserializer.SafeDeserializeMember("prefabId", Type);
@@ -249,5 +539,5 @@ void FromJson(const csp::json::JsonDeserializer& Deserializer, csp::multiplayer:
 
     csp::multiplayer::mcs::DeserializeComponents(Deserializer, Components);
 
-    Obj = csp::multiplayer::mcs::ObjectMessage { Id, Type, IsTransferable, IsPersistent, OwnerId, ParentId, Components };
+    Obj = csp::multiplayer::mcs::ObjectMessage { Id, Type, IsTransferable, IsPersistent, OwnerId, ParentId, std::move(Components) };
 }
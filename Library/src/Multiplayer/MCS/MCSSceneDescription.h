@@ -15,8 +15,12 @@
  */
 #pragma once
 
+#include "CSP/Common/List.h"
+#include "CSP/Common/String.h"
 #include "MCSTypes.h"
 
+#include <functional>
+
 namespace csp::multiplayer::mcs
 {
 /// @brief Internal mcs data structure which represents objects in a scene.
@@ -28,6 +32,24 @@ public:
     std::vector<ObjectMessage> Objects;
 };
 
+/// @brief Reads the objects of a SceneDescription json one at a time, without building the whole document in memory.
+/// @details The json is read with a SAX parser directly from the chunks it was provided in, so they never need to be joined.
+/// Each entry of data.objectMessages is built into a small document of its own and handed to the callback as soon as it is complete,
+/// so peak memory is bounded by the largest object rather than the size of the scene.
+class SceneDescriptionReader
+{
+public:
+    typedef std::function<void(ObjectMessage&& Object)> ObjectCallback;
+
+    /// @brief Parses the json, calling Callback for each object in the order they appear.
+    /// @param SceneDescriptionJson const csp::common::List<csp::common::String>& : The json, which may be split at any point.
+    /// @param Callback ObjectCallback : Called with each object once it has been fully read.
+    /// @param OutError csp::common::String& : Set to a description of the parse error, if one occurred.
+    /// @return bool : False if the json could not be parsed. Objects before the error will already have been passed to the callback.
+    static bool Read(
+        const csp::common::List<csp::common::String>& SceneDescriptionJson, const ObjectCallback& Callback, csp::common::String& OutError);
+};
+
 }
 
 void FromJson(const csp::json::JsonDeserializer& Deserializer, csp::multiplayer::mcs::SceneDescription& Obj);
@@ -26,23 +26,65 @@ namespace
     ItemComponentDataType GetComponentEnum(int64_t) { return ItemComponentDataType::INT64; }
     ItemComponentDataType GetComponentEnum(uint64_t) { return ItemComponentDataType::UINT64; }
     ItemComponentDataType GetComponentEnum(float) { return ItemComponentDataType::FLOAT; }
-    ItemComponentDataType GetComponentEnum(const std::vector<float>&) { return ItemComponentDataType::FLOAT_ARRAY; }
+    ItemComponentDataType GetComponentEnum(const FloatArray&) { return ItemComponentDataType::FLOAT_ARRAY; }
     ItemComponentDataType GetComponentEnum(double) { return ItemComponentDataType::DOUBLE; }
     ItemComponentDataType GetComponentEnum(const std::string&) { return ItemComponentDataType::STRING; }
-    ItemComponentDataType GetComponentEnum(const std::map<uint16_t, ItemComponentData>&) { return ItemComponentDataType::UINT16_DICTIONARY; }
-    ItemComponentDataType GetComponentEnum(const std::map<std::string, ItemComponentData>&) { return ItemComponentDataType::STRING_DICTIONARY; }
+    ItemComponentDataType GetComponentEnum(const ComponentMap&) { return ItemComponentDataType::UINT16_DICTIONARY; }
+    ItemComponentDataType GetComponentEnum(const StringComponentMap&) { return ItemComponentDataType::STRING_DICTIONARY; }
 
     void SerializeComponentData(SignalRSerializer& Serializer, bool Value) { Serializer.WriteValue(Value); }
     void SerializeComponentData(SignalRSerializer& Serializer, int64_t Value) { Serializer.WriteValue(Value); }
     void SerializeComponentData(SignalRSerializer& Serializer, uint64_t Value) { Serializer.WriteValue(Value); }
     void SerializeComponentData(SignalRSerializer& Serializer, float Value) { Serializer.WriteValue(Value); }
-    void SerializeComponentData(SignalRSerializer& Serializer, const std::vector<float>& Value) { Serializer.WriteValue(Value); }
+    void SerializeComponentData(SignalRSerializer& Serializer, const FloatArray& Value)
+    {
+        Serializer.StartWriteArray();
+
+        for (float Element : Value)
+        {
+            Serializer.WriteValue(Element);
+        }
+
+        Serializer.EndWriteArray();
+    }
+
     void SerializeComponentData(SignalRSerializer& Serializer, double Value) { Serializer.WriteValue(Value); }
     void SerializeComponentData(SignalRSerializer& Serializer, const std::string& Value) { Serializer.WriteValue(Value); }
-    void SerializeComponentData(SignalRSerializer& Serializer, const std::map<uint16_t, ItemComponentData>& Value) { Serializer.WriteValue(Value); }
-    void SerializeComponentData(SignalRSerializer& Serializer, const std::map<std::string, ItemComponentData>& Value)
+
+    void SerializeComponentData(SignalRSerializer& Serializer, const ComponentMap& Value)
     {
-        Serializer.WriteValue(Value);
+        Serializer.StartWriteUintMap();
+
+        for (const auto& [Key, Data] : Value)
+        {
+            Serializer.WriteKeyValue(Key, Data);
+        }
+
+        Serializer.EndWriteUintMap();
+    }
+
+    void SerializeComponentData(SignalRSerializer& Serializer, const StringComponentMap& Value)
+    {
+        Serializer.StartWriteStringMap();
+
+        for (const auto& [Key, Data] : Value)
+        {
+            Serializer.WriteKeyValue(Key, Data);
+        }
+
+        Serializer.EndWriteStringMap();
+    }
+
+    void SerializeComponents(SignalRSerializer& Serializer, const std::optional<ComponentMap>& Components)
+    {
+        if (Components.has_value())
+        {
+            SerializeComponentData(Serializer, *Components);
+        }
+        else
+        {
+            Serializer.WriteValue(nullptr);
+        }
     }
 
     template <class T> void DeserializeComponentDataInternal(SignalRDeserializer& Deserializer, ItemComponentDataVariant& OutVal)
@@ -51,7 +93,69 @@ namespace
         // as we want to make sure our variant is populated with the correct type.
         T DeserializedValue {};
         Deserializer.ReadValue(DeserializedValue);
-        OutVal = DeserializedValue;
+        OutVal = std::move(DeserializedValue);
+    }
+
+    void DeserializeFloatArray(SignalRDeserializer& Deserializer, ItemComponentDataVariant& OutVal)
+    {
+        size_t ArraySize = 0;
+        Deserializer.StartReadArray(ArraySize);
+
+        FloatArray Values(ArraySize);
+
+        for (float& Value : Values)
+        {
+            Deserializer.ReadValue(Value);
+        }
+
+        Deserializer.EndReadArray();
+
+        OutVal = std::move(Values);
+    }
+
+    // Reads a uint or string keyed map. Entries arrive in key order, so each one is appended to the flat map without searching.
+    template <class MapType> void DeserializeComponentMap(SignalRDeserializer& Deserializer, ItemComponentDataVariant& OutVal)
+    {
+        MapType Map;
+
+        // If a dictionary is empty, we will receive null from MCS.
+        if (Deserializer.NextValueIsNull())
+        {
+            Deserializer.Skip();
+            OutVal = std::move(Map);
+            return;
+        }
+
+        size_t MapSize = 0;
+
+        if constexpr (std::is_same_v<MapType, ComponentMap>)
+        {
+            Deserializer.StartReadUintMap(MapSize);
+        }
+        else
+        {
+            Deserializer.StartReadStringMap(MapSize);
+        }
+
+        Map.reserve(MapSize);
+
+        for (size_t i = 0; i < MapSize; ++i)
+        {
+            std::pair<typename MapType::key_type, ItemComponentData> Pair;
+            Deserializer.ReadKeyValue(Pair);
+            Map.insert_or_assign(Pair.first, std::move(Pair.second));
+        }
+
+        if constexpr (std::is_same_v<MapType, ComponentMap>)
+        {
+            Deserializer.EndReadUintMap();
+        }
+        else
+        {
+            Deserializer.EndReadStringMap();
+        }
+
+        OutVal = std::move(Map);
     }
 
     void DeserializeComponentData(SignalRDeserializer& Deserializer, ItemComponentDataType Type, ItemComponentDataVariant& OutVal)
@@ -92,48 +196,31 @@ namespace
             DeserializeComponentDataInternal<float>(Deserializer, OutVal);
             break;
         case ItemComponentDataType::FLOAT_ARRAY:
-            DeserializeComponentDataInternal<std::vector<float>>(Deserializer, OutVal);
+            DeserializeFloatArray(Deserializer, OutVal);
             break;
         case ItemComponentDataType::STRING:
             DeserializeComponentDataInternal<std::string>(Deserializer, OutVal);
             break;
         case ItemComponentDataType::UINT16_DICTIONARY:
-            // If a dictionary is empty, we will receive null from MCS.
-            if (Deserializer.NextValueIsNull())
-            {
-                Deserializer.Skip();
-                OutVal = std::map<uint16_t, ItemComponentData> {};
-            }
-            else
-            {
-                DeserializeComponentDataInternal<std::map<uint16_t, ItemComponentData>>(Deserializer, OutVal);
-            }
+            DeserializeComponentMap<ComponentMap>(Deserializer, OutVal);
             break;
         case ItemComponentDataType::STRING_DICTIONARY:
-            // If a dictionary is empty, we will receive null from MCS.
-            if (Deserializer.NextValueIsNull())
-            {
-                Deserializer.Skip();
-                OutVal = std::map<std::string, ItemComponentData> {};
-            }
-            else
-            {
-                DeserializeComponentDataInternal<std::map<std::string, ItemComponentData>>(Deserializer, OutVal);
-            }
+            DeserializeComponentMap<StringComponentMap>(Deserializer, OutVal);
             break;
         default:
             throw std::invalid_argument("Trying to deserialize unsupported ItemComponentDataType");
         }
     }
 
-    void DeserializeComponents(SignalRDeserializer& Deserializer, std::optional<std::map<PropertyKeyType, ItemComponentData>>& Components)
+    void DeserializeComponents(SignalRDeserializer& Deserializer, std::optional<ComponentMap>& Components)
     {
         if (Deserializer.NextValueIsNull() == false)
         {
-            Components = std::map<PropertyKeyType, ItemComponentData> {};
+            Components = ComponentMap {};
 
             size_t ComponentsSize = 0;
             Deserializer.StartReadUintMap(ComponentsSize);
+            Components->reserve(ComponentsSize);
 
             for (size_t i = 0; i < ComponentsSize; ++i)
             {
@@ -142,7 +229,7 @@ namespace
                     std::pair<PropertyKeyType, ItemComponentData> ComponentKeyValue;
                     Deserializer.ReadKeyValue(ComponentKeyValue);
 
-                    (*Components)[ComponentKeyValue.first] = ComponentKeyValue.second;
+                    Components->insert_or_assign(ComponentKeyValue.first, std::move(ComponentKeyValue.second));
                 }
                 catch (const std::exception&)
                 {
@@ -173,6 +260,11 @@ ItemComponentData::ItemComponentData(const ItemComponentDataVariant& Value)
 {
 }
 
+ItemComponentData::ItemComponentData(ItemComponentDataVariant&& Value)
+    : Value { std::move(Value) }
+{
+}
+
 void ItemComponentData::Serialize(SignalRSerializer& Serializer) const
 {
     // 1. Write an array for type-value pair.
@@ -224,17 +316,24 @@ void ItemComponentData::Deserialize(SignalRDeserializer& Deserializer)
 
 const ItemComponentDataVariant& ItemComponentData::GetValue() const { return Value; }
 
+ItemComponentDataVariant& ItemComponentData::GetMutableValue() { return Value; }
+
+ItemComponentDataType ItemComponentData::GetType() const
+{
+    return std::visit([](const auto& ValueType) { return GetComponentEnum(ValueType); }, Value);
+}
+
 bool ItemComponentData::operator==(const ItemComponentData& Other) const { return Value == Other.Value; }
 
 ObjectMessage::ObjectMessage(uint64_t Id, uint64_t Type, bool IsTransferable, bool IsPersistent, uint64_t OwnerId, std::optional<uint64_t> ParentId,
-    const std::optional<std::map<PropertyKeyType, ItemComponentData>>& Components)
+    std::optional<ComponentMap> Components)
     : Id { Id }
     , Type { Type }
     , IsTransferable { IsTransferable }
     , IsPersistent { IsPersistent }
     , OwnerId { OwnerId }
     , ParentId { ParentId }
-    , Components { Components }
+    , Components { std::move(Components) }
 {
 }
 
@@ -248,7 +347,7 @@ void ObjectMessage::Serialize(SignalRSerializer& Serializer) const
         Serializer.WriteValue(IsPersistent);
         Serializer.WriteValue(OwnerId);
         Serializer.WriteValue(ParentId);
-        Serializer.WriteValue(Components);
+        SerializeComponents(Serializer, Components);
     }
     Serializer.EndWriteArray();
 }
@@ -287,16 +386,16 @@ uint64_t ObjectMessage::GetOwnerId() const { return OwnerId; }
 
 std::optional<uint64_t> ObjectMessage::GetParentId() const { return ParentId; }
 
-const std::optional<std::map<PropertyKeyType, ItemComponentData>>& ObjectMessage::GetComponents() const { return Components; }
+const std::optional<ComponentMap>& ObjectMessage::GetComponents() const { return Components; }
 
 ObjectPatch::ObjectPatch(uint64_t Id, uint64_t OwnerId, bool Destroy, bool ShouldUpdateParent, std::optional<uint64_t> ParentId,
-    const std::map<PropertyKeyType, ItemComponentData>& Components)
+    ComponentMap Components)
     : Id { Id }
     , OwnerId { OwnerId }
     , Destroy { Destroy }
     , ShouldUpdateParent { ShouldUpdateParent }
     , ParentId { ParentId }
-    , Components { Components }
+    , Components { std::move(Components) }
 {
 }
 
@@ -316,7 +415,7 @@ void ObjectPatch::Serialize(SignalRSerializer& Serializer) const
         }
         Serializer.EndWriteArray();
 
-        Serializer.WriteValue(Components);
+        SerializeComponents(Serializer, Components);
     }
     Serializer.EndWriteArray();
 }
@@ -363,6 +462,6 @@ bool ObjectPatch::GetShouldUpdateParent() const { return ShouldUpdateParent; }
 
 std::optional<uint64_t> ObjectPatch::GetParentId() const { return ParentId; }
 
-const std::optional<std::map<PropertyKeyType, ItemComponentData>>& ObjectPatch::GetComponents() const { return Components; }
+const std::optional<ComponentMap>& ObjectPatch::GetComponents() const { return Components; }
 
 }
@@ -16,12 +16,17 @@
 
 #pragma once
 
+#include "Multiplayer/MCS/MCSContainers.h"
 #include "Multiplayer/SignalRSerializer.h"
 
-#include <map>
 #include <memory>
 #include <optional>
 
+namespace csp::multiplayer
+{
+class IncomingPatchCoalescer;
+}
+
 /*
     Read if you want to support new types!!!
 
@@ -36,6 +41,9 @@
        so it can be serialized to a signalr value.
 
     4. Add a new case in DeserializeComponentData so it can be deserialized from a signalr value.
+
+    5. Add matching PackComponentValue and ReadComponentValue support to MCSMessagePack.cpp,
+       so it can be written and read by the direct MessagePack path.
 */
 
 namespace csp::json
@@ -46,6 +54,8 @@ class JsonDeserializer;
 
 namespace csp::multiplayer::mcs
 {
+class MessagePackReader;
+
 /// @brief All supported MCS types
 enum class ItemComponentDataType : uint64_t
 {
@@ -109,13 +119,18 @@ enum class ItemComponentDataType : uint64_t
 
 class ItemComponentData;
 
+using PropertyKeyType = uint16_t;
+
+/// @brief Map of component data keyed by property key, used for object components and UINT16_DICTIONARY values.
+using ComponentMap = FlatMap<PropertyKeyType, ItemComponentData>;
+
+/// @brief Map of component data keyed by string, used for STRING_DICTIONARY values.
+using StringComponentMap = FlatMap<std::string, ItemComponentData>;
+
 /// @brief Variant that holds all currently implemented MCS types by CSP.
 /// @details This should be updated if we need to support more of the above types in the future.
-/// All of our variant types must match the supported signalr serializer values, or we will get a compile error.
-using ItemComponentDataVariant = std::variant<bool, int64_t, uint64_t, float, std::vector<float>, double, std::string,
-    std::map<uint16_t, ItemComponentData>, std::map<std::string, ItemComponentData>>;
-
-using PropertyKeyType = uint16_t;
+/// Scalars and float arrays of up to 4 elements are held inline, so only strings, larger arrays and maps allocate.
+using ItemComponentDataVariant = std::variant<bool, int64_t, uint64_t, float, FloatArray, double, std::string, ComponentMap, StringComponentMap>;
 
 /// @brief ItemComponentData which represents a MCS component which is stores as a variant.
 /// More information about this type can be found here:
@@ -125,11 +140,16 @@ class ItemComponentData : public ISignalRSerializable, public ISignalRDeserializ
 public:
     ItemComponentData() = default;
     ItemComponentData(const ItemComponentDataVariant& Value);
+    ItemComponentData(ItemComponentDataVariant&& Value);
 
     void Serialize(SignalRSerializer& Serializer) const override;
     void Deserialize(SignalRDeserializer& Deserializer) override;
 
     const ItemComponentDataVariant& GetValue() const;
+    ItemComponentDataVariant& GetMutableValue();
+
+    /// @brief Gets the MCS type of the held value.
+    ItemComponentDataType GetType() const;
 
     bool operator==(const ItemComponentData& Other) const;
 
@@ -143,10 +163,12 @@ private:
 /// https://github.com/magnopus/Magnopus.Services/blob/e7fff2e1171bbe185c0ad1f50fadc1ec64a30a6a/Source/Magnopus.Service.Multiplayer.Contracts/Messages/ObjectMessage.cs
 class ObjectMessage : public ISignalRSerializable, public ISignalRDeserializable
 {
+    friend class MessagePackReader;
+
 public:
     ObjectMessage() = default;
     ObjectMessage(uint64_t Id, uint64_t Type, bool IsTransferable, bool IsPersistent, uint64_t OwnerId, std::optional<uint64_t> ParentId,
-        const std::optional<std::map<PropertyKeyType, ItemComponentData>>& Components);
+        std::optional<ComponentMap> Components);
 
     void Serialize(SignalRSerializer& Serializer) const override;
     void Deserialize(SignalRDeserializer& Deserializer) override;
@@ -159,7 +181,7 @@ public:
     bool GetIsPersistent() const;
     uint64_t GetOwnerId() const;
     std::optional<uint64_t> GetParentId() const;
-    const std::optional<std::map<PropertyKeyType, ItemComponentData>>& GetComponents() const;
+    const std::optional<ComponentMap>& GetComponents() const;
 
 private:
     uint64_t Id = 0;
@@ -168,7 +190,7 @@ private:
     bool IsPersistent = false;
     uint64_t OwnerId = 0;
     std::optional<uint64_t> ParentId;
-    std::optional<std::map<PropertyKeyType, ItemComponentData>> Components;
+    std::optional<ComponentMap> Components;
 };
 
 /// @brief Represents an MCS object patch.
@@ -176,10 +198,13 @@ private:
 /// More information about this type can be found here:
 class ObjectPatch : public ISignalRSerializable, public ISignalRDeserializable
 {
+    friend class MessagePackReader;
+    friend class csp::multiplayer::IncomingPatchCoalescer;
+
 public:
     ObjectPatch() = default;
     ObjectPatch(uint64_t Id, uint64_t OwnerId, bool Destroy, bool ShouldUpdateParent, std::optional<uint64_t> ParentId,
-        const std::map<PropertyKeyType, ItemComponentData>& Components);
+        ComponentMap Components);
 
     void Serialize(SignalRSerializer& Serializer) const override;
     void Deserialize(SignalRDeserializer& Deserializer) override;
@@ -191,7 +216,7 @@ public:
     bool GetDestroy() const;
     bool GetShouldUpdateParent() const;
     std::optional<uint64_t> GetParentId() const;
-    const std::optional<std::map<PropertyKeyType, ItemComponentData>>& GetComponents() const;
+    const std::optional<ComponentMap>& GetComponents() const;
 
 private:
     uint64_t Id = 0;
@@ -199,7 +224,7 @@ private:
     bool Destroy = false;
     bool ShouldUpdateParent = false;
     std::optional<uint64_t> ParentId;
-    std::optional<std::map<PropertyKeyType, ItemComponentData>> Components;
+    std::optional<ComponentMap> Components;
 };
 }
 
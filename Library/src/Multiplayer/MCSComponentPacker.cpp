@@ -1,11 +1,12 @@
 #include "MCSComponentPacker.h"
 #include "CSP/Multiplayer/ComponentBase.h"
+#include "CompactTransform.h"
 #include "SpaceEntityKeys.h"
 
 namespace csp::multiplayer
 {
 
-MCSComponentUnpacker::MCSComponentUnpacker(const std::map<uint16_t, mcs::ItemComponentData>& Components)
+MCSComponentUnpacker::MCSComponentUnpacker(const mcs::ComponentMap& Components)
     : Components { Components }
 {
 }
@@ -20,7 +21,12 @@ bool MCSComponentUnpacker::TryReadValue(uint16_t Key, csp::common::ReplicatedVal
     }
 
     const mcs::ItemComponentData& ComponentData = ComponentDataIt->second;
-    Value = ToReplicatedValue(ComponentData);
+
+    // Transform properties may have been written with the compact encoding, which isn't a direct conversion of the MCS type
+    if (!CompactTransform::TryReadValue(Key, ComponentData, Value))
+    {
+        Value = ToReplicatedValue(ComponentData);
+    }
 
     return true;
 }
@@ -40,7 +46,9 @@ uint64_t MCSComponentUnpacker::GetRuntimeComponentsCount() const
     return ComponentCount;
 }
 
-const std::map<uint16_t, mcs::ItemComponentData>& MCSComponentPacker::GetComponents() const { return Components; }
+const mcs::ComponentMap& MCSComponentPacker::GetComponents() const { return Components; }
+
+mcs::ComponentMap MCSComponentPacker::TakeComponents() { return std::move(Components); }
 
 csp::common::ReplicatedValue ToReplicatedValue(double) { throw std::runtime_error("Unsupported"); }
 
@@ -48,7 +56,7 @@ csp::common::ReplicatedValue ToReplicatedValue(uint64_t Value) { return csp::com
 
 csp::common::ReplicatedValue ToReplicatedValue(const std::string& Value) { return csp::common::ReplicatedValue { Value.c_str() }; }
 
-csp::common::ReplicatedValue ToReplicatedValue(const std::vector<float>& Value)
+csp::common::ReplicatedValue ToReplicatedValue(const mcs::FloatArray& Value)
 {
     if (Value.size() == 2)
     {
@@ -73,9 +81,9 @@ csp::common::ReplicatedValue ToReplicatedValue(const mcs::ItemComponentData& Val
     return std::visit([](const auto& ValueType) { return ToReplicatedValue(ValueType); }, Value.GetValue());
 }
 
-csp::common::ReplicatedValue ToReplicatedValue(const std::map<uint16_t, mcs::ItemComponentData>&) { throw std::runtime_error("Not yet implemented"); }
+csp::common::ReplicatedValue ToReplicatedValue(const mcs::ComponentMap&) { throw std::runtime_error("Not yet implemented"); }
 
-csp::common::ReplicatedValue ToReplicatedValue(const std::map<std::string, mcs::ItemComponentData>& Value)
+csp::common::ReplicatedValue ToReplicatedValue(const mcs::StringComponentMap& Value)
 {
     // Convert string map of ItemComponentData to csp string map of ReplicatedValue.
     csp::common::Map<csp::common::String, csp::common::ReplicatedValue> Map;
@@ -98,14 +106,12 @@ mcs::ItemComponentData ToItemComponentData(ComponentBase* Value)
     ComponentPacker.WriteValue(COMPONENT_KEY_COMPONENTTYPE, static_cast<uint64_t>(Value->GetComponentType()));
 
     // Our current component keys are stores as uint32s when they should really be stored as uint16, as this is what we support.
-    std::unique_ptr<common::Array<uint32_t>> Keys(const_cast<common::Array<uint32_t>*>(Value->GetProperties()->Keys()));
-
-    for (uint32_t Key : *Keys)
+    for (const auto& [Key, Property] : *Value->GetProperties())
     {
-        ComponentPacker.WriteValue(static_cast<uint16_t>(Key), (*Value->GetProperties())[static_cast<uint32_t>(Key)]);
+        ComponentPacker.WriteValue(static_cast<uint16_t>(Key), Property);
     }
 
-    return mcs::ItemComponentData { ComponentPacker.GetComponents() };
+    return mcs::ItemComponentData { ComponentPacker.TakeComponents() };
 }
 
 mcs::ItemComponentData ToItemComponentData(const csp::common::ReplicatedValue& Value)
@@ -128,30 +134,28 @@ mcs::ItemComponentData ToItemComponentData(const csp::common::String& Value) { r
 
 mcs::ItemComponentData ToItemComponentData(const csp::common::Vector3& Value)
 {
-    return mcs::ItemComponentData { std::vector<float> { Value.X, Value.Y, Value.Z } };
+    return mcs::ItemComponentData { mcs::FloatArray { Value.X, Value.Y, Value.Z } };
 }
 
 mcs::ItemComponentData ToItemComponentData(const csp::common::Vector4& Value)
 {
-    return mcs::ItemComponentData { std::vector<float> { Value.X, Value.Y, Value.Z, Value.W } };
+    return mcs::ItemComponentData { mcs::FloatArray { Value.X, Value.Y, Value.Z, Value.W } };
 }
 
 mcs::ItemComponentData ToItemComponentData(const csp::common::Vector2& Value)
 {
-    return mcs::ItemComponentData { std::vector<float> { Value.X, Value.Y } };
+    return mcs::ItemComponentData { mcs::FloatArray { Value.X, Value.Y } };
 }
 
 mcs::ItemComponentData ToItemComponentData(const csp::common::Map<csp::common::String, csp::common::ReplicatedValue>& Value)
 {
-    std::map<std::string, mcs::ItemComponentData> Map;
-    std::unique_ptr<common::Array<csp::common::String>> Keys(const_cast<common::Array<csp::common::String>*>(Value.Keys()));
-
-    for (auto Key : (*Keys))
+    mcs::StringComponentMap Map;
+    for (const auto& [Key, Item] : Value)
     {
-        Map[Key.c_str()] = ToItemComponentData(Value[Key]);
+        Map.insert_or_assign(Key.c_str(), ToItemComponentData(Item));
     }
 
-    return mcs::ItemComponentData { Map };
+    return mcs::ItemComponentData { std::move(Map) };
 }
 
 }
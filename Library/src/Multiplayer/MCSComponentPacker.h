@@ -22,8 +22,6 @@
 #include "MCS/MCSTypes.h"
 #include "Multiplayer/SpaceEntityKeys.h"
 
-#include <map>
-
 namespace csp::multiplayer
 {
 class ComponentBase;
@@ -36,18 +34,22 @@ public:
     template <class T> void WriteValue(uint16_t Key, const T& Value);
     template <class T> void WriteValue(SpaceEntityComponentKey Key, const T& Value);
 
-    const std::map<uint16_t, mcs::ItemComponentData>& GetComponents() const;
+    const mcs::ComponentMap& GetComponents() const;
+
+    /// @brief Moves the packed components out of the packer, leaving it empty.
+    mcs::ComponentMap TakeComponents();
 
 private:
-    std::map<uint16_t, mcs::ItemComponentData> Components;
+    mcs::ComponentMap Components;
 };
 
 /// @brief Helper class to convert mcs domain types to csp types.
 /// @details Reads value from a components maps retrieved from a mcs::ObjectMessage or mcs::ObjectPatch.
+/// The components are referenced rather than copied, so must outlive the unpacker.
 class MCSComponentUnpacker
 {
 public:
-    MCSComponentUnpacker(const std::map<uint16_t, mcs::ItemComponentData>& Components);
+    MCSComponentUnpacker(const mcs::ComponentMap& Components);
 
     bool TryReadValue(uint16_t Key, csp::common::ReplicatedValue& Value) const;
 
@@ -55,7 +57,7 @@ public:
     uint64_t GetRuntimeComponentsCount() const;
 
 private:
-    std::map<uint16_t, mcs::ItemComponentData> Components;
+    const mcs::ComponentMap& Components;
 };
 
 template <class T> inline void MCSComponentPacker::WriteValue(SpaceEntityComponentKey Key, const T& Value)
@@ -73,10 +75,10 @@ template <typename T> std::enable_if_t<std::is_enum_v<T>, csp::common::Replicate
 csp::common::ReplicatedValue ToReplicatedValue(double);
 csp::common::ReplicatedValue ToReplicatedValue(uint64_t Value);
 csp::common::ReplicatedValue ToReplicatedValue(const std::string& Value);
-csp::common::ReplicatedValue ToReplicatedValue(const std::vector<float>& Value);
+csp::common::ReplicatedValue ToReplicatedValue(const mcs::FloatArray& Value);
 csp::common::ReplicatedValue ToReplicatedValue(const mcs::ItemComponentData& Value);
-csp::common::ReplicatedValue ToReplicatedValue(const std::map<uint16_t, mcs::ItemComponentData>&);
-csp::common::ReplicatedValue ToReplicatedValue(const std::map<std::string, mcs::ItemComponentData>& Value);
+csp::common::ReplicatedValue ToReplicatedValue(const mcs::ComponentMap&);
+csp::common::ReplicatedValue ToReplicatedValue(const mcs::StringComponentMap& Value);
 
 mcs::ItemComponentData ToItemComponentData(ComponentBase* Value);
 mcs::ItemComponentData ToItemComponentData(const csp::common::ReplicatedValue& Value);
@@ -90,7 +92,10 @@ mcs::ItemComponentData ToItemComponentData(const csp::common::Vector4& Value);
 mcs::ItemComponentData ToItemComponentData(const csp::common::Vector2& Value);
 mcs::ItemComponentData ToItemComponentData(const csp::common::Map<csp::common::String, csp::common::ReplicatedValue>& Value);
 
-template <class T> inline void MCSComponentPacker::WriteValue(uint16_t Key, const T& Value) { Components[Key] = ToItemComponentData(Value); }
+template <class T> inline void MCSComponentPacker::WriteValue(uint16_t Key, const T& Value)
+{
+    Components.insert_or_assign(Key, ToItemComponentData(Value));
+}
 
 template <typename T> std::enable_if_t<std::is_enum_v<T>, mcs::ItemComponentData> ToItemComponentData(T Value)
 {
@@ -135,8 +135,13 @@ namespace
 
 ISignalRConnection* MultiplayerConnection::MakeSignalRConnection(csp::common::IAuthContext& AuthContext)
 {
+    // Incoming objects and patches are decoded straight from MessagePack by the realtime engine, so the hub protocol passes them through as is.
+    const MultiplayerHubMethodMap HubMethods;
+    const std::vector<std::string> EncodedArgumentMethods { HubMethods.Get(MultiplayerHubMethod::ON_OBJECT_MESSAGE),
+        HubMethods.Get(MultiplayerHubMethod::ON_OBJECT_PATCH) };
+
     return new csp::multiplayer::SignalRConnection(csp::CSPFoundation::GetEndpoints().MultiplayerConnection.GetURI().c_str(), KEEP_ALIVE_INTERVAL,
-        std::make_shared<csp::multiplayer::CSPWebsocketClient>(), AuthContext);
+        std::make_shared<csp::multiplayer::CSPWebsocketClient>(), AuthContext, EncodedArgumentMethods);
 }
 
 MultiplayerConnection::MultiplayerConnection(csp::common::LogSystem& LogSystem, csp::multiplayer::ISignalRConnection& Connection)
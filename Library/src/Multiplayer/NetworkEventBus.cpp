@@ -59,7 +59,13 @@ void NetworkEventBus::ListenNetworkEvent(NetworkEventRegistration Registration,
         return;
     }
 
-    if (RegisteredEvents.find(Registration) != RegisteredEvents.end())
+    auto It = RegisteredEvents.find(std::string(Registration.EventName.c_str()));
+
+    if (It == RegisteredEvents.end())
+    {
+        It = RegisteredEvents.emplace(Registration.EventName.c_str(), EventListeners { NetworkEventFromString(Registration.EventName), {} }).first;
+    }
+    else if (FindListener(It->second.Listeners, Registration.EventReceiverId) != It->second.Listeners.end())
     {
         // We have found an event registered for this event receiver and this event type, double registration is disallowed.
         LogSystem.LogMsg(csp::common::LogLevel::Warning,
@@ -71,12 +77,14 @@ void NetworkEventBus::ListenNetworkEvent(NetworkEventRegistration Registration,
 
     LogSystem.LogMsg(csp::common::LogLevel::Verbose,
         fmt::format("Registering network event. EventReceiverId: {}, Event: {}.", Registration.EventReceiverId, Registration.EventName).c_str());
-    RegisteredEvents[Registration] = Callback;
+    It->second.Listeners.push_back(EventListener { Registration.EventReceiverId, std::make_shared<NetworkEventCallback>(std::move(Callback)) });
 }
 
 void NetworkEventBus::StopListenNetworkEvent(NetworkEventRegistration Registration)
 {
-    if (RegisteredEvents.find(Registration) == RegisteredEvents.end())
+    const auto It = RegisteredEvents.find(std::string(Registration.EventName.c_str()));
+
+    if (It == RegisteredEvents.end() || FindListener(It->second.Listeners, Registration.EventReceiverId) == It->second.Listeners.end())
     {
         LogSystem.LogMsg(csp::common::LogLevel::Verbose,
             fmt::format("Could not find network event registration with EventReceiverId: {}, Event: {}. Deregistration denied.",
@@ -85,28 +93,40 @@ void NetworkEventBus::StopListenNetworkEvent(NetworkEventRegistration Registrati
         return;
     }
 
-    RegisteredEvents.erase(Registration);
+    RemoveListener(It->second, FindListener(It->second.Listeners, Registration.EventReceiverId));
+
+    if (It->second.Listeners.empty())
+    {
+        RegisteredEvents.erase(It);
+    }
 }
 
 void NetworkEventBus::StopListenAllNetworkEvents(const csp::common::String& EventReceiverId)
 {
-    std::vector<NetworkEventRegistration> RegistrationsToRemove {};
+    bool RemovedAny = false;
 
-    for (std::pair<NetworkEventRegistration, NetworkEventCallback> RegAndCallback : RegisteredEvents)
+    for (auto It = RegisteredEvents.begin(); It != RegisteredEvents.end();)
     {
-        if (RegAndCallback.first.EventReceiverId == EventReceiverId)
+        const auto Listener = FindListener(It->second.Listeners, EventReceiverId);
+
+        if (Listener != It->second.Listeners.end())
         {
-            RegistrationsToRemove.push_back(RegAndCallback.first);
+            RemoveListener(It->second, Listener);
+            RemovedAny = true;
         }
-    }
 
-    for (const NetworkEventRegistration& RegToRemove : RegistrationsToRemove)
-    {
-        StopListenNetworkEvent(RegToRemove);
+        if (It->second.Listeners.empty())
+        {
+            It = RegisteredEvents.erase(It);
+        }
+        else
+        {
+            ++It;
+        }
     }
 
     // Just be helpful in case the user was expecting to remove something
-    if (RegistrationsToRemove.size() == 0)
+    if (!RemovedAny)
     {
         LogSystem.LogMsg(csp::common::LogLevel::Log,
             fmt::format("Could not find any network event registration with EventReceiverId: {}. No events were deregistered.", EventReceiverId)
@@ -116,10 +136,22 @@ void NetworkEventBus::StopListenAllNetworkEvents(const csp::common::String& Even
 
 csp::common::Array<NetworkEventRegistration> NetworkEventBus::AllRegistrations() const
 {
-    csp::common::Array<NetworkEventRegistration> Registrations(RegisteredEvents.size());
-    std::transform(RegisteredEvents.cbegin(), RegisteredEvents.cend(), Registrations.begin(),
-        [](const std::pair<NetworkEventRegistration, NetworkEventCallback>& RegAndCallback) { return RegAndCallback.first; });
-    return Registrations;
+    std::vector<NetworkEventRegistration> Registrations;
+
+    for (const auto& [EventName, Entry] : RegisteredEvents)
+    {
+        for (const EventListener& Listener : Entry.Listeners)
+        {
+            if (!Listener.Removed)
+            {
+                Registrations.emplace_back(Listener.EventReceiverId, EventName.c_str());
+            }
+        }
+    }
+
+    csp::common::Array<NetworkEventRegistration> Result(Registrations.size());
+    std::copy(Registrations.cbegin(), Registrations.cend(), Result.begin());
+    return Result;
 }
 
 bool NetworkEventBus::StartEventMessageListening()
@@ -131,56 +163,113 @@ bool NetworkEventBus::StartEventMessageListening()
         return false;
     }
 
-    std::function<void(signalr::value)> EventDispatchCallback = [this](signalr::value Result)
+    std::function<void(signalr::value)> EventDispatchCallback = [this](signalr::value Result) { DispatchEventMessage(Result); };
+
+    MultiplayerConnectionInst->GetSignalRConnection()->On("OnEventMessage", EventDispatchCallback, LogSystem);
+    return true;
+}
+
+void NetworkEventBus::DispatchEventMessage(const signalr::value& Result)
+{
+    if (Result.is_null())
     {
-        if (Result.is_null())
-        {
-            LogSystem.LogMsg(csp::common::LogLevel::Log, "NetworkEventBus unexpectedly received event with null data, returning.");
-            return;
-        }
+        LogSystem.LogMsg(csp::common::LogLevel::Log, "NetworkEventBus unexpectedly received event with null data, returning.");
+        return;
+    }
 
-        std::vector<signalr::value> EventValues = Result.as_array()[0].as_array();
-        const csp::common::String EventTypeStr(EventValues[0].as_string().c_str());
+    // The message is only read from, so it is used in place rather than copied.
+    const std::vector<signalr::value>& EventValues = Result.as_array()[0].as_array();
+    const std::string& EventTypeStr = EventValues[0].as_string();
 
-        // Find all registrations that match this network event type.
-        std::vector<NetworkEventRegistration> MatchingRegistrations;
-        for (auto const& [Registration, CB] : RegisteredEvents)
-        {
-            if (Registration.EventName == EventTypeStr)
-            {
-                MatchingRegistrations.push_back(Registration);
-            }
-        }
+    const auto It = RegisteredEvents.find(EventTypeStr);
 
-        // If we have no registered event matching this string, ignore it entirely.
-        if (MatchingRegistrations.size() == 0)
+    // If we have no registered event matching this string, ignore it entirely, without paying for deserialisation.
+    if (It == RegisteredEvents.end())
+    {
+        if (LogSystem.LoggingEnabled(csp::common::LogLevel::Verbose))
         {
             LogSystem.LogMsg(
                 csp::common::LogLevel::Verbose, fmt::format("Received event {} has no registrations, discarding...", EventTypeStr).c_str());
-            return;
         }
 
-        // Deserialize the signalR packets using the appropriate deserialiser.
-        // This only does anything for internal events, external events will always use the base EventDeserializer.
-        // After this, we'll have ReplicatedValues, which serves as our common exchange type.
-        // NOTE: This is not ideal, we'd rather have systems interpret this data directly. However, that would mean breaking the signalr dependency
-        // in the deserialisation, which is very possible, just a bit time consuming, so we'll do it later.
-        std::unique_ptr<csp::common::NetworkEventData> DeserialisedEventData
-            = DeserialiseForEventType(NetworkEventFromString(EventTypeStr), EventValues);
+        return;
+    }
+
+    // Deserialize the signalR packets using the appropriate deserialiser.
+    // This only does anything for internal events, external events will always use the base EventDeserializer.
+    // After this, we'll have ReplicatedValues, which serves as our common exchange type.
+    // NOTE: This is not ideal, we'd rather have systems interpret this data directly. However, that would mean breaking the signalr dependency
+    // in the deserialisation, which is very possible, just a bit time consuming, so we'll do it later.
+    std::unique_ptr<csp::common::NetworkEventData> DeserialisedEventData = DeserialiseForEventType(It->second.EventType, EventValues);
 
-        // Dispatch the events
-        for (const NetworkEventRegistration& Registration : MatchingRegistrations)
+    // Callbacks may register and deregister listeners. Deregistered listeners are only flagged until the outermost dispatch returns,
+    // so neither the entry nor the indices into its list change under us, and listeners registered by a callback wait for the next event.
+    // Registering a new event name may rehash the map, which invalidates It but not references to its entries.
+    EventListeners& Entry = It->second;
+    ++DispatchDepth;
+
+    const size_t ListenerCount = Entry.Listeners.size();
+
+    for (size_t i = 0; i < ListenerCount; ++i)
+    {
+        if (Entry.Listeners[i].Removed)
         {
-            // Pass NetworkEventData object to user ownership
-            // This may be a subtype, the registrar will know what type they are expecting. External users should
-            // only ever register general purpose events, and thus should only ever get an NetworkEventData, so no need to cast.
-            // The user shouldn't expect the scope of this variable to live beyond the callback
-            RegisteredEvents[Registration](*DeserialisedEventData);
+            continue;
         }
-    };
 
-    MultiplayerConnectionInst->GetSignalRConnection()->On("OnEventMessage", EventDispatchCallback, LogSystem);
-    return true;
+        // Pass NetworkEventData object to user ownership
+        // This may be a subtype, the registrar will know what type they are expecting. External users should
+        // only ever register general purpose events, and thus should only ever get an NetworkEventData, so no need to cast.
+        // The user shouldn't expect the scope of this variable to live beyond the callback
+        const std::shared_ptr<NetworkEventCallback> Callback = Entry.Listeners[i].Callback;
+        (*Callback)(*DeserialisedEventData);
+    }
+
+    if (--DispatchDepth == 0 && HasDeregisteredListeners)
+    {
+        RemoveDeregisteredListeners();
+    }
+}
+
+std::vector<NetworkEventBus::EventListener>::iterator NetworkEventBus::FindListener(
+    std::vector<EventListener>& Listeners, const csp::common::String& EventReceiverId)
+{
+    return std::find_if(Listeners.begin(), Listeners.end(),
+        [&EventReceiverId](const EventListener& Listener) { return !Listener.Removed && Listener.EventReceiverId == EventReceiverId; });
+}
+
+void NetworkEventBus::RemoveListener(EventListeners& Entry, std::vector<EventListener>::iterator Listener)
+{
+    if (DispatchDepth > 0)
+    {
+        Listener->Removed = true;
+        HasDeregisteredListeners = true;
+    }
+    else
+    {
+        Entry.Listeners.erase(Listener);
+    }
+}
+
+void NetworkEventBus::RemoveDeregisteredListeners()
+{
+    for (auto It = RegisteredEvents.begin(); It != RegisteredEvents.end();)
+    {
+        std::vector<EventListener>& Listeners = It->second.Listeners;
+        Listeners.erase(
+            std::remove_if(Listeners.begin(), Listeners.end(), [](const EventListener& Listener) { return Listener.Removed; }), Listeners.end());
+
+        if (Listeners.empty())
+        {
+            It = RegisteredEvents.erase(It);
+        }
+        else
+        {
+            ++It;
+        }
+    }
+
+    HasDeregisteredListeners = false;
 }
 
 void NetworkEventBus::SendNetworkEvent(
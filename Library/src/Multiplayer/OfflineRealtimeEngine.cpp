@@ -24,8 +24,13 @@
 #include "Common/UUIDGenerator.h"
 #include "Events/EventListener.h"
 #include "Events/EventSystem.h"
+#include "Multiplayer/MCS/MCSSceneCheckpoint.h"
 #include "Multiplayer/RealtimeEngineUtils.h"
 #include "Multiplayer/Script/EntityScriptBinding.h"
+#include "Multiplayer/SpaceEntityIndex.h"
+#include "Multiplayer/SpaceEntitySpatialIndex.h"
+#include "Multiplayer/SpaceEntityStatePatcher.h"
+#include "Json/JsonSerializer.h"
 
 #include "CSP/Common/fmt_Formatters.h"
 
@@ -108,6 +113,8 @@ OfflineRealtimeEngine::OfflineRealtimeEngine(
 OfflineRealtimeEngine::OfflineRealtimeEngine(csp::common::LogSystem& LogSystem, csp::common::IJSScriptRunner& RemoteScriptRunner)
     : LogSystem { &LogSystem }
     , ScriptRunner { &RemoteScriptRunner }
+    , EntityIndex { std::make_unique<SpaceEntityIndex>() }
+    , SpatialIndex { std::make_unique<SpaceEntitySpatialIndex>() }
 {
     ScriptBinding = EntityScriptBinding::BindEntitySystem(this, *this->LogSystem, *this->ScriptRunner);
 
@@ -139,6 +146,8 @@ void csp::multiplayer::OfflineRealtimeEngine::CreateAvatar(const csp::common::St
 
     Entities.Append(NewAvatar.get());
     Avatars.Append(NewAvatar.get());
+    EntityIndex->Add(NewAvatar.get());
+    SpatialIndex->Add(NewAvatar.get());
 
     Callback(NewAvatar.release());
 }
@@ -158,6 +167,8 @@ void OfflineRealtimeEngine::CreateEntity(const csp::common::String& Name, const
 
     Entities.Append(NewEntity);
     Objects.Append(NewEntity);
+    EntityIndex->Add(NewEntity);
+    SpatialIndex->Add(NewEntity);
 
     Callback(NewEntity);
 }
@@ -186,14 +197,8 @@ void OfflineRealtimeEngine::DestroyEntity(csp::multiplayer::SpaceEntity* Entity,
     // At time of writing, the only reason to do this is to call cleanup behaviour in ConversationSpaceComponent.
     // This feels like an unfortunate pattern break and an unnecesary concept (OnLocalDelete). An opportunity to
     // refactor. This also happens in OnlineRealtimeEngine.
-    auto EntityComponents = Entity->GetComponents();
-
-    using KeysType = std::remove_pointer_t<decltype(EntityComponents)>::MapType::key_type;
-    std::unique_ptr<const csp::common::Array<KeysType>> Keys(EntityComponents->Keys());
-
-    for (size_t i = 0; i < Keys->Size(); ++i)
+    for (const auto& [Key, EntityComponent] : *Entity->GetComponents())
     {
-        auto EntityComponent = Entity->GetComponent((*Keys)[i]);
         EntityComponent->OnLocalDelete();
     }
 
@@ -210,6 +215,13 @@ void OfflineRealtimeEngine::DestroyEntity(csp::multiplayer::SpaceEntity* Entity,
     AvatarOrObjectList.RemoveItem(Entity);
     RealtimeEngineUtils::RemoveParentChildRelationshipsFromEntity(*this, RootHierarchyEntities, Entity);
     Entities.RemoveItem(Entity);
+    EntityIndex->Remove(Entity);
+    SpatialIndex->Remove(Entity);
+
+    {
+        std::scoped_lock DirtyTransformRootsLocker(DirtyTransformRootsLock);
+        DirtyTransformRoots.erase(Entity);
+    }
 
     delete (Entity);
 
@@ -250,22 +262,32 @@ bool OfflineRealtimeEngine::RemoveEntityFromSelectedEntities(csp::multiplayer::S
 
 csp::multiplayer::SpaceEntity* OfflineRealtimeEngine::FindSpaceEntity(const csp::common::String& Name)
 {
-    return RealtimeEngineUtils::FindSpaceEntity(*this, Name);
+    return EntityIndex->FindByName(Name);
 }
 
 csp::multiplayer::SpaceEntity* OfflineRealtimeEngine::FindSpaceEntityById(uint64_t EntityId)
 {
-    return RealtimeEngineUtils::FindSpaceEntityById(*this, EntityId);
+    return EntityIndex->FindById(EntityId);
 }
 
 csp::multiplayer::SpaceEntity* OfflineRealtimeEngine::FindSpaceAvatar(const csp::common::String& Name)
 {
-    return RealtimeEngineUtils::FindSpaceAvatar(*this, Name);
+    return EntityIndex->FindByName(Name, SpaceEntityType::Avatar);
 }
 
 csp::multiplayer::SpaceEntity* OfflineRealtimeEngine::FindSpaceObject(const csp::common::String& Name)
 {
-    return RealtimeEngineUtils::FindSpaceObject(*this, Name);
+    return EntityIndex->FindByName(Name, SpaceEntityType::Object);
+}
+
+csp::common::List<csp::multiplayer::SpaceEntity*> OfflineRealtimeEngine::FindSpaceEntitiesByName(const csp::common::String& Name)
+{
+    return RealtimeEngineUtils::ToList(EntityIndex->GetEntitiesByName(Name));
+}
+
+csp::common::List<csp::multiplayer::SpaceEntity*> OfflineRealtimeEngine::FindSpaceEntitiesWithComponent(ComponentType Type)
+{
+    return RealtimeEngineUtils::ToList(EntityIndex->GetEntitiesWithComponentType(Type));
 }
 
 csp::multiplayer::SpaceEntity* OfflineRealtimeEngine::GetEntityByIndex(size_t EntityIndex) { return Entities[EntityIndex]; }
@@ -284,6 +306,27 @@ size_t OfflineRealtimeEngine::GetNumObjects() const { return Objects.Size(); }
 
 const csp::common::List<csp::multiplayer::SpaceEntity*>* OfflineRealtimeEngine::GetRootHierarchyEntities() const { return &RootHierarchyEntities; }
 
+csp::common::List<csp::multiplayer::SpaceEntity*> OfflineRealtimeEngine::FindSpaceEntitiesInRadius(const csp::common::Vector3& Position, float Radius)
+{
+    std::scoped_lock EntitiesLocker(EntitiesLock);
+
+    return RealtimeEngineUtils::FindSpaceEntitiesInRadius(*SpatialIndex, Position, Radius);
+}
+
+csp::common::List<csp::multiplayer::SpaceEntity*> OfflineRealtimeEngine::FindNearestSpaceEntities(const csp::common::Vector3& Position, size_t Count)
+{
+    std::scoped_lock EntitiesLocker(EntitiesLock);
+
+    return RealtimeEngineUtils::FindNearestSpaceEntities(*SpatialIndex, Position, Count);
+}
+
+csp::common::List<csp::multiplayer::SpaceEntity*> OfflineRealtimeEngine::FindSpaceEntitiesInFrustum(const csp::common::List<csp::common::Vector4>& Planes)
+{
+    std::scoped_lock EntitiesLocker(EntitiesLock);
+
+    return RealtimeEngineUtils::FindSpaceEntitiesInFrustum(*SpatialIndex, Planes);
+}
+
 void OfflineRealtimeEngine::ResolveEntityHierarchy(csp::multiplayer::SpaceEntity* Entity)
 {
     RealtimeEngineUtils::ResolveEntityHierarchy(*this, RootHierarchyEntities, Entity);
@@ -322,6 +365,82 @@ ModifiableStatus OfflineRealtimeEngine::IsEntityModifiable(const csp::multiplaye
 
 std::recursive_mutex& OfflineRealtimeEngine::GetEntitiesLock() { return EntitiesLock; }
 
+void OfflineRealtimeEngine::OnEntitySelectionChanged(SpaceEntity* Entity, uint64_t PreviousClientId)
+{
+    EntityIndex->OnSelectingClientChanged(Entity, PreviousClientId, Entity->GetSelectingClientID());
+}
+
+void OfflineRealtimeEngine::OnEntityTransformInvalidated(SpaceEntity* Entity)
+{
+    SpatialIndex->MarkMoved(Entity);
+
+    // Entities under a dirty parent are reached by the walk down from whichever root that parent is under.
+    const SpaceEntity* Parent = Entity->GetParentEntity();
+
+    if (Parent == nullptr || !Parent->IsGlobalTransformDirty())
+    {
+        std::scoped_lock DirtyTransformRootsLocker(DirtyTransformRootsLock);
+        DirtyTransformRoots.insert(Entity);
+    }
+}
+
+void OfflineRealtimeEngine::OnEntityNameChanged(SpaceEntity* Entity) { EntityIndex->OnNameChanged(Entity); }
+
+void OfflineRealtimeEngine::OnEntityComponentAdded(SpaceEntity* Entity, ComponentType Type) { EntityIndex->OnComponentAdded(Entity, Type); }
+
+void OfflineRealtimeEngine::OnEntityComponentRemoved(SpaceEntity* Entity, ComponentType Type) { EntityIndex->OnComponentRemoved(Entity, Type); }
+
+void OfflineRealtimeEngine::UpdateGlobalTransforms()
+{
+    std::scoped_lock EntitiesLocker(EntitiesLock);
+
+    {
+        std::scoped_lock DirtyTransformRootsLocker(DirtyTransformRootsLock);
+        GlobalTransformUpdateOrder.assign(DirtyTransformRoots.begin(), DirtyTransformRoots.end());
+        DirtyTransformRoots.clear();
+    }
+
+    RealtimeEngineUtils::UpdateGlobalTransforms(GlobalTransformUpdateOrder);
+
+    // The global positions were all just computed, so this is the cheapest point to bring the spatial index up to date.
+    SpatialIndex->Refresh();
+}
+
+CSPSceneDescription OfflineRealtimeEngine::CreateCheckpoint()
+{
+    std::scoped_lock EntitiesLocker(EntitiesLock);
+
+    mcs::SceneCheckpointWriter Writer;
+
+    for (size_t i = 0; i < Entities.Size(); ++i)
+    {
+        Writer.Write(SpaceEntityStatePatcher::ObjectMessageFromEntity(*Entities[i]));
+    }
+
+    return CSPSceneDescription { Writer.TakeData() };
+}
+
+csp::common::String OfflineRealtimeEngine::CreateSceneDescriptionJson()
+{
+    std::scoped_lock EntitiesLocker(EntitiesLock);
+
+    std::string Json = R"({"data":{"objectMessages":[)";
+
+    for (size_t i = 0; i < Entities.Size(); ++i)
+    {
+        if (i > 0)
+        {
+            Json += ',';
+        }
+
+        Json += csp::json::JsonSerializer::Serialize(SpaceEntityStatePatcher::ObjectMessageFromEntity(*Entities[i])).c_str();
+    }
+
+    Json += "]}}";
+
+    return csp::common::String { Json.c_str(), Json.size() };
+}
+
 uint64_t OfflineRealtimeEngine::LocalClientId() { return csp::common::LocalClientID; }
 
 void OfflineRealtimeEngine::AddEntity(SpaceEntity* EntityToAdd)
@@ -334,9 +453,10 @@ void OfflineRealtimeEngine::AddEntity(SpaceEntity* EntityToAdd)
 
     std::scoped_lock EntitiesLocker(EntitiesLock);
 
-    if (FindSpaceEntityById(EntityToAdd->GetId()) == nullptr)
+    if (EntityIndex->Add(EntityToAdd))
     {
         Entities.Append(EntityToAdd);
+        SpatialIndex->Add(EntityToAdd);
 
         switch (EntityToAdd->GetEntityType())
         {
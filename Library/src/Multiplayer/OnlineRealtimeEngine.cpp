@@ -15,6 +15,7 @@
  */
 #include "CSP/Multiplayer/OnlineRealtimeEngine.h"
 
+#include "CSP/Common/CSPAsyncScheduler.h"
 #include "CSP/Common/List.h"
 #include "CSP/Common/LoginState.h"
 #include "CSP/Common/StringFormat.h"
@@ -27,16 +28,24 @@
 #include "CSP/Multiplayer/Script/EntityScript.h"
 #include "CSP/Multiplayer/Script/EntityScriptMessages.h"
 #include "CSP/Multiplayer/SpaceEntity.h"
+#include "Common/Systems/Log/LogMacros.h"
 #include "Events/EventListener.h"
 #include "Events/EventSystem.h"
+#include "MCS/MCSMessagePack.h"
 #include "MCS/MCSTypes.h"
+#include "Multiplayer/CompactTransform.h"
 #include "Multiplayer/Election/ClientElectionManager.h"
 #include "Multiplayer/Election/ScopeLeadershipManager.h"
+#include "Multiplayer/EntityInterestManager.h"
+#include "Multiplayer/IncomingPatchCoalescer.h"
 #include "Multiplayer/MultiplayerConstants.h"
+#include "Multiplayer/OutgoingPatchScheduler.h"
 #include "Multiplayer/RealtimeEngineUtils.h"
 #include "Multiplayer/Script/EntityScriptBinding.h"
 #include "Multiplayer/SignalR/ISignalRConnection.h"
 #include "Multiplayer/SignalR/SignalRClient.h"
+#include "Multiplayer/SpaceEntityIndex.h"
+#include "Multiplayer/SpaceEntitySpatialIndex.h"
 #include "Multiplayer/SpaceEntityStatePatcher.h"
 #include "RealtimeEngineUtils.h"
 #include "SignalRSerializer.h"
@@ -51,6 +60,7 @@
 #include <fmt/format.h>
 #include <iostream>
 #include <map>
+#include <optional>
 #include <unordered_set>
 #include <utility>
 
@@ -90,6 +100,34 @@ uint64_t ParseGenerateObjectIDsResult(const signalr::value& Result, csp::common:
 
     return EntityId;
 }
+
+// Invocation arguments made of a single argument, already encoded by the writer.
+signalr::value CreateEncodedArguments(const csp::multiplayer::mcs::MessagePackWriter& Writer)
+{
+    return signalr::value { std::vector<signalr::value> { Writer.ToSignalRValue() } };
+}
+
+// Incoming objects and patches are still MessagePack encoded when they come from a connection built to pass them through,
+// and value trees otherwise, e.g. from an injected connection.
+template <typename T> void ReadIncoming(csp::multiplayer::mcs::MessagePackReader& Reader, const signalr::value& Value, T& OutValue)
+{
+    if (Value.is_messagepack())
+    {
+        const std::string& Encoded = Value.as_messagepack();
+        Reader.Read(Encoded.data(), Encoded.size(), OutValue);
+    }
+    else
+    {
+        csp::multiplayer::SignalRDeserializer Deserializer { Value };
+        Deserializer.ReadValue(OutValue);
+    }
+}
+
+// Receiver ids are unique per listener on the bus, and several engines may share one bus, so each engine listens under its own id.
+csp::common::String GetNetworkEventReceiverId(const void* RealtimeEngine)
+{
+    return fmt::format("CSPInternal::OnlineRealtimeEngine::{}", RealtimeEngine).c_str();
+}
 } // namespace
 
 template class csp::common::List<csp::multiplayer::SpaceEntity*>;
@@ -98,6 +136,7 @@ namespace csp::multiplayer
 {
 
 constexpr uint64_t ENTITY_PAGE_LIMIT = 100;
+constexpr std::chrono::milliseconds DEFAULT_ENTITY_PATCH_INTERVAL { 90 };
 
 class SpaceEntityEventHandler : public csp::events::EventListener
 {
@@ -162,8 +201,16 @@ using namespace std::chrono;
 
 OnlineRealtimeEngine::OnlineRealtimeEngine()
     : EntitiesLock(new std::recursive_mutex)
+    , EntityIndex(std::make_unique<SpaceEntityIndex>())
     , MultiplayerConnectionInst(nullptr)
     , LogSystem(nullptr)
+    , PatchWriter(std::make_unique<mcs::MessagePackWriter>())
+    , PatchReader(std::make_unique<mcs::MessagePackReader>())
+    , PatchCoalescer(std::make_unique<IncomingPatchCoalescer>())
+    , PatchScheduler(std::make_unique<OutgoingPatchScheduler>(DEFAULT_ENTITY_PATCH_INTERVAL))
+    , PatchBudgetWriter(std::make_unique<mcs::MessagePackWriter>())
+    , SpatialIndex(std::make_unique<SpaceEntitySpatialIndex>())
+    , InterestManager(std::make_unique<EntityInterestManager>())
     , ScriptBinding(nullptr)
     , EventHandler(nullptr)
     , ElectionManager(nullptr)
@@ -174,7 +221,6 @@ OnlineRealtimeEngine::OnlineRealtimeEngine()
     , PendingIncomingUpdates(nullptr)
     , EnableEntityTick(false)
     , LastTickTime(std::chrono::system_clock::now())
-    , EntityPatchRate(90)
     , ScriptRunner(nullptr)
     , NetworkEventBus(nullptr)
 {
@@ -183,8 +229,16 @@ OnlineRealtimeEngine::OnlineRealtimeEngine()
 OnlineRealtimeEngine::OnlineRealtimeEngine(MultiplayerConnection& InMultiplayerConnection, csp::common::LogSystem& LogSystem,
     csp::multiplayer::NetworkEventBus& NetworkEventBus, csp::common::IJSScriptRunner& ScriptRunner)
     : EntitiesLock(new std::recursive_mutex)
+    , EntityIndex(std::make_unique<SpaceEntityIndex>())
     , MultiplayerConnectionInst(&InMultiplayerConnection)
     , LogSystem(&LogSystem)
+    , PatchWriter(std::make_unique<mcs::MessagePackWriter>())
+    , PatchReader(std::make_unique<mcs::MessagePackReader>())
+    , PatchCoalescer(std::make_unique<IncomingPatchCoalescer>())
+    , PatchScheduler(std::make_unique<OutgoingPatchScheduler>(DEFAULT_ENTITY_PATCH_INTERVAL))
+    , PatchBudgetWriter(std::make_unique<mcs::MessagePackWriter>())
+    , SpatialIndex(std::make_unique<SpaceEntitySpatialIndex>())
+    , InterestManager(std::make_unique<EntityInterestManager>())
     , EventHandler(new SpaceEntityEventHandler(this))
     , ElectionManager(nullptr)
     , TickEntitiesLock(new std::recursive_mutex)
@@ -194,17 +248,26 @@ OnlineRealtimeEngine::OnlineRealtimeEngine(MultiplayerConnection& InMultiplayerC
     , PendingIncomingUpdates(new(PatchMessageQueue))
     , EnableEntityTick(false)
     , LastTickTime(std::chrono::system_clock::now())
-    , EntityPatchRate(90)
     , ScriptRunner(&ScriptRunner)
     , NetworkEventBus(&NetworkEventBus)
 {
     ScriptBinding = EntityScriptBinding::BindEntitySystem(this, *this->LogSystem, *this->ScriptRunner);
 
     csp::events::EventSystem::Get().RegisterListener(csp::events::FOUNDATION_TICK_EVENT_ID, EventHandler);
+
+    this->NetworkEventBus->ListenNetworkEvent(
+        csp::multiplayer::NetworkEventRegistration { GetNetworkEventReceiverId(this), CompactTransform::SUPPORT_MESSAGE },
+        [this](const csp::common::NetworkEventData& EventData) { this->OnCompactTransformSupportEvent(EventData); });
 }
 
 OnlineRealtimeEngine::~OnlineRealtimeEngine()
 {
+    if (NetworkEventBus != nullptr)
+    {
+        NetworkEventBus->StopListenNetworkEvent(
+            csp::multiplayer::NetworkEventRegistration(GetNetworkEventReceiverId(this), CompactTransform::SUPPORT_MESSAGE));
+    }
+
     DisableLeaderElection();
     LocalDestroyAllEntities();
 
@@ -258,14 +321,13 @@ std::function<async::task<uint64_t>(uint64_t)> OnlineRealtimeEngine::SendNewAvat
         auto NewAvatar = RealtimeEngineUtils::BuildNewAvatar(UserId, *this, *this->ScriptRunner, *LogSystem, NetworkId, Name, Transform, IsVisible,
             MultiplayerConnectionInst->GetClientId(), false, false, AvatarId, AvatarState, AvatarPlayMode, LocomotionModel);
 
-        const mcs::ObjectMessage Message = NewAvatar->GetStatePatcher()->CreateObjectMessage();
-
-        SignalRSerializer Serializer;
-        Serializer.WriteValue(std::vector<mcs::ObjectMessage> { Message });
+        mcs::MessagePackWriter Writer;
+        Writer.Write(NewAvatar->GetStatePatcher()->CreateObjectMessage());
 
         // Explicitly specify types when dealing with signalr values, initializer list schenanigans abound.
         return MultiplayerConnectionInst->GetSignalRConnection()
-            ->Invoke(MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::SEND_OBJECT_MESSAGE), Serializer.Get(),
+            ->Invoke(MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::SEND_OBJECT_MESSAGE),
+                CreateEncodedArguments(Writer),
                 [](const signalr::value&, std::exception_ptr) {})
             .then(multiplayer::continuations::UnwrapSignalRResultOrThrow())
             .then([NetworkId]() { return NetworkId; });
@@ -305,6 +367,7 @@ std::function<void(uint64_t)> OnlineRealtimeEngine::CreateNewLocalAvatar(const c
         SpaceEntity* ReleasedAvatar = NewAvatar.release();
         Entities.Append(ReleasedAvatar);
         Avatars.Append(ReleasedAvatar);
+        EntityIndex->Add(ReleasedAvatar);
         ReleasedAvatar->ApplyLocalPatch(false, GetMultiplayerConnectionInstance()->GetAllowSelfMessagingFlag());
 
         if (ElectionManager != nullptr)
@@ -357,10 +420,8 @@ void OnlineRealtimeEngine::CreateEntity(const csp::common::String& Name, const c
         auto* NewObject = new SpaceEntity(this, *ScriptRunner, LogSystem, SpaceEntityType::Object, ID, Name, SpaceTransform,
             MultiplayerConnectionInst->GetClientId(), ParentID, true, true);
 
-        const mcs::ObjectMessage Message = NewObject->GetStatePatcher()->CreateObjectMessage();
-
-        SignalRSerializer Serializer;
-        Serializer.WriteValue(std::vector<mcs::ObjectMessage> { Message });
+        mcs::MessagePackWriter Writer;
+        Writer.Write(NewObject->GetStatePatcher()->CreateObjectMessage());
 
         const std::function<void(signalr::value, std::exception_ptr)> LocalSendCallback
             = [this, Callback, NewObject, &LogSystem = this->LogSystem](const signalr::value& /*Result*/, const std::exception_ptr& Except)
@@ -385,11 +446,12 @@ void OnlineRealtimeEngine::CreateEntity(const csp::common::String& Name, const c
 
             Entities.Append(NewObject);
             Objects.Append(NewObject);
+            EntityIndex->Add(NewObject);
             Callback(NewObject);
         };
 
         MultiplayerConnectionInst->GetSignalRConnection()->Invoke(
-            MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::SEND_OBJECT_MESSAGE), Serializer.Get(),
+            MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::SEND_OBJECT_MESSAGE), CreateEncodedArguments(Writer),
             LocalSendCallback);
     };
 
@@ -450,17 +512,11 @@ void OnlineRealtimeEngine::DestroyEntity(SpaceEntity* Entity, CallbackHandler Ca
         ObjectPatches.push_back(signalr::value { ChildParentIdPatch });
     }
 
-    auto EntityComponents = Entity->GetComponents();
-    auto Keys = EntityComponents->Keys();
-
-    for (size_t i = 0; i < Keys->Size(); ++i)
+    for (const auto& [Key, EntityComponent] : *Entity->GetComponents())
     {
-        auto EntityComponent = Entity->GetComponent((*Keys)[i]);
         EntityComponent->OnLocalDelete();
     }
 
-    delete (Keys);
-
     RootHierarchyEntities.RemoveItem(Entity);
 
     RealtimeEngineUtils::LocalProcessChildUpdates(*this, RootHierarchyEntities, Entity);
@@ -491,26 +547,32 @@ void OnlineRealtimeEngine::LocalDestroyEntity(SpaceEntity* Entity)
 
 SpaceEntity* OnlineRealtimeEngine::FindSpaceEntity(const csp::common::String& InName)
 {
-    std::scoped_lock EntitiesLocker(*EntitiesLock);
-    return RealtimeEngineUtils::FindSpaceEntity(*this, InName);
+    return EntityIndex->FindByName(InName);
 }
 
 SpaceEntity* OnlineRealtimeEngine::FindSpaceEntityById(uint64_t EntityId)
 {
-    std::scoped_lock EntitiesLocker(*EntitiesLock);
-    return RealtimeEngineUtils::FindSpaceEntityById(*this, EntityId);
+    return EntityIndex->FindById(EntityId);
 }
 
 SpaceEntity* OnlineRealtimeEngine::FindSpaceAvatar(const csp::common::String& InName)
 {
-    std::scoped_lock EntitiesLocker(*EntitiesLock);
-    return RealtimeEngineUtils::FindSpaceAvatar(*this, InName);
+    return EntityIndex->FindByName(InName, SpaceEntityType::Avatar);
 }
 
 SpaceEntity* OnlineRealtimeEngine::FindSpaceObject(const csp::common::String& InName)
 {
-    std::scoped_lock EntitiesLocker(*EntitiesLock);
-    return RealtimeEngineUtils::FindSpaceObject(*this, InName);
+    return EntityIndex->FindByName(InName, SpaceEntityType::Object);
+}
+
+csp::common::List<SpaceEntity*> OnlineRealtimeEngine::FindSpaceEntitiesByName(const csp::common::String& Name)
+{
+    return RealtimeEngineUtils::ToList(EntityIndex->GetEntitiesByName(Name));
+}
+
+csp::common::List<SpaceEntity*> OnlineRealtimeEngine::FindSpaceEntitiesWithComponent(ComponentType Type)
+{
+    return RealtimeEngineUtils::ToList(EntityIndex->GetEntitiesWithComponentType(Type));
 }
 
 void OnlineRealtimeEngine::SetRemoteEntityCreatedCallback(EntityCreatedCallback Callback)
@@ -533,6 +595,31 @@ bool OnlineRealtimeEngine::AddEntityToSelectedEntities(csp::multiplayer::SpaceEn
     return false;
 }
 
+void OnlineRealtimeEngine::OnEntitySelectionChanged(SpaceEntity* Entity, uint64_t PreviousClientId)
+{
+    EntityIndex->OnSelectingClientChanged(Entity, PreviousClientId, Entity->GetSelectingClientID());
+}
+
+void OnlineRealtimeEngine::OnEntityTransformInvalidated(SpaceEntity* Entity)
+{
+    SpatialIndex->MarkMoved(Entity);
+
+    // Entities under a dirty parent are reached by the walk down from whichever root that parent is under.
+    const SpaceEntity* Parent = Entity->GetParentEntity();
+
+    if (Parent == nullptr || !Parent->IsGlobalTransformDirty())
+    {
+        std::scoped_lock DirtyTransformRootsLocker(DirtyTransformRootsLock);
+        DirtyTransformRoots.insert(Entity);
+    }
+}
+
+void OnlineRealtimeEngine::OnEntityNameChanged(SpaceEntity* Entity) { EntityIndex->OnNameChanged(Entity); }
+
+void OnlineRealtimeEngine::OnEntityComponentAdded(SpaceEntity* Entity, ComponentType Type) { EntityIndex->OnComponentAdded(Entity, Type); }
+
+void OnlineRealtimeEngine::OnEntityComponentRemoved(SpaceEntity* Entity, ComponentType Type) { EntityIndex->OnComponentRemoved(Entity, Type); }
+
 bool OnlineRealtimeEngine::RemoveEntityFromSelectedEntities(csp::multiplayer::SpaceEntity* Entity)
 {
     if (SelectedEntities.Contains(Entity))
@@ -583,8 +670,8 @@ SpaceEntity* OnlineRealtimeEngine::CreateRemotelyRetrievedEntity(const signalr::
 {
     //  Create object message from signalr value
     mcs::ObjectMessage Message;
-    SignalRDeserializer Deserializer { EntityMessage };
-    Deserializer.ReadValue(Message);
+    mcs::MessagePackReader Reader;
+    ReadIncoming(Reader, EntityMessage, Message);
 
     auto NewEntity = SpaceEntityStatePatcher::NewFromObjectMessage(Message, *this, *ScriptRunner, *LogSystem);
 
@@ -622,16 +709,14 @@ void OnlineRealtimeEngine::OnRequestToSendObject(const signalr::value& Params)
     // TODO: add ability to check for ID or get by ID from Entity List (maybe change to Map<EntityID, Entity> ?)
     if (SpaceEntity* MatchedEntity = FindSpaceEntityById(EntityID))
     {
-        mcs::ObjectMessage Message = MatchedEntity->GetStatePatcher()->CreateObjectMessage();
-
-        SignalRSerializer Serializer;
-        Serializer.WriteValue(std::vector<mcs::ObjectMessage> { Message });
+        mcs::MessagePackWriter Writer;
+        Writer.Write(MatchedEntity->GetStatePatcher()->CreateObjectMessage());
 
         const std::function LocalSendCallback
             = [this](const signalr::value&, const std::exception_ptr& Except) { HandleException(Except, "Failed to send server requested object."); };
 
         MultiplayerConnectionInst->GetSignalRConnection()->Invoke(
-            MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::SEND_OBJECT_MESSAGE), Serializer.Get(),
+            MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::SEND_OBJECT_MESSAGE), CreateEncodedArguments(Writer),
             LocalSendCallback);
     }
     else
@@ -704,87 +789,307 @@ void OnlineRealtimeEngine::GetEntitiesPaged(int Skip, int Limit, const std::func
         MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::PAGE_SCOPED_OBJECTS), Params, Callback);
 }
 
-std::function<void(const signalr::value&, std::exception_ptr)> OnlineRealtimeEngine::CreateRetrieveAllEntitiesCallback(
-    int Skip, csp::common::EntityFetchCompleteCallback FetchCompleteCallback)
+struct OnlineRealtimeEngine::EntityFetchState
+{
+    // A page of entities that has been decoded, but not yet turned into entities and committed to the entity lists.
+    struct FetchedPage
+    {
+        // Entities that failed to decode are left empty.
+        std::vector<std::optional<mcs::ObjectMessage>> Messages;
+        int ItemCount = 0;
+        bool IsFinal = false;
+    };
+
+    explicit EntityFetchState(csp::common::EntityFetchCompleteCallback InFetchCompleteCallback)
+        : FetchCompleteCallback(std::move(InFetchCompleteCallback))
+        , StartTime(std::chrono::steady_clock::now())
+    {
+    }
+
+    csp::common::EntityFetchCompleteCallback FetchCompleteCallback;
+    std::chrono::steady_clock::time_point StartTime;
+
+    std::mutex Mutex;
+    // Pages that have been decoded, keyed by their Skip. Committed in order, starting from NextCommitSkip.
+    std::map<int, FetchedPage> FetchedPages;
+    int NextCommitSkip = 0;
+    // Set while a thread is committing pages, so pages that arrive in the meantime are committed by that thread instead.
+    bool Committing = false;
+
+    EntityFetchMetrics Metrics;
+};
+
+namespace
+{
+    // Runs Func for every index in [0, Count) on the worker pool, returning once all have finished.
+    // The inline scheduler is used on WASM, where we can't rely on having worker threads.
+    template <typename Func> void ParallelForEachIndex(size_t Count, const Func& Function)
+    {
+#ifdef CSP_WASM
+        async::parallel_for(async::inline_scheduler(), async::irange(size_t { 0 }, Count), Function);
+#else
+        async::parallel_for(async::default_threadpool_scheduler(), async::irange(size_t { 0 }, Count), Function);
+#endif
+    }
+
+    std::chrono::microseconds MicrosecondsSince(std::chrono::steady_clock::time_point Start)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start);
+    }
+}
+
+void OnlineRealtimeEngine::RequestEntityPage(int Skip, const std::shared_ptr<EntityFetchState>& FetchState)
 {
-    const std::function Callback = [this, Skip, FetchCompleteCallback](const signalr::value& Result, std::exception_ptr Except)
+    const auto RequestTime = std::chrono::steady_clock::now();
+
+    const std::function Callback = [this, Skip, FetchState, RequestTime](const signalr::value& Result, std::exception_ptr Except)
     {
-        HandleException(Except, "Failed to retrieve paged entities.");
+        const auto NetworkWait = MicrosecondsSince(RequestTime);
 
-        const auto& Results = Result.as_array();
-        const auto& Items = Results[0].as_array();
-        auto ItemTotalCount = Results[1].as_uinteger();
+        // A page that can't be read ends the fetch with the entities we already have, so that the fetch still completes.
+        const auto EndFetch = [this, Skip, &FetchState]()
+        {
+            {
+                std::scoped_lock FetchLocker(FetchState->Mutex);
+                FetchState->FetchedPages[Skip].IsFinal = true;
+            }
 
-        for (const auto& EntityMessage : Items)
+            CommitFetchedEntityPages(*FetchState);
+        };
+
+        if (Except)
         {
-            SpaceEntity* NewEntity = CreateRemotelyRetrievedEntity(EntityMessage);
-            FireRemoteSpaceEntityCreatedCallback(NewEntity, RemoteSpaceEntityCreatedCallback, *LogSystem);
+            HandleException(Except, "Failed to retrieve paged entities.");
+            EndFetch();
+            return;
         }
 
-        int CurrentEntityCount = Skip + static_cast<int>(Items.size());
+        const std::vector<signalr::value>* PageItems = nullptr;
+        uint64_t ItemTotalCount = 0;
 
-        if (static_cast<uint64_t>(CurrentEntityCount) < ItemTotalCount)
+        try
         {
-            GetEntitiesPaged(CurrentEntityCount, ENTITY_PAGE_LIMIT, CreateRetrieveAllEntitiesCallback(CurrentEntityCount, FetchCompleteCallback));
+            const auto& Results = Result.as_array();
+            PageItems = &Results.at(0).as_array();
+            ItemTotalCount = Results.at(1).as_uinteger();
         }
-        else
+        catch (const std::exception& Exception)
         {
-            std::scoped_lock EntitiesLocker(*EntitiesLock);
-            // Ensure entity list is up to date
-            ProcessPendingEntityOperations();
+            LogSystem->LogMsg(csp::common::LogLevel::Error, fmt::format("Failed to read paged entities. Exception: {}", Exception.what()).c_str());
+            EndFetch();
+            return;
+        }
 
-            RealtimeEngineUtils::InitialiseEntityScripts(Entities);
-            EnableEntityTick = true;
+        const auto& Items = *PageItems;
 
-            // This is a suboptimal fix. We shouldn't be doing much of the things we do here. Remember this is the
-            // "Space has finished hydrating" call, when all the assets have been fetched. You can be in a space
-            // and moving around before this.
-            // Without this lock, calling "DisableLeadershipElection" after entering a space creates a race condition.
-            // As this function can be called at any point after entering a space.
+        const int CurrentEntityCount = Skip + static_cast<int>(Items.size());
+        // An empty page would request the same page forever, so treat it as the end of the fetch.
+        const bool IsFinal = Items.empty() || static_cast<uint64_t>(CurrentEntityCount) >= ItemTotalCount;
 
-            std::scoped_lock LeaderElectionLocker(LeadershipElectionLock);
+        // Prefetch the next page, so that it is in flight while we decode this one.
+        if (!IsFinal)
+        {
+            RequestEntityPage(CurrentEntityCount, FetchState);
+        }
+
+        // Only decode on the worker pool. The entities themselves are created by the commit, as creating them calls into shared systems.
+        const auto DecodeStartTime = std::chrono::steady_clock::now();
 
-            if (IsLeaderElectionEnabled())
+        std::vector<std::optional<mcs::ObjectMessage>> Messages(Items.size());
+
+        ParallelForEachIndex(Items.size(),
+            [this, &Items, &Messages](size_t Index)
             {
-                if (ServerSideElectionEnabled)
+                try
                 {
-                    // For server-side leader election, we want to listen for script run requests from other clients.
-                    // We will receive these if we are the leader and another client modifies a script or sends an event.
-                    this->NetworkEventBus->ListenNetworkEvent(
-                        csp::multiplayer::NetworkEventRegistration { "CSPInternal::ClientElectionManager", RemoteRunScriptMessage },
-                        [this](const csp::common::NetworkEventData& EventData) { this->OnRemoteRunScriptEvent(EventData.EventValues); });
-
-                    // To match the behaviour of the client-side leader election, the ScriptSystemReadyCallback should fire here.
-                    // We may want to move this to earlier in the initialization in the future.
-                    if (ScriptSystemReadyCallback)
-                    {
-                        ScriptSystemReadyCallback(true);
-                    }
+                    mcs::ObjectMessage Message;
+                    SignalRDeserializer Deserializer { Items[Index] };
+                    Deserializer.ReadValue(Message);
+                    Messages[Index] = std::move(Message);
                 }
-                else
+                catch (const std::exception& Exception)
                 {
-                    // Start listening for election events
-                    //
-                    // If we are the first client to connect then this
-                    // will also set this client as the leader
-                    ElectionManager->OnConnect(Avatars, Objects);
+                    LogSystem->LogMsg(
+                        csp::common::LogLevel::Error, fmt::format("Failed to decode fetched entity. Exception: {}", Exception.what()).c_str());
                 }
+            });
+
+        const auto Decode = MicrosecondsSince(DecodeStartTime);
+
+        {
+            std::scoped_lock FetchLocker(FetchState->Mutex);
+
+            auto& Page = FetchState->FetchedPages[Skip];
+            Page.Messages = std::move(Messages);
+            Page.ItemCount = static_cast<int>(Items.size());
+            Page.IsFinal = IsFinal;
+
+            FetchState->Metrics.PageCount++;
+            FetchState->Metrics.NetworkWait += NetworkWait;
+            FetchState->Metrics.Decode += Decode;
+        }
+
+        CommitFetchedEntityPages(*FetchState);
+    };
+
+    GetEntitiesPaged(Skip, ENTITY_PAGE_LIMIT, Callback);
+}
+
+void OnlineRealtimeEngine::CommitFetchedEntityPages(EntityFetchState& FetchState)
+{
+    std::unique_lock FetchLocker(FetchState.Mutex);
+
+    // Only one thread commits at a time. Any page that arrives while it is committing will be picked up by its loop below.
+    if (FetchState.Committing)
+    {
+        return;
+    }
+
+    FetchState.Committing = true;
+
+    while (true)
+    {
+        auto PageIt = FetchState.FetchedPages.find(FetchState.NextCommitSkip);
+
+        if (PageIt == FetchState.FetchedPages.end())
+        {
+            FetchState.Committing = false;
+            return;
+        }
+
+        EntityFetchState::FetchedPage Page = std::move(PageIt->second);
+        FetchState.FetchedPages.erase(PageIt);
+
+        FetchLocker.unlock();
+
+        const auto ConstructStartTime = std::chrono::steady_clock::now();
+
+        std::vector<SpaceEntity*> NewEntities;
+        NewEntities.reserve(Page.Messages.size());
+
+        for (const auto& Message : Page.Messages)
+        {
+            // Entities that failed to decode are skipped.
+            if (Message)
+            {
+                NewEntities.push_back(SpaceEntityStatePatcher::NewFromObjectMessage(*Message, *this, *ScriptRunner, *LogSystem).release());
             }
-            else
+        }
+
+        const auto Construct = MicrosecondsSince(ConstructStartTime);
+        const auto InsertStartTime = std::chrono::steady_clock::now();
+
+        {
+            std::scoped_lock EntitiesLocker(*EntitiesLock);
+            PendingAdds->insert(PendingAdds->end(), NewEntities.begin(), NewEntities.end());
+        }
+
+        for (SpaceEntity* NewEntity : NewEntities)
+        {
+            FireRemoteSpaceEntityCreatedCallback(NewEntity, RemoteSpaceEntityCreatedCallback, *LogSystem);
+        }
+
+        const auto Insert = MicrosecondsSince(InsertStartTime);
+
+        FetchLocker.lock();
+
+        FetchState.NextCommitSkip += Page.ItemCount;
+        FetchState.Metrics.EntityCount += Page.ItemCount;
+        FetchState.Metrics.Construct += Construct;
+        FetchState.Metrics.Insert += Insert;
+
+        if (Page.IsFinal)
+        {
+            FetchState.Metrics.Total = MicrosecondsSince(FetchState.StartTime);
+
+            const EntityFetchMetrics Metrics = FetchState.Metrics;
+            const int EntityCount = FetchState.NextCommitSkip;
+
+            FetchState.Committing = false;
+            FetchLocker.unlock();
+
+            LogSystem->LogMsg(csp::common::LogLevel::Log,
+                fmt::format("Fetched {} entities in {} pages. Total: {}ms, network wait: {}ms, decode: {}ms, construct: {}ms, insert: {}ms",
+                    Metrics.EntityCount, Metrics.PageCount, Metrics.Total.count() / 1000, Metrics.NetworkWait.count() / 1000,
+                    Metrics.Decode.count() / 1000, Metrics.Construct.count() / 1000, Metrics.Insert.count() / 1000)
+                    .c_str());
+
             {
-                // Leader election not enabled, set ourselves as the script owner.
-                RealtimeEngineUtils::DetermineScriptOwners(Entities, GetMultiplayerConnectionInstance()->GetClientId());
+                std::scoped_lock EntitiesLocker(*EntitiesLock);
+                LastEntityFetchMetrics = Metrics;
             }
 
-            if (FetchCompleteCallback)
+            CompleteEntityFetch(EntityCount, FetchState.FetchCompleteCallback);
+            return;
+        }
+    }
+}
+
+void OnlineRealtimeEngine::CompleteEntityFetch(int EntityCount, const csp::common::EntityFetchCompleteCallback& FetchCompleteCallback)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    // Ensure entity list is up to date
+    ProcessPendingEntityOperations();
+
+    RealtimeEngineUtils::InitialiseEntityScripts(Entities);
+    EnableEntityTick = true;
+
+    // This is a suboptimal fix. We shouldn't be doing much of the things we do here. Remember this is the
+    // "Space has finished hydrating" call, when all the assets have been fetched. You can be in a space
+    // and moving around before this.
+    // Without this lock, calling "DisableLeadershipElection" after entering a space creates a race condition.
+    // As this function can be called at any point after entering a space.
+
+    std::scoped_lock LeaderElectionLocker(LeadershipElectionLock);
+
+    if (IsLeaderElectionEnabled())
+    {
+        if (ServerSideElectionEnabled)
+        {
+            // For server-side leader election, we want to listen for script run requests from other clients.
+            // We will receive these if we are the leader and another client modifies a script or sends an event.
+            this->NetworkEventBus->ListenNetworkEvent(
+                csp::multiplayer::NetworkEventRegistration { "CSPInternal::ClientElectionManager", RemoteRunScriptMessage },
+                [this](const csp::common::NetworkEventData& EventData) { this->OnRemoteRunScriptEvent(EventData.EventValues); });
+
+            // To match the behaviour of the client-side leader election, the ScriptSystemReadyCallback should fire here.
+            // We may want to move this to earlier in the initialization in the future.
+            if (ScriptSystemReadyCallback)
             {
-                FetchCompleteCallback(CurrentEntityCount);
+                ScriptSystemReadyCallback(true);
             }
         }
-    };
+        else
+        {
+            // Start listening for election events
+            //
+            // If we are the first client to connect then this
+            // will also set this client as the leader
+            ElectionManager->OnConnect(Avatars, Objects);
+        }
+    }
+    else
+    {
+        // Leader election not enabled, set ourselves as the script owner.
+        RealtimeEngineUtils::DetermineScriptOwners(Entities, GetMultiplayerConnectionInstance()->GetClientId());
+    }
 
-    return Callback;
-};
+    // Clients already in the space reply, so that we know which of them can decode compact transforms.
+    {
+        std::scoped_lock CompactTransformClientsLocker(CompactTransformClientsLock);
+        CompactTransformClients.clear();
+    }
+
+    if (CompactTransformEncodingEnabled)
+    {
+        AnnounceCompactTransformSupport(std::nullopt);
+    }
+
+    if (FetchCompleteCallback)
+    {
+        FetchCompleteCallback(EntityCount);
+    }
+}
 
 void OnlineRealtimeEngine::FetchAllEntitiesAndPopulateBuffers(
     const csp::common::String&, csp::common::EntityFetchStartedCallback FetchStartedCallback)
@@ -834,8 +1139,66 @@ void OnlineRealtimeEngine::RetrieveAllEntities(csp::common::EntityFetchCompleteC
         return;
     }
 
-    GetEntitiesPaged(
-        0, ENTITY_PAGE_LIMIT, CreateRetrieveAllEntitiesCallback(0, FetchCompleteCallback)); // Get at most ENTITY_PAGE_LIMIT entities at a time
+    // Get at most ENTITY_PAGE_LIMIT entities at a time
+    RequestEntityPage(0, std::make_shared<EntityFetchState>(FetchCompleteCallback));
+}
+
+void OnlineRealtimeEngine::UpdateGlobalTransforms()
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+
+    {
+        std::scoped_lock DirtyTransformRootsLocker(DirtyTransformRootsLock);
+        GlobalTransformUpdateOrder.assign(DirtyTransformRoots.begin(), DirtyTransformRoots.end());
+        DirtyTransformRoots.clear();
+    }
+
+    RealtimeEngineUtils::UpdateGlobalTransforms(GlobalTransformUpdateOrder);
+
+    // The global positions were all just computed, so this is the cheapest point to bring the spatial index up to date.
+    SpatialIndex->Refresh();
+}
+
+EntityFetchMetrics OnlineRealtimeEngine::GetLastEntityFetchMetrics() const
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    return LastEntityFetchMetrics;
+}
+
+IncomingPatchMetrics OnlineRealtimeEngine::GetIncomingPatchMetrics() const
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    return PatchMetrics;
+}
+
+OutgoingPatchMetrics OnlineRealtimeEngine::GetOutgoingPatchMetrics() const
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    return OutgoingMetrics;
+}
+
+InterestManagementMetrics OnlineRealtimeEngine::GetInterestManagementMetrics() const
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    return InterestManager->GetMetrics();
+}
+
+float OnlineRealtimeEngine::GetInterestRadius() const
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    return InterestManager->GetRadius();
+}
+
+void OnlineRealtimeEngine::SetInterestRadius(float Radius)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    InterestManager->SetRadius(Radius);
+}
+
+void OnlineRealtimeEngine::SetInterestCatchUpInterval(uint32_t IntervalMilliseconds)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    InterestManager->SetCatchUpInterval(milliseconds(IntervalMilliseconds));
 }
 
 void OnlineRealtimeEngine::LocalDestroyAllEntities()
@@ -867,10 +1230,24 @@ void OnlineRealtimeEngine::LocalDestroyAllEntities()
     Objects.Clear();
     Avatars.Clear();
     RootHierarchyEntities.Clear();
+    EntityIndex->Clear();
+    PatchScheduler->ResetAllEntities();
+    SpatialIndex->Clear();
+    InterestManager->Clear();
+
+    {
+        std::scoped_lock DirtyTransformRootsLocker(DirtyTransformRootsLock);
+        DirtyTransformRoots.clear();
+    }
 
     // Clear adds/removes, we don't want to mutate if we're cleaning everything else.
     PendingAdds->clear();
     PendingRemoves->clear();
+    for (signalr::value* PendingUpdate : *PendingIncomingUpdates)
+    {
+        delete (PendingUpdate);
+    }
+
     PendingIncomingUpdates->clear();
 
     UnlockEntityUpdate();
@@ -925,7 +1302,14 @@ void OnlineRealtimeEngine::TickEntities()
         // If there is no leadership election, then we assume all clients may run scripts.
         bool CanRunScripts = IsLocalClientLeader();
 
-        if (CanRunScripts)
+        if (CanRunScripts && InterestManager->GetRadius() > 0.0f)
+        {
+            // Which entities are in range is worked out under the entities lock, so we need it to decide which to tick.
+            LastTickTime = RealtimeEngineUtils::TickEntityScripts(*EntitiesLock, Entities,
+                [this](const SpaceEntity* Entity, system_clock::time_point Now)
+                { return InterestManager->GetScriptTickDelta(Entity, LastTickTime, Now); });
+        }
+        else if (CanRunScripts)
         {
             LastTickTime = RealtimeEngineUtils::TickEntityScripts(*TickEntitiesLock, Entities, LastTickTime);
         }
@@ -1072,6 +1456,21 @@ void OnlineRealtimeEngine::ClaimScriptOwnershipFromClient(uint64_t ClientId)
     }
 }
 
+SpaceEntity* OnlineRealtimeEngine::FindLocalAvatar() const
+{
+    const uint64_t LocalClientId = MultiplayerConnectionInst->GetClientId();
+
+    for (size_t i = 0; i < Avatars.Size(); ++i)
+    {
+        if (Avatars[i]->GetOwnerId() == LocalClientId)
+        {
+            return Avatars[i];
+        }
+    }
+
+    return nullptr;
+}
+
 bool OnlineRealtimeEngine::IsLocalClientLeader() const
 {
     if (IsLeaderElectionEnabled() == false)
@@ -1156,8 +1555,190 @@ bool OnlineRealtimeEngine::GetEntityPatchRateLimitEnabled() const { return Entit
 
 void OnlineRealtimeEngine::SetEntityPatchRateLimitEnabled(bool Enabled) { EntityPatchRateLimitEnabled = Enabled; }
 
+void OnlineRealtimeEngine::SetEntityPatchPriority(SpaceEntity* Entity, EntityPatchPriority Priority)
+{
+    if (Entity == nullptr)
+    {
+        LogSystem->LogMsg(csp::common::LogLevel::Warning, "Attempting to set the patch priority of a null entity. Aborting operation.");
+        return;
+    }
+
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    PatchScheduler->SetEntityPriority(Entity->GetId(), Priority);
+}
+
+void OnlineRealtimeEngine::SetEntityPatchInterval(SpaceEntity* Entity, uint32_t IntervalMilliseconds)
+{
+    if (Entity == nullptr)
+    {
+        LogSystem->LogMsg(csp::common::LogLevel::Warning, "Attempting to set the patch interval of a null entity. Aborting operation.");
+        return;
+    }
+
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    PatchScheduler->SetEntityInterval(Entity->GetId(), milliseconds { IntervalMilliseconds });
+}
+
+void OnlineRealtimeEngine::ResetEntityPatchSettings(SpaceEntity* Entity)
+{
+    if (Entity == nullptr)
+    {
+        LogSystem->LogMsg(csp::common::LogLevel::Warning, "Attempting to reset the patch settings of a null entity. Aborting operation.");
+        return;
+    }
+
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    PatchScheduler->ResetEntity(Entity->GetId());
+}
+
+void OnlineRealtimeEngine::SetPatchIntervalForPriority(EntityPatchPriority Priority, uint32_t IntervalMilliseconds)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    PatchScheduler->SetPriorityInterval(Priority, milliseconds { IntervalMilliseconds });
+}
+
+void OnlineRealtimeEngine::SetPatchIntervalForComponentType(ComponentType Type, uint32_t IntervalMilliseconds)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    PatchScheduler->SetComponentTypeInterval(Type, milliseconds { IntervalMilliseconds });
+}
+
+void OnlineRealtimeEngine::SetPatchByteBudget(uint32_t BytesPerTick)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+    PatchScheduler->SetByteBudget(BytesPerTick);
+}
+
+bool OnlineRealtimeEngine::GetCompactTransformEncodingEnabled() const { return CompactTransformEncodingEnabled; }
+
+void OnlineRealtimeEngine::SetCompactTransformEncodingEnabled(bool Enabled)
+{
+    const bool WasEnabled = CompactTransformEncodingEnabled;
+    CompactTransformEncodingEnabled = Enabled;
+
+    // Clients only announce support once they've opted in, so if we're already in a space, tell the other clients now.
+    if (Enabled && !WasEnabled && EnableEntityTick)
+    {
+        AnnounceCompactTransformSupport(std::nullopt);
+    }
+}
+
+void OnlineRealtimeEngine::AnnounceCompactTransformSupport(std::optional<uint64_t> ReplyToClientId)
+{
+    const MultiplayerConnection::ErrorCodeCallbackHandler SignalRCallback = [&LogSystem = this->LogSystem](ErrorCode Error)
+    {
+        if (Error != ErrorCode::None)
+        {
+            LogSystem->LogMsg(csp::common::LogLevel::Error, "OnlineRealtimeEngine::AnnounceCompactTransformSupport: SignalR connection: Error");
+        }
+    };
+
+    const csp::common::Array<csp::common::ReplicatedValue> Args { csp::common::ReplicatedValue(CompactTransform::ENCODING_VERSION),
+        csp::common::ReplicatedValue(ReplyToClientId.has_value()) };
+
+    if (ReplyToClientId.has_value())
+    {
+        NetworkEventBus->SendNetworkEventToClient(CompactTransform::SUPPORT_MESSAGE, Args, *ReplyToClientId, SignalRCallback);
+    }
+    else
+    {
+        NetworkEventBus->SendNetworkEvent(CompactTransform::SUPPORT_MESSAGE, Args, SignalRCallback);
+    }
+}
+
+void OnlineRealtimeEngine::OnCompactTransformSupportEvent(const csp::common::NetworkEventData& EventData)
+{
+    const auto& Values = EventData.EventValues;
+
+    // Clients that only support a different version of the encoding are treated like clients that don't support it at all.
+    if (Values.Size() < 2 || Values[0].GetReplicatedValueType() != csp::common::ReplicatedValueType::Integer
+        || Values[0].GetInt() != CompactTransform::ENCODING_VERSION || Values[1].GetReplicatedValueType() != csp::common::ReplicatedValueType::Boolean)
+    {
+        return;
+    }
+
+    if (MultiplayerConnectionInst == nullptr || EventData.SenderClientId == MultiplayerConnectionInst->GetClientId())
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock CompactTransformClientsLocker(CompactTransformClientsLock);
+        CompactTransformClients.insert(EventData.SenderClientId);
+    }
+
+    // Reply to announcements, so that the client that has just entered learns that we support it too. Announcements are still recorded while
+    // we haven't opted in ourselves, so that we know who can decode the encoding if we do.
+    if (CompactTransformEncodingEnabled && Values[1].GetBool() == false)
+    {
+        AnnounceCompactTransformSupport(EventData.SenderClientId);
+    }
+}
+
+bool OnlineRealtimeEngine::CanSendCompactTransforms() const
+{
+    if (!CompactTransformEncodingEnabled)
+    {
+        return false;
+    }
+
+    const uint64_t LocalClientId = MultiplayerConnectionInst->GetClientId();
+
+    std::scoped_lock CompactTransformClientsLocker(CompactTransformClientsLock);
+
+    // Avatars are assumed to be clients, as they are for client-side leader election.
+    for (size_t i = 0; i < Avatars.Size(); ++i)
+    {
+        const uint64_t OwnerId = Avatars[i]->GetOwnerId();
+
+        if (OwnerId != LocalClientId && CompactTransformClients.count(OwnerId) == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void OnlineRealtimeEngine::ResendTransientTransforms()
+{
+    const uint64_t LocalClientId = MultiplayerConnectionInst->GetClientId();
+
+    for (size_t i = 0; i < Entities.Size(); ++i)
+    {
+        SpaceEntity* Entity = Entities[i];
+
+        if (!Entity->GetIsPersistent() && Entity->GetOwnerId() == LocalClientId && Entity->GetStatePatcher() != nullptr)
+        {
+            Entity->GetStatePatcher()->MarkTransformDirty();
+            QueueEntityUpdate(Entity);
+        }
+    }
+}
+
 const csp::common::List<SpaceEntity*>* OnlineRealtimeEngine::GetRootHierarchyEntities() const { return &RootHierarchyEntities; }
 
+csp::common::List<SpaceEntity*> OnlineRealtimeEngine::FindSpaceEntitiesInRadius(const csp::common::Vector3& Position, float Radius)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+
+    return RealtimeEngineUtils::FindSpaceEntitiesInRadius(*SpatialIndex, Position, Radius);
+}
+
+csp::common::List<SpaceEntity*> OnlineRealtimeEngine::FindNearestSpaceEntities(const csp::common::Vector3& Position, size_t Count)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+
+    return RealtimeEngineUtils::FindNearestSpaceEntities(*SpatialIndex, Position, Count);
+}
+
+csp::common::List<SpaceEntity*> OnlineRealtimeEngine::FindSpaceEntitiesInFrustum(const csp::common::List<csp::common::Vector4>& Planes)
+{
+    std::scoped_lock EntitiesLocker(*EntitiesLock);
+
+    return RealtimeEngineUtils::FindSpaceEntitiesInFrustum(*SpatialIndex, Planes);
+}
+
 void OnlineRealtimeEngine::ResolveEntityHierarchy(csp::multiplayer::SpaceEntity* Entity)
 {
     RealtimeEngineUtils::ResolveEntityHierarchy(*this, RootHierarchyEntities, Entity);
@@ -1267,7 +1848,7 @@ SpaceEntity* OnlineRealtimeEngine::GetObjectByIndex(const size_t ObjectIndex)
 
 const csp::common::List<SpaceEntity*>* OnlineRealtimeEngine::GetAllEntities() const { return &Entities; }
 
-void OnlineRealtimeEngine::SendPatches(const csp::common::List<SpaceEntity*> PendingEntities)
+size_t OnlineRealtimeEngine::SendPatches(const csp::common::List<SpaceEntity*>& PendingEntities, bool AllowCompactTransforms)
 {
     const std::function LocalCallback = [&LogSystem = this->LogSystem](const signalr::value& /*Result*/, const std::exception_ptr& Except)
     {
@@ -1285,23 +1866,41 @@ void OnlineRealtimeEngine::SendPatches(const csp::common::List<SpaceEntity*> Pen
         }
     };
 
-    std::vector<mcs::ObjectPatch> Patches;
-    SignalRSerializer Serializer;
+    // Patches are encoded straight into a reused buffer as they are created, rather than being collected and converted into a signalr
+    // value tree first. Once the batch has been cut to the byte budget, it is sent as a single argument, which the hub protocol writes as is.
+    const size_t ByteBudget = PatchScheduler->GetByteBudget();
+    size_t PatchCount = 0;
+    size_t PatchBytes = 0;
+
+    PatchBudgetWriter->Reset();
 
     for (size_t i = 0; i < PendingEntities.Size(); ++i)
     {
-        Patches.push_back(PendingEntities[i]->GetStatePatcher()->CreateObjectPatch());
-    }
+        PatchBudgetWriter->Write(PendingEntities[i]->GetStatePatcher()->CreateObjectPatch(AllowCompactTransforms));
 
-    // We are writing multiple patches, so we need an additional nested array.
-    Serializer.StartWriteArray();
-    {
-        Serializer.WriteValue(Patches);
+        // Always send at least one patch, so a patch larger than the budget can't block the queue
+        if (ByteBudget != 0 && PatchCount != 0 && PatchBudgetWriter->GetSize() > ByteBudget)
+        {
+            break;
+        }
+
+        PatchBytes = PatchBudgetWriter->GetSize();
+        ++PatchCount;
     }
-    Serializer.EndWriteArray();
+
+    PatchWriter->Reset();
+    PatchWriter->WriteArrayHeader(static_cast<uint32_t>(PatchCount));
+    PatchWriter->WriteRaw(PatchBudgetWriter->GetData(), PatchBytes);
 
     MultiplayerConnectionInst->GetSignalRConnection()->Invoke(
-        MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::SEND_OBJECT_PATCHES), Serializer.Get(), LocalCallback);
+        MultiplayerConnectionInst->GetMultiplayerHubMethods().Get(MultiplayerHubMethod::SEND_OBJECT_PATCHES), CreateEncodedArguments(*PatchWriter),
+        LocalCallback);
+
+    OutgoingMetrics.Sent += PatchCount;
+    OutgoingMetrics.Bytes += PatchBytes;
+    OutgoingMetrics.DeferredByBudget += PendingEntities.Size() - PatchCount;
+
+    return PatchCount;
 }
 
 void OnlineRealtimeEngine::ProcessPendingEntityOperations()
@@ -1330,71 +1929,127 @@ void OnlineRealtimeEngine::ProcessPendingEntityOperations()
         PendingAdds->pop_front();
     }
 
-    // local updates
-    while (PendingIncomingUpdates->empty() == false)
+    // interest management
+    // Patches held back for entities that are now in range, or have waited for the catch-up interval, are older than anything received since.
+    SpatialIndex->Refresh();
+
+    std::vector<mcs::ObjectPatch> DuePatches;
+    InterestManager->Update(*SpatialIndex, InterestManager->GetRadius() > 0.0f ? FindLocalAvatar() : nullptr, system_clock::now(), DuePatches);
+
+    for (const mcs::ObjectPatch& Patch : DuePatches)
     {
-        ApplyIncomingPatch(PendingIncomingUpdates->front());
-        PendingIncomingUpdates->pop_front();
+        ApplyIncomingPatch(Patch);
     }
 
-    // remote updates
+    mcs::ObjectPatch HeldPatch;
+
+    // local updates
+    // Patches for the same entity are merged first, so an entity being moved by another client is only updated once per tick
+    if (PendingIncomingUpdates->empty() == false)
     {
-        for (auto it = PendingOutgoingUpdateUniqueSet->begin(); it != PendingOutgoingUpdateUniqueSet->end();)
+        for (signalr::value* PendingUpdate : *PendingIncomingUpdates)
         {
-            SpaceEntity* PendingEntity = *it;
+            mcs::ObjectPatch Patch;
+            ReadIncoming(*PatchReader, *PendingUpdate, Patch);
 
-            const milliseconds CurrentTime = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+            PatchCoalescer->Add(std::move(Patch));
+            delete (PendingUpdate);
+        }
+
+        PatchMetrics.Received += PendingIncomingUpdates->size();
+        PatchMetrics.Coalesced += PatchCoalescer->GetCoalescedCount();
+        PendingIncomingUpdates->clear();
+
+        for (mcs::ObjectPatch& Patch : PatchCoalescer->GetPatches())
+        {
+            SpaceEntity* Entity = EntityIndex->FindById(Patch.GetId());
 
-            if (CurrentTime - PendingEntity->GetTimeOfLastPatch() >= EntityPatchRate || !EntityPatchRateLimitEnabled)
+            if (Entity != nullptr && InterestManager->TryDefer(*Entity, Patch))
             {
-                // Ensure we can modify the entity. The criteria for this can be found on the specific RealtimeEngine::IsEntityModifiable overloads.
-                ModifiableStatus Modifiable = PendingEntity->IsModifiable();
-                if (Modifiable != ModifiableStatus::Modifiable)
-                {
-                    if (LogSystem != nullptr)
-                    {
-                        LogSystem->LogMsg(csp::common::LogLevel::Warning,
-                            fmt::format("Failed to send patch for entity: {0}. Entity name: {1}",
-                                RealtimeEngineUtils::ModifiableStatusToString(Modifiable), PendingEntity->GetName())
-                                .c_str());
-                    }
-
-                    it = PendingOutgoingUpdateUniqueSet->erase(it);
-                    continue;
-                }
+                continue;
+            }
+
+            if (InterestManager->TakeHeldPatch(Patch.GetId(), HeldPatch))
+            {
+                ApplyIncomingPatch(HeldPatch);
+            }
 
-                // since we are aiming to mutate the data for this entity remotely, we need to claim ownership over it
-                PendingEntity->SetOwnerId(MultiplayerConnectionInst->GetClientId());
-                RealtimeEngineUtils::ClaimScriptOwnership(PendingEntity, GetMultiplayerConnectionInstance()->GetClientId());
+            ApplyIncomingPatch(Patch);
+        }
+
+        PatchCoalescer->Clear();
+    }
+
+    // A client that can't decode compact transforms may have read ones we sent before it was seen, so send ours again in full.
+    const bool AllowCompactTransforms = CanSendCompactTransforms();
+
+    if (CompactTransformsAllowed && !AllowCompactTransforms)
+    {
+        ResendTransientTransforms();
+    }
 
-                PendingEntities.Append(PendingEntity);
+    CompactTransformsAllowed = AllowCompactTransforms;
 
-                if (PendingEntity->GetStatePatcher()->GetEntityPatchSentCallback() != nullptr)
+    // remote updates
+    if (PendingOutgoingUpdateUniqueSet->empty() == false)
+    {
+        const milliseconds CurrentTime = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+        const uint64_t LocalClientId = MultiplayerConnectionInst->GetClientId();
+
+        PatchScheduler->SelectReadyEntities(
+            *PendingOutgoingUpdateUniqueSet, CurrentTime, LocalClientId, EntityPatchRateLimitEnabled, ReadyOutgoingEntities);
+
+        for (SpaceEntity* PendingEntity : ReadyOutgoingEntities)
+        {
+            // Ensure we can modify the entity. The criteria for this can be found on the specific RealtimeEngine::IsEntityModifiable overloads.
+            ModifiableStatus Modifiable = PendingEntity->IsModifiable();
+            if (Modifiable != ModifiableStatus::Modifiable)
+            {
+                if (LogSystem != nullptr)
                 {
-                    PendingEntity->GetStatePatcher()->CallEntityPatchSentCallback(true);
+                    LogSystem->LogMsg(csp::common::LogLevel::Warning,
+                        fmt::format("Failed to send patch for entity: {0}. Entity name: {1}",
+                            RealtimeEngineUtils::ModifiableStatusToString(Modifiable), PendingEntity->GetName())
+                            .c_str());
                 }
 
-                PendingEntity->GetStatePatcher()->SetTimeOfLastPatch(CurrentTime);
-                it = PendingOutgoingUpdateUniqueSet->erase(it);
-            }
-            else
-            {
-                LogSystem->LogMsg(common::LogLevel::VeryVerbose,
-                    "Skipping patch send in ProcessPendingEntityOperations as not enough time has passed since the last patch");
-                ++it;
+                PendingOutgoingUpdateUniqueSet->erase(PendingEntity);
+                continue;
             }
+
+            // since we are aiming to mutate the data for this entity remotely, we need to claim ownership over it
+            PendingEntity->SetOwnerId(LocalClientId);
+            RealtimeEngineUtils::ClaimScriptOwnership(PendingEntity, LocalClientId);
+
+            PendingEntities.Append(PendingEntity);
         }
 
         // Only send if there are patches in list
         if (PendingEntities.Size() != 0)
         {
-            // Send list of PendingEntities to chs
-            SendPatches(PendingEntities);
+            // Send list of PendingEntities to chs. Any that don't fit in the byte budget stay pending, and move up the order next tick.
+            const size_t SentCount = SendPatches(PendingEntities, AllowCompactTransforms);
 
-            // Loop through and apply local patches from generated list
-            for (size_t i = 0; i < PendingEntities.Size(); ++i)
+            // Loop through and apply local patches for the entities that were sent
+            for (size_t i = 0; i < SentCount; ++i)
             {
-                PendingEntities[i]->ApplyLocalPatch(true, GetMultiplayerConnectionInstance()->GetAllowSelfMessagingFlag());
+                SpaceEntity* SentEntity = PendingEntities[i];
+
+                if (SentEntity->GetStatePatcher()->GetEntityPatchSentCallback() != nullptr)
+                {
+                    SentEntity->GetStatePatcher()->CallEntityPatchSentCallback(true);
+                }
+
+                SentEntity->GetStatePatcher()->SetTimeOfLastPatch(CurrentTime);
+                PendingOutgoingUpdateUniqueSet->erase(SentEntity);
+
+                // Anything held back by interest management predates our change, so must be applied before it.
+                if (InterestManager->TakeHeldPatch(SentEntity->GetId(), HeldPatch))
+                {
+                    ApplyIncomingPatch(HeldPatch);
+                }
+
+                SentEntity->ApplyLocalPatch(true, GetMultiplayerConnectionInstance()->GetAllowSelfMessagingFlag());
             }
         }
     }
@@ -1418,9 +2073,10 @@ void OnlineRealtimeEngine::ProcessPendingEntityOperations()
 
 void OnlineRealtimeEngine::AddPendingEntity(SpaceEntity* EntityToAdd)
 {
-    if (FindSpaceEntityById(EntityToAdd->GetId()) == nullptr)
+    if (EntityIndex->Add(EntityToAdd))
     {
         Entities.Append(EntityToAdd);
+        SpatialIndex->Add(EntityToAdd);
 
         switch (EntityToAdd->GetEntityType())
         {
@@ -1468,6 +2124,15 @@ void OnlineRealtimeEngine::RemovePendingEntity(SpaceEntity* EntityToRemove)
     RealtimeEngineUtils::RemoveParentChildRelationshipsFromEntity(*this, RootHierarchyEntities, EntityToRemove);
 
     Entities.RemoveItem(EntityToRemove);
+    EntityIndex->Remove(EntityToRemove);
+    PatchScheduler->ResetEntity(EntityToRemove->GetId());
+    SpatialIndex->Remove(EntityToRemove);
+    InterestManager->RemoveEntity(EntityToRemove);
+
+    {
+        std::scoped_lock DirtyTransformRootsLocker(DirtyTransformRootsLock);
+        DirtyTransformRoots.erase(EntityToRemove);
+    }
 
     delete (EntityToRemove);
 }
@@ -1506,62 +2171,46 @@ void OnlineRealtimeEngine::OnObjectRemove(const SpaceEntity* Object, const csp::
     }
 }
 
-void OnlineRealtimeEngine::ApplyIncomingPatch(const signalr::value* EntityMessage)
+void OnlineRealtimeEngine::ApplyIncomingPatch(const mcs::ObjectPatch& Patch)
 {
-    mcs::ObjectPatch Patch;
-    SignalRDeserializer Deserializer { *EntityMessage };
-    Deserializer.ReadValue(Patch);
+    ++PatchMetrics.Applied;
 
     if (Patch.GetDestroy())
     {
         // This is an entity deletion.
-        for (size_t i = 0; i < Entities.Size(); ++i)
+        if (SpaceEntity* Entity = EntityIndex->FindById(Patch.GetId()))
         {
-            SpaceEntity* Entity = Entities[i];
-
-            if (Entity->GetId() == Patch.GetId())
+            if (Entity->GetEntityType() == SpaceEntityType::Avatar)
             {
-                if (Entity->GetEntityType() == SpaceEntityType::Avatar)
+                // This can be removed as part of OF-1785.
+                if (ServerSideElectionEnabled == false)
                 {
-                    // This can be removed as part of OF-1785.
-                    if (ServerSideElectionEnabled == false)
-                    {
-                        // All clients will take ownership of deleted avatars scripts
-                        // Last client which receives patch will end up with ownership
-                        ClaimScriptOwnershipFromClient(Entity->GetOwnerId());
-                    }
-
-                    // Loop through all entities and check if the deleted avatar owned any of them. If they did, deselect them.
-                    // This covers disconnected clients as their avatar gets cleaned up after timing out.
-                    for (size_t j = 0; j < Entities.Size(); ++j)
-                    {
-                        if (Entities[j]->GetSelectingClientID() == Patch.GetId())
-                        {
-                            Entities[j]->Deselect();
-                            SelectedEntities.RemoveItem(Entities[j]);
-                        }
-                    }
+                    // All clients will take ownership of deleted avatars scripts
+                    // Last client which receives patch will end up with ownership
+                    ClaimScriptOwnershipFromClient(Entity->GetOwnerId());
                 }
 
-                LocalDestroyEntity(Entity);
+                // Deselect any entities the deleted avatar had selected.
+                // This covers disconnected clients as their avatar gets cleaned up after timing out.
+                // Deselecting mutates the selection index, so we iterate over a snapshot.
+                for (SpaceEntity* SelectedEntity : EntityIndex->GetEntitiesSelectedByClient(Patch.GetId()))
+                {
+                    SelectedEntity->Deselect();
+                    SelectedEntities.RemoveItem(SelectedEntity);
+                }
             }
+
+            LocalDestroyEntity(Entity);
         }
     }
     else
     {
-        bool EntityFound = false;
-
         // Update
-        for (SpaceEntity* Entity : Entities)
+        if (SpaceEntity* Entity = EntityIndex->FindById(Patch.GetId()))
         {
-            if (Entity->GetId() == Patch.GetId())
-            {
-                Entity->GetStatePatcher()->ApplyPatchFromObjectPatch(Patch);
-                EntityFound = true;
-            }
+            Entity->GetStatePatcher()->ApplyPatchFromObjectPatch(Patch);
         }
-
-        if (!EntityFound)
+        else
         {
             LogSystem->LogMsg(csp::common::LogLevel::Error,
                 fmt::format("Failed to find an entity with ID {} when received a patch message.", Patch.GetId()).c_str());
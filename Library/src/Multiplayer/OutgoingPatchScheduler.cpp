@@ -0,0 +1,154 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "Multiplayer/OutgoingPatchScheduler.h"
+
+#include "CSP/Multiplayer/SpaceEntity.h"
+#include "Multiplayer/SpaceEntityStatePatcher.h"
+
+#include <algorithm>
+
+namespace csp::multiplayer
+{
+
+OutgoingPatchScheduler::OutgoingPatchScheduler(std::chrono::milliseconds DefaultInterval)
+{
+    PriorityIntervals.fill(DefaultInterval);
+}
+
+void OutgoingPatchScheduler::SetPriorityInterval(EntityPatchPriority Priority, std::chrono::milliseconds Interval)
+{
+    PriorityIntervals[static_cast<size_t>(Priority)] = Interval;
+}
+
+std::chrono::milliseconds OutgoingPatchScheduler::GetPriorityInterval(EntityPatchPriority Priority) const
+{
+    return PriorityIntervals[static_cast<size_t>(Priority)];
+}
+
+void OutgoingPatchScheduler::SetComponentTypeInterval(ComponentType Type, std::chrono::milliseconds Interval)
+{
+    ComponentTypeIntervals[Type] = Interval;
+}
+
+void OutgoingPatchScheduler::SetEntityPriority(uint64_t EntityId, EntityPatchPriority Priority) { EntitySettingsById[EntityId].Priority = Priority; }
+
+void OutgoingPatchScheduler::SetEntityInterval(uint64_t EntityId, std::chrono::milliseconds Interval)
+{
+    EntitySettingsById[EntityId].Interval = Interval;
+}
+
+void OutgoingPatchScheduler::ResetEntity(uint64_t EntityId) { EntitySettingsById.erase(EntityId); }
+
+void OutgoingPatchScheduler::ResetAllEntities() { EntitySettingsById.clear(); }
+
+void OutgoingPatchScheduler::SetByteBudget(size_t Budget) { ByteBudget = Budget; }
+
+size_t OutgoingPatchScheduler::GetByteBudget() const { return ByteBudget; }
+
+EntityPatchPriority OutgoingPatchScheduler::GetPriority(const SpaceEntity* Entity, uint64_t LocalClientId) const
+{
+    auto SettingsIt = EntitySettingsById.find(Entity->GetId());
+
+    if (SettingsIt != EntitySettingsById.end() && SettingsIt->second.Priority.has_value())
+    {
+        return *SettingsIt->second.Priority;
+    }
+
+    if (Entity->GetEntityType() == SpaceEntityType::Avatar && Entity->GetOwnerId() == LocalClientId)
+    {
+        return EntityPatchPriority::Critical;
+    }
+
+    if (Entity->GetSelectingClientID() == LocalClientId)
+    {
+        return EntityPatchPriority::High;
+    }
+
+    return EntityPatchPriority::Normal;
+}
+
+std::chrono::milliseconds OutgoingPatchScheduler::GetInterval(SpaceEntity* Entity, const EntitySettings* Settings, EntityPatchPriority Priority)
+{
+    if (Settings != nullptr && Settings->Interval.has_value())
+    {
+        return *Settings->Interval;
+    }
+
+    std::chrono::milliseconds Interval = PriorityIntervals[static_cast<size_t>(Priority)];
+
+    // Only look at the dirty components when there are component intervals to apply, as it means taking the patcher's lock
+    if (!ComponentTypeIntervals.empty())
+    {
+        Entity->GetStatePatcher()->GetDirtyComponentTypes(DirtyComponentTypes);
+
+        for (ComponentType Type : DirtyComponentTypes)
+        {
+            auto It = ComponentTypeIntervals.find(Type);
+
+            if (It != ComponentTypeIntervals.end())
+            {
+                Interval = std::min(Interval, It->second);
+            }
+        }
+    }
+
+    return Interval;
+}
+
+void OutgoingPatchScheduler::SelectReadyEntities(const std::set<SpaceEntity*>& Pending, std::chrono::milliseconds Now, uint64_t LocalClientId,
+    bool RateLimitEnabled, std::vector<SpaceEntity*>& OutReady)
+{
+    OutReady.clear();
+    Candidates.clear();
+
+    for (SpaceEntity* Entity : Pending)
+    {
+        auto SettingsIt = EntitySettingsById.find(Entity->GetId());
+        const EntitySettings* Settings = SettingsIt != EntitySettingsById.end() ? &SettingsIt->second : nullptr;
+
+        const EntityPatchPriority Priority = GetPriority(Entity, LocalClientId);
+        const std::chrono::milliseconds Waited = Now - Entity->GetTimeOfLastPatch();
+
+        if (RateLimitEnabled && Waited < GetInterval(Entity, Settings, Priority))
+        {
+            continue;
+        }
+
+        // Each priority level counts the time waited twice as much as the level below
+        const int64_t Score = Waited.count() << static_cast<int>(Priority);
+        Candidates.push_back({ Entity, Priority == EntityPatchPriority::Critical, Score });
+    }
+
+    std::stable_sort(Candidates.begin(), Candidates.end(),
+        [](const Candidate& Lhs, const Candidate& Rhs)
+        {
+            if (Lhs.IsCritical != Rhs.IsCritical)
+            {
+                return Lhs.IsCritical;
+            }
+
+            return Lhs.Score > Rhs.Score;
+        });
+
+    OutReady.reserve(Candidates.size());
+
+    for (const Candidate& Ready : Candidates)
+    {
+        OutReady.push_back(Ready.Entity);
+    }
+}
+
+} // namespace csp::multiplayer
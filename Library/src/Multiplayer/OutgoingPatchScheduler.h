@@ -0,0 +1,93 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "CSP/Multiplayer/OnlineRealtimeEngine.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace csp::multiplayer
+{
+class SpaceEntity;
+
+/// @brief Decides which entities with pending outgoing patches are sent each tick, and in what order.
+/// @details Each entity has a priority, which is either set explicitly or derived from the entity: the local client's avatar is Critical,
+/// entities selected by the local client are High, and everything else is Normal. An entity is ready to send once the interval for its
+/// priority has elapsed since its last patch. Per-entity and per-component-type intervals override this, with the shortest interval of the
+/// entity's dirty component types being used.
+/// Ready entities are ordered with Critical entities first, then by how long they have waited weighted by their priority, so under a byte
+/// budget the entities that miss out on a tick move up the order on the next, and lower priorities are never starved.
+class OutgoingPatchScheduler
+{
+public:
+    explicit OutgoingPatchScheduler(std::chrono::milliseconds DefaultInterval);
+
+    void SetPriorityInterval(EntityPatchPriority Priority, std::chrono::milliseconds Interval);
+    std::chrono::milliseconds GetPriorityInterval(EntityPatchPriority Priority) const;
+
+    void SetComponentTypeInterval(ComponentType Type, std::chrono::milliseconds Interval);
+
+    void SetEntityPriority(uint64_t EntityId, EntityPatchPriority Priority);
+    void SetEntityInterval(uint64_t EntityId, std::chrono::milliseconds Interval);
+
+    /// @brief Clears any priority or interval set for the entity, returning it to the derived defaults.
+    void ResetEntity(uint64_t EntityId);
+    void ResetAllEntities();
+
+    /// @brief Sets the most patch data to send per tick, in bytes. 0 means no limit.
+    void SetByteBudget(size_t Budget);
+    size_t GetByteBudget() const;
+
+    EntityPatchPriority GetPriority(const SpaceEntity* Entity, uint64_t LocalClientId) const;
+
+    /// @brief Fills OutReady with the pending entities that are ready to send, most urgent first.
+    /// @param RateLimitEnabled : If false, every pending entity is ready, but they are still ordered by urgency.
+    void SelectReadyEntities(const std::set<SpaceEntity*>& Pending, std::chrono::milliseconds Now, uint64_t LocalClientId, bool RateLimitEnabled,
+        std::vector<SpaceEntity*>& OutReady);
+
+private:
+    struct EntitySettings
+    {
+        std::optional<EntityPatchPriority> Priority;
+        std::optional<std::chrono::milliseconds> Interval;
+    };
+
+    struct Candidate
+    {
+        SpaceEntity* Entity;
+        bool IsCritical;
+        int64_t Score;
+    };
+
+    std::chrono::milliseconds GetInterval(SpaceEntity* Entity, const EntitySettings* Settings, EntityPatchPriority Priority);
+
+    std::array<std::chrono::milliseconds, 4> PriorityIntervals;
+    std::unordered_map<ComponentType, std::chrono::milliseconds> ComponentTypeIntervals;
+    std::unordered_map<uint64_t, EntitySettings> EntitySettingsById;
+    size_t ByteBudget = 0;
+
+    // Reused between ticks
+    std::vector<Candidate> Candidates;
+    std::vector<ComponentType> DirtyComponentTypes;
+};
+
+} // namespace csp::multiplayer
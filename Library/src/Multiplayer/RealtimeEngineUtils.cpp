@@ -17,78 +17,61 @@
 
 #include "CSP/Common/Interfaces/IRealtimeEngine.h"
 #include "CSP/Multiplayer/Components/AvatarSpaceComponent.h"
+#include "CSP/Multiplayer/Script/EntityScript.h"
 #include "CSP/Multiplayer/Script/EntityScriptMessages.h"
 #include "CSP/Multiplayer/SpaceEntity.h"
 #include "Multiplayer/Election/ClientElectionManager.h"
 #include "Multiplayer/Election/ScopeLeadershipManager.h"
+#include "Multiplayer/SpaceEntitySpatialIndex.h"
 #include <fmt/format.h>
 
 namespace
 {
 csp::common::String JSONStringFromDeltaTime(double DeltaTime) { return fmt::format("{{\"deltaTimeMS\": {}}}", DeltaTime).c_str(); }
-}
 
-namespace csp::multiplayer::RealtimeEngineUtils
-{
-csp::common::String ModifiableStatusToString(ModifiableStatus Failure)
+// Posts the tick message to every entity script that has subscribed to it.
+// The message and its parameters are built once per tick and shared by every entity.
+void PostTickToEntityScripts(const csp::common::List<csp::multiplayer::SpaceEntity*>& Entities, std::chrono::system_clock::duration DeltaTime)
 {
-    if (auto it = ModifiableStatusErrors.find(Failure); it != ModifiableStatusErrors.end())
-    {
-        return it->second;
-    }
-    return "No log specified for modifiable status";
-}
+    static const csp::common::String TickMessage = csp::multiplayer::SCRIPT_MSG_ENTITY_TICK;
 
-csp::multiplayer::SpaceEntity* FindSpaceEntity(csp::common::IRealtimeEngine& RealtimeEngine, const csp::common::String& Name)
-{
-    for (size_t i = 0; i < RealtimeEngine.GetNumEntities(); ++i)
-    {
-        if (RealtimeEngine.GetEntityByIndex(i)->GetName() == Name)
-        {
-            return RealtimeEngine.GetEntityByIndex(i);
-        }
-    }
-
-    return nullptr;
-}
+    const auto DeltaTimeMS = std::chrono::duration_cast<std::chrono::milliseconds>(DeltaTime).count();
+    const csp::common::String DeltaTimeJSON = JSONStringFromDeltaTime(static_cast<double>(DeltaTimeMS));
 
-csp::multiplayer::SpaceEntity* FindSpaceEntityById(csp::common::IRealtimeEngine& RealtimeEngine, uint64_t EntityId)
-{
-    for (size_t i = 0; i < RealtimeEngine.GetNumEntities(); ++i)
+    for (size_t i = 0; i < Entities.Size(); ++i)
     {
-        if (RealtimeEngine.GetEntityByIndex(i)->GetId() == EntityId)
+        csp::multiplayer::EntityScript& Script = Entities[i]->GetScript();
+
+        // Most entities have no tick subscription, so skip them before doing any per-message work
+        if (Script.IsSubscribedToMessage(TickMessage))
         {
-            return RealtimeEngine.GetEntityByIndex(i);
+            Script.PostMessageToScript(TickMessage, DeltaTimeJSON);
         }
     }
-
-    return nullptr;
+}
 }
 
-csp::multiplayer::SpaceEntity* FindSpaceAvatar(csp::common::IRealtimeEngine& RealtimeEngine, const csp::common::String& Name)
+namespace csp::multiplayer::RealtimeEngineUtils
+{
+csp::common::String ModifiableStatusToString(ModifiableStatus Failure)
 {
-    for (size_t i = 0; i < RealtimeEngine.GetNumAvatars(); ++i)
+    if (auto it = ModifiableStatusErrors.find(Failure); it != ModifiableStatusErrors.end())
     {
-        if (RealtimeEngine.GetAvatarByIndex(i)->GetName() == Name)
-        {
-            return RealtimeEngine.GetAvatarByIndex(i);
-        }
+        return it->second;
     }
-
-    return nullptr;
+    return "No log specified for modifiable status";
 }
 
-csp::multiplayer::SpaceEntity* FindSpaceObject(csp::common::IRealtimeEngine& RealtimeEngine, const csp::common::String& Name)
+csp::common::List<SpaceEntity*> ToList(const std::vector<SpaceEntity*>& Entities)
 {
-    for (size_t i = 0; i < RealtimeEngine.GetNumObjects(); ++i)
+    csp::common::List<SpaceEntity*> Result(Entities.size());
+
+    for (SpaceEntity* Entity : Entities)
     {
-        if (RealtimeEngine.GetObjectByIndex(i)->GetName() == Name)
-        {
-            return RealtimeEngine.GetObjectByIndex(i);
-        }
+        Result.Append(Entity);
     }
 
-    return nullptr;
+    return Result;
 }
 
 std::unique_ptr<csp::multiplayer::SpaceEntity> BuildNewAvatar(const csp::common::String& UserId, csp::common::IRealtimeEngine& RealtimeEngine,
@@ -241,6 +224,32 @@ void ClaimScriptOwnership(SpaceEntity* Entity, uint64_t ClientId)
     Script.SetOwnerId(ClientId);
 }
 
+void UpdateGlobalTransforms(std::vector<SpaceEntity*>& UpdateOrder)
+{
+    // Breadth first, so each entity is visited after its parent, whose cache is then already up to date.
+    // Only dirty children are followed. Dirty entities further below a clean one are either roots themselves, or are left to be
+    // computed when next read. A root may already be clean, if a query or the walk from another root got to it first.
+    for (size_t i = 0; i < UpdateOrder.size(); ++i)
+    {
+        SpaceEntity* Entity = UpdateOrder[i];
+
+        if (Entity->IsGlobalTransformDirty())
+        {
+            Entity->GetGlobalTransform();
+        }
+
+        const csp::common::List<SpaceEntity*>& ChildEntities = *Entity->GetChildEntities();
+
+        for (size_t j = 0; j < ChildEntities.Size(); ++j)
+        {
+            if (ChildEntities[j]->IsGlobalTransformDirty())
+            {
+                UpdateOrder.push_back(ChildEntities[j]);
+            }
+        }
+    }
+}
+
 std::chrono::system_clock::time_point TickEntityScripts(std::recursive_mutex& EntitiesLock, csp::common::RealtimeEngineType RealtimeEngineType,
     const csp::common::List<SpaceEntity*>& Entities, std::chrono::system_clock::time_point LastTickTime,
     csp::common::Optional<csp::multiplayer::ClientElectionManager*> ElectionManager)
@@ -248,30 +257,24 @@ std::chrono::system_clock::time_point TickEntityScripts(std::recursive_mutex& En
     std::scoped_lock EntitiesLocker(EntitiesLock);
 
     const auto CurrentTime = std::chrono::system_clock::now();
-    const auto DeltaTimeMS = std::chrono::duration_cast<std::chrono::milliseconds>(CurrentTime - LastTickTime).count();
 
-    const csp::common::String DeltaTimeJSON = JSONStringFromDeltaTime(static_cast<double>(DeltaTimeMS));
+    bool CanRunScripts = true;
 
-    for (size_t i = 0; i < Entities.Size(); ++i)
+    // Note that offline realtime engines may always run scripts.
+    if (RealtimeEngineType == csp::common::RealtimeEngineType::Online)
     {
-        bool CanRunScripts = true;
-
-        // Note that offline realtime engines may always run scripts.
-        if (RealtimeEngineType == csp::common::RealtimeEngineType::Online)
+        // If this is an online engine with leadership election enabled, then only the script leader may run scripts.
+        // If there is no leadership election, then we assume all clients may run scripts.
+        csp::multiplayer::ClientElectionManager* ElectionManagerPtr = ElectionManager.HasValue() ? *ElectionManager : nullptr;
+        if (ElectionManagerPtr != nullptr)
         {
-            // If this is an online engine with leadership election enabled, then only the script leader may run scripts.
-            // If there is no leadership election, then we assume all clients may run scripts.
-            csp::multiplayer::ClientElectionManager* ElectionManagerPtr = ElectionManager.HasValue() ? *ElectionManager : nullptr;
-            if (ElectionManagerPtr != nullptr)
-            {
-                CanRunScripts = ElectionManagerPtr->IsLocalClientLeader();
-            }
+            CanRunScripts = ElectionManagerPtr->IsLocalClientLeader();
         }
+    }
 
-        if (CanRunScripts)
-        {
-            Entities[i]->GetScript().PostMessageToScript(SCRIPT_MSG_ENTITY_TICK, DeltaTimeJSON);
-        }
+    if (CanRunScripts)
+    {
+        PostTickToEntityScripts(Entities, CurrentTime - LastTickTime);
     }
 
     return CurrentTime;
@@ -283,15 +286,68 @@ std::chrono::system_clock::time_point TickEntityScripts(
     std::scoped_lock EntitiesLocker(EntitiesLock);
 
     const auto CurrentTime = std::chrono::system_clock::now();
-    const auto DeltaTimeMS = std::chrono::duration_cast<std::chrono::milliseconds>(CurrentTime - LastTickTime).count();
 
-    const csp::common::String DeltaTimeJSON = JSONStringFromDeltaTime(static_cast<double>(DeltaTimeMS));
+    PostTickToEntityScripts(Entities, CurrentTime - LastTickTime);
+
+    return CurrentTime;
+}
+
+std::chrono::system_clock::time_point TickEntityScripts(std::recursive_mutex& EntitiesLock, const csp::common::List<SpaceEntity*>& Entities,
+    const std::function<std::optional<std::chrono::system_clock::duration>(const SpaceEntity*, std::chrono::system_clock::time_point)>&
+        GetDeltaTime)
+{
+    static const csp::common::String TickMessage = csp::multiplayer::SCRIPT_MSG_ENTITY_TICK;
+
+    std::scoped_lock EntitiesLocker(EntitiesLock);
+
+    const auto CurrentTime = std::chrono::system_clock::now();
 
     for (size_t i = 0; i < Entities.Size(); ++i)
     {
-        Entities[i]->GetScript().PostMessageToScript(SCRIPT_MSG_ENTITY_TICK, DeltaTimeJSON);
+        csp::multiplayer::EntityScript& Script = Entities[i]->GetScript();
+
+        if (!Script.IsSubscribedToMessage(TickMessage))
+        {
+            continue;
+        }
+
+        if (const auto DeltaTime = GetDeltaTime(Entities[i], CurrentTime))
+        {
+            const auto DeltaTimeMS = std::chrono::duration_cast<std::chrono::milliseconds>(*DeltaTime).count();
+            Script.PostMessageToScript(TickMessage, JSONStringFromDeltaTime(static_cast<double>(DeltaTimeMS)));
+        }
     }
 
     return CurrentTime;
 }
+
+csp::common::List<SpaceEntity*> FindSpaceEntitiesInRadius(SpaceEntitySpatialIndex& SpatialIndex, const csp::common::Vector3& Position, float Radius)
+{
+    SpatialIndex.Refresh();
+
+    std::vector<SpaceEntity*> Found;
+    SpatialIndex.QueryRadius(Position, Radius, Found);
+
+    return ToList(Found);
+}
+
+csp::common::List<SpaceEntity*> FindNearestSpaceEntities(SpaceEntitySpatialIndex& SpatialIndex, const csp::common::Vector3& Position, size_t Count)
+{
+    SpatialIndex.Refresh();
+
+    std::vector<SpaceEntity*> Found;
+    SpatialIndex.QueryNearest(Position, Count, Found);
+
+    return ToList(Found);
+}
+
+csp::common::List<SpaceEntity*> FindSpaceEntitiesInFrustum(SpaceEntitySpatialIndex& SpatialIndex, const csp::common::List<csp::common::Vector4>& Planes)
+{
+    SpatialIndex.Refresh();
+
+    std::vector<SpaceEntity*> Found;
+    SpatialIndex.QueryPlanes(std::vector<csp::common::Vector4>(Planes.begin(), Planes.end()), Found);
+
+    return ToList(Found);
+}
 }
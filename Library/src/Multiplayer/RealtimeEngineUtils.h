@@ -21,9 +21,12 @@
 #include "CSP/Common/String.h"
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace csp::common
 {
@@ -35,6 +38,7 @@ class LogSystem;
 namespace csp::multiplayer
 {
 class ClientElectionManager;
+class SpaceEntitySpatialIndex;
 }
 
 /*
@@ -63,16 +67,8 @@ static const std::unordered_map<ModifiableStatus, csp::common::String> Modifiabl
 
 csp::common::String ModifiableStatusToString(ModifiableStatus Failure);
 
-// Finds a space entity in the Entities container. Returns nullptr if the entity is not found.
-csp::multiplayer::SpaceEntity* FindSpaceEntity(csp::common::IRealtimeEngine& RealtimeEngine, const csp::common::String& Name);
-
-csp::multiplayer::SpaceEntity* FindSpaceEntityById(csp::common::IRealtimeEngine& RealtimeEngine, uint64_t EntityId);
-
-// Finds an avatar entity in the Avatar container. Returns nullptr if the avatar is not found.
-csp::multiplayer::SpaceEntity* FindSpaceAvatar(csp::common::IRealtimeEngine& RealtimeEngine, const csp::common::String& Name);
-
-// Finds an object in the Objects container. Returns nullptr if the object is not found.
-csp::multiplayer::SpaceEntity* FindSpaceObject(csp::common::IRealtimeEngine& RealtimeEngine, const csp::common::String& Name);
+// Copies the results of an index lookup into the list type returned through IRealtimeEngine.
+csp::common::List<SpaceEntity*> ToList(const std::vector<SpaceEntity*>& Entities);
 
 // Creates a space entity with an avatar component.
 std::unique_ptr<csp::multiplayer::SpaceEntity> BuildNewAvatar(const csp::common::String& UserId, csp::common::IRealtimeEngine& RealtimeEngine,
@@ -109,6 +105,18 @@ void DetermineScriptOwners(const csp::common::List<SpaceEntity*>& Entities, uint
 // ClientID is the ID that comes from the multiplayerConnection
 void ClaimScriptOwnership(SpaceEntity* Entity, uint64_t ClientId);
 
+// Brings the cached global transforms below the given dirty roots up to date, walking down from each root so every entity follows its parent.
+// UpdateOrder should hold the roots on entry, and is used as scratch space for the walk. Pass the same vector each time to avoid reallocating it.
+// You should lock the entities mutex before calling this.
+void UpdateGlobalTransforms(std::vector<SpaceEntity*>& UpdateOrder);
+
+// Spatial queries over the entities in SpatialIndex, which is refreshed first so entities that have moved are found where they are now.
+// You should lock the entities mutex before calling these.
+csp::common::List<SpaceEntity*> FindSpaceEntitiesInRadius(SpaceEntitySpatialIndex& SpatialIndex, const csp::common::Vector3& Position, float Radius);
+csp::common::List<SpaceEntity*> FindNearestSpaceEntities(SpaceEntitySpatialIndex& SpatialIndex, const csp::common::Vector3& Position, size_t Count);
+csp::common::List<SpaceEntity*> FindSpaceEntitiesInFrustum(
+    SpaceEntitySpatialIndex& SpatialIndex, const csp::common::List<csp::common::Vector4>& Planes);
+
 // TODO: remove in OF-1785
 std::chrono::system_clock::time_point TickEntityScripts(std::recursive_mutex& EntitiesLock, csp::common::RealtimeEngineType RealtimeEngineType,
     const csp::common::List<SpaceEntity*>& Entities, std::chrono::system_clock::time_point LastTickTime,
@@ -118,4 +126,10 @@ std::chrono::system_clock::time_point TickEntityScripts(std::recursive_mutex& En
 std::chrono::system_clock::time_point TickEntityScripts(
     std::recursive_mutex& EntitiesLock, const csp::common::List<SpaceEntity*>& Entities, std::chrono::system_clock::time_point LastTickTime);
 
+// As above, but each entity with a tick subscription is ticked by the time GetDeltaTime returns for it, and skipped if it returns nothing.
+// GetDeltaTime is passed the current time, and is not called for entities that aren't subscribed to the tick message.
+std::chrono::system_clock::time_point TickEntityScripts(std::recursive_mutex& EntitiesLock, const csp::common::List<SpaceEntity*>& Entities,
+    const std::function<std::optional<std::chrono::system_clock::duration>(const SpaceEntity*, std::chrono::system_clock::time_point)>&
+        GetDeltaTime);
+
 }
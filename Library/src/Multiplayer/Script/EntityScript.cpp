@@ -21,6 +21,7 @@
 #include "CSP/Multiplayer/Components/ScriptSpaceComponent.h"
 #include "CSP/Multiplayer/Script/EntityScriptMessages.h"
 #include "CSP/Multiplayer/SpaceEntity.h"
+#include "Common/Systems/Log/LogMacros.h"
 
 #include <fmt/format.h>
 
@@ -46,10 +47,7 @@ EntityScript::~EntityScript() { Shutdown(); }
 
 bool EntityScript::Invoke()
 {
-    if (LogSystem != nullptr)
-    {
-        LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose, fmt::format("EntityScript::Invoke called for {}", Entity->GetName()).c_str());
-    }
+    CSP_LOG_LAZY(LogSystem, csp::common::LogLevel::VeryVerbose, "EntityScript::Invoke called for {}", Entity->GetName());
 
     CheckBinding();
 
@@ -95,35 +93,33 @@ void EntityScript::RunScript(const csp::common::String& ScriptSource)
         return;
     }
 
-    // If offline, just run the script
-    if (RealtimeEnginePtr->GetRealtimeEngineType() != csp::common::RealtimeEngineType::Online)
-    {
-        ScriptRunner->RunScript(Entity->GetId(), ScriptSource);
-        return;
-    }
-
-    // Otherwise we're online
-    auto* OnlineRealtimeEngine = static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEnginePtr);
-    if (OnlineRealtimeEngine->CheckIfWeShouldRunScriptsLocally())
+    if (ShouldRunScriptsLocally())
     {
         ScriptRunner->RunScript(Entity->GetId(), ScriptSource);
     }
     else
     {
-
-        OnlineRealtimeEngine->RunScriptRemotely(Entity->GetId(), ScriptSource);
+        static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEnginePtr)->RunScriptRemotely(Entity->GetId(), ScriptSource);
     }
 }
 
-void EntityScript::SetScriptSource(const csp::common::String& InScriptSource)
+bool EntityScript::ShouldRunScriptsLocally() const
 {
-    if (LogSystem != nullptr)
+    // If offline, scripts always run locally
+    if (RealtimeEnginePtr->GetRealtimeEngineType() != csp::common::RealtimeEngineType::Online)
     {
-        LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose,
-            fmt::format("EntityScript::SetScriptSource called for {0}\nSource: {1}", Entity->GetName(), InScriptSource).c_str());
-        LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose, "--EndScriptSource--");
+        return true;
     }
 
+    return static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEnginePtr)->CheckIfWeShouldRunScriptsLocally();
+}
+
+void EntityScript::SetScriptSource(const csp::common::String& InScriptSource)
+{
+    CSP_LOG_LAZY(LogSystem, csp::common::LogLevel::VeryVerbose, "EntityScript::SetScriptSource called for {0}\nSource: {1}", Entity->GetName(),
+        InScriptSource);
+    CSP_LOG_LAZY(LogSystem, csp::common::LogLevel::VeryVerbose, "--EndScriptSource--");
+
     if (EntityScriptComponent == nullptr)
     {
         EntityScriptComponent = (ScriptSpaceComponent*)(Entity->AddComponent(ComponentType::ScriptData));
@@ -194,10 +190,7 @@ void EntityScript::Shutdown()
 
 void EntityScript::OnSourceChanged(const csp::common::String& InScriptSource)
 {
-    if (LogSystem != nullptr)
-    {
-        LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose, fmt::format("OnSourceChanged: {}\n", InScriptSource).c_str());
-    }
+    CSP_LOG_LAZY(LogSystem, csp::common::LogLevel::VeryVerbose, "OnSourceChanged: {}\n", InScriptSource);
 
     if (EntityScriptComponent != nullptr)
     {
@@ -238,11 +231,8 @@ void EntityScript::SubscribeToPropertyChange(int32_t ComponentId, int32_t Proper
 
     if (It == PropertyMap.end())
     {
-        if (LogSystem != nullptr)
-        {
-            LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose,
-                fmt::format("SubscribeToPropertyChange: ({0}, {1}) {2}\n", ComponentId, PropertyKey, Message).c_str());
-        }
+        CSP_LOG_LAZY(
+            LogSystem, csp::common::LogLevel::VeryVerbose, "SubscribeToPropertyChange: ({0}, {1}) {2}\n", ComponentId, PropertyKey, Message);
 
         PropertyMap.insert(PropertyChangeMap::value_type(Key, Message));
     }
@@ -270,10 +260,7 @@ void EntityScript::SubscribeToMessage(const csp::common::String Message, const c
 
     if (It == MessageMap.end())
     {
-        if (LogSystem != nullptr)
-        {
-            LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose, fmt::format("SubscribeToMessage: {} -> {}\n", Message, OnMessageCallback).c_str());
-        }
+        CSP_LOG_LAZY(LogSystem, csp::common::LogLevel::VeryVerbose, "SubscribeToMessage: {} -> {}\n", Message, OnMessageCallback);
 
         MessageMap.insert(SubscribedMessageMap::value_type(Message, OnMessageCallback));
     }
@@ -287,20 +274,39 @@ void EntityScript::PostMessageToScript(const csp::common::String Message, const
     {
         const csp::common::String& OnMessageCallback = It->second;
 
-        // Generate a call to the callback with the correct parameters
-        csp::common::String ScriptText
-            = csp::common::StringFormat("%s('%s','%s')", OnMessageCallback.c_str(), Message.c_str(), MessageParamsJson.c_str());
-
         if (Message != SCRIPT_MSG_ENTITY_TICK)
+        {
+            CSP_LOG_LAZY(LogSystem, csp::common::LogLevel::VeryVerbose, "PostMessageToScript: {}('{}','{}')\n", OnMessageCallback, Message,
+                MessageParamsJson);
+        }
+
+        if (RealtimeEnginePtr == nullptr)
         {
             if (LogSystem != nullptr)
             {
-                LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose, fmt::format("PostMessageToScript: {}\n", ScriptText).c_str());
+                LogSystem->LogMsg(csp::common::LogLevel::Fatal, "Null RealtimeEngine when trying to post message to script. Aborting Operation.");
             }
+
+            return;
         }
 
-        RunScript(ScriptText.c_str());
+        if (ShouldRunScriptsLocally())
+        {
+            // Call the subscribed callback directly rather than evaluating a generated call expression,
+            // so the script runner doesn't need to parse new source for every message.
+            ScriptRunner->CallMessageCallback(Entity->GetId(), OnMessageCallback, Message, MessageParamsJson);
+        }
+        else
+        {
+            // Remote clients can only be sent source, so generate a call to the callback with the correct parameters
+            csp::common::String ScriptText
+                = csp::common::StringFormat("%s('%s','%s')", OnMessageCallback.c_str(), Message.c_str(), MessageParamsJson.c_str());
+
+            static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEnginePtr)->RunScriptRemotely(Entity->GetId(), ScriptText);
+        }
     }
 }
 
+bool EntityScript::IsSubscribedToMessage(const csp::common::String& Message) const { return MessageMap.find(Message) != MessageMap.end(); }
+
 } // namespace csp::multiplayer
@@ -209,16 +209,9 @@ public:
         EntityScriptInterface* ScriptInterface = nullptr;
         if (EntitySystem)
         {
-            RAIILock EntityLock([&]() { EntitySystem->LockEntityUpdate(); }, [&]() { EntitySystem->UnlockEntityUpdate(); });
-
-            for (size_t i = 0; i < EntitySystem->GetNumEntities(); ++i)
+            if (SpaceEntity* Entity = EntitySystem->FindSpaceEntity(EntityName.c_str()))
             {
-                SpaceEntity* Entity = EntitySystem->GetEntityByIndex(i);
-                if (Entity->GetName() == EntityName.c_str())
-                {
-                    ScriptInterface = Entity->GetScriptInterface();
-                    break;
-                }
+                ScriptInterface = Entity->GetScriptInterface();
             }
         }
 
@@ -242,9 +235,79 @@ public:
         return RootHierarchyEntities;
     }
 
+    // Positions are [x, y, z] arrays, as elsewhere in the script API.
+    std::vector<EntityScriptInterface*> GetEntitiesInRadius(std::vector<float> Position, float Radius)
+    {
+        std::vector<EntityScriptInterface*> Entities;
+
+        if (EntitySystem && Position.size() >= 3)
+        {
+            RAIILock EntityLock([&]() { EntitySystem->LockEntityUpdate(); }, [&]() { EntitySystem->UnlockEntityUpdate(); });
+
+            const auto Found = EntitySystem->FindSpaceEntitiesInRadius(csp::common::Vector3(Position[0], Position[1], Position[2]), Radius);
+            AppendScriptInterfaces(Found, Entities);
+        }
+
+        return Entities;
+    }
+
+    std::vector<EntityScriptInterface*> GetNearestEntities(std::vector<float> Position, int32_t Count)
+    {
+        std::vector<EntityScriptInterface*> Entities;
+
+        if (EntitySystem && Position.size() >= 3 && Count > 0)
+        {
+            RAIILock EntityLock([&]() { EntitySystem->LockEntityUpdate(); }, [&]() { EntitySystem->UnlockEntityUpdate(); });
+
+            const auto Found
+                = EntitySystem->FindNearestSpaceEntities(csp::common::Vector3(Position[0], Position[1], Position[2]), static_cast<size_t>(Count));
+            AppendScriptInterfaces(Found, Entities);
+        }
+
+        return Entities;
+    }
+
+    // Planes are [x, y, z, d] arrays with the normal pointing into the frustum, see IRealtimeEngine::FindSpaceEntitiesInFrustum.
+    std::vector<EntityScriptInterface*> GetEntitiesInFrustum(std::vector<std::vector<float>> Planes)
+    {
+        std::vector<EntityScriptInterface*> Entities;
+
+        if (EntitySystem)
+        {
+            csp::common::List<csp::common::Vector4> FrustumPlanes(Planes.size());
+
+            for (const std::vector<float>& Plane : Planes)
+            {
+                if (Plane.size() < 4)
+                {
+                    return Entities;
+                }
+
+                FrustumPlanes.Append(csp::common::Vector4(Plane[0], Plane[1], Plane[2], Plane[3]));
+            }
+
+            RAIILock EntityLock([&]() { EntitySystem->LockEntityUpdate(); }, [&]() { EntitySystem->UnlockEntityUpdate(); });
+
+            const auto Found = EntitySystem->FindSpaceEntitiesInFrustum(FrustumPlanes);
+            AppendScriptInterfaces(Found, Entities);
+        }
+
+        return Entities;
+    }
+
     std::string GetFoundationVersion() { return csp::CSPFoundation::GetVersion().c_str(); }
 
 private:
+    static void AppendScriptInterfaces(const csp::common::List<SpaceEntity*>& Found, std::vector<EntityScriptInterface*>& OutEntities)
+    {
+        OutEntities.reserve(OutEntities.size() + Found.Size());
+
+        for (size_t i = 0; i < Found.Size(); ++i)
+        {
+            OutEntities.push_back(Found[i]->GetScriptInterface());
+        }
+    }
+
     csp::common::IRealtimeEngine* EntitySystem;
 };
 
@@ -672,7 +735,10 @@ void EntityScriptBinding::Bind(int64_t ContextId, csp::common::IJSScriptRunner&
         .fun<&EntitySystemScriptInterface::GetEntityById>("getEntityById")
         .fun<&EntitySystemScriptInterface::GetEntityByName>("getEntityByName")
         .fun<&EntitySystemScriptInterface::GetIndexOfEntity>("getIndexOfEntity")
-        .fun<&EntitySystemScriptInterface::GetRootHierarchyEntities>("getRootHierarchyEntities");
+        .fun<&EntitySystemScriptInterface::GetRootHierarchyEntities>("getRootHierarchyEntities")
+        .fun<&EntitySystemScriptInterface::GetEntitiesInRadius>("getEntitiesInRadius")
+        .fun<&EntitySystemScriptInterface::GetNearestEntities>("getNearestEntities")
+        .fun<&EntitySystemScriptInterface::GetEntitiesInFrustum>("getEntitiesInFrustum");
 
     Context->global()["TheEntitySystem"] = new EntitySystemScriptInterface(EntitySystem);
     Context->global()["ThisEntity"] = new EntityScriptInterface(EntitySystem->FindSpaceEntityById(ContextId));
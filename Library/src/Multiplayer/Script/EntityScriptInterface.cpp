@@ -229,19 +229,15 @@ std::vector<ComponentScriptInterface*> EntityScriptInterface::GetComponents()
     if (Entity)
     {
         const csp::common::Map<uint16_t, ComponentBase*>& ComponentMap = *Entity->GetComponents();
-        const auto ComponentKeys = ComponentMap.Keys();
+        Components.reserve(ComponentMap.Size());
 
-        for (size_t i = 0; i < ComponentKeys->Size(); ++i)
+        for (const auto& [Key, Component] : ComponentMap)
         {
-            ComponentBase* Component = ComponentMap[ComponentKeys->operator[](i)];
-
             if (Component->GetScriptInterface() != nullptr)
             {
                 Components.push_back(Component->GetScriptInterface());
             }
         }
-
-        delete (ComponentKeys);
     }
 
     return Components;
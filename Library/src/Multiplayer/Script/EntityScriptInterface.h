@@ -86,19 +86,14 @@ template <typename ScriptInterface, ComponentType Type> std::vector<ScriptInterf
         const ComponentType ThisType = Type;
 
         const auto& ComponentMap = *Entity->GetComponents();
-        const auto ComponentKeys = ComponentMap.Keys();
 
-        for (size_t i = 0; i < ComponentKeys->Size(); ++i)
+        for (const auto& [Key, Component] : ComponentMap)
         {
-            ComponentBase* Component = ComponentMap[ComponentKeys->operator[](i)];
-
             if ((Component != nullptr) && (Component->GetComponentType() == ThisType) && (Component->GetScriptInterface() != nullptr))
             {
                 Components.push_back((ScriptInterface*)Component->GetScriptInterface());
             }
         }
-
-        delete (ComponentKeys);
     }
 
     return Components;
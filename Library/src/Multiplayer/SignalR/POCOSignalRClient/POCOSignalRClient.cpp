@@ -21,6 +21,7 @@
 #include <Poco/Net/NetException.h>
 #include <Poco/URI.h>
 #include <chrono>
+#include <cstring>
 #include <fmt/format.h>
 #include <stdexcept>
 #include <thread>
@@ -33,13 +34,32 @@ using namespace std::chrono_literals;
 constexpr const size_t INITIAL_BUFFER_SIZE = 8192;
 constexpr const size_t RECEIVE_BLOCK_SIZE = 4096;
 
+// How long a blocking socket poll may wait before re-checking whether we've been asked to stop.
+// This only bounds shutdown latency, incoming data wakes the poll immediately.
+constexpr const long SOCKET_POLL_TIMEOUT_MICROSECONDS = 50000;
+
+// SignalR binary messages are prefixed with their length as a varint of at most 5 bytes.
+constexpr const size_t MAX_LENGTH_PREFIX_SIZE = 5;
+
+// JSON messages, which the handshake always is, are terminated with the 0x1E character.
+constexpr const char JSON_RECORD_SEPARATOR = 0x1E;
+
 namespace csp::multiplayer
 {
 
 CSPWebSocketClientPOCO::CSPWebSocketClientPOCO(
     const std::string& MultiplayerUri, const std::string& AccessToken, const std::string& DeviceId, csp::common::LogSystem& LogSystem) noexcept
     : PocoWebSocket(nullptr)
+    , ReceiveReady(false)
     , StopFlag(false)
+    , ReceiveBuffer(0)
+    , ReceiveReadIndex(0)
+    , BytesReceived(0)
+    , FramesReceived(0)
+    , MessagesReceived(0)
+    , BatchesDelivered(0)
+    , TotalQueueDelayMicroseconds(0)
+    , MaxQueueDelayMicroseconds(0)
     , MultiplayerUri { MultiplayerUri }
     , AccessToken { AccessToken }
     , DeviceId { DeviceId }
@@ -106,6 +126,18 @@ void CSPWebSocketClientPOCO::Start(const std::string& /*Url*/, CallbackHandler C
         request.set("Authorization", Str);
 
         StopFlag = false;
+        ReceiveReady = false;
+
+        ReceiveBuffer.resize(0);
+        ReceiveBuffer.setCapacity(INITIAL_BUFFER_SIZE);
+        ReceiveReadIndex = 0;
+
+        BytesReceived = 0;
+        FramesReceived = 0;
+        MessagesReceived = 0;
+        BatchesDelivered = 0;
+        TotalQueueDelayMicroseconds = 0;
+        MaxQueueDelayMicroseconds = 0;
 
         PocoWebSocket = new Poco::Net::WebSocket(*cs, request, response);
         // Receive worker thread
@@ -132,6 +164,13 @@ void CSPWebSocketClientPOCO::Stop(CallbackHandler Callback)
     {
         StopFlag = true;
 
+        // Wake the receive thread if it is waiting for SignalR to ask for the next message.
+        // Taking the lock ensures it either sees the flag before waiting or is already waiting and receives the notification.
+        {
+            std::scoped_lock ReceiveLock(ReceiveMutex);
+        }
+        ReceiveReadyCondition.notify_all();
+
         // We need to unlock here to prevent a deadlock
         // If the ReceiveThread is locked then the other thread will never finish because itd will be waiting for the ReceiveThread to join
         Mutex.unlock();
@@ -213,8 +252,13 @@ void CSPWebSocketClientPOCO::Receive(ReceiveHandler Callback)
     {
         assert(PocoWebSocket && "Web socket not created! Please call Start() before calling Receive().");
 
-        ReceiveCallback = Callback;
-        ReceiveReady = true;
+        {
+            std::scoped_lock ReceiveLock(ReceiveMutex);
+            ReceiveCallback = Callback;
+            ReceiveReady = true;
+        }
+
+        ReceiveReadyCondition.notify_one();
     }
     else if (Callback)
     {
@@ -224,15 +268,59 @@ void CSPWebSocketClientPOCO::Receive(ReceiveHandler Callback)
 
 void CSPWebSocketClientPOCO::__CauseFailure() { HandleReceiveError("__CauseFailure"); }
 
+size_t CSPWebSocketClientPOCO::FindCompleteMessagesEnd(const char* Data, size_t Size, size_t& OutMessageCount)
+{
+    size_t Offset = 0;
+    OutMessageCount = 0;
+
+    while (Offset < Size)
+    {
+        size_t Length = 0;
+        size_t PrefixSize = 0;
+        bool PrefixComplete = false;
+
+        while (PrefixSize < MAX_LENGTH_PREFIX_SIZE && Offset + PrefixSize < Size)
+        {
+            const auto Byte = static_cast<unsigned char>(Data[Offset + PrefixSize]);
+            Length |= static_cast<size_t>(Byte & 0x7F) << (PrefixSize * 7);
+            ++PrefixSize;
+
+            if ((Byte & 0x80) == 0)
+            {
+                PrefixComplete = true;
+                break;
+            }
+        }
+
+        // Either the prefix itself hasn't fully arrived, or the payload hasn't
+        if (!PrefixComplete || Length > Size - Offset - PrefixSize)
+        {
+            break;
+        }
+
+        Offset += PrefixSize + Length;
+        ++OutMessageCount;
+    }
+
+    return Offset;
+}
+
+CSPWebSocketClientPOCO::ReceiveStatistics CSPWebSocketClientPOCO::GetReceiveStatistics() const
+{
+    ReceiveStatistics Statistics;
+    Statistics.BytesReceived = BytesReceived;
+    Statistics.FramesReceived = FramesReceived;
+    Statistics.MessagesReceived = MessagesReceived;
+    Statistics.BatchesDelivered = BatchesDelivered;
+    Statistics.TotalQueueDelay = std::chrono::microseconds(TotalQueueDelayMicroseconds.load());
+    Statistics.MaxQueueDelay = std::chrono::microseconds(MaxQueueDelayMicroseconds.load());
+
+    return Statistics;
+}
+
 void CSPWebSocketClientPOCO::ReceiveThreadFunc()
 {
     bool HandshakeReceived = false;
-    auto* Buffer = (char*)std::malloc(INITIAL_BUFFER_SIZE);
-    auto CurrentBufferSize = INITIAL_BUFFER_SIZE;
-    auto CurrentBufferIndex = 0;
-    auto SkipWait = false;
-    auto SocketPollTimeout = Poco::Timespan(1000);
-    auto ShouldRead = true;
 
     for (;;)
     {
@@ -243,199 +331,175 @@ void CSPWebSocketClientPOCO::ReceiveThreadFunc()
             return;
         }
 
-        if (!SkipWait)
+        const char* Pending = ReceiveBuffer.begin() + ReceiveReadIndex;
+        const size_t PendingSize = ReceiveBuffer.size() - ReceiveReadIndex;
+
+        size_t BatchSize = 0;
+        size_t MessageCount = 0;
+
+        if (!HandshakeReceived)
         {
-            while (!ReceiveReady)
-            {
-                std::this_thread::sleep_for(500ns);
+            // Handshake needs to be handled differently as it is in JSON format
+            const auto* Terminator = static_cast<const char*>(std::memchr(Pending, JSON_RECORD_SEPARATOR, PendingSize));
 
-                if (StopFlag)
-                {
-                    return;
-                }
+            if (Terminator != nullptr)
+            {
+                BatchSize = (Terminator - Pending) + 1;
+                MessageCount = 1;
+                HandshakeReceived = true;
             }
         }
+        else
+        {
+            // Hand over every complete message we hold in one go, SignalR will parse them all out of a single payload
+            BatchSize = FindCompleteMessagesEnd(Pending, PendingSize, MessageCount);
+        }
 
-        SkipWait = false;
-
-        if (ShouldRead)
+        if (BatchSize > 0)
         {
-            // Resize buffer if needed
-            if (CurrentBufferIndex + RECEIVE_BLOCK_SIZE > CurrentBufferSize)
-            {
-                auto* NewBuffer = std::realloc(Buffer, CurrentBufferSize * 2);
-                Buffer = static_cast<char*>(NewBuffer);
-                CurrentBufferSize = CurrentBufferSize * 2;
-                LogSystem.LogMsg(csp::common::LogLevel::Log, fmt::format("Resizing receive buffer to {}", CurrentBufferSize).c_str());
-            }
+            DeliverBatch(Pending, BatchSize, MessageCount);
+            continue;
+        }
 
-            try
-            {
-                while (!PocoWebSocket->poll(SocketPollTimeout, Poco::Net::WebSocket::SELECT_READ))
-                {
-                    std::this_thread::sleep_for(500ns);
-
-                    if (StopFlag)
-                    {
-                        return;
-                    }
-                }
-            }
-            catch (const std::exception& e)
-            {
-                std::free(Buffer);
-                HandleReceiveError(e.what());
+        // Read more data if we don't have a complete message yet
+        if (!ReadFrame())
+        {
+            return;
+        }
+    }
+}
 
-                return;
-            }
+CSPWebSocketClientPOCO::ReceiveHandler CSPWebSocketClientPOCO::WaitForReceiveReady()
+{
+    std::unique_lock ReceiveLock(ReceiveMutex);
+    ReceiveReadyCondition.wait(ReceiveLock, [this]() { return ReceiveReady || StopFlag; });
 
-            int Flags;
-            int Received = 0;
+    if (StopFlag)
+    {
+        return nullptr;
+    }
 
-            try
-            {
-                Received = PocoWebSocket->receiveFrame(Buffer + CurrentBufferIndex, RECEIVE_BLOCK_SIZE, Flags);
-            }
-            catch (const std::exception& e)
-            {
-                std::free(Buffer);
-                HandleReceiveError(e.what());
+    ReceiveReady = false;
 
-                return;
-            }
+    return ReceiveCallback;
+}
 
-            if (Received == 0)
-            {
-                std::free(Buffer);
-                HandleReceiveError("Error: Socket closed by remote host.");
+bool CSPWebSocketClientPOCO::ReadFrame()
+{
+    // Reclaim space used by delivered messages before growing
+    if (ReceiveReadIndex == ReceiveBuffer.size())
+    {
+        ReceiveBuffer.resize(0);
+        ReceiveReadIndex = 0;
+    }
+    else if (ReceiveReadIndex > 0 && ReceiveBuffer.capacity() - ReceiveBuffer.size() < RECEIVE_BLOCK_SIZE)
+    {
+        const size_t Remaining = ReceiveBuffer.size() - ReceiveReadIndex;
+        std::memmove(ReceiveBuffer.begin(), ReceiveBuffer.begin() + ReceiveReadIndex, Remaining);
+        ReceiveBuffer.resize(Remaining);
+        ReceiveReadIndex = 0;
+    }
 
-                return;
-            }
+    if (ReceiveBuffer.capacity() - ReceiveBuffer.size() < RECEIVE_BLOCK_SIZE)
+    {
+        ReceiveBuffer.setCapacity(ReceiveBuffer.capacity() * 2);
+        LogSystem.LogMsg(csp::common::LogLevel::Log, fmt::format("Resizing receive buffer to {}", ReceiveBuffer.capacity()).c_str());
+    }
 
-            assert(!(Flags & Poco::Net::WebSocket::FrameOpcodes::FRAME_OP_TEXT) && "The JSON hub protocol is currently not supported!");
+    int Flags = 0;
+    int Received = 0;
 
-            if (Flags & Poco::Net::WebSocket::FrameOpcodes::FRAME_OP_CLOSE)
+    try
+    {
+        // Block on the socket. The timeout only exists so that we notice Stop being called.
+        while (!PocoWebSocket->poll(Poco::Timespan(0, SOCKET_POLL_TIMEOUT_MICROSECONDS), Poco::Net::WebSocket::SELECT_READ))
+        {
+            if (StopFlag)
             {
-                std::free(Buffer);
-                HandleReceiveError("Error: Socket closed.");
-
-                return;
+                return false;
             }
-
-            CurrentBufferIndex += Received;
         }
 
-        if (StopFlag)
-        {
-            return;
-        }
+        // Appends the frame payload to the buffer, growing it if the frame is larger than the free space
+        Received = PocoWebSocket->receiveFrame(ReceiveBuffer, Flags);
+    }
+    catch (const std::exception& e)
+    {
+        HandleReceiveError(e.what());
 
-        // Handshake needs to be handled differently as it is in JSON format
-        if (!HandshakeReceived)
-        {
-            int i;
+        return false;
+    }
 
-            for (i = 0; i < CurrentBufferIndex; ++i)
-            {
-                // JSON messages are terminated with the 0x1E character
-                if (Buffer[i] == 0x1E)
-                {
-                    break;
-                }
-            }
+    if (Received == 0)
+    {
+        HandleReceiveError("Error: Socket closed by remote host.");
 
-            // Read more data if we haven't found the message terminator yet
-            if (i == CurrentBufferIndex)
-            {
-                SkipWait = true;
-                ShouldRead = true;
-                continue;
-            }
+        return false;
+    }
 
-            std::string CallbackMessage(Buffer, i + 1);
+    assert(!(Flags & Poco::Net::WebSocket::FrameOpcodes::FRAME_OP_TEXT) && "The JSON hub protocol is currently not supported!");
 
-            if (i < (CurrentBufferIndex - (i + 1)))
-            {
-                auto Remaining = CurrentBufferIndex - (i + 1);
-                memmove(Buffer, Buffer + i + 1, Remaining);
-                CurrentBufferIndex = Remaining;
-                ShouldRead = false;
-            }
-            else
-            {
-                CurrentBufferIndex = 0;
-                ShouldRead = true;
-            }
+    if (Flags & Poco::Net::WebSocket::FrameOpcodes::FRAME_OP_CLOSE)
+    {
+        HandleReceiveError("Error: Socket closed.");
 
-            HandshakeReceived = true;
-            ReceiveReady = false;
-            ReceiveCallback(CallbackMessage, true);
+        return false;
+    }
 
-            continue;
-        }
+    if (ReceiveReadIndex == ReceiveBuffer.size() - Received)
+    {
+        // The buffer was empty, so this frame starts the queue of undelivered data
+        OldestPendingReceiveTime = std::chrono::steady_clock::now();
+    }
 
-        /*
-         * TODO: Make sure we have enough bytes for length
-         * Max number of bytes for message length is 5. Let's ensure we have at least 5 before we try to read length.
-         */
+    BytesReceived += Received;
+    ++FramesReceived;
 
-        auto Length = 0;
-        int i;
+    return !StopFlag;
+}
 
-        for (i = 0; i < 5; ++i)
-        {
-            Length |= (Buffer[i] & 0x7F) << (i * 7);
+void CSPWebSocketClientPOCO::DeliverBatch(const char* Data, size_t Size, size_t MessageCount)
+{
+    ReceiveHandler Callback = WaitForReceiveReady();
 
-            if ((Buffer[i] & 0x80) == 0)
-            {
-                ++i;
-                break;
-            }
-        }
+    if (Callback == nullptr)
+    {
+        return;
+    }
 
-        // Continue reading if we don't have the entire message yet
-        if (Length > CurrentBufferIndex - i)
-        {
-            SkipWait = true;
-            ShouldRead = true;
-            continue;
-        }
+    DeliveryBuffer.assign(Data, Size);
+    ReceiveReadIndex += Size;
 
-        /*
-         * TODO: Look into modifying SignalR to process byte arrays instead of strings, and re-use a buffer for holding the
-         *  message to be processed
-         */
-        std::string CallbackMessage(Buffer, Length + i);
-        ReceiveReady = false;
+    const auto QueueDelay
+        = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - OldestPendingReceiveTime).count();
 
-        // Move remaining data to beginning of buffer
-        if (Length < CurrentBufferIndex - i)
-        {
-            auto Remaining = (CurrentBufferIndex - i) - Length;
-            memmove(Buffer, Buffer + Length + i, Remaining);
-            CurrentBufferIndex = Remaining;
-            // If we have remaining data, we should try to process it the next time Receive is called without reading from the socket
-            ShouldRead = false;
-        }
-        else
-        {
-            CurrentBufferIndex = 0;
-            ShouldRead = true;
-        }
+    MessagesReceived += MessageCount;
+    ++BatchesDelivered;
+    TotalQueueDelayMicroseconds += QueueDelay;
 
-        auto Callback = ReceiveCallback;
-        Callback(CallbackMessage, true);
+    if (QueueDelay > MaxQueueDelayMicroseconds)
+    {
+        MaxQueueDelayMicroseconds = QueueDelay;
     }
+
+    Callback(DeliveryBuffer, true);
 }
 
 void CSPWebSocketClientPOCO::HandleReceiveError(const std::string& Message)
 {
     LogSystem.LogMsg(csp::common::LogLevel::Error, Message.c_str());
 
-    if (ReceiveCallback)
+    ReceiveHandler Callback;
+
+    {
+        std::scoped_lock ReceiveLock(ReceiveMutex);
+        std::swap(Callback, ReceiveCallback);
+        ReceiveReady = false;
+    }
+
+    if (Callback)
     {
-        ReceiveCallback("", false);
-        ReceiveCallback = nullptr;
+        Callback("", false);
     }
 }
 
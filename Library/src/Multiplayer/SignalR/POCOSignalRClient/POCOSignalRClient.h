@@ -17,8 +17,11 @@
 
 #include "Multiplayer/WebSocketClient.h"
 
+#include <Poco/Buffer.h>
 #include <Poco/Net/WebSocket.h>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <signalrclient/hub_exception.h>
 #include <signalrclient/signalr_client_config.h>
@@ -57,18 +60,65 @@ public:
 
     static ParsedURIInfo ParseMultiplayerServiceUriEndPoint(const std::string& MultiplayerServiceUriEndpoint);
 
+    // Scans a buffer of SignalR binary (MessagePack) hub messages, each prefixed with a variable length size.
+    // Returns the number of bytes spanned by all complete messages at the start of the buffer, or 0 if there is not yet a complete message.
+    // OutMessageCount is set to the number of complete messages found.
+    static size_t FindCompleteMessagesEnd(const char* Data, size_t Size, size_t& OutMessageCount);
+
+    // Counters describing the traffic handled by the receive thread since the socket was started.
+    struct ReceiveStatistics
+    {
+        uint64_t BytesReceived = 0;
+        uint64_t FramesReceived = 0;
+        uint64_t MessagesReceived = 0;
+        uint64_t BatchesDelivered = 0;
+        // Time messages spent buffered between arriving on the socket and being handed to SignalR.
+        std::chrono::microseconds TotalQueueDelay { 0 };
+        std::chrono::microseconds MaxQueueDelay { 0 };
+    };
+
+    ReceiveStatistics GetReceiveStatistics() const;
+
 private:
     void ReceiveThreadFunc();
     void HandleReceiveError(const std::string& Message);
 
+    // Blocks until SignalR has asked for the next message, or the socket is stopping.
+    // Returns the callback to deliver to, or nullptr if stopping.
+    ReceiveHandler WaitForReceiveReady();
+
+    // Blocks until a frame is available, then appends it to ReceiveBuffer. Returns false if the receive thread should exit.
+    bool ReadFrame();
+
+    void DeliverBatch(const char* Data, size_t Size, size_t MessageCount);
+
     Poco::Net::WebSocket* PocoWebSocket;
 
     std::thread ReceiveThread;
     std::mutex Mutex;
-    std::atomic_bool ReceiveReady;
+
+    // Guards the handoff of the receive callback from SignalR to the receive thread.
+    std::mutex ReceiveMutex;
+    std::condition_variable ReceiveReadyCondition;
+    bool ReceiveReady;
     ReceiveHandler ReceiveCallback;
     std::atomic_bool StopFlag;
 
+    // Bytes read from the socket but not yet delivered start at ReceiveReadIndex. Only accessed by the receive thread.
+    Poco::Buffer<char> ReceiveBuffer;
+    size_t ReceiveReadIndex;
+    std::chrono::steady_clock::time_point OldestPendingReceiveTime;
+
+    // Reused for every delivery, as SignalR consumes messages as strings.
+    std::string DeliveryBuffer;
+
+    std::atomic<uint64_t> BytesReceived;
+    std::atomic<uint64_t> FramesReceived;
+    std::atomic<uint64_t> MessagesReceived;
+    std::atomic<uint64_t> BatchesDelivered;
+    std::atomic<int64_t> TotalQueueDelayMicroseconds;
+    std::atomic<int64_t> MaxQueueDelayMicroseconds;
+
     std::string MultiplayerUri;
     std::string AccessToken;
     std::string DeviceId;
@@ -140,7 +140,8 @@ CSPHttpClient::CSPHttpClient(csp::common::IAuthContext& AuthContext)
 #ifdef CSP_WASM
     WebClientHttps = new csp::web::EmscriptenWebClient(443, csp::web::ETransferProtocol::HTTPS, AuthContext, nullptr);
 #else
-    WebClientHttps = new csp::web::POCOWebClient(443, csp::web::ETransferProtocol::HTTPS, AuthContext, nullptr);
+    WebClientHttps = new csp::web::POCOWebClient(
+        443, csp::web::ETransferProtocol::HTTPS, AuthContext, nullptr, true, csp::web::GetConfiguredWebClientSettings());
 #endif
 }
 
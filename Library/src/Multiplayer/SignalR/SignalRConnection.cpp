@@ -62,12 +62,12 @@ public:
 #endif
 
 SignalRConnection::SignalRConnection(const std::string& BaseUri, const uint32_t KeepAliveSeconds, std::shared_ptr<websocket_client> WebsocketClient,
-    csp::common::IAuthContext& AuthContext)
+    csp::common::IAuthContext& AuthContext, const std::vector<std::string>& EncodedArgumentMethods)
     : Connection(hub_connection_builder::create(BaseUri)
                      .with_http_client_factory([&AuthContext](const signalr_client_config&) { return std::make_shared<CSPHttpClient>(AuthContext); })
                      .with_websocket_factory([WebsocketClient](const signalr_client_config&) { return WebsocketClient; })
                      .skip_negotiation(true)
-                     .with_messagepack_hub_protocol()
+                     .with_messagepack_hub_protocol(EncodedArgumentMethods)
 #if ENABLE_SIGNALR_LOGGING
                      .with_logging(std::make_shared<stdout_log_writer>(), trace_level::verbose)
 #else
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <signalrclient/hub_connection_builder.h>
 #include <unordered_set>
+#include <vector>
 
 CSP_START_IGNORE
 class CSPEngine_MultiplayerTests_SignalRConnectionTest_Test;
@@ -43,8 +44,9 @@ public:
 
     typedef std::function<void __cdecl(const signalr::value&)> MethodInvokedHandler;
 
+    // The arguments of the hub methods in EncodedArgumentMethods reach their handlers still MessagePack encoded, as signalr::value_type::messagepack.
     SignalRConnection(const std::string& url, const uint32_t KeepAliveSeconds, std::shared_ptr<signalr::websocket_client> WebSocketClient,
-        csp::common::IAuthContext& AuthContext);
+        csp::common::IAuthContext& AuthContext, const std::vector<std::string>& EncodedArgumentMethods = {});
     virtual ~SignalRConnection();
 
     void Start(std::function<void(std::exception_ptr)> Callback) override;
@@ -99,13 +99,14 @@ void SignalRSerializer::FinalizeContainerSerializationInternal(std::vector<signa
 }
 
 SignalRDeserializer::SignalRDeserializer(const signalr::value& Object)
-    : Root { Object }
+    : Root { &Object }
 {
     ObjectStack.push(nullptr);
 }
 
 SignalRDeserializer::SignalRDeserializer(signalr::value&& Object)
-    : Root { std::move(Object) }
+    : OwnedRoot { std::move(Object) }
+    , Root { &OwnedRoot }
 {
     ObjectStack.push(nullptr);
 }
@@ -197,7 +198,7 @@ const signalr::value& SignalRDeserializer::ReadNextValue() const
     }
     else if (std::holds_alternative<nullptr_t>(ObjectStack.top()))
     {
-        return Root;
+        return *Root;
     }
     else
     {
@@ -235,7 +236,7 @@ void SignalRDeserializer::EndReadStringMapInternal()
     ObjectStack.pop();
 }
 
-const std::pair<std::uint64_t, signalr::value> SignalRDeserializer::ReadNextUintKeyValue() const
+const std::pair<const std::uint64_t, signalr::value>& SignalRDeserializer::ReadNextUintKeyValue() const
 {
     if (std::holds_alternative<std::map<uint64_t, signalr::value>::const_iterator>(ObjectStack.top()) == false)
     {
@@ -245,7 +246,7 @@ const std::pair<std::uint64_t, signalr::value> SignalRDeserializer::ReadNextUint
     return *std::get<std::map<uint64_t, signalr::value>::const_iterator>(ObjectStack.top());
 }
 
-const std::pair<std::string, signalr::value> SignalRDeserializer::ReadNextStringKeyValue() const
+const std::pair<const std::string, signalr::value>& SignalRDeserializer::ReadNextStringKeyValue() const
 {
     if (std::holds_alternative<std::map<std::string, signalr::value>::const_iterator>(ObjectStack.top()) == false)
     {
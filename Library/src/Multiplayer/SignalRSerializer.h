@@ -140,9 +140,10 @@ private:
 class SignalRDeserializer
 {
 public:
-    /// @brief Constructor used to copy object to deserialize.
+    /// @brief Constructor used to reference object to deserialize.
     /// @param Object const signalr::value& : The value to deserialize
     /// This should match the structure generated by the SignalRSerializer.
+    /// The value is not copied, so it must outlive the deserializer.
     SignalRDeserializer(const signalr::value& Object);
 
     /// @brief Constructor used to move object to deserialize.
@@ -150,6 +151,9 @@ public:
     /// This should match the structure generated by the SignalRSerializer.
     SignalRDeserializer(signalr::value&& Object);
 
+    SignalRDeserializer(const SignalRDeserializer&) = delete;
+    SignalRDeserializer& operator=(const SignalRDeserializer&) = delete;
+
     /// @brief Reads a value from the internal signalr array.
     /// @pre This function should be used if this serializer represents a single value,
     /// or if StartReadArray is called first to write to the array.
@@ -223,8 +227,8 @@ private:
     void EndReadUintMapInternal();
     void EndReadStringMapInternal();
 
-    const std::pair<std::uint64_t, signalr::value> ReadNextUintKeyValue() const;
-    const std::pair<std::string, signalr::value> ReadNextStringKeyValue() const;
+    const std::pair<const std::uint64_t, signalr::value>& ReadNextUintKeyValue() const;
+    const std::pair<const std::string, signalr::value>& ReadNextStringKeyValue() const;
 
     // Reads the specified type from the given signalr object.
     // This internally calls the ReadValueFromObjectInternal for the given type.
@@ -252,7 +256,9 @@ private:
     using Iterator = std::variant<nullptr_t, std::vector<signalr::value>::const_iterator, std::map<uint64_t, signalr::value>::const_iterator,
         std::map<std::string, signalr::value>::const_iterator>;
 
-    signalr::value Root;
+    // Only set when constructed from an rvalue, otherwise Root points at the caller's value.
+    signalr::value OwnedRoot;
+    const signalr::value* Root;
     std::stack<Iterator> ObjectStack;
 };
 
@@ -460,7 +466,7 @@ template <typename T> std::enable_if_t<IsSupportedSignalRType<T>::value> SignalR
 template <typename K, typename T>
 std::enable_if_t<IsUnsignedIntegerV<K> && IsSupportedSignalRType<T>::value> SignalRDeserializer::ReadKeyValue(std::pair<K, T>& OutVal)
 {
-    const std::pair<uint64_t, signalr::value>& Next = ReadNextUintKeyValue();
+    const std::pair<const uint64_t, signalr::value>& Next = ReadNextUintKeyValue();
 
     OutVal.first = static_cast<K>(Next.first);
     ReadValueFromObject(Next.second, OutVal.second);
@@ -470,7 +476,7 @@ std::enable_if_t<IsUnsignedIntegerV<K> && IsSupportedSignalRType<T>::value> Sign
 
 template <typename T> std::enable_if_t<IsSupportedSignalRType<T>::value> SignalRDeserializer::ReadKeyValue(std::pair<std::string, T>& OutVal)
 {
-    const std::pair<std::string, signalr::value>& Next = ReadNextStringKeyValue();
+    const std::pair<const std::string, signalr::value>& Next = ReadNextStringKeyValue();
 
     OutVal.first = Next.first;
     ReadValueFromObject(Next.second, OutVal.second);
@@ -563,7 +569,7 @@ template <typename K, typename T> inline void SignalRDeserializer::ReadValueFrom
     {
         std::pair<K, T> Pair;
         ReadKeyValue(Pair);
-        OutVal[Pair.first] = Pair.second;
+        OutVal[Pair.first] = std::move(Pair.second);
     }
 
     EndReadUintMapInternal();
@@ -578,7 +584,7 @@ template <typename T> inline void SignalRDeserializer::ReadValueFromObjectIntern
     {
         std::pair<std::string, T> Pair;
         ReadKeyValue(Pair);
-        OutVal[Pair.first] = Pair.second;
+        OutVal[Pair.first] = std::move(Pair.second);
     }
 
     EndReadStringMapInternal();
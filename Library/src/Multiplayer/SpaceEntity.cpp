@@ -58,9 +58,11 @@
 #include "RealtimeEngineUtils.h"
 #include "signalrclient/signalr_value.h"
 
+#include <algorithm>
 #include <chrono>
 #include <glm/gtc/quaternion.hpp>
 #include <thread>
+#include <vector>
 
 using namespace std::chrono;
 
@@ -84,6 +86,24 @@ glm::mat4 computeParentMat4(const SpaceTransform& ParentSpaceTransform)
     return ParentTransform;
 }
 
+// Calls Func with the realtime engine cast to its concrete type, for the notifications that aren't part of IRealtimeEngine.
+template <typename FuncT> void WithConcreteEngine(csp::common::IRealtimeEngine* EntitySystem, FuncT&& Func)
+{
+    if (EntitySystem == nullptr)
+    {
+        return;
+    }
+
+    if (EntitySystem->GetRealtimeEngineType() == csp::common::RealtimeEngineType::Online)
+    {
+        Func(static_cast<csp::multiplayer::OnlineRealtimeEngine*>(EntitySystem));
+    }
+    else
+    {
+        Func(static_cast<csp::multiplayer::OfflineRealtimeEngine*>(EntitySystem));
+    }
+}
+
 inline uint32_t CheckedUInt64ToUint32(uint64_t Value)
 {
     assert(Value <= UINT32_MAX);
@@ -183,55 +203,100 @@ const SpaceTransform& SpaceEntity::GetTransform() const { return Transform; }
 
 SpaceTransform SpaceEntity::GetGlobalTransform() const
 {
-    if (Parent != nullptr)
+    std::scoped_lock GlobalTransformLocker(GlobalTransformLock);
+
+    // Root entities still go through the cache, so that their dirty flag is cleared and later moves propagate to their children.
+    if (GlobalTransformDirty)
     {
-        SpaceTransform GlobalTransform;
-        GlobalTransform.Position = GetGlobalPosition();
-        GlobalTransform.Rotation = GetGlobalRotation();
-        GlobalTransform.Scale = GetGlobalScale();
-        return GlobalTransform;
+        UpdateGlobalTransform();
     }
-    return Transform;
+
+    return GlobalTransform;
 }
 
-const csp::common::Vector3& SpaceEntity::GetPosition() const { return Transform.Position; }
+bool SpaceEntity::IsGlobalTransformDirty() const
+{
+    std::scoped_lock GlobalTransformLocker(GlobalTransformLock);
+    return GlobalTransformDirty;
+}
 
-csp::common::Vector3 SpaceEntity::GetGlobalPosition() const
+void SpaceEntity::InvalidateGlobalTransform()
 {
-    if (Parent != nullptr)
     {
-        glm::mat4 ParentTransform = computeParentMat4(Parent->GetGlobalTransform());
+        std::scoped_lock GlobalTransformLocker(GlobalTransformLock);
 
-        glm::vec3 GlobalEntityPosition = ParentTransform * glm::vec4(Transform.Position.X, Transform.Position.Y, Transform.Position.Z, 1.0f);
+        // Descendants of a dirty entity are already dirty, so there's no need to walk any further.
+        if (GlobalTransformDirty)
+        {
+            return;
+        }
 
-        return { GlobalEntityPosition.x, GlobalEntityPosition.y, GlobalEntityPosition.z };
+        GlobalTransformDirty = true;
+    }
+
+    // Let the engine know where to look for moved entities, so its spatial index doesn't have to check every entity.
+    WithConcreteEngine(EntitySystem, [this](auto* Engine) { Engine->OnEntityTransformInvalidated(this); });
+
+    for (size_t i = 0; i < ChildEntities.Size(); ++i)
+    {
+        ChildEntities[i]->InvalidateGlobalTransform();
     }
-    else
-        return Transform.Position;
 }
 
-bool SpaceEntity::SetPosition(const csp::common::Vector3& Value)
+void SpaceEntity::NotifyNameChanged()
 {
-    return SetProperty(*this, Transform.Position, Value, SpaceEntityComponentKey::Position, UPDATE_FLAGS_POSITION, LogSystem);
+    WithConcreteEngine(EntitySystem, [this](auto* Engine) { Engine->OnEntityNameChanged(this); });
 }
 
-const csp::common::Vector4& SpaceEntity::GetRotation() const { return Transform.Rotation; }
+void SpaceEntity::NotifyComponentAdded(ComponentType Type)
+{
+    WithConcreteEngine(EntitySystem, [this, Type](auto* Engine) { Engine->OnEntityComponentAdded(this, Type); });
+}
 
-csp::common::Vector4 SpaceEntity::GetGlobalRotation() const
+void SpaceEntity::NotifyComponentRemoved(ComponentType Type)
 {
-    if (Parent != nullptr)
-    {
-        csp::common::Vector4 GlobalRotation = Parent->GetGlobalRotation();
-        glm::quat Orientation { Transform.Rotation.W, Transform.Rotation.X, Transform.Rotation.Y, Transform.Rotation.Z };
-        glm::quat GlobalOrientation(GlobalRotation.W, GlobalRotation.X, GlobalRotation.Y, GlobalRotation.Z);
+    WithConcreteEngine(EntitySystem, [this, Type](auto* Engine) { Engine->OnEntityComponentRemoved(this, Type); });
+}
 
-        glm::quat FinalOrientation = GlobalOrientation * Orientation;
-        return csp::common::Vector4 { FinalOrientation.x, FinalOrientation.y, FinalOrientation.z, FinalOrientation.w };
+void SpaceEntity::UpdateGlobalTransform() const
+{
+    if (Parent == nullptr)
+    {
+        GlobalTransform = Transform;
+        GlobalTransformDirty = false;
+        return;
     }
-    else
-        return Transform.Rotation;
+
+    // This only recurses as far as the nearest ancestor with an up to date cache.
+    const SpaceTransform ParentGlobalTransform = Parent->GetGlobalTransform();
+
+    const glm::mat4 ParentTransform = computeParentMat4(ParentGlobalTransform);
+    const glm::vec3 GlobalEntityPosition = ParentTransform * glm::vec4(Transform.Position.X, Transform.Position.Y, Transform.Position.Z, 1.0f);
+
+    const glm::quat Orientation { Transform.Rotation.W, Transform.Rotation.X, Transform.Rotation.Y, Transform.Rotation.Z };
+    const glm::quat ParentOrientation { ParentGlobalTransform.Rotation.W, ParentGlobalTransform.Rotation.X, ParentGlobalTransform.Rotation.Y,
+        ParentGlobalTransform.Rotation.Z };
+    const glm::quat GlobalOrientation = ParentOrientation * Orientation;
+
+    GlobalTransform.Position = { GlobalEntityPosition.x, GlobalEntityPosition.y, GlobalEntityPosition.z };
+    GlobalTransform.Rotation = { GlobalOrientation.x, GlobalOrientation.y, GlobalOrientation.z, GlobalOrientation.w };
+    GlobalTransform.Scale = ParentGlobalTransform.Scale * Transform.Scale;
+    GlobalTransformDirty = false;
 }
 
+const csp::common::Vector3& SpaceEntity::GetPosition() const { return Transform.Position; }
+
+csp::common::Vector3 SpaceEntity::GetGlobalPosition() const { return GetGlobalTransform().Position; }
+
+bool SpaceEntity::SetPosition(const csp::common::Vector3& Value)
+{
+    return SetProperty(*this, Transform.Position, Value, SpaceEntityComponentKey::Position, UPDATE_FLAGS_POSITION, LogSystem);
+}
+
+const csp::common::Vector4& SpaceEntity::GetRotation() const { return Transform.Rotation; }
+
+csp::common::Vector4 SpaceEntity::GetGlobalRotation() const { return GetGlobalTransform().Rotation; }
+
 bool SpaceEntity::SetRotation(const csp::common::Vector4& Value)
 {
     return SetProperty(*this, Transform.Rotation, Value, SpaceEntityComponentKey::Rotation, UPDATE_FLAGS_ROTATION, LogSystem);
@@ -239,12 +304,7 @@ bool SpaceEntity::SetRotation(const csp::common::Vector4& Value)
 
 const csp::common::Vector3& SpaceEntity::GetScale() const { return Transform.Scale; }
 
-csp::common::Vector3 SpaceEntity::GetGlobalScale() const
-{
-    if (Parent != nullptr)
-        return Parent->GetGlobalScale() * Transform.Scale;
-    return Transform.Scale;
-}
+csp::common::Vector3 SpaceEntity::GetGlobalScale() const { return GetGlobalTransform().Scale; }
 
 bool SpaceEntity::SetScale(const csp::common::Vector3& Value)
 {
@@ -427,6 +487,7 @@ void SpaceEntity::RemoveAsChildFromParent()
     {
         Parent->ChildEntities.RemoveItem(this);
         Parent = nullptr;
+        InvalidateGlobalTransform();
     }
 }
 
@@ -434,8 +495,10 @@ void SpaceEntity::RemoveParentFromChildEntity(size_t Index)
 {
     if (Index < ChildEntities.Size())
     {
-        ChildEntities[Index]->RemoveParentEntity();
-        ChildEntities[Index]->Parent = nullptr;
+        SpaceEntity* ChildEntity = ChildEntities[Index];
+        ChildEntity->RemoveParentEntity();
+        ChildEntity->Parent = nullptr;
+        ChildEntity->InvalidateGlobalTransform();
     }
 }
 
@@ -472,7 +535,11 @@ SpaceEntity::DestroyCallback SpaceEntity::GetEntityDestroyCallback() { return En
 
 SpaceEntity* SpaceEntity::GetParent() { return Parent; }
 
-void SpaceEntity::SetParent(SpaceEntity* InParent) { Parent = InParent; }
+void SpaceEntity::SetParent(SpaceEntity* InParent)
+{
+    Parent = InParent;
+    InvalidateGlobalTransform();
+}
 
 uint16_t SpaceEntity::GenerateComponentId()
 {
@@ -681,6 +748,25 @@ void SpaceEntity::QueueUpdate()
     }
 }
 
+void SpaceEntity::SetSelectedIdDirect(uint64_t Value, bool CallNotifyingCallback)
+{
+    const uint64_t PreviousSelectedId = SelectedId;
+
+    SetPropertyDirect(SelectedId, Value, UPDATE_FLAGS_SELECTION_ID);
+
+    // Keep the engine's selecting-client index in sync before anyone observes the change.
+    if (PreviousSelectedId != SelectedId)
+    {
+        WithConcreteEngine(EntitySystem, [this, PreviousSelectedId](auto* Engine) { Engine->OnEntitySelectionChanged(this, PreviousSelectedId); });
+    }
+
+    if (CallNotifyingCallback && EntityUpdateCallback)
+    {
+        csp::common::Array<ComponentUpdateInfo> Empty;
+        EntityUpdateCallback(this, UPDATE_FLAGS_SELECTION_ID, Empty);
+    }
+}
+
 bool SpaceEntity::InternalSetSelectionStateOfEntity(const bool SelectedState)
 {
     uint64_t LocalClientId = (EntitySystem->GetRealtimeEngineType() == csp::common::RealtimeEngineType::Online)
@@ -701,7 +787,7 @@ bool SpaceEntity::InternalSetSelectionStateOfEntity(const bool SelectedState)
             bool Added = EntitySystem->AddEntityToSelectedEntities(this);
             if (Added)
             {
-                SetPropertyDirect(SelectedId, LocalClientId, UPDATE_FLAGS_SELECTION_ID, true);
+                SetSelectedIdDirect(LocalClientId, true);
                 return true;
             }
         }
@@ -722,7 +808,7 @@ bool SpaceEntity::InternalSetSelectionStateOfEntity(const bool SelectedState)
             bool Removed = EntitySystem->RemoveEntityFromSelectedEntities(this);
             if (Removed)
             {
-                SetPropertyDirect(SelectedId, 0, UPDATE_FLAGS_SELECTION_ID, true);
+                SetSelectedIdDirect(0, true);
                 return true;
             }
         }
@@ -754,7 +840,14 @@ void SpaceEntity::SetParentIdDirect(csp::common::Optional<uint64_t> Value, bool
 bool SpaceEntity::AddComponentDirect(uint16_t ComponentKey, ComponentBase* Component, bool CallNotifyingCallback)
 {
     std::scoped_lock ComponentsLocker(ComponentsLock);
+
+    if (Components.HasKey(ComponentKey))
+    {
+        NotifyComponentRemoved(Components[ComponentKey]->GetComponentType());
+    }
+
     Components[ComponentKey] = Component;
+    NotifyComponentAdded(Component->GetComponentType());
 
     if (CallNotifyingCallback && EntityUpdateCallback)
     {
@@ -777,7 +870,8 @@ bool SpaceEntity::UpdateComponentDirect(uint16_t ComponentKey, ComponentBase* Co
         if (EntityUpdateCallback)
         {
             csp::common::Array<ComponentUpdateInfo> UpdateInfo(1);
-            UpdateInfo[0] = ComponentUpdateInfo { ComponentKey, ComponentUpdateType::Update };
+            UpdateInfo[0] = ComponentUpdateInfo { ComponentKey, ComponentUpdateType::Update,
+                SpaceEntityStatePatcher::CreatePropertyUpdateInfo(Component->GetDirtyProperties()) };
             EntityUpdateCallback(this, UPDATE_FLAGS_COMPONENTS, UpdateInfo);
         }
 
@@ -785,6 +879,9 @@ bool SpaceEntity::UpdateComponentDirect(uint16_t ComponentKey, ComponentBase* Co
         OnPropertyChanged(Component, ComponentKey);
     }
 
+    // Without a patcher there is nothing to replicate, the change has been fully applied
+    Component->ClearDirtyProperties();
+
     return true;
 }
 
@@ -795,6 +892,7 @@ bool SpaceEntity::RemoveComponentDirect(uint16_t ComponentKey, bool CallNotifyin
     if (Components.HasKey(ComponentKey))
     {
         Components[ComponentKey]->OnRemove();
+        NotifyComponentRemoved(Components[ComponentKey]->GetComponentType());
         Components.Remove(ComponentKey);
 
         if (CallNotifyingCallback && EntityUpdateCallback)
@@ -876,6 +974,8 @@ void SpaceEntity::ResolveParentChildRelationship()
             }
         }
 
+        InvalidateGlobalTransform();
+
         if (Parent != nullptr)
         {
             Parent->ChildEntities.Append(this);
@@ -896,6 +996,7 @@ void SpaceEntity::ResolveParentChildRelationship()
         {
             Parent->ChildEntities.RemoveItem(this);
             Parent = nullptr;
+            InvalidateGlobalTransform();
         }
     }
 }
@@ -906,8 +1007,8 @@ std::unique_ptr<SpaceEntityStatePatcher>& SpaceEntity::GetStatePatcher() { retur
 
 void SpaceEntity::AddComponentFromItemComponentData(uint16_t ComponentId, const mcs::ItemComponentData& ComponentData)
 {
-    auto ComponentDataMap = std::get<std::map<uint16_t, mcs::ItemComponentData>>(ComponentData.GetValue());
-    ComponentType MessageComponentType = static_cast<ComponentType>(std::get<uint64_t>(ComponentDataMap[COMPONENT_KEY_COMPONENTTYPE].GetValue()));
+    const auto& ComponentDataMap = std::get<mcs::ComponentMap>(ComponentData.GetValue());
+    ComponentType MessageComponentType = static_cast<ComponentType>(std::get<uint64_t>(ComponentDataMap.at(COMPONENT_KEY_COMPONENTTYPE).GetValue()));
 
     if (MessageComponentType != ComponentType::Invalid)
     {
@@ -927,20 +1028,30 @@ void SpaceEntity::AddComponentFromItemComponentData(uint16_t ComponentId, const
                 csp::common::ReplicatedValue Property = ToReplicatedValue(PatchComponentPair.second);
 
                 Component->Properties[PatchComponentPair.first] = Property;
-                Component->OnCreated();
             }
+
+            Component->OnCreated();
+
             std::scoped_lock ComponentsLocker(ComponentsLock);
+
+            if (Components.HasKey(ComponentId))
+            {
+                NotifyComponentRemoved(Components[ComponentId]->GetComponentType());
+            }
+
             Components[ComponentId] = Component;
+            NotifyComponentAdded(Component->GetComponentType());
         }
     }
 }
 
 ComponentUpdateInfo SpaceEntity::AddComponentFromItemComponentDataPatch(uint16_t ComponentId, const mcs::ItemComponentData& ComponentData)
 {
-    auto ComponentDataMap = std::get<std::map<uint16_t, mcs::ItemComponentData>>(ComponentData.GetValue());
-    ComponentType PatchComponentType = static_cast<ComponentType>(std::get<uint64_t>(ComponentDataMap[COMPONENT_KEY_COMPONENTTYPE].GetValue()));
+    const auto& ComponentDataMap = std::get<mcs::ComponentMap>(ComponentData.GetValue());
+    ComponentType PatchComponentType = static_cast<ComponentType>(std::get<uint64_t>(ComponentDataMap.at(COMPONENT_KEY_COMPONENTTYPE).GetValue()));
 
     auto UpdateType = ComponentUpdateType::Update;
+    csp::common::Array<ComponentPropertyUpdateInfo> PropertyInfo;
 
     if (!Components.HasKey(ComponentId))
     {
@@ -958,6 +1069,10 @@ ComponentUpdateInfo SpaceEntity::AddComponentFromItemComponentDataPatch(uint16_t
     case ComponentUpdateType::Update:
     {
         auto* Component = Components[ComponentId];
+        const auto& CurrentProperties = *Component->GetProperties();
+
+        // Patches carry the whole component, so report only the properties whose value actually changed to the client
+        std::vector<ComponentPropertyUpdateInfo> ChangedProperties;
 
         for (const auto& PatchComponentPair : ComponentDataMap)
         {
@@ -969,10 +1084,20 @@ ComponentUpdateInfo SpaceEntity::AddComponentFromItemComponentDataPatch(uint16_t
 
             csp::common::ReplicatedValue Property = ToReplicatedValue(PatchComponentPair.second);
 
+            const auto CurrentProperty = CurrentProperties.Find(PatchComponentPair.first);
+
+            if (CurrentProperty == CurrentProperties.end() || !(CurrentProperty->second == Property))
+            {
+                ChangedProperties.push_back(ComponentPropertyUpdateInfo { PatchComponentPair.first, ComponentUpdateType::Update });
+            }
+
             // UpdateComponentDirect(false);
             Component->SetPropertyFromPatch(PatchComponentPair.first, Property);
         }
 
+        PropertyInfo = csp::common::Array<ComponentPropertyUpdateInfo>(ChangedProperties.size());
+        std::copy(ChangedProperties.begin(), ChangedProperties.end(), PropertyInfo.begin());
+
         break;
     }
     case ComponentUpdateType::Add:
@@ -1011,6 +1136,7 @@ ComponentUpdateInfo SpaceEntity::AddComponentFromItemComponentDataPatch(uint16_t
     ComponentUpdateInfo UpdateInfo;
     UpdateInfo.ComponentId = ComponentId;
     UpdateInfo.UpdateType = UpdateType;
+    UpdateInfo.PropertyInfo = PropertyInfo;
     return UpdateInfo;
 }
 
@@ -1041,7 +1167,7 @@ csp::common::Array<EntityProperty> SpaceEntity::CreateReplicatedProperties()
         {
             SpaceEntityComponentKey::SelectedClientId, UPDATE_FLAGS_SELECTION_ID,
             [&SelectedId = SelectedId]() { return csp::common::ReplicatedValue { static_cast<int64_t>(SelectedId) }; },
-            [this](const csp::common::ReplicatedValue& Value) { SetPropertyDirect(SelectedId, Value.GetInt(), UPDATE_FLAGS_SELECTION_ID); }
+            [this](const csp::common::ReplicatedValue& Value) { SetSelectedIdDirect(Value.GetInt()); }
         },
         {
             SpaceEntityComponentKey::ThirdPartyRef, UPDATE_FLAGS_THIRD_PARTY_REF,
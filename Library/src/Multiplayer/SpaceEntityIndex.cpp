@@ -0,0 +1,335 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Multiplayer/SpaceEntityIndex.h"
+
+#include "CSP/Multiplayer/ComponentBase.h"
+#include "CSP/Multiplayer/SpaceEntity.h"
+
+namespace csp::multiplayer
+{
+
+bool SpaceEntityIndex::Add(SpaceEntity* Entity)
+{
+    // Components added after this are reported through OnComponentAdded.
+    std::unordered_map<ComponentType, uint32_t> ComponentCounts;
+
+    for (const auto& [Key, Component] : Entity->GetComponents()->GetUnderlying())
+    {
+        ++ComponentCounts[Component->GetComponentType()];
+    }
+
+    std::scoped_lock IndexLocker(IndexLock);
+
+    const auto Inserted = EntitiesById.emplace(Entity->GetId(), Entity).second;
+
+    if (!Inserted)
+    {
+        return false;
+    }
+
+    if (Entity->GetSelectingClientID() != 0)
+    {
+        EntitiesBySelectingClient[Entity->GetSelectingClientID()].insert(Entity);
+    }
+
+    const uint64_t AddOrder = NextAddOrder++;
+
+    EntitiesByName[Entity->GetName()].emplace(AddOrder, Entity);
+
+    for (const auto& [Type, Count] : ComponentCounts)
+    {
+        EntitiesByComponentType[Type].emplace(AddOrder, Entity);
+    }
+
+    IndexedEntities.emplace(Entity, IndexedEntity { AddOrder, Entity->GetName(), std::move(ComponentCounts) });
+
+    return true;
+}
+
+void SpaceEntityIndex::Remove(SpaceEntity* Entity)
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = EntitiesById.find(Entity->GetId());
+
+    // Only remove the mapping if it refers to this exact entity, a different instance may share the id while pending.
+    if (It != EntitiesById.end() && It->second == Entity)
+    {
+        EntitiesById.erase(It);
+    }
+
+    RemoveSelection(Entity, Entity->GetSelectingClientID());
+
+    auto IndexedIt = IndexedEntities.find(Entity);
+
+    if (IndexedIt != IndexedEntities.end())
+    {
+        const IndexedEntity& Indexed = IndexedIt->second;
+        RemoveName(Indexed.Name, Indexed.AddOrder);
+
+        for (const auto& [Type, Count] : Indexed.ComponentCounts)
+        {
+            RemoveComponentType(Type, Indexed.AddOrder);
+        }
+
+        IndexedEntities.erase(IndexedIt);
+    }
+}
+
+void SpaceEntityIndex::Clear()
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    EntitiesById.clear();
+    EntitiesBySelectingClient.clear();
+    IndexedEntities.clear();
+    EntitiesByName.clear();
+    EntitiesByComponentType.clear();
+}
+
+SpaceEntity* SpaceEntityIndex::FindById(uint64_t EntityId) const
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = EntitiesById.find(EntityId);
+
+    return It != EntitiesById.end() ? It->second : nullptr;
+}
+
+SpaceEntity* SpaceEntityIndex::FindByName(const csp::common::String& Name) const
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = EntitiesByName.find(Name);
+
+    return It != EntitiesByName.end() ? It->second.begin()->second : nullptr;
+}
+
+SpaceEntity* SpaceEntityIndex::FindByName(const csp::common::String& Name, SpaceEntityType Type) const
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = EntitiesByName.find(Name);
+
+    if (It == EntitiesByName.end())
+    {
+        return nullptr;
+    }
+
+    for (const auto& [AddOrder, Entity] : It->second)
+    {
+        if (Entity->GetEntityType() == Type)
+        {
+            return Entity;
+        }
+    }
+
+    return nullptr;
+}
+
+std::vector<SpaceEntity*> SpaceEntityIndex::GetEntitiesByName(const csp::common::String& Name) const
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    std::vector<SpaceEntity*> Entities;
+    auto It = EntitiesByName.find(Name);
+
+    if (It != EntitiesByName.end())
+    {
+        Entities.reserve(It->second.size());
+
+        for (const auto& [AddOrder, Entity] : It->second)
+        {
+            Entities.push_back(Entity);
+        }
+    }
+
+    return Entities;
+}
+
+std::vector<SpaceEntity*> SpaceEntityIndex::GetEntitiesWithComponentType(ComponentType Type) const
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    std::vector<SpaceEntity*> Entities;
+    auto It = EntitiesByComponentType.find(Type);
+
+    if (It != EntitiesByComponentType.end())
+    {
+        Entities.reserve(It->second.size());
+
+        for (const auto& [AddOrder, Entity] : It->second)
+        {
+            Entities.push_back(Entity);
+        }
+    }
+
+    return Entities;
+}
+
+void SpaceEntityIndex::OnNameChanged(SpaceEntity* Entity)
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = IndexedEntities.find(Entity);
+
+    if (It == IndexedEntities.end() || It->second.Name == Entity->GetName())
+    {
+        return;
+    }
+
+    IndexedEntity& Indexed = It->second;
+    RemoveName(Indexed.Name, Indexed.AddOrder);
+
+    Indexed.Name = Entity->GetName();
+    EntitiesByName[Indexed.Name].emplace(Indexed.AddOrder, Entity);
+}
+
+void SpaceEntityIndex::OnComponentAdded(SpaceEntity* Entity, ComponentType Type)
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = IndexedEntities.find(Entity);
+
+    if (It != IndexedEntities.end() && It->second.ComponentCounts[Type]++ == 0)
+    {
+        EntitiesByComponentType[Type].emplace(It->second.AddOrder, Entity);
+    }
+}
+
+void SpaceEntityIndex::OnComponentRemoved(SpaceEntity* Entity, ComponentType Type)
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = IndexedEntities.find(Entity);
+
+    if (It == IndexedEntities.end())
+    {
+        return;
+    }
+
+    auto CountIt = It->second.ComponentCounts.find(Type);
+
+    if (CountIt != It->second.ComponentCounts.end() && --CountIt->second == 0)
+    {
+        It->second.ComponentCounts.erase(CountIt);
+        RemoveComponentType(Type, It->second.AddOrder);
+    }
+}
+
+void SpaceEntityIndex::OnSelectingClientChanged(SpaceEntity* Entity, uint64_t PreviousClientId, uint64_t NewClientId)
+{
+    if (PreviousClientId == NewClientId)
+    {
+        return;
+    }
+
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = EntitiesById.find(Entity->GetId());
+
+    if (It == EntitiesById.end() || It->second != Entity)
+    {
+        return;
+    }
+
+    RemoveSelection(Entity, PreviousClientId);
+
+    if (NewClientId != 0)
+    {
+        EntitiesBySelectingClient[NewClientId].insert(Entity);
+    }
+}
+
+std::vector<SpaceEntity*> SpaceEntityIndex::GetEntitiesSelectedByClient(uint64_t ClientId) const
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    auto It = EntitiesBySelectingClient.find(ClientId);
+
+    if (It == EntitiesBySelectingClient.end())
+    {
+        return {};
+    }
+
+    return std::vector<SpaceEntity*>(It->second.begin(), It->second.end());
+}
+
+size_t SpaceEntityIndex::Size() const
+{
+    std::scoped_lock IndexLocker(IndexLock);
+
+    return EntitiesById.size();
+}
+
+void SpaceEntityIndex::RemoveSelection(SpaceEntity* Entity, uint64_t ClientId)
+{
+    if (ClientId == 0)
+    {
+        return;
+    }
+
+    auto It = EntitiesBySelectingClient.find(ClientId);
+
+    if (It == EntitiesBySelectingClient.end())
+    {
+        return;
+    }
+
+    It->second.erase(Entity);
+
+    if (It->second.empty())
+    {
+        EntitiesBySelectingClient.erase(It);
+    }
+}
+
+void SpaceEntityIndex::RemoveName(const csp::common::String& Name, uint64_t AddOrder)
+{
+    auto It = EntitiesByName.find(Name);
+
+    if (It == EntitiesByName.end())
+    {
+        return;
+    }
+
+    It->second.erase(AddOrder);
+
+    if (It->second.empty())
+    {
+        EntitiesByName.erase(It);
+    }
+}
+
+void SpaceEntityIndex::RemoveComponentType(ComponentType Type, uint64_t AddOrder)
+{
+    auto It = EntitiesByComponentType.find(Type);
+
+    if (It == EntitiesByComponentType.end())
+    {
+        return;
+    }
+
+    It->second.erase(AddOrder);
+
+    if (It->second.empty())
+    {
+        EntitiesByComponentType.erase(It);
+    }
+}
+
+}
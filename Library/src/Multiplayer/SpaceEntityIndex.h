@@ -0,0 +1,110 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "CSP/Common/Hash.h"
+#include "CSP/Common/String.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace csp::multiplayer
+{
+class SpaceEntity;
+enum class ComponentType;
+enum class SpaceEntityType;
+
+/// @brief Constant-time lookup structure for the entities owned by a realtime engine.
+/// @details Maintains an id -> entity map, and a reverse map of selecting client id -> entities, so that
+/// incoming patches and client disconnects can be routed without scanning the full entity list.
+/// Entities are also indexed by name and by the types of component they hold. Lookups by name or component type return entities in
+/// the order they were added, which is the order of the engine entity list, so they match what a scan of that list would find.
+/// The index does not own the entities it references. The engine is responsible for keeping it in sync
+/// with its entity lists whenever an entity is added or removed.
+/// The index guards itself with its own leaf mutex, so it is safe to update from code paths that already hold
+/// either the engine entities lock or an entity's own lock.
+class SpaceEntityIndex
+{
+public:
+    // Registers an entity. Returns false if an entity with the same id is already indexed.
+    bool Add(SpaceEntity* Entity);
+
+    // Unregisters an entity, including any selection it currently holds.
+    void Remove(SpaceEntity* Entity);
+
+    void Clear();
+
+    // Returns nullptr if no entity with the given id is indexed.
+    SpaceEntity* FindById(uint64_t EntityId) const;
+
+    // Returns the first added entity with the given name, or nullptr if there is none.
+    SpaceEntity* FindByName(const csp::common::String& Name) const;
+
+    // As above, but only considering entities of the given type.
+    SpaceEntity* FindByName(const csp::common::String& Name, SpaceEntityType Type) const;
+
+    // Returns a snapshot of every entity with the given name, in the order they were added.
+    std::vector<SpaceEntity*> GetEntitiesByName(const csp::common::String& Name) const;
+
+    // Returns a snapshot of every entity holding at least one component of the given type, in the order they were added.
+    std::vector<SpaceEntity*> GetEntitiesWithComponentType(ComponentType Type) const;
+
+    // Re-files an entity under its current name. Ignored if the entity is not indexed.
+    void OnNameChanged(SpaceEntity* Entity);
+
+    // Records that an entity gained or lost a component of the given type. Ignored if the entity is not indexed.
+    void OnComponentAdded(SpaceEntity* Entity, ComponentType Type);
+    void OnComponentRemoved(SpaceEntity* Entity, ComponentType Type);
+
+    // Moves an entity between selecting clients. Ignored if the entity is not indexed.
+    void OnSelectingClientChanged(SpaceEntity* Entity, uint64_t PreviousClientId, uint64_t NewClientId);
+
+    // Returns a snapshot of the entities currently selected by the given client.
+    std::vector<SpaceEntity*> GetEntitiesSelectedByClient(uint64_t ClientId) const;
+
+    size_t Size() const;
+
+private:
+    struct IndexedEntity
+    {
+        // Orders the name and component type lookups.
+        uint64_t AddOrder;
+        // The name the entity is filed under, which is kept so it can be found again after the entity has been renamed.
+        csp::common::String Name;
+        // How many components of each type the entity holds, as an entity may have several of the same type.
+        std::unordered_map<ComponentType, uint32_t> ComponentCounts;
+    };
+
+    void RemoveSelection(SpaceEntity* Entity, uint64_t ClientId);
+    void RemoveName(const csp::common::String& Name, uint64_t AddOrder);
+    void RemoveComponentType(ComponentType Type, uint64_t AddOrder);
+
+    std::unordered_map<uint64_t, SpaceEntity*> EntitiesById;
+    std::unordered_map<uint64_t, std::unordered_set<SpaceEntity*>> EntitiesBySelectingClient;
+
+    std::unordered_map<const SpaceEntity*, IndexedEntity> IndexedEntities;
+    std::unordered_map<csp::common::String, std::map<uint64_t, SpaceEntity*>> EntitiesByName;
+    std::unordered_map<ComponentType, std::map<uint64_t, SpaceEntity*>> EntitiesByComponentType;
+    uint64_t NextAddOrder = 0;
+
+    mutable std::mutex IndexLock;
+};
+
+}
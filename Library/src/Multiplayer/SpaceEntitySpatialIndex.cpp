@@ -0,0 +1,415 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Multiplayer/SpaceEntitySpatialIndex.h"
+
+#include "CSP/Multiplayer/SpaceEntity.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// Cell coordinates are packed into 21 bits each, which at the default cell size covers 16,000km either side of the origin.
+// Anything further out shares the outermost cells.
+constexpr int32_t MAX_CELL_COORDINATE = (1 << 20) - 1;
+
+float DistanceSquared(const csp::common::Vector3& A, const csp::common::Vector3& B)
+{
+    const float X = A.X - B.X;
+    const float Y = A.Y - B.Y;
+    const float Z = A.Z - B.Z;
+
+    return X * X + Y * Y + Z * Z;
+}
+
+}
+
+namespace csp::multiplayer
+{
+
+SpaceEntitySpatialIndex::SpaceEntitySpatialIndex(float CellSize)
+    : CellSize(CellSize)
+{
+}
+
+void SpaceEntitySpatialIndex::Add(SpaceEntity* Entity)
+{
+    const auto [It, Inserted] = Entries.try_emplace(Entity);
+
+    if (Inserted)
+    {
+        It->second.Position = Entity->GetGlobalPosition();
+        InsertIntoCell(Entity, It->second);
+    }
+}
+
+void SpaceEntitySpatialIndex::Remove(SpaceEntity* Entity)
+{
+    const auto It = Entries.find(Entity);
+
+    if (It != Entries.end())
+    {
+        RemoveFromCell(It->second);
+        Entries.erase(It);
+    }
+
+    std::scoped_lock MovedEntitiesLocker(MovedEntitiesLock);
+    MovedEntities.erase(Entity);
+}
+
+void SpaceEntitySpatialIndex::Clear()
+{
+    Entries.clear();
+    Cells.clear();
+
+    std::scoped_lock MovedEntitiesLocker(MovedEntitiesLock);
+    MovedEntities.clear();
+}
+
+void SpaceEntitySpatialIndex::MarkMoved(SpaceEntity* Entity)
+{
+    std::scoped_lock MovedEntitiesLocker(MovedEntitiesLock);
+    MovedEntities.insert(Entity);
+}
+
+void SpaceEntitySpatialIndex::Refresh()
+{
+    {
+        std::scoped_lock MovedEntitiesLocker(MovedEntitiesLock);
+        std::swap(MovedEntities, RefreshingEntities);
+    }
+
+    for (SpaceEntity* Entity : RefreshingEntities)
+    {
+        const auto It = Entries.find(Entity);
+
+        if (It == Entries.end())
+        {
+            continue;
+        }
+
+        EntityEntry& Entry = It->second;
+        Entry.Position = Entity->GetGlobalPosition();
+
+        const uint64_t NewCell = CellKey(CellCoordinate(Entry.Position.X), CellCoordinate(Entry.Position.Y), CellCoordinate(Entry.Position.Z));
+
+        if (NewCell != Entry.Cell)
+        {
+            RemoveFromCell(Entry);
+            InsertIntoCell(Entity, Entry);
+        }
+    }
+
+    RefreshingEntities.clear();
+}
+
+void SpaceEntitySpatialIndex::QueryRadius(const csp::common::Vector3& Centre, float Radius, std::vector<SpaceEntity*>& OutEntities) const
+{
+    // Squaring would turn a negative radius into a positive one. Written this way round so that NaN is rejected too.
+    if (!(Radius >= 0.0f))
+    {
+        return;
+    }
+
+    const float RadiusSquared = Radius * Radius;
+
+    const auto AppendInRange = [&](const std::vector<SpaceEntity*>& CellEntities)
+    {
+        for (SpaceEntity* Entity : CellEntities)
+        {
+            if (DistanceSquared(Entries.at(Entity).Position, Centre) <= RadiusSquared)
+            {
+                OutEntities.push_back(Entity);
+            }
+        }
+    };
+
+    const int32_t MinX = CellCoordinate(Centre.X - Radius);
+    const int32_t MinY = CellCoordinate(Centre.Y - Radius);
+    const int32_t MinZ = CellCoordinate(Centre.Z - Radius);
+    const int32_t MaxX = CellCoordinate(Centre.X + Radius);
+    const int32_t MaxY = CellCoordinate(Centre.Y + Radius);
+    const int32_t MaxZ = CellCoordinate(Centre.Z + Radius);
+
+    const uint64_t OverlappedCellCount = static_cast<uint64_t>(MaxX - MinX + 1) * (MaxY - MinY + 1) * (MaxZ - MinZ + 1);
+
+    // A query larger than the occupied part of the space is cheaper to answer by visiting every occupied cell.
+    if (OverlappedCellCount > Cells.size())
+    {
+        for (const auto& [Key, CellEntities] : Cells)
+        {
+            AppendInRange(CellEntities);
+        }
+
+        return;
+    }
+
+    for (int32_t X = MinX; X <= MaxX; ++X)
+    {
+        for (int32_t Y = MinY; Y <= MaxY; ++Y)
+        {
+            for (int32_t Z = MinZ; Z <= MaxZ; ++Z)
+            {
+                const auto CellIt = Cells.find(CellKey(X, Y, Z));
+
+                if (CellIt != Cells.end())
+                {
+                    AppendInRange(CellIt->second);
+                }
+            }
+        }
+    }
+}
+
+void SpaceEntitySpatialIndex::QueryNearest(const csp::common::Vector3& Centre, size_t Count, std::vector<SpaceEntity*>& OutEntities) const
+{
+    Count = std::min(Count, Entries.size());
+
+    if (Count == 0)
+    {
+        return;
+    }
+
+    // A max-heap of the nearest entities found so far, by squared distance, so the furthest of them is the one to replace.
+    std::vector<std::pair<float, SpaceEntity*>> Nearest;
+    Nearest.reserve(Count);
+
+    const auto Consider = [&](const std::vector<SpaceEntity*>& CellEntities)
+    {
+        for (SpaceEntity* Entity : CellEntities)
+        {
+            const float Distance = DistanceSquared(Entries.at(Entity).Position, Centre);
+
+            if (Nearest.size() < Count)
+            {
+                Nearest.emplace_back(Distance, Entity);
+                std::push_heap(Nearest.begin(), Nearest.end());
+            }
+            else if (Distance < Nearest.front().first)
+            {
+                std::pop_heap(Nearest.begin(), Nearest.end());
+                Nearest.back() = { Distance, Entity };
+                std::push_heap(Nearest.begin(), Nearest.end());
+            }
+        }
+    };
+
+    const int32_t CentreX = CellCoordinate(Centre.X);
+    const int32_t CentreY = CellCoordinate(Centre.Y);
+    const int32_t CentreZ = CellCoordinate(Centre.Z);
+
+    const auto IsValidCoordinate = [](int32_t Coordinate) { return Coordinate >= -MAX_CELL_COORDINATE && Coordinate <= MAX_CELL_COORDINATE; };
+
+    size_t CellLookups = 0;
+    size_t VisitedCells = 0;
+
+    for (int32_t Shell = 0; VisitedCells < Cells.size(); ++Shell)
+    {
+        // If the entities are sparse compared to the cell size, searching shell by shell costs more than checking every occupied cell.
+        if (CellLookups > Cells.size())
+        {
+            Nearest.clear();
+
+            for (const auto& [Key, CellEntities] : Cells)
+            {
+                Consider(CellEntities);
+            }
+
+            break;
+        }
+
+        // Visit the cells on the surface of the cube of cells Shell away from the centre cell.
+        for (int32_t X = -Shell; X <= Shell; ++X)
+        {
+            for (int32_t Y = -Shell; Y <= Shell; ++Y)
+            {
+                const bool OnSide = std::abs(X) == Shell || std::abs(Y) == Shell;
+                const int32_t ZStep = OnSide ? 1 : 2 * Shell;
+
+                for (int32_t Z = -Shell; Z <= Shell; Z += ZStep)
+                {
+                    if (!IsValidCoordinate(CentreX + X) || !IsValidCoordinate(CentreY + Y) || !IsValidCoordinate(CentreZ + Z))
+                    {
+                        continue;
+                    }
+
+                    ++CellLookups;
+                    const auto CellIt = Cells.find(CellKey(CentreX + X, CentreY + Y, CentreZ + Z));
+
+                    if (CellIt != Cells.end())
+                    {
+                        ++VisitedCells;
+                        Consider(CellIt->second);
+                    }
+                }
+            }
+        }
+
+        // Every cell further out than this shell is at least this far from the centre, wherever it is within its cell.
+        const float UnvisitedDistance = static_cast<float>(Shell) * CellSize;
+
+        if (Nearest.size() == Count && Nearest.front().first <= UnvisitedDistance * UnvisitedDistance)
+        {
+            break;
+        }
+    }
+
+    std::sort_heap(Nearest.begin(), Nearest.end());
+
+    for (const auto& [Distance, Entity] : Nearest)
+    {
+        OutEntities.push_back(Entity);
+    }
+}
+
+void SpaceEntitySpatialIndex::QueryPlanes(const std::vector<csp::common::Vector4>& Planes, std::vector<SpaceEntity*>& OutEntities) const
+{
+    const auto IsInside = [&Planes](const csp::common::Vector3& Position)
+    {
+        for (const csp::common::Vector4& Plane : Planes)
+        {
+            if (Plane.X * Position.X + Plane.Y * Position.Y + Plane.Z * Position.Z + Plane.W < 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    for (const auto& [Key, CellEntities] : Cells)
+    {
+        int32_t X, Y, Z;
+        CellCoordinates(Key, X, Y, Z);
+
+        const csp::common::Vector3 Min { X * CellSize, Y * CellSize, Z * CellSize };
+        const csp::common::Vector3 Max { Min.X + CellSize, Min.Y + CellSize, Min.Z + CellSize };
+
+        // The outermost cells also hold everything beyond them, so can't be taken whole.
+        bool CellInside = std::max({ std::abs(X), std::abs(Y), std::abs(Z) }) < MAX_CELL_COORDINATE;
+        bool CellOutside = false;
+
+        for (const csp::common::Vector4& Plane : Planes)
+        {
+            // The corners of the cell furthest along, and furthest against, the plane normal.
+            const float Furthest = Plane.X * (Plane.X >= 0.0f ? Max.X : Min.X) + Plane.Y * (Plane.Y >= 0.0f ? Max.Y : Min.Y)
+                + Plane.Z * (Plane.Z >= 0.0f ? Max.Z : Min.Z) + Plane.W;
+            const float Nearest = Plane.X * (Plane.X >= 0.0f ? Min.X : Max.X) + Plane.Y * (Plane.Y >= 0.0f ? Min.Y : Max.Y)
+                + Plane.Z * (Plane.Z >= 0.0f ? Min.Z : Max.Z) + Plane.W;
+
+            if (Furthest < 0.0f)
+            {
+                CellOutside = true;
+                break;
+            }
+
+            CellInside = CellInside && Nearest >= 0.0f;
+        }
+
+        if (CellOutside)
+        {
+            continue;
+        }
+
+        if (CellInside)
+        {
+            OutEntities.insert(OutEntities.end(), CellEntities.begin(), CellEntities.end());
+            continue;
+        }
+
+        for (SpaceEntity* Entity : CellEntities)
+        {
+            if (IsInside(Entries.at(Entity).Position))
+            {
+                OutEntities.push_back(Entity);
+            }
+        }
+    }
+}
+
+bool SpaceEntitySpatialIndex::TryGetPosition(const SpaceEntity* Entity, csp::common::Vector3& OutPosition) const
+{
+    const auto It = Entries.find(Entity);
+
+    if (It == Entries.end())
+    {
+        return false;
+    }
+
+    OutPosition = It->second.Position;
+    return true;
+}
+
+size_t SpaceEntitySpatialIndex::Size() const { return Entries.size(); }
+
+int32_t SpaceEntitySpatialIndex::CellCoordinate(float Value) const
+{
+    const float Cell = std::floor(Value / CellSize);
+
+    if (std::isnan(Cell))
+    {
+        return 0;
+    }
+
+    return static_cast<int32_t>(std::clamp(Cell, static_cast<float>(-MAX_CELL_COORDINATE), static_cast<float>(MAX_CELL_COORDINATE)));
+}
+
+uint64_t SpaceEntitySpatialIndex::CellKey(int32_t X, int32_t Y, int32_t Z)
+{
+    constexpr uint64_t Mask = (1 << 21) - 1;
+
+    return (static_cast<uint64_t>(X + MAX_CELL_COORDINATE) & Mask) | ((static_cast<uint64_t>(Y + MAX_CELL_COORDINATE) & Mask) << 21)
+        | ((static_cast<uint64_t>(Z + MAX_CELL_COORDINATE) & Mask) << 42);
+}
+
+void SpaceEntitySpatialIndex::CellCoordinates(uint64_t Key, int32_t& OutX, int32_t& OutY, int32_t& OutZ)
+{
+    constexpr uint64_t Mask = (1 << 21) - 1;
+
+    OutX = static_cast<int32_t>(Key & Mask) - MAX_CELL_COORDINATE;
+    OutY = static_cast<int32_t>((Key >> 21) & Mask) - MAX_CELL_COORDINATE;
+    OutZ = static_cast<int32_t>((Key >> 42) & Mask) - MAX_CELL_COORDINATE;
+}
+
+void SpaceEntitySpatialIndex::InsertIntoCell(SpaceEntity* Entity, EntityEntry& Entry)
+{
+    Entry.Cell = CellKey(CellCoordinate(Entry.Position.X), CellCoordinate(Entry.Position.Y), CellCoordinate(Entry.Position.Z));
+
+    std::vector<SpaceEntity*>& CellEntities = Cells[Entry.Cell];
+    Entry.SlotInCell = CellEntities.size();
+    CellEntities.push_back(Entity);
+}
+
+void SpaceEntitySpatialIndex::RemoveFromCell(const EntityEntry& Entry)
+{
+    const auto CellIt = Cells.find(Entry.Cell);
+    std::vector<SpaceEntity*>& CellEntities = CellIt->second;
+
+    // Swap the last entity in the cell into the vacated slot.
+    SpaceEntity* LastEntity = CellEntities.back();
+    CellEntities[Entry.SlotInCell] = LastEntity;
+    Entries.at(LastEntity).SlotInCell = Entry.SlotInCell;
+    CellEntities.pop_back();
+
+    if (CellEntities.empty())
+    {
+        Cells.erase(CellIt);
+    }
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "CSP/Common/Vector.h"
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace csp::multiplayer
+{
+class SpaceEntity;
+
+/// @brief Spatial lookup structure for the global positions of the entities owned by a realtime engine.
+/// @details Entities are bucketed into a uniform grid of cubic cells, so a query only visits the cells that overlap it.
+/// The index does not own the entities it references. The engine adds and removes entities alongside its entity lists, and entities
+/// report when their global transform changes through MarkMoved. Their new positions are read in the next Refresh, so an entity that
+/// moves many times between refreshes is only queued, and re-bucketed, once. Besides refreshing before each query, the engines refresh
+/// the index in UpdateGlobalTransforms, and the online engine on every ProcessPendingEntityOperations.
+/// MarkMoved guards itself with its own leaf mutex, so it is safe to call from code paths that already hold an entity's own lock.
+/// Everything else must be called under the engine entities lock.
+class SpaceEntitySpatialIndex
+{
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 16.0f;
+
+    explicit SpaceEntitySpatialIndex(float CellSize = DEFAULT_CELL_SIZE);
+
+    // Registers an entity at its current global position. Ignored if the entity is already indexed.
+    void Add(SpaceEntity* Entity);
+
+    void Remove(SpaceEntity* Entity);
+
+    void Clear();
+
+    // Records that the global position of the entity may have changed. It is not read until the next Refresh.
+    void MarkMoved(SpaceEntity* Entity);
+
+    // Re-reads the global positions of the entities marked as moved since the last refresh.
+    void Refresh();
+
+    // Appends the entities whose last refreshed position is within Radius of Centre to OutEntities, in no particular order.
+    // Nothing is appended if Radius is negative.
+    void QueryRadius(const csp::common::Vector3& Centre, float Radius, std::vector<SpaceEntity*>& OutEntities) const;
+
+    // Appends the Count entities nearest to Centre to OutEntities, nearest first.
+    // Cells are visited in growing shells around Centre, stopping once no unvisited cell could hold anything nearer than what was found.
+    void QueryNearest(const csp::common::Vector3& Centre, size_t Count, std::vector<SpaceEntity*>& OutEntities) const;
+
+    // Appends the entities inside every plane to OutEntities, in no particular order. Each plane is (Normal.X, Normal.Y, Normal.Z, Distance),
+    // with the normal pointing inwards, so a position P is inside when Dot(Normal, P) + Distance >= 0.
+    // Cells entirely outside a plane are skipped, and cells entirely inside all of them are taken whole.
+    void QueryPlanes(const std::vector<csp::common::Vector4>& Planes, std::vector<SpaceEntity*>& OutEntities) const;
+
+    // Returns false if the entity is not indexed.
+    bool TryGetPosition(const SpaceEntity* Entity, csp::common::Vector3& OutPosition) const;
+
+    size_t Size() const;
+
+private:
+    struct EntityEntry
+    {
+        csp::common::Vector3 Position;
+        uint64_t Cell;
+        // Where the entity is in its cell's list, so that it can be removed without a search.
+        size_t SlotInCell;
+    };
+
+    int32_t CellCoordinate(float Value) const;
+    static uint64_t CellKey(int32_t X, int32_t Y, int32_t Z);
+    static void CellCoordinates(uint64_t Key, int32_t& OutX, int32_t& OutY, int32_t& OutZ);
+
+    void InsertIntoCell(SpaceEntity* Entity, EntityEntry& Entry);
+    void RemoveFromCell(const EntityEntry& Entry);
+
+    float CellSize;
+
+    std::unordered_map<const SpaceEntity*, EntityEntry> Entries;
+    std::unordered_map<uint64_t, std::vector<SpaceEntity*>> Cells;
+
+    // A set, so an entity that is marked again before the next refresh isn't queued twice.
+    // Entities are only dereferenced in Refresh if they are still in Entries, so entities that were never added can safely be left in here.
+    std::unordered_set<SpaceEntity*> MovedEntities;
+    std::unordered_set<SpaceEntity*> RefreshingEntities;
+    std::mutex MovedEntitiesLock;
+};
+
+}
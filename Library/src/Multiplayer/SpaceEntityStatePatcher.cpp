@@ -18,6 +18,8 @@
 #include "CSP/Common/Systems/Log/LogSystem.h"
 #include "CSP/Multiplayer/SpaceEntity.h"
 #include "Common/Convert.h"
+#include "Multiplayer/CompactTransform.h"
+#include "Common/Systems/Log/LogMacros.h"
 
 #include <algorithm>
 #include <fmt/format.h>
@@ -38,13 +40,8 @@ bool SpaceEntityStatePatcher::SetDirtyComponent(uint16_t ComponentKey, DirtyComp
 
     if (DirtyComponents.count(ComponentKey) > 0)
     {
-        if (LogSystem)
-        {
-            LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose,
-                fmt::format(
-                    "SpaceEntityStatePatcher::SetDirtyComponent. Dirty components map already contains key : {}. Performing no action", ComponentKey)
-                    .c_str());
-        }
+        CSP_LOG_LAZY(LogSystem, csp::common::LogLevel::VeryVerbose,
+            "SpaceEntityStatePatcher::SetDirtyComponent. Dirty components map already contains key : {}. Performing no action", ComponentKey);
         return false;
     }
 
@@ -124,6 +121,9 @@ std::pair<SpaceEntityUpdateFlags, csp::common::Array<ComponentUpdateInfo>> Space
                 // Components[ComponentKey] = DirtyComponents[ComponentKey].Component;
                 ComponentUpdates[Index].ComponentId = DirtyComponents[ComponentKey].Component->GetId();
                 ComponentUpdates[Index].UpdateType = ComponentUpdateType::Add;
+
+                // The whole component went out with the add, so nothing is left to replicate
+                DirtyComponents[ComponentKey].Component->ClearDirtyProperties();
                 break;
             case ComponentUpdateType::Delete:
                 SpaceEntity.RemoveComponentDirect(ComponentKey, false);
@@ -135,26 +135,14 @@ std::pair<SpaceEntityUpdateFlags, csp::common::Array<ComponentUpdateInfo>> Space
                 // You may expect a `SpaceEntity.UpdateComponentDirect`, but component property updates
                 // are still out-of-pattern and set immediately rather than looping back. Should change.
 
-                ComponentUpdates[Index].ComponentId = DirtyComponents[ComponentKey].Component->GetId();
-                ComponentUpdates[Index].UpdateType = ComponentUpdateType::Update;
-
-                // TODO: For the moment, we update all properties on a dirty component, in future we need to change this to per property
-                // replication. Components[DirtyComponents[i].Component->GetId()]->Properties = DirtyComponents[i].Component->DirtyProperties;
+                ComponentBase* Component = DirtyComponents[ComponentKey].Component;
 
-                /*const csp::common::Map<uint32_t, csp::common::ReplicatedValue> DirtyComponentProperties =
-                DirtyComponents[i].Component->DirtyProperties; const csp::common::Array<uint32_t>* DirtyComponentPropertyKeys
-                = DirtyComponentProperties.Keys();
-
-                for (size_t j = 0; j < DirtyComponentPropertyKeys->Size(); j++)
-                {
-                        uint32_t PropertyKey							  = DirtyComponentPropertyKeys->operator[](j);
-                        Components[ComponentKey]->Properties[PropertyKey] = DirtyComponentProperties[PropertyKey];
-
-                        ComponentUpdates[i].PropertyInfo[j].PropertyId = PropertyKey;
-                        ComponentUpdates[i].PropertyInfo[j].UpdateType = ComponentUpdateType::Update;
-                }
+                ComponentUpdates[Index].ComponentId = Component->GetId();
+                ComponentUpdates[Index].UpdateType = ComponentUpdateType::Update;
+                ComponentUpdates[Index].PropertyInfo = CreatePropertyUpdateInfo(Component->GetDirtyProperties());
 
-                DirtyComponents[i].Component->DirtyProperties.Clear();*/
+                // The patch for these has been created by now, so they no longer need replicating
+                Component->ClearDirtyProperties();
                 break;
             }
             default:
@@ -210,6 +198,21 @@ std::unordered_map<SpaceEntityComponentKey, csp::common::ReplicatedValue> SpaceE
 
 std::unordered_map<uint16_t, SpaceEntityStatePatcher::DirtyComponent> SpaceEntityStatePatcher::GetDirtyComponents() const { return DirtyComponents; }
 
+void SpaceEntityStatePatcher::GetDirtyComponentTypes(std::vector<ComponentType>& OutTypes) const
+{
+    std::scoped_lock<std::mutex> ComponentsLocker(DirtyComponentsLock);
+
+    OutTypes.clear();
+
+    for (const auto& DirtyComponentPair : DirtyComponents)
+    {
+        if (DirtyComponentPair.second.Component != nullptr)
+        {
+            OutTypes.push_back(DirtyComponentPair.second.Component->GetComponentType());
+        }
+    }
+}
+
 std::chrono::milliseconds SpaceEntityStatePatcher::GetTimeOfLastPatch() const { return TimeOfLastPatch; }
 
 void SpaceEntityStatePatcher::SetTimeOfLastPatch(std::chrono::milliseconds NewTimeOfLastPatch) { this->TimeOfLastPatch = NewTimeOfLastPatch; }
@@ -224,6 +227,38 @@ bool SpaceEntityStatePatcher::HasPendingPatch() const
         && GetNewParentId().HasValue() == false);
 }
 
+bool SpaceEntityStatePatcher::IsTransformOnlyPatch() const
+{
+    {
+        std::scoped_lock ComponentsLocker(DirtyComponentsLock);
+
+        if (!DirtyComponents.empty() || TransientDeletionComponentIds.Size() != 0 || NewParentId.HasValue())
+        {
+            return false;
+        }
+    }
+
+    for (const auto& DirtyProp : DirtyProperties)
+    {
+        if (DirtyProp.first != SpaceEntityComponentKey::Position && DirtyProp.first != SpaceEntityComponentKey::Rotation
+            && DirtyProp.first != SpaceEntityComponentKey::Scale)
+        {
+            return false;
+        }
+    }
+
+    return !DirtyProperties.empty();
+}
+
+void SpaceEntityStatePatcher::MarkTransformDirty()
+{
+    std::scoped_lock<std::mutex> PropertiesLocker(DirtyPropertiesLock);
+
+    DirtyProperties.try_emplace(SpaceEntityComponentKey::Position, csp::common::ReplicatedValue(SpaceEntity.GetPosition()));
+    DirtyProperties.try_emplace(SpaceEntityComponentKey::Rotation, csp::common::ReplicatedValue(SpaceEntity.GetRotation()));
+    DirtyProperties.try_emplace(SpaceEntityComponentKey::Scale, csp::common::ReplicatedValue(SpaceEntity.GetScale()));
+}
+
 csp::multiplayer::ComponentBase* SpaceEntityStatePatcher::GetFirstPendingComponentOfType(
     ComponentType Type, std::set<ComponentUpdateType> InterestingUpdateTypes) const
 {
@@ -269,19 +304,29 @@ mcs::ObjectMessage SpaceEntityStatePatcher::CreateObjectMessage() const
 
     // 3. Create the object message using the reqired properties and our created components.
     return mcs::ObjectMessage { SpaceEntity.GetId(), static_cast<uint64_t>(SpaceEntity.GetEntityType()), SpaceEntity.GetIsTransferable(),
-        SpaceEntity.GetIsPersistent(), SpaceEntity.GetOwnerId(), Convert(SpaceEntity.GetParentId()), ComponentPacker.GetComponents() };
+        SpaceEntity.GetIsPersistent(), SpaceEntity.GetOwnerId(), Convert(SpaceEntity.GetParentId()), ComponentPacker.TakeComponents() };
 }
 
-mcs::ObjectPatch SpaceEntityStatePatcher::CreateObjectPatch() const
+mcs::ObjectPatch SpaceEntityStatePatcher::CreateObjectPatch(bool AllowCompactTransform) const
 {
     MCSComponentPacker ComponentPacker;
 
     // 1. Convert our modified view components to mcs compatible types.
     {
+        // Persistent entities are stored by the server, where clients and tools that can't decode the compact encoding may read them.
+        const bool UseCompactTransform = AllowCompactTransform && !SpaceEntity.GetIsPersistent() && IsTransformOnlyPatch();
+
         // Loop through modfied view components and convert to ItemComponentData.
         for (const std::pair<const SpaceEntityComponentKey, csp::common::ReplicatedValue>& DirtyProp : DirtyProperties)
         {
-            ComponentPacker.WriteValue(DirtyProp.first, DirtyProp.second);
+            if (UseCompactTransform)
+            {
+                CompactTransform::WriteValue(ComponentPacker, DirtyProp.first, DirtyProp.second);
+            }
+            else
+            {
+                ComponentPacker.WriteValue(DirtyProp.first, DirtyProp.second);
+            }
         }
     }
 
@@ -297,6 +342,9 @@ mcs::ObjectPatch SpaceEntityStatePatcher::CreateObjectPatch() const
             if (Component.second.Component != nullptr)
             {
                 auto* RealComponent = Component.second.Component;
+
+                // Updates carry the whole component, as the server stores the component from the latest patch, not a merge of them.
+                // Sending only the changed properties would lose the others for anyone reading the entity back from the server.
                 ComponentPacker.WriteValue(Component.first, RealComponent);
             }
         }
@@ -317,7 +365,7 @@ mcs::ObjectPatch SpaceEntityStatePatcher::CreateObjectPatch() const
     // leaves us vulnerable to sequencing bugs. Fine if ID + OwnerID never change, but dubious about that for OwnerId.
     const bool HasBeenParentUpdate = NewParentId.HasValue();
     return mcs::ObjectPatch { SpaceEntity.GetId(), SpaceEntity.GetOwnerId(), false, HasBeenParentUpdate,
-        HasBeenParentUpdate ? Convert(*NewParentId) : Convert(SpaceEntity.GetParentId()), ComponentPacker.GetComponents() };
+        HasBeenParentUpdate ? Convert(*NewParentId) : Convert(SpaceEntity.GetParentId()), ComponentPacker.TakeComponents() };
 }
 
 std::unique_ptr<csp::multiplayer::SpaceEntity> SpaceEntityStatePatcher::NewFromObjectMessage(const mcs::ObjectMessage& Message,
@@ -330,7 +378,7 @@ std::unique_ptr<csp::multiplayer::SpaceEntity> SpaceEntityStatePatcher::NewFromO
     const auto OwnerId = Message.GetOwnerId();
     const auto ParentId = common::Convert(Message.GetParentId());
 
-    const std::optional<std::map<uint16_t, mcs::ItemComponentData>>& MessageComponents = Message.GetComponents();
+    const std::optional<mcs::ComponentMap>& MessageComponents = Message.GetComponents();
 
     std::unique_ptr<csp::multiplayer::SpaceEntity> Entity(new csp::multiplayer::SpaceEntity(
         &RealtimeEngine, ScriptRunner, &LogSystem, Type, Id, "", SpaceTransform {}, OwnerId, ParentId, IsTransferable, IsPersistent));
@@ -380,16 +428,37 @@ std::unique_ptr<csp::multiplayer::SpaceEntity> SpaceEntityStatePatcher::NewFromO
     return Entity;
 }
 
+mcs::ObjectMessage SpaceEntityStatePatcher::ObjectMessageFromEntity(csp::multiplayer::SpaceEntity& Entity)
+{
+    MCSComponentPacker ComponentPacker;
+
+    // As with NewFromObjectMessage, we can't rely on a patcher having registered the properties, so create them here.
+    const auto Properties = Entity.CreateReplicatedProperties();
+
+    for (const EntityProperty& Property : Properties)
+    {
+        ComponentPacker.WriteValue(Property.GetKey(), Property.Get());
+    }
+
+    for (const auto& Component : *Entity.GetComponents())
+    {
+        ComponentPacker.WriteValue(Component.first, Component.second);
+    }
+
+    return mcs::ObjectMessage { Entity.GetId(), static_cast<uint64_t>(Entity.GetEntityType()), Entity.GetIsTransferable(),
+        Entity.GetIsPersistent(), Entity.GetOwnerId(), Convert(Entity.GetParentId()), ComponentPacker.TakeComponents() };
+}
+
 void SpaceEntityStatePatcher::ApplyPatchFromObjectPatch(const mcs::ObjectPatch& Patch)
 {
     SpaceEntityUpdateFlags UpdateFlags = SpaceEntityUpdateFlags(0);
     csp::common::Array<ComponentUpdateInfo> ComponentUpdates(0);
 
-    auto PatchComponents = Patch.GetComponents();
+    const auto& PatchComponents = Patch.GetComponents();
 
     if (PatchComponents.has_value())
     {
-        MCSComponentUnpacker ComponentUnpacker { *Patch.GetComponents() };
+        MCSComponentUnpacker ComponentUnpacker { *PatchComponents };
         uint64_t ComponentCount = ComponentUnpacker.GetRuntimeComponentsCount();
 
         if (ComponentCount > 0)
@@ -471,6 +540,20 @@ void SpaceEntityStatePatcher::RegisterProperties(const csp::common::Array<Entity
     }
 }
 
+csp::common::Array<ComponentPropertyUpdateInfo> SpaceEntityStatePatcher::CreatePropertyUpdateInfo(
+    const csp::common::Map<uint32_t, csp::common::ReplicatedValue>& Properties)
+{
+    csp::common::Array<ComponentPropertyUpdateInfo> PropertyInfo(Properties.Size());
+    size_t i = 0;
+
+    for (const auto& [Key, Value] : Properties)
+    {
+        PropertyInfo[i++] = ComponentPropertyUpdateInfo { Key, ComponentUpdateType::Update };
+    }
+
+    return PropertyInfo;
+}
+
 void EntityProperty::Set(const csp::common::ReplicatedValue& RepValue) { FromReplicatedValue(RepValue); }
 
 csp::common::ReplicatedValue EntityProperty::Get() const { return ToReplicatedValue(); }
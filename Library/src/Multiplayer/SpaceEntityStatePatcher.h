@@ -21,6 +21,7 @@
 #include "CSP/Common/Systems/Log/LogSystem.h"
 #include "CSP/Multiplayer/ComponentBase.h"
 #include "CSP/Multiplayer/PatchTypes.h"
+#include "Common/Systems/Log/LogMacros.h"
 #include "MCS/MCSTypes.h"
 #include "Multiplayer/MCSComponentPacker.h"
 #include "Multiplayer/SpaceEntityKeys.h"
@@ -30,6 +31,7 @@
 #include <set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace csp::common
 {
@@ -148,10 +150,7 @@ public:
         }
         else
         {
-            if (LogSystem)
-            {
-                LogSystem->LogMsg(csp::common::LogLevel::VeryVerbose, "Attempting to set dirty property to identical value, ignoring.");
-            }
+            CSP_LOG_LAZY(LogSystem, csp::common::LogLevel::VeryVerbose, "Attempting to set dirty property to identical value, ignoring.");
             return false;
         }
     }
@@ -162,6 +161,8 @@ public:
 
     std::unordered_map<SpaceEntityComponentKey, csp::common::ReplicatedValue> GetDirtyProperties() const;
     std::unordered_map<uint16_t, DirtyComponent> GetDirtyComponents() const;
+    // Fills OutTypes with the types of the components with pending adds or updates, without copying the dirty components.
+    void GetDirtyComponentTypes(std::vector<ComponentType>& OutTypes) const;
 
     std::chrono::milliseconds GetTimeOfLastPatch() const;
     void SetTimeOfLastPatch(std::chrono::milliseconds NewTimeOfLastPatch);
@@ -170,17 +171,28 @@ public:
     void SetNewParentId(csp::common::Optional<uint64_t> NewParentId);
 
     bool HasPendingPatch() const;
+    // True if the only pending changes are to the Position, Rotation or Scale properties.
+    bool IsTransformOnlyPatch() const;
+    // Marks the current transform as dirty, so that it is sent in the next patch even though it hasn't changed.
+    // Transform properties that are already dirty keep their pending values.
+    void MarkTransformDirty();
 
     csp::multiplayer::ComponentBase* GetFirstPendingComponentOfType(csp::multiplayer::ComponentType Type,
         std::set<ComponentUpdateType> InterestingUpdateTypes
         = { ComponentUpdateType::Add, ComponentUpdateType::Update, ComponentUpdateType::Delete }) const;
 
     [[nodiscard]] mcs::ObjectMessage CreateObjectMessage() const;
-    [[nodiscard]] mcs::ObjectPatch CreateObjectPatch() const;
+    // @param AllowCompactTransform : If true, the entity isn't persistent, and only transform properties are dirty, they are written with the
+    // compact encoding in CompactTransform.h.
+    [[nodiscard]] mcs::ObjectPatch CreateObjectPatch(bool AllowCompactTransform = false) const;
 
     [[nodiscard]] static std::unique_ptr<csp::multiplayer::SpaceEntity> NewFromObjectMessage(const mcs::ObjectMessage& Message,
         csp::common::IRealtimeEngine& RealtimeEngine, csp::common::IJSScriptRunner& ScriptRunner, csp::common::LogSystem& LogSystem);
 
+    // Creates an object message holding the full state of an entity, the inverse of NewFromObjectMessage.
+    // Unlike CreateObjectMessage, this doesn't need a patcher, so can be used for entities owned by an OfflineRealtimeEngine.
+    [[nodiscard]] static mcs::ObjectMessage ObjectMessageFromEntity(csp::multiplayer::SpaceEntity& Entity);
+
     // Apply the data inside the object patch to the space entity this patcher relates to.
     void ApplyPatchFromObjectPatch(const mcs::ObjectPatch& Patch);
 
@@ -194,6 +206,10 @@ public:
     void RegisterProperty(const EntityProperty& Property);
     void RegisterProperties(const csp::common::Array<EntityProperty>& Properties);
 
+    // Builds the per-property update info reported to clients for a component update, from a map of changed properties.
+    static csp::common::Array<ComponentPropertyUpdateInfo> CreatePropertyUpdateInfo(
+        const csp::common::Map<uint32_t, csp::common::ReplicatedValue>& Properties);
+
 private:
     CSP_START_IGNORE
     mutable std::mutex DirtyPropertiesLock;
@@ -73,6 +73,9 @@ void ScriptContext::Shutdown()
     Modules.clear();
     Imports.clear();
 
+    // Cached values must be released before the context they belong to
+    CachedFunctions.clear();
+
     delete (Context);
 }
 
@@ -148,6 +151,34 @@ const char* ScriptContext::GetImportedModule(size_t Index) const
     return Imports[Index].c_str();
 }
 
+bool ScriptContext::CallGlobalFunction(const csp::common::String& FunctionName, int ArgumentCount, JSValueConst* Arguments)
+{
+    FunctionMap::iterator It = CachedFunctions.find(FunctionName.c_str());
+
+    if (It == CachedFunctions.end())
+    {
+        qjs::Value Global = Context->global();
+        qjs::Value Function { Context->ctx, JS_GetPropertyStr(Context->ctx, Global.v, FunctionName.c_str()) };
+
+        if (!JS_IsFunction(Context->ctx, Function.v))
+        {
+            CSP_LOG_ERROR_FORMAT("Function %s not found in context %llu\n", FunctionName.c_str(), ContextId);
+            return false;
+        }
+
+        It = CachedFunctions.insert(FunctionMap::value_type(FunctionName.c_str(), std::move(Function))).first;
+    }
+
+    // Hold our own reference, the callback may run script that clears the cache while it is executing
+    qjs::Value Function = It->second;
+
+    qjs::Value Result { Context->ctx, JS_Call(Context->ctx, Function.v, JS_UNDEFINED, ArgumentCount, Arguments) };
+    bool HasErrors = Result.isException();
+    return !HasErrors;
+}
+
+void ScriptContext::ClearCachedFunctions() { CachedFunctions.clear(); }
+
 void ScriptContext::Reset()
 {
     // Re-initialise the context ready for new or updated script source
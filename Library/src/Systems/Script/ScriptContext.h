@@ -51,6 +51,14 @@ public:
 
     void Reset();
 
+    // Calls a function on the context's global object, without parsing any source. The name must be a plain global property, not an expression.
+    // The resolved function is cached until ClearCachedFunctions is called, so a function reassigned from inside a callback is only picked up once
+    // new source has been run.
+    bool CallGlobalFunction(const csp::common::String& FunctionName, int ArgumentCount, JSValueConst* Arguments);
+
+    // Drops any cached global functions. Should be called whenever new source has been evaluated in this context.
+    void ClearCachedFunctions();
+
 private:
     void Initialise();
     void Shutdown();
@@ -59,6 +67,7 @@ private:
 
     using ModuleMap = std::map<std::string, ScriptModule*>;
     using ImportedModules = std::vector<std::string>;
+    using FunctionMap = std::map<std::string, qjs::Value>;
 
     uint64_t ContextId;
     ScriptSystem* TheScriptSystem;
@@ -67,6 +76,7 @@ private:
     qjs::Runtime* Runtime;
     ModuleMap Modules;
     ImportedModules Imports;
+    FunctionMap CachedFunctions;
 };
 
 } // namespace csp::systems
@@ -56,6 +56,9 @@ ScriptRuntime::~ScriptRuntime()
         delete (Context.second);
     }
 
+    JS_FreeValueRT(Runtime->rt, CachedMessage.Value);
+    JS_FreeValueRT(Runtime->rt, CachedMessageParams.Value);
+
     delete (Runtime);
 }
 
@@ -218,4 +221,26 @@ csp::common::String ScriptRuntime::GetModuleSource(csp::common::String ModuleUrl
     return csp::common::String();
 }
 
+void ScriptRuntime::GetMessageArguments(
+    JSContext* Context, const csp::common::String& Message, const csp::common::String& MessageParamsJson, JSValue (&OutArguments)[2])
+{
+    OutArguments[0] = GetCachedString(Context, CachedMessage, Message);
+    OutArguments[1] = GetCachedString(Context, CachedMessageParams, MessageParamsJson);
+}
+
+JSValue ScriptRuntime::GetCachedString(JSContext* Context, CachedString& Cache, const csp::common::String& Text)
+{
+    // Strings are not bound to the context that created them, so a value made in one context can be passed to functions in any other
+    // context sharing this runtime.
+    if (JS_IsUndefined(Cache.Value) || Cache.Text != Text.c_str())
+    {
+        JS_FreeValueRT(Runtime->rt, Cache.Value);
+
+        Cache.Text = Text.c_str();
+        Cache.Value = JS_NewStringLen(Context, Text.c_str(), Text.Length());
+    }
+
+    return Cache.Value;
+}
+
 } // namespace csp::systems
@@ -17,6 +17,7 @@
 
 #include "CSP/Common/Interfaces/IScriptBinding.h"
 #include "CSP/Common/String.h"
+#include "quickjs.h"
 
 #include <list>
 #include <map>
@@ -64,6 +65,12 @@ public:
     void AddModuleUrlAlias(const csp::common::String& ModuleUrl, const csp::common::String& ModuleUrlAlias);
     bool GetModuleUrlAlias(const csp::common::String& ModuleUrl, csp::common::String& OutModuleUrlAlias);
 
+    // Gets JS string values for a message and its parameters, to be passed to a message callback.
+    // The values are shared by every context in the runtime and reused for as long as the same text is posted,
+    // so delivering one tick to many entities only allocates them once. The values remain owned by the runtime.
+    void GetMessageArguments(
+        JSContext* Context, const csp::common::String& Message, const csp::common::String& MessageParamsJson, JSValue (&OutArguments)[2]);
+
     ScriptSystem* TheScriptSystem;
     qjs::Runtime* Runtime;
 
@@ -71,6 +78,18 @@ public:
     BindingList Bindings;
     ModuleSourceMap Modules;
     UrlAliasMap UrlAliases;
+
+private:
+    struct CachedString
+    {
+        std::string Text;
+        JSValue Value = JS_UNDEFINED;
+    };
+
+    JSValue GetCachedString(JSContext* Context, CachedString& Cache, const csp::common::String& Text);
+
+    CachedString CachedMessage;
+    CachedString CachedMessageParams;
 };
 
 } // namespace csp::systems
@@ -29,6 +29,7 @@
 #include "quickjs-libc.h"
 #endif
 
+#include <cctype>
 #include <map>
 #include <sstream>
 
@@ -65,6 +66,33 @@ template <> struct qjs::js_traits<csp::common::String>
     static JSValue wrap(JSContext* ctx, csp::common::String str) noexcept { return JS_NewStringLen(ctx, str.c_str(), str.Length()); }
 };
 
+namespace
+{
+
+// Whether Name can be looked up directly as a property of the global object, rather than needing to be evaluated as an expression.
+bool IsGlobalIdentifier(const csp::common::String& Name)
+{
+    if (Name.IsEmpty())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < Name.Length(); ++i)
+    {
+        const char Character = Name.c_str()[i];
+        const bool IsIdentifierStart = std::isalpha(static_cast<unsigned char>(Character)) || Character == '_' || Character == '$';
+
+        if (!IsIdentifierStart && (i == 0 || !std::isdigit(static_cast<unsigned char>(Character))))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
 namespace csp::systems
 {
 
@@ -123,6 +151,10 @@ bool ScriptSystem::RunScript(int64_t ContextId, const csp::common::String& Scrip
 
     qjs::Value Result = TheScriptContext->Context->eval(ScriptText.c_str(), "<eval>", JS_EVAL_TYPE_MODULE);
     bool HasErrors = Result.isException();
+
+    // The script may have (re)assigned global callbacks
+    TheScriptContext->ClearCachedFunctions();
+
     return !HasErrors;
 }
 
@@ -138,9 +170,33 @@ bool ScriptSystem::RunScriptFile(int64_t ContextId, const csp::common::String& S
 
     qjs::Value Result = TheScriptContext->Context->evalFile(ScriptFilePath.c_str(), JS_EVAL_TYPE_MODULE);
     bool HasErrors = Result.isException();
+
+    TheScriptContext->ClearCachedFunctions();
+
     return !HasErrors;
 }
 
+bool ScriptSystem::CallMessageCallback(
+    int64_t ContextId, const csp::common::String& CallbackName, const csp::common::String& Message, const csp::common::String& MessageParamsJson)
+{
+    ScriptContext* TheScriptContext = TheScriptRuntime->GetContext(ContextId);
+    if (TheScriptContext == nullptr)
+    {
+        return false;
+    }
+
+    // Callbacks such as "handlers.onTick" are expressions, which only the formatted call of the default implementation can resolve.
+    if (!IsGlobalIdentifier(CallbackName))
+    {
+        return IJSScriptRunner::CallMessageCallback(ContextId, CallbackName, Message, MessageParamsJson);
+    }
+
+    JSValue Arguments[2];
+    TheScriptRuntime->GetMessageArguments(TheScriptContext->Context->ctx, Message, MessageParamsJson, Arguments);
+
+    return TheScriptContext->CallGlobalFunction(CallbackName, 2, Arguments);
+}
+
 bool ScriptSystem::CreateContext(int64_t ContextId) { return TheScriptRuntime->AddContext(ContextId); }
 
 bool ScriptSystem::DestroyContext(int64_t ContextId) { return TheScriptRuntime->RemoveContext(ContextId); }
@@ -136,8 +136,12 @@ const Space& SpaceResult::GetSpace() const { return Space; }
 
 const csp::common::String& SpaceResult::GetSpaceCode() const { return SpaceCode; }
 
+const EnterSpaceMetrics& SpaceResult::GetEnterSpaceMetrics() const { return Metrics; }
+
 void SpaceResult::SetSpace(const csp::systems::Space& InSpace) { Space = InSpace; }
 
+void SpaceResult::SetEnterSpaceMetrics(const EnterSpaceMetrics& InMetrics) { Metrics = InMetrics; }
+
 void SpaceResult::OnResponse(const csp::services::ApiResponseBase* ApiResponse)
 {
     ResultBase::OnResponse(ApiResponse);
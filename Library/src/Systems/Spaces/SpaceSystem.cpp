@@ -85,6 +85,25 @@ std::shared_ptr<chsaggregation::DuplicateSpaceOptions> ConstructDuplicateSpaceOp
     return Request;
 }
 
+// Times the phases of EnterSpace, relative to when it was called.
+// Concurrent phases write to different timings, and the metrics are only read once all of them have finished.
+struct EnterSpaceTimer
+{
+    using PhaseTiming = csp::systems::EnterSpacePhaseTiming csp::systems::EnterSpaceMetrics::*;
+
+    std::chrono::microseconds Elapsed() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - StartTime);
+    }
+
+    void Begin(PhaseTiming Phase) { (Metrics.*Phase).Start = Elapsed(); }
+
+    void End(PhaseTiming Phase) { (Metrics.*Phase).Duration = Elapsed() - (Metrics.*Phase).Start; }
+
+    std::chrono::steady_clock::time_point StartTime = std::chrono::steady_clock::now();
+    csp::systems::EnterSpaceMetrics Metrics;
+};
+
 } // namespace
 
 namespace csp::systems
@@ -290,96 +309,97 @@ std::function<async::task<NullResult>()> SpaceSystem::BulkInviteUsersToSpaceIfNe
     };
 }
 
-std::function<async::task<SpaceResult>(const SpaceResult& SpaceResult)> SpaceSystem::RegisterScopesInSpace(
-    csp::common::IRealtimeEngine* RealtimeEngine)
+async::task<SpaceSystem::DefaultScopeInfo> SpaceSystem::LookupDefaultScope(const csp::common::String& SpaceId)
 {
     // Fow now, we only want to register the default scope to run scripts.
     // When we fully enable scope support, this will need to change.
-    return [this, RealtimeEngine](const SpaceResult& SpaceResult)
-    {
-        // 1. Find all the scopes associated with the space.
-        auto FinishedGetScopeEvent = std::make_shared<async::event_task<csp::systems::SpaceResult>>();
-        auto FinishedGetScopeContinuation = FinishedGetScopeEvent->get_task();
+    return this->MultiplayerSystem->GetScopesBySpace(SpaceId).then(async::inline_scheduler(),
+        [this](const csp::systems::ScopesResult& ScopesResult) -> async::task<DefaultScopeInfo>
+        {
+            // Ensure we have single default, auto-generated scope.
+            // This is done by checking for the global scope in the space, and that we only have 1 of these scopes, which is global.
+            // Right now, clients can't create scopes, so there should be a 0 chance of the below conditions failing.
+            if (ScopesResult.GetResultCode() != EResultCode::Success)
+            {
+                this->LogSystem->LogMsg(csp::common::LogLevel::Error, "SpaceSystem::LookupDefaultScope: Failed to get the scopes of the space.");
+                throw csp::common::continuations::ResultException(
+                    "SpaceSystem::LookupDefaultScope: Failed to get the scopes of the space", MakeInvalid<csp::systems::SpaceResult>());
+            }
 
-        this->MultiplayerSystem->GetScopesBySpace(SpaceResult.GetSpace().Id)
-            .then(async::inline_scheduler(),
-                [this, FinishedGetScopeEvent, SpaceResult, RealtimeEngine](const csp::systems::ScopesResult& ScopesResult)
-                {
-                    // 2. Ensure we have single default, auto-generated scope.
-                    // This is done by checking for the global scope in the space, and that we only have 1 of these scopes, which is global.
-                    // Right now, clients can't create scopes, so there should be a 0 chance of the above conditions failing.
-                    const auto& Scopes = ScopesResult.GetScopes();
+            const auto& Scopes = ScopesResult.GetScopes();
 
-                    if (Scopes.Size() < 1)
-                    {
-                        this->LogSystem->LogMsg(
-                            csp::common::LogLevel::Error, "SpaceSystem::RegisterScopesInSpace: Space doesn't have a scope.");
-                        FinishedGetScopeEvent->set_exception(std::make_exception_ptr(csp::common::continuations::ResultException(
-                            "SpaceSystem::RegisterScopesInSpace: Space doesn't have a scope", MakeInvalid<csp::systems::SpaceResult>())));
-                        return;
-                    }
-
-                    if (Scopes.Size() > 1)
-                    {
-                        this->LogSystem->LogMsg(
-                            csp::common::LogLevel::Error, "SpaceSystem::RegisterScopesInSpace: Multiple scopes found. This version of CSP only supports spaces that have only a single global scope.");
-                        FinishedGetScopeEvent->set_exception(std::make_exception_ptr(csp::common::continuations::ResultException(
-                            "SpaceSystem::RegisterScopesInSpace: Space has multiple scopes", MakeInvalid<csp::systems::SpaceResult>())));
-                        return;
-                    }
+            if (Scopes.Size() < 1)
+            {
+                this->LogSystem->LogMsg(csp::common::LogLevel::Error, "SpaceSystem::LookupDefaultScope: Space doesn't have a scope.");
+                throw csp::common::continuations::ResultException(
+                    "SpaceSystem::LookupDefaultScope: Space doesn't have a scope", MakeInvalid<csp::systems::SpaceResult>());
+            }
 
-                    if (Scopes[0].PubSubType != PubSubModelType::Global)
-                    {
-                        this->LogSystem->LogMsg(csp::common::LogLevel::Error,
-                            "SpaceSystem::RegisterScopesInSpace: Space doesn't contain a global scope.");
-                        FinishedGetScopeEvent->set_exception(std::make_exception_ptr(csp::common::continuations::ResultException(
-                            "SpaceSystem::RegisterScopesInSpace: Space doesn't contain a global scope.", MakeInvalid<csp::systems::SpaceResult>())));
-                        return;
-                    }
+            if (Scopes.Size() > 1)
+            {
+                this->LogSystem->LogMsg(csp::common::LogLevel::Error,
+                    "SpaceSystem::LookupDefaultScope: Multiple scopes found. This version of CSP only supports spaces that have only a single global "
+                    "scope.");
+                throw csp::common::continuations::ResultException(
+                    "SpaceSystem::LookupDefaultScope: Space has multiple scopes", MakeInvalid<csp::systems::SpaceResult>());
+            }
 
-                    // No need to check validity as the above conditions guarantee a valid iterator.
-                    auto DefaultScopeIt
-                        = std::find_if(Scopes.begin(), Scopes.end(),
-                        [](const Scope& Scope) { return Scope.PubSubType == PubSubModelType::Global; });
+            if (Scopes[0].PubSubType != PubSubModelType::Global)
+            {
+                this->LogSystem->LogMsg(csp::common::LogLevel::Error, "SpaceSystem::LookupDefaultScope: Space doesn't contain a global scope.");
+                throw csp::common::continuations::ResultException(
+                    "SpaceSystem::LookupDefaultScope: Space doesn't contain a global scope.", MakeInvalid<csp::systems::SpaceResult>());
+            }
 
-                    const bool ManagedLeaderElection = DefaultScopeIt->ManagedLeaderElection;
+            DefaultScopeInfo DefaultScope;
+            DefaultScope.Id = Scopes[0].Id;
+            DefaultScope.ManagedLeaderElection = Scopes[0].ManagedLeaderElection;
 
-                    // This will set server-side election to true if the scope has ManagedLeaderElection enabled. Otherwise it will default to client
-                    // election.
-                    static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEngine)->SetServerSideElectionEnabled(ManagedLeaderElection);
-                    // Start leader election
-                    static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEngine)->EnableLeaderElection();
+            // The leader is only tracked by the server-side leader election system.
+            if (DefaultScope.ManagedLeaderElection == false)
+            {
+                return async::make_task(DefaultScope);
+            }
 
-                    // We don't want to register the scope and activate the server-side leader election system,
-                    // if the scope doesn't have ManagedLeaderElection set to true.
-                    if (ManagedLeaderElection == false)
+            return this->MultiplayerSystem->GetScopeLeader(DefaultScope.Id)
+                .then(async::inline_scheduler(),
+                    [this, DefaultScope](const ScopeLeaderResult& LeaderResult) mutable
                     {
-                        FinishedGetScopeEvent->set(SpaceResult);
-                        return;
-                    }
-
-                    // 3. We want to find the scope leader, and register this scope to the RealtimeEngine for use in leader election.
-                    this->MultiplayerSystem->GetScopeLeader(DefaultScopeIt->Id,
-                        [FinishedGetScopeEvent, SpaceResult, RealtimeEngine](const ScopeLeaderResult& LeaderResult)
+                        if (LeaderResult.GetResultCode() != EResultCode::Success)
                         {
-                            if (LeaderResult.GetResultCode() == EResultCode::InProgress)
-                            {
-                                return;
-                            }
+                            this->LogSystem->LogMsg(
+                                csp::common::LogLevel::Error, "SpaceSystem::LookupDefaultScope: Failed to get the default scope leader.");
+                            throw csp::common::continuations::ResultException(
+                                "SpaceSystem::LookupDefaultScope: Failed to get the default scope leader", MakeInvalid<csp::systems::SpaceResult>());
+                        }
+
+                        DefaultScope.LeaderClientId = LeaderResult.GetScopeLeader().ScopeClientId;
+                        return DefaultScope;
+                    });
+        });
+}
 
-                             const ScopeLeader& Leader = LeaderResult.GetScopeLeader();
+void SpaceSystem::RegisterDefaultScope(csp::common::IRealtimeEngine* RealtimeEngine, const DefaultScopeInfo& DefaultScope)
+{
+    auto* OnlineEngine = static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEngine);
 
-                            std::optional<uint64_t> LeaderUserId
-                                = (Leader.ScopeClientId != 0) ? std::make_optional<uint64_t>(Leader.ScopeClientId) : std::nullopt;
+    // This will set server-side election to true if the scope has ManagedLeaderElection enabled. Otherwise it will default to client
+    // election.
+    OnlineEngine->SetServerSideElectionEnabled(DefaultScope.ManagedLeaderElection);
+    // Start leader election
+    OnlineEngine->EnableLeaderElection();
 
-                            static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEngine)
-                                ->RegisterDefaultScope(Leader.ScopeId.c_str(), LeaderUserId);
+    // We don't want to register the scope and activate the server-side leader election system,
+    // if the scope doesn't have ManagedLeaderElection set to true.
+    if (DefaultScope.ManagedLeaderElection == false)
+    {
+        return;
+    }
 
-                            FinishedGetScopeEvent->set(SpaceResult);
-                        });
-                });
-        return FinishedGetScopeContinuation;
-    };
+    std::optional<uint64_t> LeaderUserId
+        = (DefaultScope.LeaderClientId != 0) ? std::make_optional<uint64_t>(DefaultScope.LeaderClientId) : std::nullopt;
+
+    OnlineEngine->RegisterDefaultScope(DefaultScope.Id.c_str(), LeaderUserId);
 }
 
 /* EnterSpace Continuations */
@@ -452,16 +472,21 @@ auto SpaceSystem::FireEnterSpaceEvent(Space& OutCurrentSpace)
 
 /*
  * ** EnterSpace Flow **
- * GetSpace
- * AssertRequestSuccessOrError (GetSpace Validation)
- * AddUserToSpaceIfNecessary
- * AssertRequestSuccessOrError (AddUserToSpace Validation)
+ * Online:
+ *   GetSpace
+ *   AssertRequestSuccessOrError (GetSpace Validation)
+ *   AddUserToSpaceIfNecessary
+ *   AssertRequestSuccessOrError (AddUserToSpace Validation)
+ * Then two branches run concurrently:
+ *   RefreshMultiplayerScopes
+ * and
+ *   LookupDefaultScope (Sets the current space, then GetScopesBySpace, then GetScopeLeader if the scope uses server-side leader election)
+ * Once both have finished:
+ *   RegisterDefaultScope
+ * Offline, a local space result is built instead. Then:
  * FireEnterSpaceEvent
- * RefreshMultiplayerScopes
- * RegisterScopesInSpace
  * FetchAllEntitiesAndPopulateBuffers
- * AssertRequestSuccessOrErrorFromMultiplayerErrorCode (RefreshMultiplayerScopes Validation)
- * ReportSuccess
+ * SendResult (With the phase timings)
  * InvokeIfExceptionInChain (Handle any errors from the above Assert methods in chain, resets state)
  */
 void SpaceSystem::EnterSpace(const String& SpaceId, csp::common::IRealtimeEngine* RealtimeEngine, SpaceResultCallback Callback)
@@ -508,38 +533,94 @@ void SpaceSystem::EnterSpace(const String& SpaceId, csp::common::IRealtimeEngine
 
     CSP_LOG_MSG(csp::common::LogLevel::Log, "SpaceSystem::EnterSpace");
 
-    // If online, get the space, add the user to it. If offline, create a local space and forward a local result through.
-    auto UpstreamConnectionTask = (RealtimeEngine->GetRealtimeEngineType() == csp::common::RealtimeEngineType::Online)
-        ? GetSpace(SpaceId)
-              .then(async::inline_scheduler(),
-                  systems::continuations::AssertRequestSuccessOrErrorFromResult<SpaceResult>(
-                      "SpaceSystem::EnterSpace, successfully discovered space.",
-                      "Logged in user does not have permission to discover this space. Failed to enter space.", {}, {}, {}))
-              .then(async::inline_scheduler(), AddUserToSpaceIfNecessary(Callback, *this))
-              .then(async::inline_scheduler(),
-                  systems::continuations::AssertRequestSuccessOrErrorFromResult<SpaceResult>(
-                      "SpaceSystem::EnterSpace, successfully added user to space (if not already added).",
-                      "Failed to Enter Space. AddUserToSpace returned unexpected failure.", {}, {}, {}))
-              .then(async::inline_scheduler(),
-                  [RealtimeEngine, SpaceId](const SpaceResult& SpaceResult)
-                  {
-                      /* Refresh the multiplayer connection to force the scopes to change
-                      This is done in a nested continuation to prevent passing SpaceResult through all of the internal calls */
-                      auto RefreshMultiplayerConnectionEvent = std::make_shared<async::event_task<csp::systems::SpaceResult>>();
-                      auto RefreshMultiplayerConnectionContinuation = RefreshMultiplayerConnectionEvent->get_task();
-
-                      /* Investigate whether this needs to happen at all, it 's overwhelmingly complex... If you' re doing anything AOI,
-                       * this probably wants rewritten or removed along with your work. */
-                      static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEngine)
-                          ->RefreshMultiplayerConnectionToEnactScopeChange(SpaceId)
-                          .then(async::inline_scheduler(),
-                              [RefreshMultiplayerConnectionEvent, SpaceResult]() { RefreshMultiplayerConnectionEvent->set(SpaceResult); });
-
-                      return RefreshMultiplayerConnectionContinuation;
-                  })
-              .then(async::inline_scheduler(), FireEnterSpaceEvent(CurrentSpace)) // Neccesary?
-              .then(async::inline_scheduler(), this->RegisterScopesInSpace(RealtimeEngine))
-        : async::spawn(async::inline_scheduler(),
+    auto Timer = std::make_shared<EnterSpaceTimer>();
+
+    // If online, get the space, add the user to it and look up its scopes. If offline, create a local space and forward a local result through.
+    async::task<SpaceResult> UpstreamConnectionTask;
+
+    if (RealtimeEngine->GetRealtimeEngineType() == csp::common::RealtimeEngineType::Online)
+    {
+        Timer->Begin(&EnterSpaceMetrics::DiscoverSpace);
+
+        UpstreamConnectionTask
+            = GetSpace(SpaceId)
+                  .then(async::inline_scheduler(),
+                      [Timer](const SpaceResult& SpaceResult)
+                      {
+                          Timer->End(&EnterSpaceMetrics::DiscoverSpace);
+                          return SpaceResult;
+                      })
+                  .then(async::inline_scheduler(),
+                      systems::continuations::AssertRequestSuccessOrErrorFromResult<SpaceResult>(
+                          "SpaceSystem::EnterSpace, successfully discovered space.",
+                          "Logged in user does not have permission to discover this space. Failed to enter space.", {}, {}, {}))
+                  .then(async::inline_scheduler(),
+                      [Timer](const SpaceResult& SpaceResult)
+                      {
+                          Timer->Begin(&EnterSpaceMetrics::AddUser);
+                          return SpaceResult;
+                      })
+                  .then(async::inline_scheduler(), AddUserToSpaceIfNecessary(Callback, *this))
+                  .then(async::inline_scheduler(),
+                      systems::continuations::AssertRequestSuccessOrErrorFromResult<SpaceResult>(
+                          "SpaceSystem::EnterSpace, successfully added user to space (if not already added).",
+                          "Failed to Enter Space. AddUserToSpace returned unexpected failure.", {}, {}, {}))
+                  .then(async::inline_scheduler(),
+                      [this, RealtimeEngine, SpaceId, Timer](const SpaceResult& SpaceResult)
+                      {
+                          Timer->End(&EnterSpaceMetrics::AddUser);
+                          Timer->Begin(&EnterSpaceMetrics::RefreshConnection);
+
+                          /* Refresh the multiplayer connection to force the scopes to change
+                          This is done in a nested continuation to prevent passing SpaceResult through all of the internal calls */
+                          auto RefreshMultiplayerConnectionEvent = std::make_shared<async::event_task<csp::systems::SpaceResult>>();
+                          auto RefreshMultiplayerConnectionContinuation = RefreshMultiplayerConnectionEvent->get_task();
+
+                          /* Investigate whether this needs to happen at all, it 's overwhelmingly complex... If you' re doing anything AOI,
+                           * this probably wants rewritten or removed along with your work. */
+                          static_cast<csp::multiplayer::OnlineRealtimeEngine*>(RealtimeEngine)
+                              ->RefreshMultiplayerConnectionToEnactScopeChange(SpaceId)
+                              .then(async::inline_scheduler(),
+                                  [RefreshMultiplayerConnectionEvent, SpaceResult, Timer]()
+                                  {
+                                      Timer->End(&EnterSpaceMetrics::RefreshConnection);
+                                      RefreshMultiplayerConnectionEvent->set(SpaceResult);
+                                  });
+
+                          // The scopes are looked up once the user is a member of the space, as a non-member may not be allowed to read them,
+                          // but there's no need to wait for the connection refresh as well.
+                          // GetScopesBySpace only answers for the current space, so it is set here rather than waiting for FireEnterSpaceEvent.
+                          // If anything below fails, the error handler at the end of the chain clears it again.
+                          CurrentSpace = SpaceResult.GetSpace();
+
+                          Timer->Begin(&EnterSpaceMetrics::LookupScopes);
+
+                          auto ScopeLookupTask = LookupDefaultScope(SpaceId).then(async::inline_scheduler(),
+                              [Timer](const DefaultScopeInfo& DefaultScope)
+                              {
+                                  Timer->End(&EnterSpaceMetrics::LookupScopes);
+                                  return DefaultScope;
+                              });
+
+                          return async::when_all(std::move(RefreshMultiplayerConnectionContinuation), std::move(ScopeLookupTask))
+                              .then(async::inline_scheduler(),
+                                  [RealtimeEngine](std::tuple<async::task<csp::systems::SpaceResult>, async::task<DefaultScopeInfo>> Results)
+                                  {
+                                      // Rethrows the exception of a branch that failed, so that it is handled at the end of the chain.
+                                      csp::systems::SpaceResult Result = std::get<0>(Results).get();
+                                      const DefaultScopeInfo DefaultScope = std::get<1>(Results).get();
+
+                                      // Leader election has to be set up before the entities are fetched, as the fetch completing
+                                      // is what starts it.
+                                      RegisterDefaultScope(RealtimeEngine, DefaultScope);
+
+                                      return Result;
+                                  });
+                      });
+    }
+    else
+    {
+        UpstreamConnectionTask = async::spawn(async::inline_scheduler(),
             [SpaceId]()
             {
                 // Offline, build a local space result
@@ -567,13 +648,13 @@ void SpaceSystem::EnterSpace(const String& SpaceId, csp::common::IRealtimeEngine
                 LocalSpaceResult.SetSpace(LocalSpace);
                 LocalSpaceResult.SetResult(EResultCode::Success, static_cast<uint16_t>(csp::web::EResponseCodes::ResponseOK));
                 return LocalSpaceResult;
-            }).then(async::inline_scheduler(), FireEnterSpaceEvent(CurrentSpace));
+            });
+    }
 
     // Whether we've done an upstream online connection or just a local one, finish entering the space
-    UpstreamConnectionTask
-        .then(async::inline_scheduler(), FireEnterSpaceEvent(CurrentSpace)) // Neccesary?
+    UpstreamConnectionTask.then(async::inline_scheduler(), FireEnterSpaceEvent(CurrentSpace))
         .then(async::inline_scheduler(),
-            [RealtimeEngine](const SpaceResult& SpaceResult)
+            [RealtimeEngine, Timer](const SpaceResult& SpaceResult)
             {
                 /* Because this is external api (RealtimeEngine) we use the callback for chaining, rather than a nicer interface.
                  * Need to make sure we've finished fetching all the entities before we move on
@@ -593,14 +674,39 @@ void SpaceSystem::EnterSpace(const String& SpaceId, csp::common::IRealtimeEngine
                 auto FinishedFetchEntitySetupEvent = std::make_shared<async::event_task<csp::systems::SpaceResult>>();
                 auto FinishedFetchEntitySetupContinuation = FinishedFetchEntitySetupEvent->get_task();
 
+                Timer->Begin(&EnterSpaceMetrics::StartEntityFetch);
+
                 // This is what fetches the data for the space, all the assets and whatnot. Creates the space entities in the realtime engine.
                 RealtimeEngine->FetchAllEntitiesAndPopulateBuffers(SpaceResult.GetSpace().Id,
-                    [FinishedFetchEntitySetupEvent, ResultCopy = SpaceResult]()
-                    { FinishedFetchEntitySetupEvent->set(ResultCopy); }); // Forward through the SpaceResult
+                    [FinishedFetchEntitySetupEvent, ResultCopy = SpaceResult, Timer]()
+                    {
+                        Timer->End(&EnterSpaceMetrics::StartEntityFetch);
+                        FinishedFetchEntitySetupEvent->set(ResultCopy); // Forward through the SpaceResult
+                    });
 
                 return FinishedFetchEntitySetupContinuation;
             })
-        .then(async::inline_scheduler(), systems::continuations::ReportSuccess(Callback, "Successfully entered space."))
+        .then(async::inline_scheduler(),
+            [Timer]()
+            {
+                Timer->Metrics.Total = Timer->Elapsed();
+
+                const EnterSpaceMetrics& Metrics = Timer->Metrics;
+
+                CSP_LOG_MSG(csp::common::LogLevel::Log,
+                    fmt::format("Entered space in {}ms. Discover space: {}ms, add user: {}ms, look up scopes: {}ms, refresh connection: {}ms, "
+                                "start entity fetch: {}ms",
+                        Metrics.Total.count() / 1000, Metrics.DiscoverSpace.Duration.count() / 1000, Metrics.AddUser.Duration.count() / 1000,
+                        Metrics.LookupScopes.Duration.count() / 1000, Metrics.RefreshConnection.Duration.count() / 1000,
+                        Metrics.StartEntityFetch.Duration.count() / 1000)
+                        .c_str());
+
+                SpaceResult SuccessResult(EResultCode::Success, csp::web::EResponseCodes::ResponseOK, ERequestFailureReason::None);
+                SuccessResult.SetEnterSpaceMetrics(Metrics);
+
+                return SuccessResult;
+            })
+        .then(async::inline_scheduler(), systems::continuations::SendResult(Callback, "Successfully entered space."))
         .then(async::inline_scheduler(),
             csp::common::continuations::InvokeIfExceptionInChain(*csp::systems::SystemsManager::Get().GetLogSystem(),
                 [Callback, &CurrentSpace = CurrentSpace]([[maybe_unused]] const csp::common::continuations::ExpectedExceptionBase& Except)
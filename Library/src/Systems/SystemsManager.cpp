@@ -170,7 +170,7 @@ void SystemsManager::CreateSystems(csp::multiplayer::ISignalRConnection* SignalR
 #ifdef CSP_WASM
     WebClient = new csp::web::EmscriptenWebClient(80, csp::web::ETransferProtocol::HTTPS, LogSystem);
 #else
-    WebClient = new csp::web::POCOWebClient(80, csp::web::ETransferProtocol::HTTPS, LogSystem);
+    WebClient = new csp::web::POCOWebClient(80, csp::web::ETransferProtocol::HTTPS, LogSystem, true, csp::web::GetConfiguredWebClientSettings());
 #endif
 
     // Emergency Fix: We have a circular dependency issue here due to SignalR requiring the AuthContext for construction. To get around this
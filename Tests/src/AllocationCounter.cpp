@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AllocationCounter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+// Innermost live counter on this thread, counters nest so that an outer scope isn't affected by an inner one.
+thread_local ScopedAllocationCounter* ActiveCounter = nullptr;
+
+// Each block is prefixed with its size, so that frees can be taken off the live byte count. This keeps the default alignment.
+constexpr std::size_t HeaderSize = alignof(std::max_align_t);
+}
+
+ScopedAllocationCounter::ScopedAllocationCounter()
+    : Previous { ActiveCounter }
+{
+    ActiveCounter = this;
+}
+
+ScopedAllocationCounter::~ScopedAllocationCounter() { ActiveCounter = Previous; }
+
+void ScopedAllocationCounter::Reset()
+{
+    Count = 0;
+    LiveBytes = 0;
+    PeakBytes = 0;
+}
+
+void ScopedAllocationCounter::RecordAllocation(size_t Size)
+{
+    if (ActiveCounter != nullptr)
+    {
+        ++ActiveCounter->Count;
+        ActiveCounter->LiveBytes += static_cast<int64_t>(Size);
+        ActiveCounter->PeakBytes = std::max(ActiveCounter->PeakBytes, ActiveCounter->LiveBytes);
+    }
+}
+
+void ScopedAllocationCounter::RecordFree(size_t Size)
+{
+    if (ActiveCounter != nullptr)
+    {
+        ActiveCounter->LiveBytes -= static_cast<int64_t>(Size);
+    }
+}
+
+// Replacing these is enough to observe every non-aligned allocation, as the array and nothrow forms forward to them by default.
+void* operator new(std::size_t Size)
+{
+    ScopedAllocationCounter::RecordAllocation(Size);
+
+    if (void* Block = std::malloc(Size + HeaderSize))
+    {
+        *static_cast<std::size_t*>(Block) = Size;
+        return static_cast<char*>(Block) + HeaderSize;
+    }
+
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* Ptr) noexcept
+{
+    if (Ptr == nullptr)
+    {
+        return;
+    }
+
+    void* Block = static_cast<char*>(Ptr) - HeaderSize;
+    ScopedAllocationCounter::RecordFree(*static_cast<std::size_t*>(Block));
+    std::free(Block);
+}
+
+void operator delete(void* Ptr, std::size_t) noexcept { operator delete(Ptr); }
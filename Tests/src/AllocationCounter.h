@@ -0,0 +1,50 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* Counts calls to the global operator new made on the current thread while an instance is alive, along with the peak
+ * number of bytes outstanding. Freeing memory that was allocated before the counter was created also lowers the count,
+ * and memory freed on another thread doesn't, so the peak is most meaningful for code that allocates and frees its own memory on one thread.
+ * The test executable replaces the global allocation functions (see AllocationCounter.cpp), so this
+ * sees allocations from CSP code and the standard library. Memory obtained directly through malloc,
+ * such as msgpack's buffers, is not counted.
+ */
+class ScopedAllocationCounter
+{
+public:
+    ScopedAllocationCounter();
+    ~ScopedAllocationCounter();
+
+    ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+    ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+    size_t GetCount() const { return Count; }
+    int64_t GetPeakBytes() const { return PeakBytes; }
+    void Reset();
+
+    // Called by the replaced operator new and delete.
+    static void RecordAllocation(size_t Size);
+    static void RecordFree(size_t Size);
+
+private:
+    size_t Count = 0;
+    int64_t LiveBytes = 0;
+    int64_t PeakBytes = 0;
+    ScopedAllocationCounter* Previous = nullptr;
+};
@@ -19,7 +19,9 @@
 #include "CSP/Common/Optional.h"
 #include "TestHelpers.h"
 
+#include <chrono>
 #include <gtest/gtest.h>
+#include <vector>
 
 using namespace csp::common;
 
@@ -230,3 +232,80 @@ CSP_INTERNAL_TEST(CSPEngine, CommonMapTests, MapClearTest)
 
     EXPECT_EQ(MyMap.Size(), 0);
 }
+
+// Test case to check that iterating a map visits every element in key order, and can modify values
+CSP_INTERNAL_TEST(CSPEngine, CommonMapTests, MapRangeForTest)
+{
+    Map<int, String> MyMap = { { 3, "Three" }, { 1, "One" }, { 2, "Two" } };
+
+    std::vector<int> VisitedKeys;
+    const Map<int, String>& ConstMap = MyMap;
+
+    for (const auto& [Key, Value] : ConstMap)
+    {
+        VisitedKeys.push_back(Key);
+    }
+
+    EXPECT_EQ(VisitedKeys, std::vector<int>({ 1, 2, 3 }));
+
+    for (auto& [Key, Value] : MyMap)
+    {
+        Value.Append("!");
+    }
+
+    EXPECT_EQ(MyMap[1], "One!");
+    EXPECT_EQ(MyMap[2], "Two!");
+    EXPECT_EQ(MyMap[3], "Three!");
+}
+
+// Compares iterating a map in place with iterating a copy of its keys, as Keys does
+// Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_INTERNAL_TEST(DISABLED_CSPEngine, CommonMapTests, MapIterationBenchmark)
+{
+    constexpr int Iterations = 100000;
+
+    Map<uint32_t, int64_t> Properties;
+
+    // Component property maps usually hold fewer than 32 entries
+    for (uint32_t i = 0; i < 24; ++i)
+    {
+        Properties[i] = i;
+    }
+
+    const auto Microseconds = [](auto Duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(Duration).count()); };
+
+    int64_t KeysTotal = 0;
+    const auto KeysStart = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < Iterations; ++i)
+    {
+        const Array<uint32_t>* Keys = Properties.Keys();
+
+        for (size_t j = 0; j < Keys->Size(); ++j)
+        {
+            KeysTotal += Properties[(*Keys)[j]];
+        }
+
+        delete Keys;
+    }
+
+    const auto KeysTime = std::chrono::steady_clock::now() - KeysStart;
+
+    int64_t RangeForTotal = 0;
+    const auto RangeForStart = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < Iterations; ++i)
+    {
+        for (const auto& [Key, Value] : Properties)
+        {
+            RangeForTotal += Value;
+        }
+    }
+
+    const auto RangeForTime = std::chrono::steady_clock::now() - RangeForStart;
+
+    EXPECT_EQ(KeysTotal, RangeForTotal);
+
+    RecordProperty("KeysMicroseconds", Microseconds(KeysTime));
+    RecordProperty("RangeForMicroseconds", Microseconds(RangeForTime));
+}
@@ -19,6 +19,7 @@
 
 #include "TestHelpers.h"
 
+#include <chrono>
 #include <gtest/gtest.h>
 
 using namespace csp::common;
@@ -523,3 +524,152 @@ CSP_INTERNAL_TEST(CSPEngine, CommonStringTests, StringSubStringInvalidLengthTest
 
     EXPECT_EQ(Instance.SubString(Offset, Length), "you can and you're halfway there.");
 }
+
+CSP_INTERNAL_TEST(CSPEngine, CommonStringTests, StringSizeIsPointerSizeTest) { EXPECT_EQ(sizeof(String), sizeof(void*)); }
+
+CSP_INTERNAL_TEST(CSPEngine, CommonStringTests, StringLongCopySharesBufferTest)
+{
+    String Instance = "A string that is long enough to be shared";
+    String Copy = Instance;
+
+    // Long strings share their buffer until one of them is modified
+    EXPECT_EQ(Copy.c_str(), Instance.c_str());
+
+    Copy.Append("!");
+
+    EXPECT_NE(Copy.c_str(), Instance.c_str());
+    EXPECT_EQ(Instance, "A string that is long enough to be shared");
+    EXPECT_EQ(Copy, "A string that is long enough to be shared!");
+
+    String LowerCopy = Instance;
+    EXPECT_EQ(Instance.ToLower(), "a string that is long enough to be shared");
+    EXPECT_EQ(LowerCopy, Instance);
+
+    LowerCopy.Data()[0] = 'B';
+    EXPECT_EQ(LowerCopy, "B string that is long enough to be shared");
+    EXPECT_EQ(Instance, "A string that is long enough to be shared");
+}
+
+CSP_INTERNAL_TEST(CSPEngine, CommonStringTests, StringDataIsNotSharedWithLaterCopiesTest)
+{
+    String Instance = "A string that is long enough to be shared";
+    char* Buffer = Instance.Data();
+
+    // Once a writable pointer has been handed out, copies get a buffer of their own, so writes through it only affect this string
+    String Copy = Instance;
+    EXPECT_NE(Copy.c_str(), Instance.c_str());
+
+    Buffer[0] = 'B';
+
+    EXPECT_EQ(Instance, "B string that is long enough to be shared");
+    EXPECT_EQ(Copy, "A string that is long enough to be shared");
+}
+
+CSP_INTERNAL_TEST(CSPEngine, CommonStringTests, StringEmptyDataIsWritableTest)
+{
+    String Instance;
+    Instance.Data()[0] = '\0';
+
+    EXPECT_TRUE(Instance.IsEmpty());
+    EXPECT_EQ(Instance, "");
+}
+
+CSP_INTERNAL_TEST(CSPEngine, CommonStringTests, StringMoveLeavesEmptyTest)
+{
+    String Instance = "A string";
+    const char* Buffer = Instance.c_str();
+
+    String Moved = std::move(Instance);
+
+    EXPECT_EQ(Moved.c_str(), Buffer);
+    EXPECT_TRUE(Instance.IsEmpty());
+    EXPECT_EQ(Instance, "");
+}
+
+CSP_INTERNAL_TEST(CSPEngine, CommonStringTests, StringSelfAppendTest)
+{
+    String Short = "abc";
+    Short.Append(Short);
+    EXPECT_EQ(Short, "abcabc");
+
+    String Long = "A string that is long enough to be shared";
+    String Copy = Long;
+    Long.Append(Long.c_str() + 2);
+    EXPECT_EQ(Long, "A string that is long enough to be sharedstring that is long enough to be shared");
+    EXPECT_EQ(Copy, "A string that is long enough to be shared");
+}
+
+CSP_INTERNAL_TEST(CSPEngine, CommonStringTests, StringRepeatedAppendTest)
+{
+    String Instance;
+    std::string Expected;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        const std::string Part = std::to_string(i) + ",";
+        Instance.Append(Part.c_str());
+        Expected += Part;
+    }
+
+    EXPECT_EQ(Instance.Length(), Expected.size());
+    EXPECT_EQ(Instance, Expected.c_str());
+}
+
+// Measures constructing, copying and appending short and long strings.
+// Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_INTERNAL_TEST(DISABLED_CSPEngine, CommonStringTests, StringBenchmark)
+{
+    constexpr int Iterations = 100000;
+
+    const char* ShortText = "EntityName";
+    const char* LongText = "A component property value that is a good deal longer than an entity name";
+
+    const auto Microseconds = [](auto Duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(Duration).count()); };
+
+    size_t TotalLength = 0;
+
+    for (const char* Text : { ShortText, LongText })
+    {
+        const auto ConstructStart = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < Iterations; ++i)
+        {
+            String Instance(Text);
+            TotalLength += Instance.Length();
+        }
+
+        const auto ConstructTime = std::chrono::steady_clock::now() - ConstructStart;
+
+        const String Source(Text);
+        const auto CopyStart = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < Iterations; ++i)
+        {
+            String Copy = Source;
+            TotalLength += Copy.Length();
+        }
+
+        const auto CopyTime = std::chrono::steady_clock::now() - CopyStart;
+
+        const std::string Characters = std::to_string(strlen(Text));
+
+        RecordProperty("Construct" + Characters + "CharactersMicroseconds", Microseconds(ConstructTime));
+        RecordProperty("Copy" + Characters + "CharactersMicroseconds", Microseconds(CopyTime));
+    }
+
+    const auto ConcatenateStart = std::chrono::steady_clock::now();
+
+    String Concatenated;
+
+    for (int i = 0; i < Iterations; ++i)
+    {
+        Concatenated += ShortText;
+    }
+
+    const auto ConcatenateTime = std::chrono::steady_clock::now() - ConcatenateStart;
+
+    EXPECT_EQ(Concatenated.Length(), strlen(ShortText) * Iterations);
+    EXPECT_GT(TotalLength, 0);
+
+    RecordProperty("AppendMicroseconds", Microseconds(ConcatenateTime));
+}
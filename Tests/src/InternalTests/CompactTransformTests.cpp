@@ -0,0 +1,176 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Multiplayer/CompactTransform.h"
+#include "Multiplayer/MCS/MCSMessagePack.h"
+#include "Multiplayer/MCS/MCSTypes.h"
+#include "Multiplayer/MCSComponentPacker.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace csp::multiplayer;
+
+namespace
+{
+
+// Largest difference between the components of a rotation and its decoded unit quaternion, allowing for q and -q being the same rotation.
+double RotationError(const csp::common::Vector4& Rotation, const csp::common::Vector4& Decoded)
+{
+    const double Length = std::sqrt(static_cast<double>(Rotation.X) * Rotation.X + static_cast<double>(Rotation.Y) * Rotation.Y
+        + static_cast<double>(Rotation.Z) * Rotation.Z + static_cast<double>(Rotation.W) * Rotation.W);
+    const double Dot = Rotation.X * Decoded.X + Rotation.Y * Decoded.Y + Rotation.Z * Decoded.Z + Rotation.W * Decoded.W;
+    const double Sign = Dot < 0.0 ? -1.0 : 1.0;
+
+    return std::max({ std::abs(Rotation.X / Length - Sign * Decoded.X), std::abs(Rotation.Y / Length - Sign * Decoded.Y),
+        std::abs(Rotation.Z / Length - Sign * Decoded.Z), std::abs(Rotation.W / Length - Sign * Decoded.W) });
+}
+
+}
+
+// Test positions near the origin round trip to within half a millimetre, and far positions to within half of the coarser step.
+CSP_INTERNAL_TEST(CSPEngine, CompactTransformTests, PositionRoundTripTest)
+{
+    std::mt19937 Random { 1234 };
+    std::uniform_real_distribution<float> Near { -500.0f, 500.0f };
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const csp::common::Vector3 Position { Near(Random), Near(Random), Near(Random) };
+
+        uint64_t Encoded = 0;
+        ASSERT_TRUE(CompactTransform::TryEncodePosition(Position, Encoded));
+
+        const csp::common::Vector3 Decoded = CompactTransform::DecodePosition(Encoded);
+
+        EXPECT_NEAR(Decoded.X, Position.X, 0.00051f);
+        EXPECT_NEAR(Decoded.Y, Position.Y, 0.00051f);
+        EXPECT_NEAR(Decoded.Z, Position.Z, 0.00051f);
+    }
+
+    {
+        const csp::common::Vector3 Position { 10000.0f, -20000.0f, 123.456f };
+
+        uint64_t Encoded = 0;
+        ASSERT_TRUE(CompactTransform::TryEncodePosition(Position, Encoded));
+
+        const csp::common::Vector3 Decoded = CompactTransform::DecodePosition(Encoded);
+
+        EXPECT_NEAR(Decoded.X, Position.X, 0.033f);
+        EXPECT_NEAR(Decoded.Y, Position.Y, 0.033f);
+        EXPECT_NEAR(Decoded.Z, Position.Z, 0.033f);
+    }
+
+    uint64_t Encoded = 0;
+    EXPECT_FALSE(CompactTransform::TryEncodePosition({ 100000.0f, 0.0f, 0.0f }, Encoded));
+    EXPECT_FALSE(CompactTransform::TryEncodePosition({ NAN, 0.0f, 0.0f }, Encoded));
+}
+
+// Test rotations round trip to within a few millionths per component, including the sign flip of the dropped component.
+CSP_INTERNAL_TEST(CSPEngine, CompactTransformTests, RotationRoundTripTest)
+{
+    std::mt19937 Random { 5678 };
+    std::normal_distribution<float> Normal;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const csp::common::Vector4 Rotation { Normal(Random), Normal(Random), Normal(Random), Normal(Random) };
+
+        uint64_t Encoded = 0;
+        ASSERT_TRUE(CompactTransform::TryEncodeRotation(Rotation, Encoded));
+
+        const csp::common::Vector4 Decoded = CompactTransform::DecodeRotation(Encoded);
+
+        EXPECT_LT(RotationError(Rotation, Decoded), 5e-6);
+    }
+
+    const csp::common::Vector4 Identity = CompactTransform::DecodeRotation([] {
+        uint64_t Encoded = 0;
+        CompactTransform::TryEncodeRotation(csp::common::Vector4::Identity(), Encoded);
+        return Encoded;
+    }());
+
+    EXPECT_NEAR(Identity.W, 1.0f, 1e-6f);
+
+    uint64_t Encoded = 0;
+    EXPECT_FALSE(CompactTransform::TryEncodeRotation(csp::common::Vector4::Zero(), Encoded));
+}
+
+// Test the compact values are read back through the unpacker, and that values the encoding can't hold fall back to floats.
+CSP_INTERNAL_TEST(CSPEngine, CompactTransformTests, PackerRoundTripTest)
+{
+    const csp::common::Vector3 Position { 1.5f, -2.25f, 3.0f };
+    const csp::common::Vector3 UniformScale { 2.0f, 2.0f, 2.0f };
+    const csp::common::Vector3 FarPosition { 1e6f, 0.0f, 0.0f };
+
+    MCSComponentPacker Packer;
+    CompactTransform::WriteValue(Packer, SpaceEntityComponentKey::Position, csp::common::ReplicatedValue { Position });
+    CompactTransform::WriteValue(Packer, SpaceEntityComponentKey::Scale, csp::common::ReplicatedValue { UniformScale });
+
+    const mcs::ComponentMap& Components = Packer.GetComponents();
+    EXPECT_EQ(Components.at(static_cast<uint16_t>(SpaceEntityComponentKey::Position)).GetType(), mcs::ItemComponentDataType::UINT64);
+    EXPECT_EQ(Components.at(static_cast<uint16_t>(SpaceEntityComponentKey::Scale)).GetType(), mcs::ItemComponentDataType::FLOAT);
+
+    MCSComponentUnpacker Unpacker { Components };
+    csp::common::ReplicatedValue Value;
+
+    ASSERT_TRUE(Unpacker.TryReadValue(static_cast<uint16_t>(SpaceEntityComponentKey::Position), Value));
+    EXPECT_EQ(Value.GetVector3(), Position);
+
+    ASSERT_TRUE(Unpacker.TryReadValue(static_cast<uint16_t>(SpaceEntityComponentKey::Scale), Value));
+    EXPECT_EQ(Value.GetVector3(), UniformScale);
+
+    MCSComponentPacker FallbackPacker;
+    CompactTransform::WriteValue(FallbackPacker, SpaceEntityComponentKey::Position, csp::common::ReplicatedValue { FarPosition });
+
+    MCSComponentUnpacker FallbackUnpacker { FallbackPacker.GetComponents() };
+    ASSERT_TRUE(FallbackUnpacker.TryReadValue(static_cast<uint16_t>(SpaceEntityComponentKey::Position), Value));
+    EXPECT_EQ(Value.GetVector3(), FarPosition);
+}
+
+// Measures the encoded size of a patch that moves and rotates an entity, with and without the compact encoding.
+// Disabled by default, as it only reports sizes. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_INTERNAL_TEST(DISABLED_CSPEngine, CompactTransformTests, TransformPatchSizeBenchmark)
+{
+    const csp::common::Vector3 Position { 12.345f, 1.8f, -67.89f };
+    const csp::common::Vector4 Rotation { 0.0f, 0.3826834f, 0.0f, 0.9238795f };
+
+    MCSComponentPacker FullPacker;
+    FullPacker.WriteValue(SpaceEntityComponentKey::Position, csp::common::ReplicatedValue { Position });
+    FullPacker.WriteValue(SpaceEntityComponentKey::Rotation, csp::common::ReplicatedValue { Rotation });
+
+    MCSComponentPacker CompactPacker;
+    CompactTransform::WriteValue(CompactPacker, SpaceEntityComponentKey::Position, csp::common::ReplicatedValue { Position });
+    CompactTransform::WriteValue(CompactPacker, SpaceEntityComponentKey::Rotation, csp::common::ReplicatedValue { Rotation });
+
+    mcs::MessagePackWriter Writer;
+
+    Writer.Write(mcs::ObjectPatch { 1234567, 42, false, false, std::nullopt, FullPacker.TakeComponents() });
+    const size_t FullSize = Writer.GetSize();
+
+    Writer.Reset();
+    Writer.Write(mcs::ObjectPatch { 1234567, 42, false, false, std::nullopt, CompactPacker.TakeComponents() });
+    const size_t CompactSize = Writer.GetSize();
+
+    RecordProperty("FullBytes", static_cast<int>(FullSize));
+    RecordProperty("CompactBytes", static_cast<int>(CompactSize));
+
+    EXPECT_LT(CompactSize * 3, FullSize * 2);
+}
@@ -15,10 +15,17 @@
  */
 
 #include "CSP/CSPFoundation.h"
+#include "Common/MPSCQueue.h"
+#include "Common/Queue.h"
 #include "Events/EventSystem.h"
 #include "TestHelpers.h"
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 using namespace csp::events;
 
@@ -126,3 +133,270 @@ CSP_INTERNAL_TEST(CSPEngine, EventTests, EventSystemTest)
     OlyEvents.UnRegisterListener(kTestEventId, &TestHandler);
     OlyEvents.UnRegisterListener(kTestEventId, &AllHandler);
 }
+
+namespace
+{
+
+constexpr uint64_t ProducerShift = 32;
+
+class CountingEventHandler : public EventListener
+{
+public:
+    virtual void OnEvent(const Event& InEvent) override
+    {
+        // Every event is allocated with a fresh payload, so nothing should be left from the event it was pooled from
+        EXPECT_EQ(InEvent.GetString("Stale"), nullptr);
+
+        ++Count;
+    }
+
+    int Count = 0;
+};
+
+} // namespace
+
+CSP_INTERNAL_TEST(CSPEngine, EventTests, MPSCQueueProducerOrderTest)
+{
+    constexpr uint64_t ProducerCount = 8;
+    constexpr uint64_t ValuesPerProducer = 20000;
+
+    // A small ring, so values regularly overflow while the consumer is running
+    csp::MPSCQueue<uint64_t> Queue(16);
+
+    std::atomic<bool> Start { false };
+    std::vector<std::thread> Producers;
+
+    for (uint64_t Producer = 0; Producer < ProducerCount; ++Producer)
+    {
+        Producers.emplace_back(
+            [&Queue, &Start, Producer]()
+            {
+                while (!Start)
+                {
+                    std::this_thread::yield();
+                }
+
+                for (uint64_t i = 0; i < ValuesPerProducer; ++i)
+                {
+                    Queue.Enqueue((Producer << ProducerShift) | i);
+                }
+            });
+    }
+
+    Start = true;
+
+    std::vector<uint64_t> NextExpected(ProducerCount, 0);
+    uint64_t Received = 0;
+    uint64_t Value = 0;
+
+    while (Received < ProducerCount * ValuesPerProducer)
+    {
+        if (!Queue.TryDequeue(Value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint64_t Producer = Value >> ProducerShift;
+        ASSERT_LT(Producer, ProducerCount);
+        ASSERT_EQ(Value & ((1ull << ProducerShift) - 1), NextExpected[Producer]);
+
+        ++NextExpected[Producer];
+        ++Received;
+    }
+
+    for (auto& Producer : Producers)
+    {
+        Producer.join();
+    }
+
+    EXPECT_TRUE(Queue.IsEmpty());
+    EXPECT_FALSE(Queue.TryDequeue(Value));
+}
+
+CSP_INTERNAL_TEST(CSPEngine, EventTests, PooledEventReuseTest)
+{
+    EventSystem& OlyEvents = EventSystem::Get();
+
+    CountingEventHandler Handler;
+    OlyEvents.RegisterListener(kTestEventId, &Handler);
+
+    Event* FirstEvent = OlyEvents.AllocateEvent(USERSERVICE_LOGIN_EVENT_ID);
+    FirstEvent->AddString("Stale", "Value");
+    OlyEvents.EnqueueEvent(FirstEvent);
+    OlyEvents.ProcessEvents();
+
+    // The processed event is back in the pool, so subsequent events reuse it
+    for (int i = 0; i < 100; ++i)
+    {
+        Event* TestEvent = OlyEvents.AllocateEvent(kTestEventId);
+        TestEvent->AddInt("Index", i);
+        OlyEvents.EnqueueEvent(TestEvent);
+    }
+
+    OlyEvents.ProcessEvents();
+
+    EXPECT_EQ(Handler.Count, 100);
+
+    OlyEvents.UnRegisterListener(kTestEventId, &Handler);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, EventTests, EventPayloadTest)
+{
+    Event* TestEvent = EventSystem::Get().AllocateEvent(kTestEventId);
+
+    // The first value added for a key is kept
+    TestEvent->AddInt("Int", 1);
+    TestEvent->AddInt("Int", 2);
+    TestEvent->AddString("AKeyTooLongForTheSmallStringBuffer", "Value");
+    TestEvent->AddFloat("Float", 3.14f);
+    TestEvent->AddBool("Bool", true);
+
+    EXPECT_EQ(TestEvent->GetInt("Int"), 1);
+    EXPECT_STREQ(TestEvent->GetString("AKeyTooLongForTheSmallStringBuffer"), "Value");
+    EXPECT_EQ(TestEvent->GetFloat("Float"), 3.14f);
+    EXPECT_TRUE(TestEvent->GetBool("Bool"));
+    EXPECT_EQ(TestEvent->GetInt("Missing"), 0);
+
+    delete (TestEvent);
+}
+
+namespace
+{
+
+struct ContentionResult
+{
+    double AverageEnqueueNs = 0.0;
+    double MaxEnqueueUs = 0.0;
+    double DrainMs = 0.0;
+};
+
+// Producers push as fast as they can while the consumer drains once per simulated tick, as CSPFoundation::Tick does
+template <typename EnqueueFunction, typename DrainFunction>
+ContentionResult RunContention(int ProducerCount, int ValuesPerProducer, EnqueueFunction Enqueue, DrainFunction Drain)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<int> Finished { 0 };
+    std::atomic<bool> Start { false };
+    std::vector<double> TotalNs(ProducerCount, 0.0);
+    std::vector<double> MaxNs(ProducerCount, 0.0);
+    std::vector<std::thread> Producers;
+
+    for (int Producer = 0; Producer < ProducerCount; ++Producer)
+    {
+        Producers.emplace_back(
+            [&, Producer]()
+            {
+                while (!Start)
+                {
+                    std::this_thread::yield();
+                }
+
+                for (int i = 0; i < ValuesPerProducer; ++i)
+                {
+                    const auto Before = Clock::now();
+                    Enqueue(i);
+                    const double Ns = std::chrono::duration<double, std::nano>(Clock::now() - Before).count();
+
+                    TotalNs[Producer] += Ns;
+                    MaxNs[Producer] = std::max(MaxNs[Producer], Ns);
+                }
+
+                ++Finished;
+            });
+    }
+
+    Start = true;
+
+    const int Expected = ProducerCount * ValuesPerProducer;
+    int Drained = 0;
+    double DrainMs = 0.0;
+
+    while (Drained < Expected)
+    {
+        const auto Before = Clock::now();
+        Drained += Drain();
+        DrainMs += std::chrono::duration<double, std::milli>(Clock::now() - Before).count();
+
+        if (Finished < ProducerCount)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    for (auto& Producer : Producers)
+    {
+        Producer.join();
+    }
+
+    ContentionResult Result;
+
+    for (int Producer = 0; Producer < ProducerCount; ++Producer)
+    {
+        Result.AverageEnqueueNs += TotalNs[Producer];
+        Result.MaxEnqueueUs = std::max(Result.MaxEnqueueUs, MaxNs[Producer] / 1000.0);
+    }
+
+    Result.AverageEnqueueNs /= Expected;
+    Result.DrainMs = DrainMs;
+
+    return Result;
+}
+
+} // namespace
+
+// Compares enqueue latency and tick drain time of the mutex and lock-free event queues, with several producer threads.
+// Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_INTERNAL_TEST(DISABLED_CSPEngine, EventTests, EventQueueContentionBenchmark)
+{
+    constexpr int ProducerCount = 8;
+    constexpr int ValuesPerProducer = 100000;
+
+    csp::Queue<const Event*> LockedQueue;
+    Event* const Payload = EventSystem::Get().AllocateEvent(kTestEventId);
+
+    const ContentionResult Locked = RunContention(
+        ProducerCount, ValuesPerProducer, [&](int) { LockedQueue.Enqueue(Payload); },
+        [&]()
+        {
+            // The drain loop ProcessEvents used before
+            int Count = 0;
+
+            while (LockedQueue.IsEmpty() == false)
+            {
+                LockedQueue.Dequeue();
+                ++Count;
+            }
+
+            return Count;
+        });
+
+    csp::MPSCQueue<const Event*> LockFreeQueue(4096);
+
+    const ContentionResult LockFree = RunContention(
+        ProducerCount, ValuesPerProducer, [&](int) { LockFreeQueue.Enqueue(Payload); },
+        [&]()
+        {
+            int Count = 0;
+            const Event* Next = nullptr;
+
+            while (LockFreeQueue.TryDequeue(Next))
+            {
+                ++Count;
+            }
+
+            return Count;
+        });
+
+    RecordProperty("MutexEnqueueAverageNanoseconds", static_cast<int>(Locked.AverageEnqueueNs));
+    RecordProperty("MutexEnqueueMaxMicroseconds", static_cast<int>(Locked.MaxEnqueueUs));
+    RecordProperty("MutexDrainMicroseconds", static_cast<int>(Locked.DrainMs * 1000.0));
+    RecordProperty("LockFreeEnqueueAverageNanoseconds", static_cast<int>(LockFree.AverageEnqueueNs));
+    RecordProperty("LockFreeEnqueueMaxMicroseconds", static_cast<int>(LockFree.MaxEnqueueUs));
+    RecordProperty("LockFreeDrainMicroseconds", static_cast<int>(LockFree.DrainMs * 1000.0));
+
+    // Hand the event back so it is recycled
+    EventSystem::Get().EnqueueEvent(Payload);
+    EventSystem::Get().ProcessEvents();
+}
@@ -0,0 +1,343 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AllocationCounter.h"
+#include "Multiplayer/MCS/MCSMessagePack.h"
+#include "Multiplayer/MCS/MCSTypes.h"
+#include "Multiplayer/SignalRSerializer.h"
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace csp::multiplayer;
+
+namespace
+{
+
+mcs::ObjectPatch CreateTestPatch(uint64_t Id)
+{
+    const mcs::ComponentMap ComponentProperties
+        = { { 0, mcs::ItemComponentData { true } }, { 1, mcs::ItemComponentData { 1.5f } }, { 2, mcs::ItemComponentData { std::string { "Test" } } },
+              { 3, mcs::ItemComponentData { mcs::FloatArray { 1.0f, 2.0f, 3.0f, 4.0f } } }, { 4, mcs::ItemComponentData { int64_t { -5 } } },
+              { 5, mcs::ItemComponentData { uint64_t { 6 } } } };
+
+    mcs::ComponentMap Components;
+    Components[1] = mcs::ItemComponentData { mcs::FloatArray { 1.0f, 2.0f, 3.0f } };
+    Components[2] = mcs::ItemComponentData { mcs::FloatArray { 0.0f, 0.0f, 0.0f, 1.0f } };
+    Components[3] = mcs::ItemComponentData { mcs::FloatArray { 1.0f, 1.0f, 1.0f } };
+    Components[4] = mcs::ItemComponentData { 2.5 };
+    Components[5] = mcs::ItemComponentData { mcs::StringComponentMap { { "Key", mcs::ItemComponentData { false } } } };
+    Components[100] = mcs::ItemComponentData { ComponentProperties };
+
+    return mcs::ObjectPatch { Id, 2, false, true, 3, Components };
+}
+
+// Checks a decoded MessagePack object against the value tree SignalRSerializer builds, using the same type mapping as the hub protocol.
+bool MatchesSignalRValue(const msgpack::object& Object, const signalr::value& Value)
+{
+    switch (Object.type)
+    {
+    case msgpack::type::NIL:
+        return Value.is_null();
+    case msgpack::type::BOOLEAN:
+        return Value.is_bool() && Value.as_bool() == Object.via.boolean;
+    case msgpack::type::POSITIVE_INTEGER:
+        return Value.is_uinteger() && Value.as_uinteger() == Object.via.u64;
+    case msgpack::type::NEGATIVE_INTEGER:
+        return Value.is_integer() && Value.as_integer() == Object.via.i64;
+    case msgpack::type::FLOAT64:
+        return Value.is_double() && Value.as_double() == Object.via.f64;
+    case msgpack::type::STR:
+        return Value.is_string() && Value.as_string() == std::string(Object.via.str.ptr, Object.via.str.size);
+    case msgpack::type::ARRAY:
+    {
+        if (Value.is_array() == false || Value.as_array().size() != Object.via.array.size)
+        {
+            return false;
+        }
+
+        for (uint32_t i = 0; i < Object.via.array.size; ++i)
+        {
+            if (MatchesSignalRValue(Object.via.array.ptr[i], Value.as_array()[i]) == false)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+    case msgpack::type::MAP:
+    {
+        if (Value.is_uint_map())
+        {
+            auto It = Value.as_uint_map().begin();
+
+            for (uint32_t i = 0; i < Object.via.map.size; ++i, ++It)
+            {
+                const msgpack::object_kv& Pair = Object.via.map.ptr[i];
+
+                if (It == Value.as_uint_map().end() || Pair.key.via.u64 != It->first || MatchesSignalRValue(Pair.val, It->second) == false)
+                {
+                    return false;
+                }
+            }
+
+            return It == Value.as_uint_map().end();
+        }
+
+        if (Value.is_string_map())
+        {
+            auto It = Value.as_string_map().begin();
+
+            for (uint32_t i = 0; i < Object.via.map.size; ++i, ++It)
+            {
+                const msgpack::object_kv& Pair = Object.via.map.ptr[i];
+
+                if (It == Value.as_string_map().end() || Pair.key.as<std::string>() != It->first
+                    || MatchesSignalRValue(Pair.val, It->second) == false)
+                {
+                    return false;
+                }
+            }
+
+            return It == Value.as_string_map().end();
+        }
+
+        return false;
+    }
+    default:
+        return false;
+    }
+}
+
+}
+
+CSP_INTERNAL_TEST(CSPEngine, MCSMessagePackTests, ObjectPatchRoundTripTest)
+{
+    const mcs::ObjectPatch Patch = CreateTestPatch(1);
+
+    mcs::MessagePackWriter Writer;
+    Writer.Write(Patch);
+
+    mcs::MessagePackReader Reader;
+    mcs::ObjectPatch DecodedPatch;
+    Reader.Read(Writer.GetData(), Writer.GetSize(), DecodedPatch);
+
+    EXPECT_EQ(DecodedPatch, Patch);
+}
+
+// Incoming patches reach the realtime engine as signalr values that still hold their encoding, which it decodes with the reader.
+CSP_INTERNAL_TEST(CSPEngine, MCSMessagePackTests, EncodedSignalRValueRoundTripTest)
+{
+    const mcs::ObjectPatch Patch = CreateTestPatch(1);
+
+    mcs::MessagePackWriter Writer;
+    Writer.Write(Patch);
+
+    const signalr::value Encoded = Writer.ToSignalRValue();
+    ASSERT_TRUE(Encoded.is_messagepack());
+
+    const std::string& EncodedData = Encoded.as_messagepack();
+
+    mcs::MessagePackReader Reader;
+    mcs::ObjectPatch DecodedPatch;
+    Reader.Read(EncodedData.data(), EncodedData.size(), DecodedPatch);
+
+    EXPECT_EQ(DecodedPatch, Patch);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, MCSMessagePackTests, ObjectMessageRoundTripTest)
+{
+    const mcs::ObjectPatch Patch = CreateTestPatch(1);
+    const mcs::ObjectMessage Message { 1, 2, true, false, 3, std::nullopt, Patch.GetComponents() };
+
+    mcs::MessagePackWriter Writer;
+    Writer.Write(Message);
+
+    mcs::MessagePackReader Reader;
+    mcs::ObjectMessage DecodedMessage;
+    Reader.Read(Writer.GetData(), Writer.GetSize(), DecodedMessage);
+
+    EXPECT_EQ(DecodedMessage, Message);
+}
+
+// The writer must produce exactly what the hub protocol would write for the SignalRSerializer output, as that is what MCS expects.
+CSP_INTERNAL_TEST(CSPEngine, MCSMessagePackTests, WriterMatchesSignalRSerializerTest)
+{
+    const std::vector<mcs::ObjectPatch> Patches { CreateTestPatch(1), CreateTestPatch(2) };
+    const mcs::ObjectMessage Message { 1, 2, true, false, 3, 4, Patches[0].GetComponents() };
+
+    {
+        SignalRSerializer Serializer;
+        Serializer.WriteValue(Patches);
+
+        mcs::MessagePackWriter Writer;
+        Writer.WriteArrayHeader(static_cast<uint32_t>(Patches.size()));
+
+        for (const auto& Patch : Patches)
+        {
+            Writer.Write(Patch);
+        }
+
+        const msgpack::object_handle Handle = msgpack::unpack(Writer.GetData(), Writer.GetSize());
+        EXPECT_TRUE(MatchesSignalRValue(Handle.get(), Serializer.Get()));
+    }
+
+    {
+        SignalRSerializer Serializer;
+        Serializer.WriteValue(Message);
+
+        mcs::MessagePackWriter Writer;
+        Writer.Write(Message);
+
+        const msgpack::object_handle Handle = msgpack::unpack(Writer.GetData(), Writer.GetSize());
+        EXPECT_TRUE(MatchesSignalRValue(Handle.get(), Serializer.Get()));
+    }
+}
+
+// MCS sends null for empty dictionaries and parent updates, and may send signed integers as unsigned.
+CSP_INTERNAL_TEST(CSPEngine, MCSMessagePackTests, ReaderHandlesMCSRepresentationsTest)
+{
+    msgpack::sbuffer Buffer;
+    msgpack::packer<msgpack::sbuffer> Packer { Buffer };
+
+    Packer.pack_array(5);
+    Packer.pack_uint64(1);
+    Packer.pack_uint64(2);
+    Packer.pack_false();
+    Packer.pack_nil();
+    Packer.pack_map(2);
+    {
+        Packer.pack_uint64(0);
+        Packer.pack_array(2);
+        Packer.pack_uint64(static_cast<uint64_t>(mcs::ItemComponentDataType::INT64));
+        Packer.pack_array(1);
+        Packer.pack_uint64(7);
+
+        Packer.pack_uint64(1);
+        Packer.pack_array(2);
+        Packer.pack_uint64(static_cast<uint64_t>(mcs::ItemComponentDataType::UINT16_DICTIONARY));
+        Packer.pack_array(1);
+        Packer.pack_nil();
+    }
+
+    mcs::MessagePackReader Reader;
+    mcs::ObjectPatch Patch;
+    Reader.Read(Buffer.data(), Buffer.size(), Patch);
+
+    EXPECT_EQ(Patch.GetId(), 1);
+    EXPECT_EQ(Patch.GetOwnerId(), 2);
+    EXPECT_FALSE(Patch.GetShouldUpdateParent());
+    EXPECT_EQ(Patch.GetParentId(), std::nullopt);
+    ASSERT_TRUE(Patch.GetComponents().has_value());
+    EXPECT_EQ(Patch.GetComponents()->at(0), mcs::ItemComponentData(uint64_t(7)));
+    const mcs::ItemComponentData EmptyMap { mcs::ComponentMap {} };
+    EXPECT_EQ(Patch.GetComponents()->at(1), EmptyMap);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, MCSMessagePackTests, ReaderThrowsOnInvalidDataTest)
+{
+    mcs::MessagePackWriter Writer;
+    Writer.Write(mcs::ItemComponentData { true });
+
+    mcs::MessagePackReader Reader;
+    mcs::ObjectPatch Patch;
+
+    EXPECT_THROW(Reader.Read(Writer.GetData(), Writer.GetSize(), Patch), std::runtime_error);
+    EXPECT_THROW(Reader.Read(Writer.GetData(), Writer.GetSize() - 1, Patch), std::runtime_error);
+}
+
+// Compares allocations and time per patch when encoding a batch of patches through a signalr value tree, and straight to MessagePack.
+// Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_INTERNAL_TEST(DISABLED_CSPEngine, MCSMessagePackTests, PatchEncodingAllocationBenchmark)
+{
+    constexpr size_t PatchCount = 1000;
+
+    std::vector<mcs::ObjectPatch> Patches;
+
+    for (size_t i = 0; i < PatchCount; ++i)
+    {
+        Patches.push_back(CreateTestPatch(i + 1));
+    }
+
+    // signalr value tree, as SendPatches used to build. This excludes the hub protocol walking the tree, so is a lower bound.
+    size_t TreeAllocations = 0;
+    auto Start = std::chrono::steady_clock::now();
+    {
+        ScopedAllocationCounter Counter;
+
+        SignalRSerializer Serializer;
+        Serializer.StartWriteArray();
+        {
+            Serializer.WriteValue(Patches);
+        }
+        Serializer.EndWriteArray();
+
+        const signalr::value Arguments = Serializer.Get();
+
+        TreeAllocations = Counter.GetCount();
+    }
+    const double TreeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+    // Direct encoding, with the writer warmed up by a previous batch as it would be in SendPatches.
+    mcs::MessagePackWriter Writer;
+    Writer.WriteArrayHeader(static_cast<uint32_t>(Patches.size()));
+
+    for (const auto& Patch : Patches)
+    {
+        Writer.Write(Patch);
+    }
+
+    size_t WriterAllocations = 0;
+    Start = std::chrono::steady_clock::now();
+    {
+        ScopedAllocationCounter Counter;
+
+        Writer.Reset();
+        Writer.WriteArrayHeader(static_cast<uint32_t>(Patches.size()));
+
+        for (const auto& Patch : Patches)
+        {
+            Writer.Write(Patch);
+        }
+
+        const signalr::value Arguments { std::vector<signalr::value> { Writer.ToSignalRValue() } };
+
+        WriterAllocations = Counter.GetCount();
+    }
+    const double WriterSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+    const double TreeAllocationsPerPatch = static_cast<double>(TreeAllocations) / PatchCount;
+    const double WriterAllocationsPerPatch = static_cast<double>(WriterAllocations) / PatchCount;
+
+    RecordProperty("TreeAllocations", static_cast<int>(TreeAllocations));
+    RecordProperty("TreeNanosecondsPerPatch", static_cast<int>(TreeSeconds * 1e9 / PatchCount));
+    RecordProperty("WriterAllocations", static_cast<int>(WriterAllocations));
+    RecordProperty("WriterNanosecondsPerPatch", static_cast<int>(WriterSeconds * 1e9 / PatchCount));
+    RecordProperty("WriterBytes", static_cast<int>(Writer.GetSize()));
+
+    EXPECT_LT(WriterAllocationsPerPatch, 0.01);
+    EXPECT_GT(TreeAllocationsPerPatch, WriterAllocationsPerPatch);
+
+    // Decoding allocates for the decoded patches themselves, but not for an intermediate tree.
+    mcs::MessagePackReader Reader;
+    std::vector<mcs::ObjectPatch> DecodedPatches;
+    Reader.Read(Writer.GetData(), Writer.GetSize(), DecodedPatches);
+
+    EXPECT_EQ(DecodedPatches, Patches);
+}
@@ -14,11 +14,16 @@
  * limitations under the License.
  */
 
+#include "AllocationCounter.h"
+#include "Multiplayer/IncomingPatchCoalescer.h"
 #include "Multiplayer/MCS/MCSTypes.h"
+#include "Multiplayer/SpaceEntityKeys.h"
 #include "TestHelpers.h"
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+
 using namespace csp::multiplayer;
 
 // Test constructor values of ObjectMessage are correct.
@@ -30,7 +35,7 @@ CSP_INTERNAL_TEST(CSPEngine, MCSTests, ObjectMessageConstructorTest)
     const bool TestIsPersistent = true;
     const uint64_t TestOwnerId = 3;
     const std::optional<uint64_t> TestParentId = 4;
-    std::map<mcs::PropertyKeyType, mcs::ItemComponentData> TestComponents;
+    mcs::ComponentMap TestComponents;
     TestComponents[0] = mcs::ItemComponentData { { 0ll } };
 
     mcs::ObjectMessage Object { TestId, TestType, TestIsTransferable, TestIsPersistent, TestOwnerId, TestParentId, TestComponents };
@@ -52,7 +57,7 @@ CSP_INTERNAL_TEST(CSPEngine, MCSTests, ObjectPatchConstructorTest)
     const bool TestDestroy = false;
     const bool TestShouldUpdateParent = true;
     const std::optional<uint64_t> TestParentId = 4;
-    std::map<mcs::PropertyKeyType, mcs::ItemComponentData> TestComponents;
+    mcs::ComponentMap TestComponents;
     TestComponents[0] = mcs::ItemComponentData { { 0ll } };
 
     mcs::ObjectPatch Object { TestId, TestOwnerId, TestDestroy, TestShouldUpdateParent, TestParentId, TestComponents };
@@ -74,7 +79,7 @@ CSP_INTERNAL_TEST(CSPEngine, MCSTests, ObjectMessageSerializeTest)
     const bool TestIsPersistent = true;
     const uint64_t TestOwnerId = 3;
     const std::optional<uint64_t> TestParentId = 4;
-    std::map<mcs::PropertyKeyType, mcs::ItemComponentData> TestComponents;
+    mcs::ComponentMap TestComponents;
     TestComponents[0] = mcs::ItemComponentData { { 0ll } };
 
     mcs::ObjectMessage Object { TestId, TestType, TestIsTransferable, TestIsPersistent, TestOwnerId, TestParentId, TestComponents };
@@ -100,7 +105,7 @@ CSP_INTERNAL_TEST(CSPEngine, MCSTests, ObjectPatchSerializeTest)
     const bool TestDestroy = false;
     const bool TestShouldUpdateParent = false;
     const std::optional<uint64_t> TestParentId = 4;
-    std::map<mcs::PropertyKeyType, mcs::ItemComponentData> TestComponents;
+    mcs::ComponentMap TestComponents;
     TestComponents[0] = mcs::ItemComponentData { { 0ll } };
 
     mcs::ObjectPatch Object { TestId, TestOwnerId, TestDestroy, TestShouldUpdateParent, TestParentId, TestComponents };
@@ -234,7 +239,7 @@ CSP_INTERNAL_TEST(CSPEngine, MCSTests, ItemComponentDataSerializeStringTest)
 
 CSP_INTERNAL_TEST(CSPEngine, MCSTests, ItemComponentDataSerializeFloatVectorTest)
 {
-    const std::vector<float> TestValue = { 1.1f, 2.2f, 3.3f };
+    const mcs::FloatArray TestValue = { 1.1f, 2.2f, 3.3f };
     mcs::ItemComponentData ComponentValue { TestValue };
 
     SignalRSerializer Serializer;
@@ -252,7 +257,7 @@ CSP_INTERNAL_TEST(CSPEngine, MCSTests, ItemComponentDataSerializeFloatVectorTest
 
 CSP_INTERNAL_TEST(CSPEngine, MCSTests, ItemComponentDataSerializeStringMapTest)
 {
-    const std::map<std::string, mcs::ItemComponentData> TestValue
+    const mcs::StringComponentMap TestValue
         = { { "Key1", mcs::ItemComponentData { 1.1f } }, { "Key2", mcs::ItemComponentData { std::string { "Test" } } } };
     mcs::ItemComponentData ComponentValue { TestValue };
 
@@ -271,7 +276,7 @@ CSP_INTERNAL_TEST(CSPEngine, MCSTests, ItemComponentDataSerializeStringMapTest)
 
 CSP_INTERNAL_TEST(CSPEngine, MCSTests, ItemComponentDataSerializeUIntMapTest)
 {
-    const std::map<uint16_t, mcs::ItemComponentData> TestValue
+    const mcs::ComponentMap TestValue
         = { { 0, mcs::ItemComponentData { 1.1f } }, { 1, mcs::ItemComponentData { std::string { "Test" } } } };
     mcs::ItemComponentData ComponentValue { TestValue };
 
@@ -286,4 +291,249 @@ CSP_INTERNAL_TEST(CSPEngine, MCSTests, ItemComponentDataSerializeUIntMapTest)
     Deserializer.ReadValue(DeserializedValue);
 
     EXPECT_EQ(DeserializedValue, ComponentValue);
-}
\ No newline at end of file
+}
+
+CSP_INTERNAL_TEST(CSPEngine, MCSTests, FlatMapKeepsKeysOrderedTest)
+{
+    // Duplicate keys keep the first value, as with std::map.
+    mcs::FlatMap<uint16_t, int> Map { { 5, 1 }, { 2, 2 }, { 5, 3 } };
+
+    EXPECT_EQ(Map.size(), 2);
+    EXPECT_EQ(Map.at(5), 1);
+
+    Map[3] = 4;
+    Map[10] = 5;
+    Map.insert_or_assign(2, 6);
+    Map.erase(5);
+
+    const std::vector<std::pair<uint16_t, int>> Expected { { 2, 6 }, { 3, 4 }, { 10, 5 } };
+    EXPECT_TRUE(std::equal(Map.begin(), Map.end(), Expected.begin(), Expected.end()));
+
+    EXPECT_EQ(Map.find(5), Map.end());
+    EXPECT_EQ(Map.count(3), 1);
+    EXPECT_THROW(Map.at(5), std::out_of_range);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, MCSTests, FloatArrayResizeTest)
+{
+    mcs::FloatArray Array { 1.0f, 2.0f, 3.0f };
+
+    // Grow past the inline capacity, moving to heap storage.
+    Array.resize(6);
+    EXPECT_EQ(Array, (mcs::FloatArray { 1.0f, 2.0f, 3.0f, 0.0f, 0.0f, 0.0f }));
+
+    // Shrink back to inline storage.
+    Array.resize(2);
+    EXPECT_EQ(Array, (mcs::FloatArray { 1.0f, 2.0f }));
+
+    Array.resize(4);
+    EXPECT_EQ(Array, (mcs::FloatArray { 1.0f, 2.0f, 0.0f, 0.0f }));
+    EXPECT_EQ(Array.ToVector(), (std::vector<float> { 1.0f, 2.0f, 0.0f, 0.0f }));
+}
+
+namespace
+{
+
+// Builds an object message shaped like a typical entity: transform, name and properties, with a handful of populated components.
+mcs::ObjectMessage CreateEntityObjectMessage(uint64_t Id)
+{
+    mcs::ComponentMap Components;
+
+    for (uint16_t ComponentKey = 0; ComponentKey < 4; ++ComponentKey)
+    {
+        mcs::ComponentMap Properties;
+        Properties[0] = mcs::ItemComponentData { uint64_t { 1 } };
+
+        for (uint16_t PropertyKey = 1; PropertyKey <= 12; ++PropertyKey)
+        {
+            switch (PropertyKey % 4)
+            {
+            case 0:
+                Properties[PropertyKey] = mcs::ItemComponentData { mcs::FloatArray { 1.0f, 2.0f, 3.0f } };
+                break;
+            case 1:
+                Properties[PropertyKey] = mcs::ItemComponentData { 0.5f };
+                break;
+            case 2:
+                Properties[PropertyKey] = mcs::ItemComponentData { true };
+                break;
+            default:
+                Properties[PropertyKey] = mcs::ItemComponentData { int64_t { PropertyKey } };
+                break;
+            }
+        }
+
+        Components[ComponentKey] = mcs::ItemComponentData { std::move(Properties) };
+    }
+
+    // Entity properties.
+    Components[1000] = mcs::ItemComponentData { std::string { "Entity" } };
+    Components[1001] = mcs::ItemComponentData { mcs::FloatArray { 0.0f, 1.0f, 2.0f } };
+    Components[1002] = mcs::ItemComponentData { mcs::FloatArray { 0.0f, 0.0f, 0.0f, 1.0f } };
+    Components[1003] = mcs::ItemComponentData { mcs::FloatArray { 1.0f, 1.0f, 1.0f } };
+    Components[1004] = mcs::ItemComponentData { std::string {} };
+    Components[1005] = mcs::ItemComponentData { int64_t { 0 } };
+    Components[1006] = mcs::ItemComponentData { mcs::ComponentMap {} };
+
+    return mcs::ObjectMessage { Id, 0, true, true, 1, std::nullopt, std::move(Components) };
+}
+
+size_t CountComponentData(const mcs::ComponentMap& Map)
+{
+    size_t Count = Map.size();
+
+    for (const auto& [Key, Data] : Map)
+    {
+        if (const auto* Nested = std::get_if<mcs::ComponentMap>(&Data.GetValue()))
+        {
+            Count += CountComponentData(*Nested);
+        }
+    }
+
+    return Count;
+}
+
+}
+
+// Measures decoding a space's worth of entities, as FetchAllEntitiesAndPopulateBuffers does when entering a space.
+// A node based map would need at least one allocation per component data entry, and vectors another for each float array.
+// Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_INTERNAL_TEST(DISABLED_CSPEngine, MCSTests, ObjectMessageDecodeBenchmark)
+{
+    constexpr size_t EntityCount = 10000;
+
+    std::vector<mcs::ObjectMessage> Messages;
+    Messages.reserve(EntityCount);
+
+    for (size_t i = 0; i < EntityCount; ++i)
+    {
+        Messages.push_back(CreateEntityObjectMessage(i + 1));
+    }
+
+    const size_t EntriesPerEntity = CountComponentData(*Messages[0].GetComponents());
+
+    SignalRSerializer Serializer;
+    Serializer.WriteValue(Messages);
+    const signalr::value SerializedMessages = Serializer.Get();
+
+    std::vector<mcs::ObjectMessage> DecodedMessages;
+    size_t DecodeAllocations = 0;
+
+    auto Start = std::chrono::steady_clock::now();
+    {
+        ScopedAllocationCounter Counter;
+
+        SignalRDeserializer Deserializer { SerializedMessages };
+        Deserializer.ReadValue(DecodedMessages);
+
+        DecodeAllocations = Counter.GetCount();
+    }
+    const double DecodeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+    EXPECT_EQ(DecodedMessages, Messages);
+
+    // Copying isolates the cost of the storage itself from the deserializer.
+    size_t CopyAllocations = 0;
+
+    Start = std::chrono::steady_clock::now();
+    {
+        ScopedAllocationCounter Counter;
+
+        const std::vector<mcs::ObjectMessage> CopiedMessages = DecodedMessages;
+
+        CopyAllocations = Counter.GetCount();
+    }
+    const double CopySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+    const double CopyAllocationsPerEntity = static_cast<double>(CopyAllocations) / EntityCount;
+
+    RecordProperty("ComponentDataEntriesPerEntity", static_cast<int>(EntriesPerEntity));
+    RecordProperty("DecodeAllocations", static_cast<int>(DecodeAllocations));
+    RecordProperty("DecodeNanosecondsPerEntity", static_cast<int>(DecodeSeconds * 1e9 / EntityCount));
+    RecordProperty("CopyAllocations", static_cast<int>(CopyAllocations));
+    RecordProperty("CopyNanosecondsPerEntity", static_cast<int>(CopySeconds * 1e9 / EntityCount));
+
+    EXPECT_LT(CopyAllocationsPerEntity, static_cast<double>(EntriesPerEntity));
+}
+
+namespace
+{
+
+mcs::ItemComponentData MakeComponentData(uint64_t Type, mcs::ComponentMap Properties)
+{
+    Properties[COMPONENT_KEY_COMPONENTTYPE] = mcs::ItemComponentData { Type };
+    return mcs::ItemComponentData { std::move(Properties) };
+}
+
+}
+
+// Test patches for the same entity are merged, with the newest value winning for each property.
+CSP_INTERNAL_TEST(CSPEngine, MCSTests, IncomingPatchCoalescerMergesPropertiesTest)
+{
+    IncomingPatchCoalescer Coalescer;
+
+    mcs::ComponentMap FirstComponents;
+    FirstComponents[0] = MakeComponentData(1, { { 0, mcs::ItemComponentData { int64_t { 1 } } }, { 1, mcs::ItemComponentData { int64_t { 2 } } } });
+    Coalescer.Add(mcs::ObjectPatch { 10, 1, false, false, std::nullopt, FirstComponents });
+
+    mcs::ComponentMap SecondComponents;
+    SecondComponents[0] = MakeComponentData(1, { { 1, mcs::ItemComponentData { int64_t { 3 } } } });
+    Coalescer.Add(mcs::ObjectPatch { 10, 2, false, false, std::nullopt, SecondComponents });
+
+    const auto& Patches = Coalescer.GetPatches();
+
+    ASSERT_EQ(Patches.size(), 1);
+    EXPECT_EQ(Coalescer.GetCoalescedCount(), 1);
+    EXPECT_EQ(Patches[0].GetOwnerId(), 2);
+
+    const auto& Properties = std::get<mcs::ComponentMap>(Patches[0].GetComponents()->at(0).GetValue());
+
+    EXPECT_EQ(std::get<int64_t>(Properties.at(0).GetValue()), 1);
+    EXPECT_EQ(std::get<int64_t>(Properties.at(1).GetValue()), 3);
+}
+
+// Test a component delete between two updates for the same entity is kept, and the patches stay in the order received.
+CSP_INTERNAL_TEST(CSPEngine, MCSTests, IncomingPatchCoalescerKeepsComponentDeletesTest)
+{
+    IncomingPatchCoalescer Coalescer;
+
+    mcs::ComponentMap UpdateComponents;
+    UpdateComponents[0] = MakeComponentData(1, { { 0, mcs::ItemComponentData { int64_t { 1 } } } });
+    Coalescer.Add(mcs::ObjectPatch { 10, 1, false, false, std::nullopt, UpdateComponents });
+
+    mcs::ComponentMap DeleteComponents;
+    DeleteComponents[0] = MakeComponentData(0, {});
+    Coalescer.Add(mcs::ObjectPatch { 10, 1, false, false, std::nullopt, DeleteComponents });
+
+    mcs::ComponentMap OtherEntityComponents;
+    OtherEntityComponents[0] = MakeComponentData(1, {});
+    Coalescer.Add(mcs::ObjectPatch { 11, 1, false, false, std::nullopt, OtherEntityComponents });
+    Coalescer.Add(mcs::ObjectPatch { 11, 1, false, false, std::nullopt, OtherEntityComponents });
+
+    const auto& Patches = Coalescer.GetPatches();
+
+    ASSERT_EQ(Patches.size(), 3);
+    EXPECT_EQ(Coalescer.GetCoalescedCount(), 1);
+    EXPECT_EQ(Patches[0].GetId(), 10);
+    EXPECT_EQ(Patches[1].GetId(), 10);
+    EXPECT_EQ(Patches[1].GetComponents(), DeleteComponents);
+    EXPECT_EQ(Patches[2].GetId(), 11);
+}
+
+// Test destroy patches are never merged, and patches after them are kept separate.
+CSP_INTERNAL_TEST(CSPEngine, MCSTests, IncomingPatchCoalescerKeepsDestroysTest)
+{
+    IncomingPatchCoalescer Coalescer;
+
+    Coalescer.Add(mcs::ObjectPatch { 10, 1, false, false, std::nullopt, {} });
+    Coalescer.Add(mcs::ObjectPatch { 10, 1, true, false, std::nullopt, {} });
+    Coalescer.Add(mcs::ObjectPatch { 10, 1, false, false, std::nullopt, {} });
+
+    ASSERT_EQ(Coalescer.GetPatches().size(), 3);
+    EXPECT_TRUE(Coalescer.GetPatches()[1].GetDestroy());
+    EXPECT_EQ(Coalescer.GetCoalescedCount(), 0);
+
+    Coalescer.Clear();
+
+    EXPECT_TRUE(Coalescer.GetPatches().empty());
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2025 Magnopus LLC
+
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CSP_WASM
+
+#include "Common/Web/RequestExecutor.h"
+#include "TestHelpers.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <future>
+
+using namespace csp::web;
+using namespace std::chrono_literals;
+
+CSP_INTERNAL_TEST(CSPEngine, RequestExecutorTests, GetHostKeyTest)
+{
+    EXPECT_EQ(RequestExecutor::GetHostKey("https://ogs-internal.magnopus-dev.cloud/mag-user/api/v1/users"), "ogs-internal.magnopus-dev.cloud");
+    EXPECT_EQ(RequestExecutor::GetHostKey("http://localhost:8081/api?query=1"), "localhost:8081");
+    EXPECT_EQ(RequestExecutor::GetHostKey("https://localhost"), "localhost");
+    EXPECT_EQ(RequestExecutor::GetHostKey("localhost:8081/api"), "localhost:8081");
+}
+
+CSP_INTERNAL_TEST(CSPEngine, RequestExecutorTests, PerHostConcurrencyLimitTest)
+{
+    constexpr size_t PerHostLimit = 2;
+    constexpr int TaskCount = 20;
+
+    std::atomic_int InFlight = 0;
+    std::atomic_int MaxInFlight = 0;
+    std::atomic_int Completed = 0;
+
+    {
+        RequestExecutor Executor(8, PerHostLimit);
+
+        for (int i = 0; i < TaskCount; ++i)
+        {
+            Executor.Enqueue("host-a",
+                [&]()
+                {
+                    const int Current = ++InFlight;
+                    int Expected = MaxInFlight;
+
+                    while (Current > Expected && !MaxInFlight.compare_exchange_weak(Expected, Current))
+                    {
+                    }
+
+                    std::this_thread::sleep_for(5ms);
+
+                    --InFlight;
+                    ++Completed;
+                });
+        }
+
+        // Shutdown runs everything that is still queued
+        Executor.Shutdown();
+    }
+
+    EXPECT_EQ(Completed, TaskCount);
+    EXPECT_LE(MaxInFlight, static_cast<int>(PerHostLimit));
+}
+
+CSP_INTERNAL_TEST(CSPEngine, RequestExecutorTests, BusyHostDoesNotStarveOtherHostsTest)
+{
+    RequestExecutor Executor(2, 1);
+
+    std::promise<void> ReleaseBusyHost;
+    std::shared_future<void> BusyHostReleased = ReleaseBusyHost.get_future().share();
+
+    // Fill one host's queue with blocked work
+    for (int i = 0; i < 10; ++i)
+    {
+        Executor.Enqueue("busy-host", [BusyHostReleased]() { BusyHostReleased.wait(); });
+    }
+
+    std::promise<void> OtherHostRan;
+    std::future<void> OtherHostRanFuture = OtherHostRan.get_future();
+
+    Executor.Enqueue("other-host", [&OtherHostRan]() { OtherHostRan.set_value(); });
+
+    // The busy host is limited to one worker, so the other is free to serve the second host despite being queued last
+    EXPECT_EQ(OtherHostRanFuture.wait_for(5s), std::future_status::ready);
+
+    ReleaseBusyHost.set_value();
+    Executor.Shutdown();
+}
+
+CSP_INTERNAL_TEST(CSPEngine, RequestExecutorTests, DelayedTaskDoesNotOccupyWorkerTest)
+{
+    // A single worker, so if waiting out the delay blocked it nothing else could run
+    RequestExecutor Executor(1, 1);
+
+    std::promise<std::chrono::steady_clock::time_point> DelayedRan;
+    std::future<std::chrono::steady_clock::time_point> DelayedRanFuture = DelayedRan.get_future();
+
+    std::promise<std::chrono::steady_clock::time_point> ImmediateRan;
+    std::future<std::chrono::steady_clock::time_point> ImmediateRanFuture = ImmediateRan.get_future();
+
+    const auto Start = std::chrono::steady_clock::now();
+
+    Executor.EnqueueDelayed("host", [&DelayedRan]() { DelayedRan.set_value(std::chrono::steady_clock::now()); }, 200ms);
+    Executor.Enqueue("host", [&ImmediateRan]() { ImmediateRan.set_value(std::chrono::steady_clock::now()); });
+
+    ASSERT_EQ(ImmediateRanFuture.wait_for(5s), std::future_status::ready);
+    ASSERT_EQ(DelayedRanFuture.wait_for(5s), std::future_status::ready);
+
+    const auto ImmediateTime = ImmediateRanFuture.get();
+    const auto DelayedTime = DelayedRanFuture.get();
+
+    EXPECT_LT(ImmediateTime, DelayedTime);
+    EXPECT_LT(ImmediateTime - Start, 200ms);
+    EXPECT_GE(DelayedTime - Start, 200ms);
+}
+
+#endif
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "AllocationCounter.h"
 #include "TestHelpers.h"
 #include "gtest/gtest.h"
 
@@ -25,13 +26,18 @@
 #include "CSP/Systems/CSPSceneData.h"
 #include "CSP/Systems/SystemsManager.h"
 #include "CSP/Systems/Users/UserSystem.h"
+#include "Multiplayer/MCS/MCSSceneCheckpoint.h"
 #include "Multiplayer/MCS/MCSSceneDescription.h"
 #include "Multiplayer/MCS/MCSTypes.h"
 #include "PublicAPITests/UserSystemTestHelpers.h"
 #include "Json/JsonSerializer.h"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <numeric>
+#include <sstream>
 
 using namespace csp::multiplayer;
 using namespace csp::systems;
@@ -39,6 +45,28 @@ using namespace csp::systems;
 namespace
 {
 bool RequestPredicate(const csp::systems::ResultBase& Result) { return Result.GetResultCode() != csp::systems::EResultCode::InProgress; }
+
+std::string ReadAsset(const char* Path)
+{
+    std::ifstream Stream { std::filesystem::absolute(Path).u8string().c_str() };
+
+    std::stringstream SStream;
+    SStream << Stream.rdbuf();
+
+    return SStream.str();
+}
+
+csp::common::List<csp::common::String> SplitIntoChunks(const std::string& Json, size_t ChunkSize)
+{
+    csp::common::List<csp::common::String> Chunks;
+
+    for (size_t Offset = 0; Offset < Json.size(); Offset += ChunkSize)
+    {
+        Chunks.Append(csp::common::String { Json.c_str() + Offset, std::min(ChunkSize, Json.size() - Offset) });
+    }
+
+    return Chunks;
+}
 }
 
 CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ObjectMessageSerializeTest)
@@ -49,7 +77,7 @@ CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ObjectMessageSerializeTest)
     const bool TestIsPersistent = true;
     const uint64_t TestOwnerId = 0; // TODO: Set to 3 when this is added to the test files.
     const std::optional<uint64_t> TestParentId = 4;
-    std::map<mcs::PropertyKeyType, mcs::ItemComponentData> TestComponents;
+    mcs::ComponentMap TestComponents;
     TestComponents[0] = mcs::ItemComponentData { { 0ll } };
 
     mcs::ObjectMessage Object { TestId, TestType, TestIsTransferable, TestIsPersistent, TestOwnerId, TestParentId, TestComponents };
@@ -155,7 +183,7 @@ CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeSt
 
 CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeFloatVectorTest)
 {
-    const std::vector<float> TestValue = { 1.1f, 2.2f, 3.3f };
+    const mcs::FloatArray TestValue = { 1.1f, 2.2f, 3.3f };
     mcs::ItemComponentData ComponentValue { TestValue };
 
     csp::common::String SerializedValue = csp::json::JsonSerializer::Serialize(ComponentValue);
@@ -168,7 +196,7 @@ CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeFl
 
 CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeFloatVectorEmptyTest)
 {
-    const std::vector<float> TestValue = {};
+    const mcs::FloatArray TestValue = {};
     mcs::ItemComponentData ComponentValue { TestValue };
 
     csp::common::String SerializedValue = csp::json::JsonSerializer::Serialize(ComponentValue);
@@ -181,7 +209,7 @@ CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeFl
 
 CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeStringMapTest)
 {
-    const std::map<std::string, mcs::ItemComponentData> TestValue
+    const mcs::StringComponentMap TestValue
         = { { "Key1", mcs::ItemComponentData { 1.1f } }, { "Key2", mcs::ItemComponentData { std::string { "Test" } } } };
     mcs::ItemComponentData ComponentValue { TestValue };
 
@@ -195,7 +223,7 @@ CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeSt
 
 CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeStringMapEmptyTest)
 {
-    const std::map<std::string, mcs::ItemComponentData> TestValue = {};
+    const mcs::StringComponentMap TestValue = {};
     mcs::ItemComponentData ComponentValue { TestValue };
 
     csp::common::String SerializedValue = csp::json::JsonSerializer::Serialize(ComponentValue);
@@ -208,7 +236,7 @@ CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeSt
 
 CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeUIntMapTest)
 {
-    const std::map<uint16_t, mcs::ItemComponentData> TestValue
+    const mcs::ComponentMap TestValue
         = { { 0, mcs::ItemComponentData { 1.1f } }, { 1, mcs::ItemComponentData { std::string { "Test" } } } };
     mcs::ItemComponentData ComponentValue { TestValue };
 
@@ -222,7 +250,7 @@ CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeUI
 
 CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, ItemComponentDataSerializeUIntMapEmptyTest)
 {
-    const std::map<uint16_t, mcs::ItemComponentData> TestValue = {};
+    const mcs::ComponentMap TestValue = {};
     mcs::ItemComponentData ComponentValue { TestValue };
 
     csp::common::String SerializedValue = csp::json::JsonSerializer::Serialize(ComponentValue);
@@ -546,4 +574,230 @@ CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, SceneDescriptionDeserializeM
     EXPECT_EQ(Material->GetMaterialId(), Asset.Id);
 
     csp::CSPFoundation::Shutdown();
-}
\ No newline at end of file
+}
+
+
+// Tests the streaming reader produces the same objects as parsing the whole document, when the input is split mid-token.
+CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, SceneDescriptionReaderMatchesDocumentTest)
+{
+    for (const char* Path : { "assets/checkpoint-empty.json", "assets/checkpoint-basic.json", "assets/checkpoint-parents.json",
+             "assets/checkpoint-material.json" })
+    {
+        const std::string Json = ReadAsset(Path);
+        ASSERT_FALSE(Json.empty()) << Path;
+
+        mcs::SceneDescription Expected;
+        ASSERT_TRUE(csp::json::JsonDeserializer::Deserialize(Json.c_str(), Expected)) << Path;
+
+        std::vector<mcs::ObjectMessage> Objects;
+        csp::common::String Error;
+
+        const bool Parsed = mcs::SceneDescriptionReader::Read(
+            SplitIntoChunks(Json, 7), [&Objects](mcs::ObjectMessage&& Object) { Objects.push_back(std::move(Object)); }, Error);
+
+        EXPECT_TRUE(Parsed) << Path << ": " << Error.c_str();
+        EXPECT_EQ(Objects, Expected.Objects) << Path;
+    }
+}
+
+// Tests objects before a parse error are still read, and the error is reported.
+CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, SceneDescriptionReaderTruncatedInputTest)
+{
+    const std::string Json = R"({"data":{"group":{"objectMessages":[{"id":9}]},"objectMessages":[{"id":1,"prefabId":2},{"id":2,"pref)";
+
+    std::vector<mcs::ObjectMessage> Objects;
+    csp::common::String Error;
+
+    const bool Parsed = mcs::SceneDescriptionReader::Read(
+        SplitIntoChunks(Json, 16), [&Objects](mcs::ObjectMessage&& Object) { Objects.push_back(std::move(Object)); }, Error);
+
+    EXPECT_FALSE(Parsed);
+    EXPECT_FALSE(Error.IsEmpty());
+
+    // The objectMessages nested in group is not part of the scene, so only the first complete object should have been read.
+    ASSERT_EQ(Objects.size(), 1);
+    EXPECT_EQ(Objects[0].GetId(), 1);
+    EXPECT_EQ(Objects[0].GetType(), 2);
+}
+
+// Compares the peak memory and time of streaming a large scene against parsing it as a single document, which is how it was previously loaded.
+// The basic checkpoint's object is repeated to scale the scene up.
+// Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_INTERNAL_TEST(DISABLED_CSPEngine, SceneDescriptionTests, SceneDescriptionReaderLargeSceneBenchmark)
+{
+    InitialiseFoundationWithUserAgentInfo(EndpointBaseURI());
+
+    constexpr size_t ObjectCount = 20000;
+    constexpr size_t ChunkSize = 1024 * 1024;
+
+    mcs::SceneDescription Basic;
+    ASSERT_TRUE(csp::json::JsonDeserializer::Deserialize(ReadAsset("assets/checkpoint-basic.json").c_str(), Basic));
+    ASSERT_EQ(Basic.Objects.size(), 1);
+
+    const mcs::ObjectMessage& Template = Basic.Objects[0];
+
+    std::string Json = R"({"data":{"objectMessages":[)";
+
+    for (size_t i = 0; i < ObjectCount; ++i)
+    {
+        const mcs::ObjectMessage Object { i + 1, Template.GetType(), Template.GetIsTransferable(), Template.GetIsPersistent(),
+            Template.GetOwnerId(), Template.GetParentId(), Template.GetComponents() };
+
+        Json += (i == 0 ? "" : ",");
+        Json += csp::json::JsonSerializer::Serialize(Object).c_str();
+    }
+
+    Json += "]}}";
+
+    const csp::common::List<csp::common::String> Chunks = SplitIntoChunks(Json, ChunkSize);
+
+    size_t DocumentObjects = 0;
+    int64_t DocumentPeakBytes = 0;
+    const auto DocumentStart = std::chrono::steady_clock::now();
+
+    {
+        ScopedAllocationCounter Counter;
+
+        const csp::common::String Joined = std::accumulate(Chunks.begin(), Chunks.end(), csp::common::String {});
+
+        mcs::SceneDescription SceneDescription;
+        csp::json::JsonDeserializer::Deserialize(Joined.c_str(), SceneDescription);
+
+        DocumentObjects = SceneDescription.Objects.size();
+        DocumentPeakBytes = Counter.GetPeakBytes();
+    }
+
+    const auto DocumentTime = std::chrono::steady_clock::now() - DocumentStart;
+
+    size_t StreamedObjects = 0;
+    int64_t StreamedPeakBytes = 0;
+    const auto StreamedStart = std::chrono::steady_clock::now();
+
+    {
+        ScopedAllocationCounter Counter;
+
+        csp::common::String Error;
+        mcs::SceneDescriptionReader::Read(Chunks, [&StreamedObjects](mcs::ObjectMessage&&) { ++StreamedObjects; }, Error);
+
+        StreamedPeakBytes = Counter.GetPeakBytes();
+    }
+
+    const auto StreamedTime = std::chrono::steady_clock::now() - StreamedStart;
+
+    EXPECT_EQ(DocumentObjects, ObjectCount);
+    EXPECT_EQ(StreamedObjects, ObjectCount);
+    EXPECT_LT(StreamedPeakBytes * 10, DocumentPeakBytes);
+
+    const auto Milliseconds = [](auto Duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(Duration).count()); };
+
+    RecordProperty("JsonBytes", static_cast<int>(Json.size()));
+    RecordProperty("DocumentMilliseconds", Milliseconds(DocumentTime));
+    RecordProperty("DocumentPeakBytes", static_cast<int>(DocumentPeakBytes));
+    RecordProperty("StreamedMilliseconds", Milliseconds(StreamedTime));
+    RecordProperty("StreamedPeakBytes", static_cast<int>(StreamedPeakBytes));
+
+    // Time the full load, including creating the entities.
+    MockScriptRunner ScriptRunner;
+    csp::common::LogSystem LogSystem;
+
+    csp::multiplayer::OfflineRealtimeEngine RealtimeEngine(LogSystem, ScriptRunner);
+
+    const auto LoadStart = std::chrono::steady_clock::now();
+
+    CSPSceneDescription SceneDescription { Chunks };
+    auto Entities = SceneDescription.CreateEntities(RealtimeEngine, LogSystem, ScriptRunner);
+
+    const auto LoadTime = std::chrono::steady_clock::now() - LoadStart;
+
+    EXPECT_EQ(Entities.Size(), ObjectCount);
+
+    RecordProperty("CreateEntitiesMilliseconds", Milliseconds(LoadTime));
+
+    for (size_t i = 0; i < Entities.Size(); ++i)
+    {
+        delete Entities[i];
+    }
+
+    csp::CSPFoundation::Shutdown();
+}
+
+// Tests every object in a scene survives a round trip through the binary checkpoint format unchanged.
+CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, SceneCheckpointRoundTripTest)
+{
+    mcs::SceneDescription Expected;
+    ASSERT_TRUE(csp::json::JsonDeserializer::Deserialize(ReadAsset("assets/checkpoint-parents.json").c_str(), Expected));
+    ASSERT_FALSE(Expected.Objects.empty());
+
+    mcs::SceneCheckpointWriter Writer;
+
+    for (const mcs::ObjectMessage& Object : Expected.Objects)
+    {
+        Writer.Write(Object);
+    }
+
+    const std::vector<char>& Checkpoint = Writer.GetData();
+    EXPECT_TRUE(mcs::SceneCheckpoint::IsCheckpoint(Checkpoint.data(), Checkpoint.size()));
+
+    std::vector<mcs::ObjectMessage> Objects;
+    csp::common::String Error;
+
+    const bool Read = mcs::SceneCheckpoint::Read(
+        Checkpoint.data(), Checkpoint.size(), [&Objects](mcs::ObjectMessage&& Object) { Objects.push_back(std::move(Object)); }, Error);
+
+    EXPECT_TRUE(Read) << Error.c_str();
+    EXPECT_EQ(Objects, Expected.Objects);
+}
+
+// Tests invalid checkpoints are rejected, and objects before a truncated record are still read.
+CSP_INTERNAL_TEST(CSPEngine, SceneDescriptionTests, SceneCheckpointInvalidDataTest)
+{
+    const auto IgnoreObject = [](mcs::ObjectMessage&&) {};
+    csp::common::String Error;
+
+    const std::string Json = R"({"data":{"objectMessages":[]}})";
+    EXPECT_FALSE(mcs::SceneCheckpoint::IsCheckpoint(Json.c_str(), Json.size()));
+    EXPECT_FALSE(mcs::SceneCheckpoint::Read(Json.c_str(), Json.size(), IgnoreObject, Error));
+    EXPECT_FALSE(Error.IsEmpty());
+
+    mcs::SceneCheckpointWriter Writer;
+    Writer.Write(mcs::ObjectMessage { 1, 0, true, true, 0, std::nullopt, std::nullopt });
+    Writer.Write(mcs::ObjectMessage { 2, 0, true, true, 0, 1, mcs::ComponentMap { { 1, mcs::ItemComponentData { std::string { "Test" } } } } });
+
+    std::vector<char> Checkpoint = Writer.TakeData();
+
+    // An empty checkpoint is valid.
+    EXPECT_TRUE(mcs::SceneCheckpoint::Read(mcs::SceneCheckpointWriter {}.GetData().data(), mcs::SceneCheckpoint::HeaderSize, IgnoreObject, Error));
+
+    for (size_t Size = mcs::SceneCheckpoint::HeaderSize; Size < Checkpoint.size(); ++Size)
+    {
+        std::vector<uint64_t> Ids;
+        Error = "";
+
+        const bool Read = mcs::SceneCheckpoint::Read(
+            Checkpoint.data(), Size, [&Ids](mcs::ObjectMessage&& Object) { Ids.push_back(Object.GetId()); }, Error);
+
+        EXPECT_FALSE(Read);
+        EXPECT_FALSE(Error.IsEmpty());
+        EXPECT_LE(Ids.size(), 1);
+    }
+
+    // A component of an unsupported type is skipped, and the rest of the object still loads.
+    std::vector<char> UnsupportedType = Checkpoint;
+    const std::string StringValue = "\x91\xA4Test";
+    const auto StringIt = std::search(UnsupportedType.begin(), UnsupportedType.end(), StringValue.begin(), StringValue.end());
+    ASSERT_NE(StringIt, UnsupportedType.end());
+
+    // The type precedes the value, and 2 is the unimplemented BOOL_ARRAY.
+    *(StringIt - 1) = 2;
+
+    std::vector<mcs::ObjectMessage> Objects;
+    EXPECT_TRUE(mcs::SceneCheckpoint::Read(
+        UnsupportedType.data(), UnsupportedType.size(), [&Objects](mcs::ObjectMessage&& Object) { Objects.push_back(std::move(Object)); }, Error));
+    ASSERT_EQ(Objects.size(), 2);
+    ASSERT_TRUE(Objects[1].GetComponents().has_value());
+    EXPECT_TRUE(Objects[1].GetComponents()->empty());
+
+    // A corrupted record should be reported rather than throw.
+    Checkpoint[mcs::SceneCheckpoint::HeaderSize + sizeof(uint32_t)] = static_cast<char>(0xC1);
+    EXPECT_FALSE(mcs::SceneCheckpoint::Read(Checkpoint.data(), Checkpoint.size(), IgnoreObject, Error));
+}
@@ -19,9 +19,36 @@
 #include "TestHelpers.h"
 
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <vector>
 
 using namespace std::chrono_literals;
 
+namespace
+{
+
+// Polls until Condition holds or Timeout passes, returning whether it held.
+template <typename ConditionT> bool WaitFor(ConditionT&& Condition, std::chrono::milliseconds Timeout)
+{
+    const auto Deadline = std::chrono::steady_clock::now() + Timeout;
+
+    while (!Condition())
+    {
+        if (std::chrono::steady_clock::now() > Deadline)
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(1ms);
+    }
+
+    return true;
+}
+
+} // namespace
+
 CSP_INTERNAL_TEST(CSPEngine, SchedulerTests, SchedulerTest)
 {
     int WaitForTestTimeoutCountMs = 0;
@@ -41,3 +68,168 @@ CSP_INTERNAL_TEST(CSPEngine, SchedulerTests, SchedulerTest)
 
     EXPECT_TRUE(ScheduleCallback);
 }
+
+CSP_INTERNAL_TEST(CSPEngine, SchedulerTests, CancelTest)
+{
+    csp::Scheduler Scheduler;
+    Scheduler.Initialise();
+
+    std::atomic_int CancelledCalls = 0;
+    std::atomic_int KeptCalls = 0;
+
+    const auto Time = std::chrono::system_clock::now() + 50ms;
+    const csp::ScheduledTaskId CancelledId = Scheduler.ScheduleAt(Time, [&CancelledCalls]() { ++CancelledCalls; });
+    Scheduler.ScheduleAt(Time, [&KeptCalls]() { ++KeptCalls; });
+
+    Scheduler.CancelTask(CancelledId);
+
+    EXPECT_TRUE(WaitFor([&KeptCalls]() { return KeptCalls == 1; }, 5000ms));
+    EXPECT_EQ(CancelledCalls, 0);
+    EXPECT_TRUE(WaitFor([&Scheduler]() { return Scheduler.GetTaskCount() == 0; }, 5000ms));
+}
+
+CSP_INTERNAL_TEST(CSPEngine, SchedulerTests, ScheduleEveryTest)
+{
+    csp::Scheduler Scheduler;
+    Scheduler.Initialise();
+
+    std::atomic_int Calls = 0;
+    // Set after the task is scheduled, which races with its first run in principle.
+    std::atomic<csp::ScheduledTaskId> Id = 0;
+
+    // Cancels itself from inside its third run.
+    Id = Scheduler.ScheduleEvery(10ms,
+        [&Calls, &Scheduler, &Id]()
+        {
+            if (++Calls == 3)
+            {
+                Scheduler.CancelTask(Id);
+            }
+        });
+
+    EXPECT_TRUE(WaitFor([&Calls]() { return Calls == 3; }, 5000ms));
+    EXPECT_TRUE(WaitFor([&Scheduler]() { return Scheduler.GetTaskCount() == 0; }, 5000ms));
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(Calls, 3);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, SchedulerTests, CancelWaitsForRunningTaskTest)
+{
+    csp::Scheduler Scheduler;
+    Scheduler.Initialise();
+
+    std::atomic_bool Running = false;
+    std::atomic_int Calls = 0;
+
+    const auto Id = Scheduler.ScheduleEvery(10ms,
+        [&Running, &Calls]()
+        {
+            Running = true;
+            std::this_thread::sleep_for(100ms);
+            ++Calls;
+            Running = false;
+        });
+
+    ASSERT_TRUE(WaitFor([&Running]() { return Running.load(); }, 5000ms));
+
+    // Cancelled mid-run, so CancelTask should only return once that run has finished.
+    Scheduler.CancelTask(Id);
+
+    EXPECT_FALSE(Running);
+    const int CallsAtCancel = Calls;
+    EXPECT_GE(CallsAtCancel, 1);
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(Calls, CallsAtCancel);
+    EXPECT_EQ(Scheduler.GetTaskCount(), 0);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, SchedulerTests, TimerAccuracyTest)
+{
+    csp::Scheduler Scheduler;
+    Scheduler.Initialise();
+
+    constexpr int TimerCount = 50;
+
+    std::vector<std::chrono::system_clock::duration> Lateness(TimerCount);
+    std::atomic_int Completed = 0;
+
+    const auto Start = std::chrono::system_clock::now();
+
+    for (int i = 0; i < TimerCount; ++i)
+    {
+        const auto Deadline = Start + std::chrono::milliseconds(10 * (i + 1));
+        Scheduler.ScheduleAt(Deadline,
+            [&Lateness, &Completed, Deadline, i]()
+            {
+                Lateness[i] = std::chrono::system_clock::now() - Deadline;
+                ++Completed;
+            });
+    }
+
+    ASSERT_TRUE(WaitFor([&Completed]() { return Completed == TimerCount; }, 10000ms));
+
+    std::sort(Lateness.begin(), Lateness.end());
+
+    const auto Microseconds = [](auto Duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(Duration).count()); };
+
+    // No timer should ever fire early. A single timer can be held up by a busy machine, so only the median is expected to be well under the
+    // old 100ms polling interval.
+    EXPECT_GE(Lateness.front(), std::chrono::system_clock::duration::zero());
+    EXPECT_LT(Lateness[TimerCount / 2], std::chrono::system_clock::duration(50ms));
+
+    RecordProperty("LatenessMedianMicroseconds", Microseconds(Lateness[TimerCount / 2]));
+    RecordProperty("LatenessMaxMicroseconds", Microseconds(Lateness.back()));
+}
+
+CSP_INTERNAL_TEST(CSPEngine, SchedulerTests, ThroughputTest)
+{
+    csp::Scheduler Scheduler;
+    Scheduler.Initialise();
+
+    constexpr int TimerCount = 10000;
+
+    std::mt19937 Random(1234);
+    std::uniform_int_distribution<int> DelayMs(100, 1000);
+
+    std::vector<csp::ScheduledTaskId> Ids;
+    Ids.reserve(TimerCount);
+    std::atomic_int Calls = 0;
+
+    const auto Now = std::chrono::system_clock::now();
+    const auto ScheduleStart = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < TimerCount; ++i)
+    {
+        Ids.push_back(Scheduler.ScheduleAt(Now + std::chrono::milliseconds(DelayMs(Random)), [&Calls]() { ++Calls; }));
+    }
+
+    const auto ScheduleTime = std::chrono::steady_clock::now() - ScheduleStart;
+    EXPECT_EQ(Scheduler.GetTaskCount(), static_cast<size_t>(TimerCount));
+
+    // Cancel every other timer while they are all still pending.
+    const auto CancelStart = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < TimerCount; i += 2)
+    {
+        Scheduler.CancelTask(Ids[i]);
+    }
+
+    const auto CancelTime = std::chrono::steady_clock::now() - CancelStart;
+    const auto RunStart = std::chrono::steady_clock::now();
+
+    EXPECT_TRUE(WaitFor([&Calls]() { return Calls == TimerCount / 2; }, 10000ms));
+
+    const auto RunTime = std::chrono::steady_clock::now() - RunStart;
+
+    std::this_thread::sleep_for(50ms);
+    EXPECT_EQ(Calls, TimerCount / 2);
+    EXPECT_EQ(Scheduler.GetTaskCount(), 0);
+
+    const auto Microseconds = [](auto Duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(Duration).count()); };
+
+    RecordProperty("ScheduleMicroseconds", Microseconds(ScheduleTime));
+    RecordProperty("CancelHalfMicroseconds", Microseconds(CancelTime));
+    RecordProperty("RemainingFiredMicroseconds", Microseconds(RunTime));
+}
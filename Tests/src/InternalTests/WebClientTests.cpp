@@ -32,6 +32,19 @@
 
 #include "Mocks/WebClientMock.h"
 
+#ifndef CSP_WASM
+#include "Common/Web/POCOWebClient/POCOWebClient.h"
+
+#include <Poco/Net/HTTPRequestHandler.h>
+#include <Poco/Net/HTTPRequestHandlerFactory.h>
+#include <Poco/Net/HTTPServer.h>
+#include <Poco/Net/HTTPServerRequest.h>
+#include <Poco/Net/HTTPServerResponse.h>
+#include <Poco/Net/ServerSocket.h>
+#include <array>
+#include <set>
+#endif
+
 using namespace csp::web;
 
 inline const char* TESTS_PAYLOAD_RESPONSE_CONTENT = "payloadData";
@@ -232,3 +245,138 @@ CSP_INTERNAL_TEST(CSPEngine, WebClientTests, MockWebClientRequestResponseVeryVer
 
     csp::CSPFoundation::Shutdown();
 }
+
+#ifndef CSP_WASM
+namespace
+{
+
+// Serves a fixed body and records the client port of every request it sees, so we can tell how many connections were used
+class KeepAliveTestRequestHandler : public Poco::Net::HTTPRequestHandler
+{
+public:
+    KeepAliveTestRequestHandler(std::mutex& ClientPortsMutex, std::set<uint16_t>& ClientPorts)
+        : ClientPortsMutex(ClientPortsMutex)
+        , ClientPorts(ClientPorts)
+    {
+    }
+
+    void handleRequest(Poco::Net::HTTPServerRequest& Request, Poco::Net::HTTPServerResponse& Response) override
+    {
+        {
+            std::scoped_lock Lock(ClientPortsMutex);
+            ClientPorts.insert(Request.clientAddress().port());
+        }
+
+        Response.setContentType("application/json");
+        Response.sendBuffer(TESTS_PAYLOAD_RESPONSE_CONTENT, strlen(TESTS_PAYLOAD_RESPONSE_CONTENT));
+    }
+
+private:
+    std::mutex& ClientPortsMutex;
+    std::set<uint16_t>& ClientPorts;
+};
+
+class KeepAliveTestRequestHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory
+{
+public:
+    Poco::Net::HTTPRequestHandler* createRequestHandler(const Poco::Net::HTTPServerRequest& /*Request*/) override
+    {
+        return new KeepAliveTestRequestHandler(ClientPortsMutex, ClientPorts);
+    }
+
+    size_t GetConnectionCount()
+    {
+        std::scoped_lock Lock(ClientPortsMutex);
+        return ClientPorts.size();
+    }
+
+private:
+    std::mutex ClientPortsMutex;
+    std::set<uint16_t> ClientPorts;
+};
+
+} // namespace
+
+CSP_INTERNAL_TEST(CSPEngine, WebClientTests, POCOWebClientReusesKeepAliveConnectionsTest)
+{
+    InitialiseFoundation();
+
+    csp::common::LogSystem* LogSystem = csp::systems::SystemsManager::Get().GetLogSystem();
+
+    // Bind to an ephemeral port on the loopback interface
+    Poco::Net::ServerSocket Socket(Poco::Net::SocketAddress("127.0.0.1", 0));
+    const uint16_t ServerPort = Socket.address().port();
+
+    auto* HandlerFactory = new KeepAliveTestRequestHandlerFactory();
+    Poco::Net::HTTPRequestHandlerFactory::Ptr HandlerFactoryPtr(HandlerFactory);
+
+    Poco::Net::HTTPServerParams::Ptr Params = new Poco::Net::HTTPServerParams();
+    Params->setKeepAlive(true);
+
+    Poco::Net::HTTPServer Server(HandlerFactoryPtr, Socket, Params);
+    Server.start();
+
+    {
+        constexpr int RequestCount = 10;
+
+        // Handlers are referenced by their requests until the client has finished with them, so must outlive it
+        std::array<MockHttpResponseHandler, RequestCount> Handlers;
+        std::array<std::promise<EResponseCodes>, RequestCount> ResponsePromises;
+
+        POCOWebClient Client(ServerPort, ETransferProtocol::HTTP, LogSystem, false);
+
+        const Uri RequestUri(fmt::format("http://127.0.0.1:{}/keepalive", ServerPort).c_str());
+
+        for (int i = 0; i < RequestCount; ++i)
+        {
+            HttpPayload Payload;
+            std::future<EResponseCodes> ResponseFuture = ResponsePromises[i].get_future();
+
+            EXPECT_CALL(Handlers[i], OnHttpResponse)
+                .WillOnce([&ResponsePromise = ResponsePromises[i]](HttpResponse& Response) { ResponsePromise.set_value(Response.GetResponseCode()); });
+
+            // Requests are sent one after another, so each should find the previous request's connection waiting in the pool
+            Client.SendRequest(ERequestVerb::Get, RequestUri, Payload, &Handlers[i], csp::common::CancellationToken::Dummy(), true);
+
+            ASSERT_EQ(ResponseFuture.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+            EXPECT_EQ(ResponseFuture.get(), EResponseCodes::ResponseOK);
+        }
+
+        const POCOSessionPool::Metrics Metrics = Client.GetSessionPoolMetrics();
+
+        EXPECT_EQ(Metrics.Misses, 1);
+        EXPECT_EQ(Metrics.Hits, RequestCount - 1);
+        EXPECT_EQ(Metrics.Evictions, 0);
+        EXPECT_EQ(HandlerFactory->GetConnectionCount(), 1);
+    }
+
+    Server.stopAll(true);
+
+    csp::CSPFoundation::Shutdown();
+}
+#endif
+
+CSP_INTERNAL_TEST(CSPEngine, WebClientTests, ConfiguredWebClientSettingsTest)
+{
+    const csp::WebRequestSettings Defaults;
+
+    // The public defaults should match the web client's own.
+    EXPECT_EQ(Defaults.MaxConcurrentRequests, static_cast<uint32_t>(CSP_MAX_CONCURRENT_REQUESTS));
+    EXPECT_EQ(Defaults.MaxConcurrentRequestsPerHost, static_cast<uint32_t>(CSP_MAX_CONCURRENT_REQUESTS_PER_HOST));
+
+    csp::WebRequestSettings Configured;
+    Configured.MaxConcurrentRequests = 4;
+    Configured.MaxConcurrentRequestsPerHost = 2;
+    Configured.MaxConcurrentRequestsByHost["localhost:8081"] = 1;
+
+    csp::CSPFoundation::SetWebRequestSettings(Configured);
+
+    const WebClientSettings Settings = GetConfiguredWebClientSettings();
+
+    EXPECT_EQ(Settings.MaxConcurrentRequests, 4);
+    EXPECT_EQ(Settings.MaxConcurrentRequestsPerHost, 2);
+    ASSERT_EQ(Settings.MaxConcurrentRequestsByHost.size(), 1);
+    EXPECT_EQ(Settings.MaxConcurrentRequestsByHost.at("localhost:8081"), 1);
+
+    csp::CSPFoundation::SetWebRequestSettings(Defaults);
+}
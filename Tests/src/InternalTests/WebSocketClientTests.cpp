@@ -206,3 +206,84 @@ CSP_INTERNAL_TEST(CSPEngine, WebSocketClientTests, LocalMalformedMultiplayerServ
 
     EXPECT_THROW(CSPWebSocketClientPOCO::ParseMultiplayerServiceUriEndPoint(Endpoints.MultiplayerConnection.GetURI().c_str()), Poco::SyntaxException);
 }
+
+/*
+ * These tests cover the framing used to batch received SignalR messages.
+ * Each binary message is prefixed by its length as a 7-bit varint of up to 5 bytes.
+ */
+
+CSP_INTERNAL_TEST(CSPEngine, WebSocketClientTests, FindCompleteMessagesEndMultipleMessages)
+{
+    const std::string Data { "\x03"
+                             "abc"
+                             "\x01"
+                             "d"
+                             "\x02"
+                             "ef",
+        9 };
+
+    size_t MessageCount = 0;
+    const size_t End = CSPWebSocketClientPOCO::FindCompleteMessagesEnd(Data.data(), Data.size(), MessageCount);
+
+    EXPECT_EQ(End, Data.size());
+    EXPECT_EQ(MessageCount, 3);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, WebSocketClientTests, FindCompleteMessagesEndPartialMessage)
+{
+    // Second message claims 4 bytes but only 2 have arrived
+    const std::string Data { "\x02"
+                             "ab"
+                             "\x04"
+                             "cd",
+        6 };
+
+    size_t MessageCount = 0;
+    const size_t End = CSPWebSocketClientPOCO::FindCompleteMessagesEnd(Data.data(), Data.size(), MessageCount);
+
+    EXPECT_EQ(End, 3);
+    EXPECT_EQ(MessageCount, 1);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, WebSocketClientTests, FindCompleteMessagesEndPartialLengthPrefix)
+{
+    // Continuation bit is set on the last byte, so the length itself is incomplete
+    const std::string Data { "\x01"
+                             "a"
+                             "\x80",
+        3 };
+
+    size_t MessageCount = 0;
+    const size_t End = CSPWebSocketClientPOCO::FindCompleteMessagesEnd(Data.data(), Data.size(), MessageCount);
+
+    EXPECT_EQ(End, 2);
+    EXPECT_EQ(MessageCount, 1);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, WebSocketClientTests, FindCompleteMessagesEndEmpty)
+{
+    size_t MessageCount = 1;
+    const size_t End = CSPWebSocketClientPOCO::FindCompleteMessagesEnd(nullptr, 0, MessageCount);
+
+    EXPECT_EQ(End, 0);
+    EXPECT_EQ(MessageCount, 0);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, WebSocketClientTests, FindCompleteMessagesEndMultiByteLength)
+{
+    // 300 = 0b1'0010'1100, encoded as 0xAC 0x02
+    std::string Data { "\xAC\x02", 2 };
+    Data.append(300, 'x');
+
+    size_t MessageCount = 0;
+    size_t End = CSPWebSocketClientPOCO::FindCompleteMessagesEnd(Data.data(), Data.size(), MessageCount);
+
+    EXPECT_EQ(End, Data.size());
+    EXPECT_EQ(MessageCount, 1);
+
+    // Drop the final byte and the message is no longer complete
+    End = CSPWebSocketClientPOCO::FindCompleteMessagesEnd(Data.data(), Data.size() - 1, MessageCount);
+
+    EXPECT_EQ(End, 0);
+    EXPECT_EQ(MessageCount, 0);
+}
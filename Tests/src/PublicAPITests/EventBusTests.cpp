@@ -28,6 +28,7 @@
 #include "UserSystemTestHelpers.h"
 
 #include "gtest/gtest.h"
+#include "signalrclient/signalr_value.h"
 #include <chrono>
 #include <fmt/format.h>
 #include <future>
@@ -69,6 +70,13 @@ csp::systems::Space CreateTestSpaceAndEnterScope(csp::systems::SpaceSystem* Spac
     return Space;
 }
 
+// Builds the arguments of an OnEventMessage as they arrive from the multiplayer connection, for an event without any values.
+signalr::value MakeEventMessage(const std::string& EventName)
+{
+    std::vector<signalr::value> EventMessage { EventName, std::uint64_t(1), signalr::value_type::null, signalr::value_type::null };
+    return signalr::value(std::vector<signalr::value> { signalr::value(std::move(EventMessage)) });
+}
+
 } // namespace
 
 CSP_PUBLIC_TEST(CSPEngine, EventBusTests, RegisterDeregister)
@@ -406,6 +414,99 @@ CSP_PUBLIC_TEST(CSPEngine, EventBusTests, TestNoConnectionRegistration)
     EXPECT_FALSE(NoConnectionEventBus.StartEventMessageListening());
 }
 
+CSP_PUBLIC_TEST(CSPEngine, EventBusTests, DispatchWithoutConnection)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    csp::multiplayer::NetworkEventBus EventBus { nullptr, *SystemsManager.GetLogSystem() };
+
+    std::vector<std::string> Calls;
+
+    EventBus.ListenNetworkEvent(NetworkEventRegistration { "First", "TestEvent" },
+        [&Calls, &EventBus](const csp::common::NetworkEventData& NetworkEventData)
+        {
+            EXPECT_EQ(NetworkEventData.EventName, "TestEvent");
+            Calls.push_back("First");
+
+            // Listeners changed by a callback take effect from the next event.
+            EventBus.StopListenNetworkEvent(NetworkEventRegistration { "First", "TestEvent" });
+            EventBus.StopListenNetworkEvent(NetworkEventRegistration { "Second", "TestEvent" });
+            EventBus.ListenNetworkEvent(NetworkEventRegistration { "Third", "TestEvent" },
+                [&Calls](const csp::common::NetworkEventData& /*NetworkEventData*/) { Calls.push_back("Third"); });
+        });
+    EventBus.ListenNetworkEvent(NetworkEventRegistration { "Second", "TestEvent" },
+        [&Calls](const csp::common::NetworkEventData& /*NetworkEventData*/) { Calls.push_back("Second"); });
+
+    EventBus.DispatchEventMessage(MakeEventMessage("OtherEvent"));
+    EXPECT_TRUE(Calls.empty());
+
+    EventBus.DispatchEventMessage(MakeEventMessage("TestEvent"));
+    EXPECT_EQ(Calls, std::vector<std::string>({ "First" }));
+
+    const csp::common::Array<NetworkEventRegistration> Registrations = EventBus.AllRegistrations();
+    EXPECT_EQ(Registrations.Size(), 1);
+    EXPECT_TRUE(Registrations.ToList().Contains(NetworkEventRegistration { "Third", "TestEvent" }));
+
+    EventBus.DispatchEventMessage(MakeEventMessage("TestEvent"));
+    EXPECT_EQ(Calls, std::vector<std::string>({ "First", "Third" }));
+
+    EventBus.StopListenAllNetworkEvents("Third");
+    EXPECT_EQ(EventBus.AllRegistrations().Size(), 0);
+}
+
+// Measures the time to dispatch an event that has registered callbacks and one that has none, at increasing registration counts.
+// Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_PUBLIC_TEST(DISABLED_CSPEngine, EventBusTests, DispatchBenchmark)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    constexpr int EventNameCount = 10;
+    constexpr int Dispatches = 10000;
+
+    const signalr::value RegisteredEvent = MakeEventMessage("BenchmarkEvent0");
+    const signalr::value UnregisteredEvent = MakeEventMessage("UnregisteredEvent");
+
+    const auto NanosecondsPerDispatch
+        = [](auto Duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::nanoseconds>(Duration).count() / Dispatches); };
+
+    for (const int RegistrationCount : { 10, 100, 1000 })
+    {
+        csp::multiplayer::NetworkEventBus EventBus { nullptr, *SystemsManager.GetLogSystem() };
+        size_t CallbackCount = 0;
+
+        // Spread the registrations over a few event names, so each event only reaches some of them.
+        for (int i = 0; i < RegistrationCount; ++i)
+        {
+            const std::string ReceiverId = fmt::format("Receiver{}", i);
+            const std::string EventName = fmt::format("BenchmarkEvent{}", i % EventNameCount);
+
+            EventBus.ListenNetworkEvent(NetworkEventRegistration { ReceiverId.c_str(), EventName.c_str() },
+                [&CallbackCount](const csp::common::NetworkEventData& /*NetworkEventData*/) { ++CallbackCount; });
+        }
+
+        const auto RegisteredStart = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < Dispatches; ++i)
+        {
+            EventBus.DispatchEventMessage(RegisteredEvent);
+        }
+
+        const auto RegisteredTime = std::chrono::steady_clock::now() - RegisteredStart;
+        const auto UnregisteredStart = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < Dispatches; ++i)
+        {
+            EventBus.DispatchEventMessage(UnregisteredEvent);
+        }
+
+        const auto UnregisteredTime = std::chrono::steady_clock::now() - UnregisteredStart;
+
+        EXPECT_EQ(CallbackCount, static_cast<size_t>(Dispatches) * (RegistrationCount / EventNameCount));
+
+        RecordProperty("RegisteredNanosecondsPerEvent" + std::to_string(RegistrationCount), NanosecondsPerDispatch(RegisteredTime));
+        RecordProperty("UnregisteredNanosecondsPerEvent" + std::to_string(RegistrationCount), NanosecondsPerDispatch(UnregisteredTime));
+    }
+}
+
 CSP_PUBLIC_TEST(DISABLED_CSPEngine, EventBusTests, TestMulticastEventToAllClients)
 {
     // Spin up 2 other clients
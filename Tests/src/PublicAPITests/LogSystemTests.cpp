@@ -14,15 +14,21 @@
  * limitations under the License.
  */
 #include "Awaitable.h"
+#include "AllocationCounter.h"
 #include "CSP/CSPFoundation.h"
 #include "CSP/Common/Systems/Log/LogSystem.h"
 #include "CSP/Systems/SystemsManager.h"
+#include "Common/Systems/Log/LogMacros.h"
 #include "Debug/Logging.h"
 #include "TestHelpers.h"
 #include "UserSystemTestHelpers.h"
 
 #include "gtest/gtest.h"
 #include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 void LogMessageLevelTest(const csp::common::LogLevel Level, const csp::common::String& TestMsg, std::atomic_bool& LogConfirmed, bool Expected)
 {
@@ -683,4 +689,169 @@ CSP_INTERNAL_TEST(CSPEngine, LogSystemTests, FailureMessageTest)
     EXPECT_TRUE(LogConfirmed);
 
     csp::CSPFoundation::Shutdown();
-}
\ No newline at end of file
+}
+
+namespace
+{
+
+int EvaluateLogArgument(int& EvaluationCount)
+{
+    ++EvaluationCount;
+    return 42;
+}
+
+}
+
+CSP_INTERNAL_TEST(CSPEngine, LogSystemTests, LazyLogFilteredMessageDoesNotAllocateTest)
+{
+    csp::common::LogSystem LogSystem;
+    LogSystem.SetSystemLevel(csp::common::LogLevel::Error);
+
+    csp::common::String LoggedMessage;
+    LogSystem.SetLogCallback([&LoggedMessage](csp::common::LogLevel, const csp::common::String& InMessage) { LoggedMessage = InMessage; });
+
+    int EvaluationCount = 0;
+
+    {
+        ScopedAllocationCounter Allocations;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            CSP_LOG_LAZY(&LogSystem, csp::common::LogLevel::VeryVerbose, "Filtered message {} {}", EvaluateLogArgument(EvaluationCount),
+                std::string(64, 'x'));
+        }
+
+        // Filtered out messages shouldn't format, allocate, or even evaluate their arguments.
+        EXPECT_EQ(Allocations.GetCount(), 0);
+    }
+
+    EXPECT_EQ(EvaluationCount, 0);
+    EXPECT_TRUE(LoggedMessage.IsEmpty());
+
+    CSP_LOG_LAZY(&LogSystem, csp::common::LogLevel::Error, "Logged message {}", EvaluateLogArgument(EvaluationCount));
+
+    EXPECT_EQ(EvaluationCount, 1);
+    EXPECT_EQ(LoggedMessage, "Logged message 42");
+
+    // A null log system is allowed, and logs nothing.
+    CSP_LOG_LAZY(nullptr, csp::common::LogLevel::Error, "Logged message {}", EvaluateLogArgument(EvaluationCount));
+
+    EXPECT_EQ(EvaluationCount, 1);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, LogSystemTests, AsyncLoggingDispatchesInOrderOffThreadTest)
+{
+    csp::common::LogSystem LogSystem;
+
+    std::mutex MessagesMutex;
+    std::vector<std::string> Messages;
+    std::atomic_bool DispatchedOnCallingThread = false;
+    const auto CallingThreadId = std::this_thread::get_id();
+
+    LogSystem.SetLogCallback(
+        [&](csp::common::LogLevel, const csp::common::String& InMessage)
+        {
+            std::scoped_lock MessagesLocker(MessagesMutex);
+            Messages.emplace_back(InMessage.c_str());
+
+            if (std::this_thread::get_id() == CallingThreadId)
+            {
+                DispatchedOnCallingThread = true;
+            }
+        });
+
+    LogSystem.SetAsyncLoggingEnabled(true);
+
+    constexpr int MessageCount = 1000;
+
+    for (int i = 0; i < MessageCount; ++i)
+    {
+        LogSystem.LogMsg(csp::common::LogLevel::Log, std::to_string(i).c_str());
+    }
+
+    LogSystem.FlushLogs();
+
+    {
+        std::scoped_lock MessagesLocker(MessagesMutex);
+        ASSERT_EQ(Messages.size(), MessageCount);
+
+        for (int i = 0; i < MessageCount; ++i)
+        {
+            EXPECT_EQ(Messages[i], std::to_string(i));
+        }
+    }
+
+    EXPECT_FALSE(DispatchedOnCallingThread);
+
+    // Once disabled, messages are handled on the calling thread again.
+    LogSystem.SetAsyncLoggingEnabled(false);
+
+    LogSystem.SetLogCallback([&](csp::common::LogLevel, const csp::common::String&)
+        { DispatchedOnCallingThread = std::this_thread::get_id() == CallingThreadId; });
+
+    LogSystem.LogMsg(csp::common::LogLevel::Log, "Synchronous");
+
+    EXPECT_TRUE(DispatchedOnCallingThread);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, LogSystemTests, AsyncLoggingFlushFromCallbackTest)
+{
+    csp::common::LogSystem LogSystem;
+
+    std::atomic_int CallbackCount = 0;
+
+    // Flushing and disabling from a log callback would otherwise wait on the thread the callback is running on.
+    LogSystem.SetLogCallback(
+        [&](csp::common::LogLevel, const csp::common::String&)
+        {
+            LogSystem.FlushLogs();
+            ++CallbackCount;
+        });
+
+    LogSystem.SetAsyncLoggingEnabled(true);
+
+    constexpr int MessageCount = 100;
+
+    for (int i = 0; i < MessageCount; ++i)
+    {
+        LogSystem.LogMsg(csp::common::LogLevel::Log, std::to_string(i).c_str());
+    }
+
+    LogSystem.FlushLogs();
+
+    EXPECT_EQ(CallbackCount, MessageCount);
+
+    LogSystem.SetAsyncLoggingEnabled(false);
+}
+
+CSP_INTERNAL_TEST(CSPEngine, LogSystemTests, AsyncLoggingEnabledConcurrentlyTest)
+{
+    csp::common::LogSystem LogSystem;
+
+    std::atomic_int CallbackCount = 0;
+    LogSystem.SetLogCallback([&](csp::common::LogLevel, const csp::common::String&) { ++CallbackCount; });
+
+    constexpr int ThreadCount = 8;
+    std::vector<std::thread> Threads;
+
+    for (int i = 0; i < ThreadCount; ++i)
+    {
+        Threads.emplace_back(
+            [&LogSystem]()
+            {
+                LogSystem.SetAsyncLoggingEnabled(true);
+                LogSystem.LogMsg(csp::common::LogLevel::Log, "Message");
+            });
+    }
+
+    for (std::thread& Thread : Threads)
+    {
+        Thread.join();
+    }
+
+    LogSystem.FlushLogs();
+
+    EXPECT_EQ(CallbackCount, ThreadCount);
+
+    LogSystem.SetAsyncLoggingEnabled(false);
+}
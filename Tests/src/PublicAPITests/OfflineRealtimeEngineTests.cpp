@@ -24,14 +24,22 @@
 #include "CSP/Systems/Spaces/SpaceSystem.h"
 #include "CSP/Systems/SystemsManager.h"
 #include "CSP/Systems/Users/UserSystem.h"
+#include "Multiplayer/SpaceEntityIndex.h"
 #include "UserSystemTestHelpers.h"
 
 #include "TestHelpers.h"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace csp;
 using namespace csp::multiplayer;
@@ -947,4 +955,754 @@ CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, IsModifiableTest)
 
     // Entity should be modifiable again.
     EXPECT_EQ(Engine.IsEntityModifiable(Entity), ModifiableStatus::Modifiable);
-}
\ No newline at end of file
+}
+
+/*
+    Ensures cached global transforms are invalidated when an ancestor moves or an entity is reparented,
+    and that OfflineRealtimeEngine::UpdateGlobalTransforms brings every dirty entity up to date, walking down from the moved entities.
+*/
+CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, GlobalTransformCacheTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    CSPSceneDescription SceneDescription;
+    OfflineRealtimeEngine Engine { SceneDescription, *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    SpaceEntity* Entity1 = nullptr;
+    SpaceEntity* Entity2 = nullptr;
+    SpaceEntity* Entity3 = nullptr;
+
+    SpaceTransform Transform {};
+    Transform.Position = csp::common::Vector3 { 1.0f, 0.0f, 0.0f };
+
+    Engine.CreateEntity("Entity1", Transform, nullptr, [&Entity1](SpaceEntity* NewEntity) { Entity1 = NewEntity; });
+    Engine.CreateEntity("Entity2", Transform, Entity1->GetId(), [&Entity2](SpaceEntity* NewEntity) { Entity2 = NewEntity; });
+    Engine.CreateEntity("Entity3", Transform, Entity2->GetId(), [&Entity3](SpaceEntity* NewEntity) { Entity3 = NewEntity; });
+
+    EXPECT_EQ(Entity3->GetGlobalPosition(), (csp::common::Vector3 { 3.0f, 0.0f, 0.0f }));
+    EXPECT_FALSE(Entity3->IsGlobalTransformDirty());
+
+    // Moving the root should invalidate every descendant.
+    Entity1->SetPosition(csp::common::Vector3 { 10.0f, 0.0f, 0.0f });
+
+    EXPECT_TRUE(Entity2->IsGlobalTransformDirty());
+    EXPECT_TRUE(Entity3->IsGlobalTransformDirty());
+    EXPECT_EQ(Entity3->GetGlobalPosition(), (csp::common::Vector3 { 12.0f, 0.0f, 0.0f }));
+
+    // Reparenting should invalidate the moved entity.
+    Entity3->SetParentId(Entity1->GetId());
+
+    EXPECT_TRUE(Entity3->IsGlobalTransformDirty());
+    EXPECT_EQ(Entity3->GetGlobalPosition(), (csp::common::Vector3 { 11.0f, 0.0f, 0.0f }));
+
+    Entity3->RemoveParentEntity();
+
+    EXPECT_EQ(Entity3->GetGlobalPosition(), (csp::common::Vector3 { 1.0f, 0.0f, 0.0f }));
+
+    // The batch update should leave nothing dirty.
+    Entity3->SetParentId(Entity2->GetId());
+    Entity1->SetPosition(csp::common::Vector3 { 0.0f, 0.0f, 0.0f });
+
+    Engine.UpdateGlobalTransforms();
+
+    EXPECT_FALSE(Entity1->IsGlobalTransformDirty());
+    EXPECT_FALSE(Entity2->IsGlobalTransformDirty());
+    EXPECT_FALSE(Entity3->IsGlobalTransformDirty());
+    EXPECT_EQ(Entity3->GetGlobalPosition(), (csp::common::Vector3 { 2.0f, 0.0f, 0.0f }));
+
+    // A moved root that has since been queried should still have its descendants brought up to date.
+    Entity1->SetPosition(csp::common::Vector3 { 5.0f, 0.0f, 0.0f });
+
+    EXPECT_EQ(Entity1->GetGlobalPosition(), (csp::common::Vector3 { 5.0f, 0.0f, 0.0f }));
+    EXPECT_TRUE(Entity2->IsGlobalTransformDirty());
+
+    Engine.UpdateGlobalTransforms();
+
+    EXPECT_FALSE(Entity2->IsGlobalTransformDirty());
+    EXPECT_FALSE(Entity3->IsGlobalTransformDirty());
+    EXPECT_EQ(Entity3->GetGlobalPosition(), (csp::common::Vector3 { 7.0f, 0.0f, 0.0f }));
+}
+
+/*
+    Ensures threads that query global transforms at the same time, and so race to fill the same caches, all see the right values.
+*/
+CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, GlobalTransformConcurrentQueryTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    OfflineRealtimeEngine Engine { *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    constexpr int Depth = 16;
+    constexpr int ThreadCount = 4;
+
+    SpaceTransform Transform {};
+    Transform.Position = csp::common::Vector3 { 1.0f, 0.0f, 0.0f };
+
+    std::vector<SpaceEntity*> Hierarchy;
+    Engine.CreateEntity("Root", Transform, nullptr, [&Hierarchy](SpaceEntity* NewEntity) { Hierarchy.push_back(NewEntity); });
+
+    for (int i = 1; i < Depth; ++i)
+    {
+        Engine.CreateEntity("Child", Transform, Hierarchy.back()->GetId(), [&Hierarchy](SpaceEntity* NewEntity) { Hierarchy.push_back(NewEntity); });
+    }
+
+    ASSERT_EQ(Hierarchy.size(), Depth);
+
+    for (int Round = 0; Round < 10; ++Round)
+    {
+        // Moving the root invalidates every cache in the hierarchy.
+        Hierarchy.front()->SetPosition(csp::common::Vector3 { static_cast<float>(Round + 1), 0.0f, 0.0f });
+
+        std::atomic<int> WrongResults = 0;
+        std::vector<std::thread> Threads;
+
+        for (int t = 0; t < ThreadCount; ++t)
+        {
+            // Each thread starts from a different depth, so some fill caches on the way up to ones another thread is filling.
+            Threads.emplace_back(
+                [&Hierarchy, &WrongResults, Round, t]()
+                {
+                    for (int i = Depth - 1 - t; i >= 0; --i)
+                    {
+                        if (Hierarchy[i]->GetGlobalPosition().X != static_cast<float>(Round + 1 + i))
+                        {
+                            ++WrongResults;
+                        }
+                    }
+                });
+        }
+
+        for (std::thread& Thread : Threads)
+        {
+            Thread.join();
+        }
+
+        EXPECT_EQ(WrongResults, 0);
+    }
+}
+
+/*
+    Measures repeated global transform queries at the bottom of a deep hierarchy, which are served from the cache
+    rather than walking every ancestor.
+    Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+*/
+CSP_PUBLIC_TEST(DISABLED_CSPEngine, OfflineRealtimeEngineTests, GlobalTransformDeepHierarchyBenchmark)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    CSPSceneDescription SceneDescription;
+    OfflineRealtimeEngine Engine { SceneDescription, *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    constexpr int Depth = 64;
+    constexpr int Queries = 100000;
+
+    SpaceTransform Transform {};
+    Transform.Position = csp::common::Vector3 { 1.0f, 0.0f, 0.0f };
+
+    SpaceEntity* Root = nullptr;
+    SpaceEntity* Leaf = nullptr;
+
+    Engine.CreateEntity("Root", Transform, nullptr, [&Root](SpaceEntity* NewEntity) { Root = NewEntity; });
+    Leaf = Root;
+
+    for (int i = 1; i < Depth; ++i)
+    {
+        Engine.CreateEntity("Child", Transform, Leaf->GetId(), [&Leaf](SpaceEntity* NewEntity) { Leaf = NewEntity; });
+    }
+
+    const auto Start = std::chrono::steady_clock::now();
+    float Sum = 0.0f;
+
+    for (int i = 0; i < Queries; ++i)
+    {
+        Sum += Leaf->GetGlobalPosition().X;
+    }
+
+    const auto Elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+
+    EXPECT_EQ(Leaf->GetGlobalPosition(), (csp::common::Vector3 { static_cast<float>(Depth), 0.0f, 0.0f }));
+    EXPECT_GT(Sum, 0.0f);
+
+    RecordProperty("QueryMicroseconds", static_cast<int>(Elapsed));
+
+    Root->SetPosition(csp::common::Vector3 { 2.0f, 0.0f, 0.0f });
+    Engine.UpdateGlobalTransforms();
+
+    EXPECT_FALSE(Leaf->IsGlobalTransformDirty());
+    EXPECT_EQ(Leaf->GetGlobalPosition(), (csp::common::Vector3 { static_cast<float>(Depth + 1), 0.0f, 0.0f }));
+}
+
+/*
+    Ensures a binary checkpoint round-trips with the json form, preserving every entity and the hierarchy,
+    and that a damaged checkpoint loads the entities before the damage without crashing.
+*/
+CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, CheckpointRoundTripTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    auto FilePath = std::filesystem::absolute("assets/checkpoint-parents.json");
+
+    std::ifstream Stream { FilePath.u8string().c_str() };
+
+    if (!Stream)
+    {
+        FAIL();
+    }
+
+    std::stringstream SStream;
+    SStream << Stream.rdbuf();
+
+    std::string Json = SStream.str();
+
+    CSPSceneDescription JsonSceneDescription { csp::common::List<csp::common::String> { Json.c_str() } };
+    OfflineRealtimeEngine JsonEngine { JsonSceneDescription, *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    ASSERT_GT(JsonEngine.GetNumEntities(), 1);
+
+    const CSPSceneDescription Checkpoint = JsonEngine.CreateCheckpoint();
+    ASSERT_TRUE(Checkpoint.IsCheckpoint());
+    EXPECT_FALSE(JsonSceneDescription.IsCheckpoint());
+
+    // Copy the checkpoint out, as if it had been saved to a file and loaded back in.
+    const char* CheckpointBytes = static_cast<const char*>(Checkpoint.GetCheckpointData());
+    const std::vector<char> SavedCheckpoint(CheckpointBytes, CheckpointBytes + Checkpoint.GetCheckpointDataLength());
+
+    CSPSceneDescription LoadedCheckpoint { SavedCheckpoint.data(), SavedCheckpoint.size() };
+    OfflineRealtimeEngine CheckpointEngine { LoadedCheckpoint, *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    EXPECT_EQ(CheckpointEngine.GetNumEntities(), JsonEngine.GetNumEntities());
+    EXPECT_EQ(CheckpointEngine.GetRootHierarchyEntities()->Size(), JsonEngine.GetRootHierarchyEntities()->Size());
+    EXPECT_EQ(CheckpointEngine.CreateSceneDescriptionJson(), JsonEngine.CreateSceneDescriptionJson());
+
+    for (size_t i = 0; i < JsonEngine.GetNumEntities(); ++i)
+    {
+        SpaceEntity* Expected = JsonEngine.GetEntityByIndex(i);
+        SpaceEntity* Actual = CheckpointEngine.FindSpaceEntityById(Expected->GetId());
+
+        ASSERT_NE(Actual, nullptr);
+        EXPECT_EQ(Actual->GetName(), Expected->GetName());
+        ASSERT_EQ(Actual->GetParentId().HasValue(), Expected->GetParentId().HasValue());
+
+        if (Expected->GetParentId().HasValue())
+        {
+            EXPECT_EQ(*Actual->GetParentId(), *Expected->GetParentId());
+        }
+
+        EXPECT_EQ(Actual->GetComponents()->Size(), Expected->GetComponents()->Size());
+    }
+
+    // Going back to json and then to a checkpoint again should give identical bytes.
+    CSPSceneDescription ExportedJson { csp::common::List<csp::common::String> { CheckpointEngine.CreateSceneDescriptionJson() } };
+    OfflineRealtimeEngine ExportedJsonEngine { ExportedJson, *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    const CSPSceneDescription SecondCheckpoint = ExportedJsonEngine.CreateCheckpoint();
+
+    ASSERT_EQ(SecondCheckpoint.GetCheckpointDataLength(), SavedCheckpoint.size());
+    EXPECT_EQ(std::memcmp(SecondCheckpoint.GetCheckpointData(), SavedCheckpoint.data(), SavedCheckpoint.size()), 0);
+
+    // A truncated checkpoint should load every object before the point it was cut off.
+    CSPSceneDescription TruncatedCheckpoint { SavedCheckpoint.data(), SavedCheckpoint.size() - 1 };
+    OfflineRealtimeEngine TruncatedEngine { TruncatedCheckpoint, *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    EXPECT_EQ(TruncatedEngine.GetNumEntities(), JsonEngine.GetNumEntities() - 1);
+}
+
+/*
+    Measures saving and loading 100k entities as a binary checkpoint, compared to json.
+    Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+*/
+CSP_PUBLIC_TEST(DISABLED_CSPEngine, OfflineRealtimeEngineTests, CheckpointBenchmark)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    constexpr size_t EntityCount = 100000;
+
+    OfflineRealtimeEngine Engine { *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    SpaceEntity* Parent = nullptr;
+
+    for (size_t i = 0; i < EntityCount; ++i)
+    {
+        SpaceTransform Transform {};
+        Transform.Position = csp::common::Vector3 { static_cast<float>(i), 0.0f, 0.0f };
+
+        // Give the scene some hierarchy, with every tenth entity starting a new group.
+        const csp::common::Optional<uint64_t> ParentId = (i % 10 == 0 || Parent == nullptr) ? csp::common::Optional<uint64_t> {}
+                                                                                              : csp::common::Optional<uint64_t> { Parent->GetId() };
+
+        Engine.CreateEntity("Entity", Transform, ParentId,
+            [&Parent, i](SpaceEntity* NewEntity)
+            {
+                if (i % 10 == 0)
+                {
+                    Parent = NewEntity;
+                }
+            });
+    }
+
+    ASSERT_EQ(Engine.GetNumEntities(), EntityCount);
+
+    const auto Milliseconds = [](auto Duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(Duration).count()); };
+
+    auto Start = std::chrono::steady_clock::now();
+    const CSPSceneDescription Checkpoint = Engine.CreateCheckpoint();
+    const auto CheckpointSaveTime = std::chrono::steady_clock::now() - Start;
+
+    Start = std::chrono::steady_clock::now();
+    const csp::common::String Json = Engine.CreateSceneDescriptionJson();
+    const auto JsonSaveTime = std::chrono::steady_clock::now() - Start;
+
+    // Clients load checkpoints from their own buffers, which the description copies.
+    Start = std::chrono::steady_clock::now();
+    const CSPSceneDescription LoadedCheckpoint { Checkpoint.GetCheckpointData(), Checkpoint.GetCheckpointDataLength() };
+    const auto CheckpointCopyTime = std::chrono::steady_clock::now() - Start;
+
+    Start = std::chrono::steady_clock::now();
+    OfflineRealtimeEngine CheckpointEngine { LoadedCheckpoint, *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+    const auto CheckpointLoadTime = std::chrono::steady_clock::now() - Start;
+
+    Start = std::chrono::steady_clock::now();
+    OfflineRealtimeEngine JsonEngine { CSPSceneDescription { csp::common::List<csp::common::String> { Json } }, *SystemsManager.GetLogSystem(),
+        *SystemsManager.GetScriptSystem() };
+    const auto JsonLoadTime = std::chrono::steady_clock::now() - Start;
+
+    EXPECT_EQ(CheckpointEngine.GetNumEntities(), EntityCount);
+    EXPECT_EQ(JsonEngine.GetNumEntities(), EntityCount);
+    EXPECT_EQ(CheckpointEngine.GetRootHierarchyEntities()->Size(), Engine.GetRootHierarchyEntities()->Size());
+
+    RecordProperty("CheckpointBytes", static_cast<int>(Checkpoint.GetCheckpointDataLength()));
+    RecordProperty("CheckpointSaveMilliseconds", Milliseconds(CheckpointSaveTime));
+    RecordProperty("CheckpointCopyMilliseconds", Milliseconds(CheckpointCopyTime));
+    RecordProperty("CheckpointLoadMilliseconds", Milliseconds(CheckpointLoadTime));
+    RecordProperty("JsonBytes", static_cast<int>(Json.Length()));
+    RecordProperty("JsonSaveMilliseconds", Milliseconds(JsonSaveTime));
+    RecordProperty("JsonLoadMilliseconds", Milliseconds(JsonLoadTime));
+}
+
+namespace
+{
+std::vector<uint64_t> SortedIds(const csp::common::List<SpaceEntity*>& Entities)
+{
+    std::vector<uint64_t> Ids;
+
+    for (size_t i = 0; i < Entities.Size(); ++i)
+    {
+        Ids.push_back(Entities[i]->GetId());
+    }
+
+    std::sort(Ids.begin(), Ids.end());
+
+    return Ids;
+}
+}
+
+/*
+    Ensures the radius, nearest and frustum queries find entities by their global position, and follow them as they move, are reparented
+    and are destroyed.
+*/
+CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, SpatialQueryTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    OfflineRealtimeEngine Engine { *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    const auto CreateEntityAt = [&Engine](const csp::common::Vector3& Position, const csp::common::Optional<uint64_t>& ParentId)
+    {
+        SpaceTransform Transform {};
+        Transform.Position = Position;
+
+        SpaceEntity* Created = nullptr;
+        Engine.CreateEntity("Entity", Transform, ParentId, [&Created](SpaceEntity* NewEntity) { Created = NewEntity; });
+
+        return Created;
+    };
+
+    SpaceEntity* EntityA = CreateEntityAt({ 0.0f, 0.0f, 0.0f }, nullptr);
+    SpaceEntity* EntityB = CreateEntityAt({ 5.0f, 0.0f, 0.0f }, nullptr);
+    SpaceEntity* EntityC = CreateEntityAt({ 50.0f, 0.0f, 0.0f }, nullptr);
+    SpaceEntity* EntityD = CreateEntityAt({ 1.0f, 0.0f, 0.0f }, EntityC->GetId());
+
+    const auto Ids = [](std::initializer_list<SpaceEntity*> Entities)
+    {
+        std::vector<uint64_t> Result;
+
+        for (SpaceEntity* Entity : Entities)
+        {
+            Result.push_back(Entity->GetId());
+        }
+
+        std::sort(Result.begin(), Result.end());
+
+        return Result;
+    };
+
+    EXPECT_EQ(SortedIds(Engine.FindSpaceEntitiesInRadius({ 0.0f, 0.0f, 0.0f }, 10.0f)), Ids({ EntityA, EntityB }));
+    EXPECT_EQ(SortedIds(Engine.FindSpaceEntitiesInRadius({ 51.0f, 0.0f, 0.0f }, 0.5f)), Ids({ EntityD }));
+    EXPECT_EQ(Engine.FindSpaceEntitiesInRadius({ 0.0f, 100.0f, 0.0f }, 10.0f).Size(), 0);
+
+    // A negative radius finds nothing, rather than searching within its magnitude.
+    EXPECT_EQ(Engine.FindSpaceEntitiesInRadius({ 0.0f, 0.0f, 0.0f }, -10.0f).Size(), 0);
+    EXPECT_EQ(Engine.FindSpaceEntitiesInRadius({ 0.0f, 0.0f, 0.0f }, 0.0f).Size(), 1);
+
+    // Nearest first, and capped at the number of entities.
+    auto Nearest = Engine.FindNearestSpaceEntities({ 52.0f, 0.0f, 0.0f }, 3);
+    ASSERT_EQ(Nearest.Size(), 3);
+    EXPECT_EQ(Nearest[0], EntityD);
+    EXPECT_EQ(Nearest[1], EntityC);
+    EXPECT_EQ(Nearest[2], EntityB);
+    EXPECT_EQ(Engine.FindNearestSpaceEntities({ 0.0f, 0.0f, 0.0f }, 10).Size(), 4);
+
+    // A box from x = -1 to x = 6, with inward facing normals.
+    const csp::common::List<csp::common::Vector4> Box { { 1.0f, 0.0f, 0.0f, 1.0f }, { -1.0f, 0.0f, 0.0f, 6.0f }, { 0.0f, 1.0f, 0.0f, 1.0f },
+        { 0.0f, -1.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, -1.0f, 1.0f } };
+    EXPECT_EQ(SortedIds(Engine.FindSpaceEntitiesInFrustum(Box)), Ids({ EntityA, EntityB }));
+
+    // Moving a parent moves its children too.
+    EntityB->SetPosition({ 48.0f, 0.0f, 0.0f });
+    EntityC->SetPosition({ 100.0f, 0.0f, 0.0f });
+
+    EXPECT_EQ(SortedIds(Engine.FindSpaceEntitiesInRadius({ 0.0f, 0.0f, 0.0f }, 10.0f)), Ids({ EntityA }));
+    EXPECT_EQ(SortedIds(Engine.FindSpaceEntitiesInRadius({ 101.0f, 0.0f, 0.0f }, 0.5f)), Ids({ EntityD }));
+    EXPECT_EQ(SortedIds(Engine.FindSpaceEntitiesInFrustum(Box)), Ids({ EntityA }));
+
+    Nearest = Engine.FindNearestSpaceEntities({ 50.0f, 0.0f, 0.0f }, 1);
+    ASSERT_EQ(Nearest.Size(), 1);
+    EXPECT_EQ(Nearest[0], EntityB);
+
+    // Reparenting moves the child to where its new parent is.
+    EntityD->SetParentId(EntityA->GetId());
+
+    EXPECT_EQ(SortedIds(Engine.FindSpaceEntitiesInRadius({ 0.0f, 0.0f, 0.0f }, 10.0f)), Ids({ EntityA, EntityD }));
+
+    Engine.DestroyEntity(EntityA, [](bool) {});
+
+    EXPECT_EQ(SortedIds(Engine.FindSpaceEntitiesInRadius({ 0.0f, 0.0f, 0.0f }, 10.0f)), Ids({ EntityD }));
+    EXPECT_EQ(Engine.FindNearestSpaceEntities({ 0.0f, 0.0f, 0.0f }, 10).Size(), 3);
+}
+
+/*
+    Ensures the entity index follows entities as they are added and destroyed, and ignores a second entity claiming an id that is already indexed.
+*/
+CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, EntityIndexTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    OfflineRealtimeEngine Engine { *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+    SpaceEntityIndex& Index = *Engine.EntityIndex;
+
+    SpaceEntity* EntityA = nullptr;
+    SpaceEntity* EntityB = nullptr;
+    Engine.CreateEntity("EntityA", SpaceTransform {}, nullptr, [&EntityA](SpaceEntity* NewEntity) { EntityA = NewEntity; });
+    Engine.CreateEntity("EntityB", SpaceTransform {}, nullptr, [&EntityB](SpaceEntity* NewEntity) { EntityB = NewEntity; });
+
+    ASSERT_NE(EntityA, nullptr);
+    ASSERT_NE(EntityB, nullptr);
+
+    EXPECT_EQ(Index.Size(), 2);
+    EXPECT_EQ(Index.FindById(EntityA->GetId()), EntityA);
+    EXPECT_EQ(Index.FindById(EntityB->GetId()), EntityB);
+    EXPECT_EQ(Index.FindById(EntityA->GetId() + EntityB->GetId() + 1), nullptr);
+    EXPECT_EQ(Engine.FindSpaceEntityById(EntityB->GetId()), EntityB);
+
+    // Adding an entity twice leaves the index as it was.
+    EXPECT_FALSE(Index.Add(EntityA));
+    EXPECT_EQ(Index.Size(), 2);
+
+    // A different instance with an indexed id is not added, and removing it doesn't remove the entity that holds the id.
+    SpaceEntity Duplicate { &Engine, *SystemsManager.GetScriptSystem(), SystemsManager.GetLogSystem(), SpaceEntityType::Object, EntityA->GetId(),
+        "Duplicate", SpaceTransform {}, 0, nullptr, false, false };
+
+    EXPECT_FALSE(Index.Add(&Duplicate));
+    Index.Remove(&Duplicate);
+
+    EXPECT_EQ(Index.Size(), 2);
+    EXPECT_EQ(Index.FindById(EntityA->GetId()), EntityA);
+
+    const uint64_t EntityAId = EntityA->GetId();
+    Engine.DestroyEntity(EntityA, [](bool) {});
+
+    EXPECT_EQ(Index.Size(), 1);
+    EXPECT_EQ(Index.FindById(EntityAId), nullptr);
+    EXPECT_EQ(Engine.FindSpaceEntityById(EntityAId), nullptr);
+    EXPECT_EQ(Index.FindById(EntityB->GetId()), EntityB);
+}
+
+/*
+    Ensures the entities selected by a client are tracked through selection, reparenting and destruction.
+*/
+CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, EntitySelectionIndexTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    OfflineRealtimeEngine Engine { *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+    SpaceEntityIndex& Index = *Engine.EntityIndex;
+
+    const auto CreateEntity = [&Engine](const csp::common::String& Name)
+    {
+        SpaceEntity* Created = nullptr;
+        Engine.CreateEntity(Name, SpaceTransform {}, nullptr, [&Created](SpaceEntity* NewEntity) { Created = NewEntity; });
+
+        return Created;
+    };
+
+    const auto SelectedIds = [&Index]()
+    {
+        std::vector<uint64_t> Ids;
+
+        for (SpaceEntity* Entity : Index.GetEntitiesSelectedByClient(OfflineRealtimeEngine::LocalClientId()))
+        {
+            Ids.push_back(Entity->GetId());
+        }
+
+        std::sort(Ids.begin(), Ids.end());
+
+        return Ids;
+    };
+
+    SpaceEntity* Parent = CreateEntity("Parent");
+    SpaceEntity* Child = CreateEntity("Child");
+    SpaceEntity* Other = CreateEntity("Other");
+
+    ASSERT_NE(Parent, nullptr);
+    ASSERT_NE(Child, nullptr);
+    ASSERT_NE(Other, nullptr);
+
+    EXPECT_TRUE(SelectedIds().empty());
+
+    EXPECT_TRUE(Parent->Select());
+    EXPECT_TRUE(Child->Select());
+
+    const uint64_t ParentId = Parent->GetId();
+    const uint64_t ChildId = Child->GetId();
+    EXPECT_EQ(SelectedIds(), (std::vector<uint64_t> { std::min(ParentId, ChildId), std::max(ParentId, ChildId) }));
+
+    // Reparenting doesn't change what is selected.
+    Child->SetParentId(ParentId);
+    EXPECT_EQ(SelectedIds(), (std::vector<uint64_t> { std::min(ParentId, ChildId), std::max(ParentId, ChildId) }));
+
+    Child->RemoveParentEntity();
+    EXPECT_EQ(SelectedIds(), (std::vector<uint64_t> { std::min(ParentId, ChildId), std::max(ParentId, ChildId) }));
+
+    // Destroying a selected entity drops it from the selection.
+    Engine.DestroyEntity(Child, [](bool) {});
+    EXPECT_EQ(SelectedIds(), std::vector<uint64_t> { ParentId });
+
+    EXPECT_TRUE(Parent->Deselect());
+    EXPECT_TRUE(SelectedIds().empty());
+
+    EXPECT_TRUE(Other->Select());
+    EXPECT_EQ(SelectedIds(), std::vector<uint64_t> { Other->GetId() });
+
+    Engine.DestroyEntity(Other, [](bool) {});
+    EXPECT_TRUE(SelectedIds().empty());
+    EXPECT_TRUE(Index.GetEntitiesSelectedByClient(OfflineRealtimeEngine::LocalClientId()).empty());
+}
+
+/*
+    Ensures the name lookups find the first entity added with a name, and follow entities as they are renamed and destroyed.
+*/
+CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, NameIndexTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    OfflineRealtimeEngine Engine { *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    SpaceEntity* Object1 = nullptr;
+    SpaceEntity* Object2 = nullptr;
+    SpaceEntity* Avatar = nullptr;
+
+    Engine.CreateEntity("Shared", SpaceTransform {}, nullptr, [&Object1](SpaceEntity* NewEntity) { Object1 = NewEntity; });
+    Engine.CreateAvatar("Shared", "UserId", SpaceTransform {}, true, AvatarState::Idle, "AvatarId", AvatarPlayMode::Default,
+        LocomotionModel::Grounded, [&Avatar](SpaceEntity* NewAvatar) { Avatar = NewAvatar; });
+    Engine.CreateEntity("Shared", SpaceTransform {}, nullptr, [&Object2](SpaceEntity* NewEntity) { Object2 = NewEntity; });
+
+    EXPECT_EQ(Engine.FindSpaceEntity("Shared"), Object1);
+    EXPECT_EQ(Engine.FindSpaceObject("Shared"), Object1);
+    EXPECT_EQ(Engine.FindSpaceAvatar("Shared"), Avatar);
+    EXPECT_EQ(Engine.FindSpaceEntity("Missing"), nullptr);
+
+    auto Shared = Engine.FindSpaceEntitiesByName("Shared");
+    ASSERT_EQ(Shared.Size(), 3);
+    EXPECT_EQ(Shared[0], Object1);
+    EXPECT_EQ(Shared[1], Avatar);
+    EXPECT_EQ(Shared[2], Object2);
+
+    // Renaming keeps the entity's place in the add order, so the lookups still match a scan of the entity list.
+    Object1->SetName("Renamed");
+
+    EXPECT_EQ(Engine.FindSpaceEntity("Shared"), Avatar);
+    EXPECT_EQ(Engine.FindSpaceObject("Shared"), Object2);
+    EXPECT_EQ(Engine.FindSpaceEntity("Renamed"), Object1);
+
+    Object1->SetName("Shared");
+
+    EXPECT_EQ(Engine.FindSpaceEntity("Shared"), Object1);
+    EXPECT_EQ(Engine.FindSpaceEntity("Renamed"), nullptr);
+
+    Engine.DestroyEntity(Object1, [](bool) {});
+
+    EXPECT_EQ(Engine.FindSpaceObject("Shared"), Object2);
+    EXPECT_EQ(Engine.FindSpaceEntitiesByName("Shared").Size(), 2);
+}
+
+/*
+    Ensures the component type lookup follows components as they are added and removed, and picks up the components of loaded entities.
+*/
+CSP_PUBLIC_TEST(CSPEngine, OfflineRealtimeEngineTests, ComponentTypeIndexTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    OfflineRealtimeEngine Engine { *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    SpaceEntity* Entity1 = nullptr;
+    SpaceEntity* Entity2 = nullptr;
+
+    Engine.CreateEntity("Entity1", SpaceTransform {}, nullptr, [&Entity1](SpaceEntity* NewEntity) { Entity1 = NewEntity; });
+    Engine.CreateEntity("Entity2", SpaceTransform {}, nullptr, [&Entity2](SpaceEntity* NewEntity) { Entity2 = NewEntity; });
+
+    EXPECT_EQ(Engine.FindSpaceEntitiesWithComponent(ComponentType::StaticModel).Size(), 0);
+
+    ComponentBase* Model1 = Entity2->AddComponent(ComponentType::StaticModel);
+    ComponentBase* Model2 = Entity2->AddComponent(ComponentType::StaticModel);
+    Entity1->AddComponent(ComponentType::StaticModel);
+    Entity1->AddComponent(ComponentType::ScriptData);
+
+    auto WithModels = Engine.FindSpaceEntitiesWithComponent(ComponentType::StaticModel);
+    ASSERT_EQ(WithModels.Size(), 2);
+    EXPECT_EQ(WithModels[0], Entity1);
+    EXPECT_EQ(WithModels[1], Entity2);
+
+    auto WithScripts = Engine.FindSpaceEntitiesWithComponent(ComponentType::ScriptData);
+    ASSERT_EQ(WithScripts.Size(), 1);
+    EXPECT_EQ(WithScripts[0], Entity1);
+
+    // An entity stays in the set until its last component of the type is removed.
+    Entity2->RemoveComponent(Model1->GetId());
+    EXPECT_EQ(Engine.FindSpaceEntitiesWithComponent(ComponentType::StaticModel).Size(), 2);
+
+    Entity2->RemoveComponent(Model2->GetId());
+    WithModels = Engine.FindSpaceEntitiesWithComponent(ComponentType::StaticModel);
+    ASSERT_EQ(WithModels.Size(), 1);
+    EXPECT_EQ(WithModels[0], Entity1);
+
+    // Entities loaded from a checkpoint are indexed with the components they were created with.
+    OfflineRealtimeEngine LoadedEngine { Engine.CreateCheckpoint(), *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+    WithScripts = LoadedEngine.FindSpaceEntitiesWithComponent(ComponentType::ScriptData);
+    ASSERT_EQ(WithScripts.Size(), 1);
+    EXPECT_EQ(WithScripts[0]->GetId(), Entity1->GetId());
+
+    Engine.DestroyEntity(Entity1, [](bool) {});
+
+    EXPECT_EQ(Engine.FindSpaceEntitiesWithComponent(ComponentType::StaticModel).Size(), 0);
+    EXPECT_EQ(Engine.FindSpaceEntitiesWithComponent(ComponentType::ScriptData).Size(), 0);
+}
+
+/*
+    Measures the spatial queries at 10k and 100k entities, compared to scanning every entity.
+    Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+*/
+CSP_PUBLIC_TEST(DISABLED_CSPEngine, OfflineRealtimeEngineTests, SpatialQueryBenchmark)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    constexpr int Queries = 1000;
+    constexpr float QueryRadius = 20.0f;
+    constexpr size_t NearestCount = 10;
+
+    const auto Microseconds = [](auto Duration) { return static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(Duration).count()); };
+
+    for (const size_t EntityCount : { size_t { 10000 }, size_t { 100000 } })
+    {
+        OfflineRealtimeEngine Engine { *SystemsManager.GetLogSystem(), *SystemsManager.GetScriptSystem() };
+
+        // Spread the entities out at roughly the same density, so the queries find a similar number of entities at both sizes.
+        const float Extent = 10.0f * std::cbrt(static_cast<float>(EntityCount));
+
+        std::mt19937 Random { 1 };
+        std::uniform_real_distribution<float> Coordinate { -Extent, Extent };
+
+        for (size_t i = 0; i < EntityCount; ++i)
+        {
+            SpaceTransform Transform {};
+            Transform.Position = csp::common::Vector3 { Coordinate(Random), Coordinate(Random), Coordinate(Random) };
+
+            Engine.CreateEntity("Entity", Transform, nullptr, [](SpaceEntity*) {});
+        }
+
+        ASSERT_EQ(Engine.GetNumEntities(), EntityCount);
+
+        std::vector<csp::common::Vector3> Centres;
+
+        for (int i = 0; i < Queries; ++i)
+        {
+            Centres.push_back({ Coordinate(Random), Coordinate(Random), Coordinate(Random) });
+        }
+
+        size_t IndexedFound = 0;
+        auto Start = std::chrono::steady_clock::now();
+
+        for (const csp::common::Vector3& Centre : Centres)
+        {
+            IndexedFound += Engine.FindSpaceEntitiesInRadius(Centre, QueryRadius).Size();
+        }
+
+        const auto RadiusTime = std::chrono::steady_clock::now() - Start;
+
+        size_t ScannedFound = 0;
+        Start = std::chrono::steady_clock::now();
+
+        for (const csp::common::Vector3& Centre : Centres)
+        {
+            for (size_t i = 0; i < Engine.GetNumEntities(); ++i)
+            {
+                const csp::common::Vector3 Offset = Engine.GetEntityByIndex(i)->GetGlobalPosition() - Centre;
+
+                if (Offset.X * Offset.X + Offset.Y * Offset.Y + Offset.Z * Offset.Z <= QueryRadius * QueryRadius)
+                {
+                    ++ScannedFound;
+                }
+            }
+        }
+
+        const auto ScanTime = std::chrono::steady_clock::now() - Start;
+
+        EXPECT_EQ(IndexedFound, ScannedFound);
+
+        Start = std::chrono::steady_clock::now();
+
+        for (const csp::common::Vector3& Centre : Centres)
+        {
+            EXPECT_EQ(Engine.FindNearestSpaceEntities(Centre, NearestCount).Size(), NearestCount);
+        }
+
+        const auto NearestTime = std::chrono::steady_clock::now() - Start;
+
+        // A frustum looking down the x axis from each centre, with a 90 degree field of view and a far plane 100m away.
+        size_t FrustumFound = 0;
+        Start = std::chrono::steady_clock::now();
+
+        for (const csp::common::Vector3& Centre : Centres)
+        {
+            const float Diagonal = std::sqrt(0.5f);
+            const csp::common::List<csp::common::Vector4> Frustum {
+                { Diagonal, Diagonal, 0.0f, -Diagonal * (Centre.X + Centre.Y) },
+                { Diagonal, -Diagonal, 0.0f, -Diagonal * (Centre.X - Centre.Y) },
+                { Diagonal, 0.0f, Diagonal, -Diagonal * (Centre.X + Centre.Z) },
+                { Diagonal, 0.0f, -Diagonal, -Diagonal * (Centre.X - Centre.Z) },
+                { -1.0f, 0.0f, 0.0f, Centre.X + 100.0f },
+            };
+
+            FrustumFound += Engine.FindSpaceEntitiesInFrustum(Frustum).Size();
+        }
+
+        const auto FrustumTime = std::chrono::steady_clock::now() - Start;
+
+        const std::string Suffix = "Microseconds" + std::to_string(EntityCount);
+        RecordProperty("RadiusIndexed" + Suffix, Microseconds(RadiusTime));
+        RecordProperty("RadiusScan" + Suffix, Microseconds(ScanTime));
+        RecordProperty("Nearest" + Suffix, Microseconds(NearestTime));
+        RecordProperty("Frustum" + Suffix, Microseconds(FrustumTime));
+        EXPECT_GT(FrustumFound, 0);
+    }
+}
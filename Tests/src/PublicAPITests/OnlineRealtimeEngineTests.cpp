@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "CSP/Common/ContinuationUtils.h"
+#include "CSP/Multiplayer/Components/LightSpaceComponent.h"
 #include "CSP/Multiplayer/ContinuationUtils.h"
 #include "CSP/Multiplayer/MultiPlayerConnection.h"
 #include "CSP/Multiplayer/SpaceEntity.h"
@@ -23,13 +24,26 @@
 #include "Debug/Logging.h"
 #include "Mocks/SignalRConnectionMock.h"
 #include "Multiplayer/MCS/MCSTypes.h"
+#include "Multiplayer/EntityInterestManager.h"
+#include "Multiplayer/MCS/MCSMessagePack.h"
+#include "Multiplayer/MCSComponentPacker.h"
+#include "Multiplayer/OutgoingPatchScheduler.h"
+#include "Multiplayer/SignalRSerializer.h"
+#include "Multiplayer/SpaceEntityKeys.h"
+#include "Multiplayer/SpaceEntitySpatialIndex.h"
 #include "Multiplayer/SpaceEntityStatePatcher.h"
 #include "RAIIMockLogger.h"
 #include "TestHelpers.h"
 
 #include "signalrclient/signalr_value.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
 
 using namespace csp::multiplayer;
 
@@ -616,4 +630,698 @@ CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, CreateAvatarSen
 
     RealtimeEngine->CreateAvatar("Username", LoginState.UserId, Transform, true, AvatarState::Idle, "AvatarId", AvatarPlayMode::Default,
         LocomotionModel::Grounded, MockCallback.AsStdFunction());
-}
\ No newline at end of file
+}
+
+// Measures how many incoming position patches per second the engine can route to their entities, at increasing entity counts.
+// Patch routing is expected to stay roughly flat as the entity count grows, as entities are looked up by id rather than scanned.
+// Disabled by default, as it only reports timings. Run it with --gtest_also_run_disabled_tests, and --gtest_output=xml to see them.
+CSP_PUBLIC_TEST_WITH_MOCKS(DISABLED_CSPEngine, OnlineRealtimeEngineTests, IncomingPatchThroughputBenchmark)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto* LogSystem = SystemsManager.GetLogSystem();
+
+    // Keep per-patch logging out of the measurement, restoring the previous level however the test exits.
+    struct LogLevelRestorer
+    {
+        csp::common::LogSystem* LogSystem;
+        csp::common::LogLevel Level;
+
+        ~LogLevelRestorer() { LogSystem->SetSystemLevel(Level); }
+    } RestoreLogLevel { LogSystem, LogSystem->GetSystemLevel() };
+
+    LogSystem->SetSystemLevel(csp::common::LogLevel::Error);
+
+    MockScriptRunner Runner;
+    const SpaceTransform Transform = { csp::common::Vector3::Zero(), csp::common::Vector4::Identity(), csp::common::Vector3::One() };
+
+    for (const size_t EntityCount : { 1000u, 10000u, 50000u })
+    {
+        std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+        for (size_t i = 0; i < EntityCount; ++i)
+        {
+            RealtimeEngine->GetPendingAdds()->push_back(
+                new SpaceEntity(RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, i + 1, "Entity", Transform, 0, {}, true, false));
+        }
+
+        RealtimeEngine->ProcessPendingEntityOperations();
+        ASSERT_EQ(RealtimeEngine->GetNumEntities(), EntityCount);
+
+        // Patch every entity once, in reverse order so that the worst case of a linear scan would be hit on every lookup.
+        for (size_t i = EntityCount; i > 0; --i)
+        {
+            MCSComponentPacker Packer;
+            Packer.WriteValue(SpaceEntityComponentKey::Position, csp::common::Vector3 { static_cast<float>(i), 0.0f, 0.0f });
+
+            mcs::ObjectPatch Patch { i, 0, false, false, std::nullopt, Packer.GetComponents() };
+
+            SignalRSerializer Serializer;
+            Serializer.WriteValue(Patch);
+
+            RealtimeEngine->OnObjectPatch(signalr::value { std::vector<signalr::value> { Serializer.Get() } });
+        }
+
+        const auto Start = std::chrono::steady_clock::now();
+        RealtimeEngine->ProcessPendingEntityOperations();
+        const auto End = std::chrono::steady_clock::now();
+
+        const double Seconds = std::chrono::duration<double>(End - Start).count();
+
+        RecordProperty("PatchesPerSecond" + std::to_string(EntityCount), static_cast<int>(static_cast<double>(EntityCount) / Seconds));
+
+        EXPECT_EQ(RealtimeEngine->FindSpaceEntityById(1)->GetPosition().X, 1.0f);
+        EXPECT_EQ(RealtimeEngine->FindSpaceEntityById(EntityCount)->GetPosition().X, static_cast<float>(EntityCount));
+    }
+}
+
+// Ensures that updating a single property on a component still writes the whole component into the outgoing patch, as the server keeps the
+// component from the latest patch, and that only the changed property is reported back to the client in the update callbacks.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, ComponentUpdatePatchContainsWholeComponentTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto* LogSystem = SystemsManager.GetLogSystem();
+
+    std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    MockScriptRunner Runner;
+    const SpaceTransform Transform = { csp::common::Vector3::Zero(), csp::common::Vector4::Identity(), csp::common::Vector3::One() };
+
+    RealtimeEngine->GetPendingAdds()->push_back(
+        new SpaceEntity(RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, 1, "Entity", Transform, 0, {}, true, false));
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    SpaceEntity* Entity = RealtimeEngine->FindSpaceEntityById(1);
+    ASSERT_NE(Entity, nullptr);
+
+    auto* LightComponent = static_cast<LightSpaceComponent*>(Entity->AddComponent(ComponentType::Light));
+    ASSERT_NE(LightComponent, nullptr);
+
+    const uint16_t ComponentId = LightComponent->GetId();
+
+    // Flush the add, which carries the whole component.
+    Entity->ApplyLocalPatch(false, false);
+
+    LightComponent->SetIntensity(42.0f);
+
+    EXPECT_EQ(LightComponent->GetDirtyProperties().Size(), 1);
+
+    const mcs::ObjectPatch Patch = Entity->GetStatePatcher()->CreateObjectPatch();
+    ASSERT_TRUE(Patch.GetComponents().has_value());
+
+    const auto& Components = *Patch.GetComponents();
+    ASSERT_EQ(Components.count(ComponentId), 1);
+
+    const auto& ComponentData = std::get<mcs::ComponentMap>(Components.at(ComponentId).GetValue());
+    EXPECT_EQ(ComponentData.size(), LightComponent->GetProperties()->Size() + 1);
+    EXPECT_EQ(ComponentData.count(COMPONENT_KEY_COMPONENTTYPE), 1);
+    EXPECT_EQ(ComponentData.count(static_cast<uint16_t>(LightPropertyKeys::Intensity)), 1);
+    EXPECT_EQ(ComponentData.count(static_cast<uint16_t>(LightPropertyKeys::Range)), 1);
+
+    int CallbackCount = 0;
+
+    Entity->SetUpdateCallback(
+        [&CallbackCount, ComponentId](SpaceEntity*, SpaceEntityUpdateFlags Flags, csp::common::Array<ComponentUpdateInfo>& UpdateInfo)
+        {
+            ++CallbackCount;
+
+            EXPECT_TRUE(Flags & UPDATE_FLAGS_COMPONENTS);
+            ASSERT_EQ(UpdateInfo.Size(), 1);
+            EXPECT_EQ(UpdateInfo[0].ComponentId, ComponentId);
+            EXPECT_EQ(UpdateInfo[0].UpdateType, ComponentUpdateType::Update);
+            ASSERT_EQ(UpdateInfo[0].PropertyInfo.Size(), 1);
+            EXPECT_EQ(UpdateInfo[0].PropertyInfo[0].PropertyId, static_cast<uint32_t>(LightPropertyKeys::Intensity));
+            EXPECT_EQ(UpdateInfo[0].PropertyInfo[0].UpdateType, ComponentUpdateType::Update);
+        });
+
+    Entity->ApplyLocalPatch(true, false);
+
+    EXPECT_EQ(CallbackCount, 1);
+    EXPECT_EQ(LightComponent->GetDirtyProperties().Size(), 0);
+
+    // Receiving the whole component back, after the intensity has moved on locally, only reports the intensity as changed.
+    LightComponent->SetIntensity(7.0f);
+    Entity->ApplyLocalPatch(true, false);
+    ASSERT_EQ(CallbackCount, 2);
+
+    SignalRSerializer Serializer;
+    Serializer.WriteValue(Patch);
+
+    RealtimeEngine->OnObjectPatch(signalr::value { std::vector<signalr::value> { Serializer.Get() } });
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    EXPECT_EQ(CallbackCount, 3);
+    EXPECT_EQ(LightComponent->GetIntensity(), 42.0f);
+}
+
+// Ensures that several patches received for one entity within a tick are merged, so the entity is updated, and its callback fired, only once.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, IncomingPatchesForOneEntityFireOneUpdateCallbackTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto* LogSystem = SystemsManager.GetLogSystem();
+
+    std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    MockScriptRunner Runner;
+    const SpaceTransform Transform = { csp::common::Vector3::Zero(), csp::common::Vector4::Identity(), csp::common::Vector3::One() };
+
+    RealtimeEngine->GetPendingAdds()->push_back(
+        new SpaceEntity(RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, 1, "Entity", Transform, 0, {}, true, false));
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    SpaceEntity* Entity = RealtimeEngine->FindSpaceEntityById(1);
+    ASSERT_NE(Entity, nullptr);
+
+    int CallbackCount = 0;
+    SpaceEntityUpdateFlags ReceivedFlags = static_cast<SpaceEntityUpdateFlags>(0);
+
+    Entity->SetUpdateCallback(
+        [&CallbackCount, &ReceivedFlags](SpaceEntity*, SpaceEntityUpdateFlags Flags, csp::common::Array<ComponentUpdateInfo>&)
+        {
+            ++CallbackCount;
+            ReceivedFlags = Flags;
+        });
+
+    const auto CreatePatch = [](SpaceEntityComponentKey Key, const auto& Value)
+    {
+        MCSComponentPacker Packer;
+        Packer.WriteValue(Key, Value);
+
+        return mcs::ObjectPatch { 1, 0, false, false, std::nullopt, Packer.GetComponents() };
+    };
+
+    // The connection hands patches over still encoded, but value trees from other connections must be merged with them all the same.
+    for (const float X : { 1.0f, 2.0f })
+    {
+        mcs::MessagePackWriter Writer;
+        Writer.Write(CreatePatch(SpaceEntityComponentKey::Position, csp::common::Vector3 { X, 0.0f, 0.0f }));
+
+        RealtimeEngine->OnObjectPatch(signalr::value { std::vector<signalr::value> { Writer.ToSignalRValue() } });
+    }
+
+    SignalRSerializer Serializer;
+    Serializer.WriteValue(CreatePatch(SpaceEntityComponentKey::Name, csp::common::String("Renamed")));
+
+    RealtimeEngine->OnObjectPatch(signalr::value { std::vector<signalr::value> { Serializer.Get() } });
+
+    const IncomingPatchMetrics MetricsBefore = RealtimeEngine->GetIncomingPatchMetrics();
+
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    EXPECT_EQ(CallbackCount, 1);
+    EXPECT_TRUE(ReceivedFlags & UPDATE_FLAGS_POSITION);
+    EXPECT_TRUE(ReceivedFlags & UPDATE_FLAGS_NAME);
+    EXPECT_EQ(Entity->GetPosition().X, 2.0f);
+    EXPECT_EQ(Entity->GetName(), "Renamed");
+
+    const IncomingPatchMetrics Metrics = RealtimeEngine->GetIncomingPatchMetrics();
+    EXPECT_EQ(Metrics.Received - MetricsBefore.Received, 3);
+    EXPECT_EQ(Metrics.Applied - MetricsBefore.Applied, 1);
+    EXPECT_EQ(Metrics.Coalesced - MetricsBefore.Coalesced, 2);
+}
+
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, CompactTransformOnlyUsedForTransientEntitiesTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto* LogSystem = SystemsManager.GetLogSystem();
+
+    std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    MockScriptRunner Runner;
+    const SpaceTransform Transform = { csp::common::Vector3::Zero(), csp::common::Vector4::Identity(), csp::common::Vector3::One() };
+
+    RealtimeEngine->GetPendingAdds()->push_back(
+        new SpaceEntity(RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, 1, "Persistent", Transform, 0, {}, true, true));
+    RealtimeEngine->GetPendingAdds()->push_back(
+        new SpaceEntity(RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, 2, "Transient", Transform, 0, {}, true, false));
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    SpaceEntity* PersistentEntity = RealtimeEngine->FindSpaceEntityById(1);
+    SpaceEntity* TransientEntity = RealtimeEngine->FindSpaceEntityById(2);
+    ASSERT_NE(PersistentEntity, nullptr);
+    ASSERT_NE(TransientEntity, nullptr);
+
+    const auto GetPositionType = [](const SpaceEntity& Entity)
+    {
+        const mcs::ObjectPatch Patch = Entity.GetStatePatcher()->CreateObjectPatch(true);
+        return Patch.GetComponents()->at(static_cast<uint16_t>(SpaceEntityComponentKey::Position)).GetType();
+    };
+
+    PersistentEntity->SetPosition({ 1.0f, 2.0f, 3.0f });
+    TransientEntity->SetPosition({ 1.0f, 2.0f, 3.0f });
+
+    EXPECT_NE(GetPositionType(*PersistentEntity), mcs::ItemComponentDataType::UINT64);
+    EXPECT_EQ(GetPositionType(*TransientEntity), mcs::ItemComponentDataType::UINT64);
+
+    // Once the transform has been sent, marking it dirty queues the unchanged values to be sent again.
+    TransientEntity->ApplyLocalPatch(false, false);
+    EXPECT_FALSE(TransientEntity->GetStatePatcher()->HasPendingPatch());
+
+    TransientEntity->GetStatePatcher()->MarkTransformDirty();
+
+    const auto DirtyProperties = TransientEntity->GetStatePatcher()->GetDirtyProperties();
+    ASSERT_EQ(DirtyProperties.count(SpaceEntityComponentKey::Position), 1);
+    EXPECT_EQ(DirtyProperties.at(SpaceEntityComponentKey::Position).GetVector3(), csp::common::Vector3(1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(DirtyProperties.count(SpaceEntityComponentKey::Rotation), 1);
+    EXPECT_EQ(DirtyProperties.count(SpaceEntityComponentKey::Scale), 1);
+}
+
+// Checks that the local avatar is always sent first, and that the rest are ordered by how long they have waited, weighted by priority,
+// with entities whose interval has not yet elapsed held back.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, OutgoingPatchSchedulerOrdersByPriorityTest)
+{
+    using namespace std::chrono_literals;
+
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto* LogSystem = SystemsManager.GetLogSystem();
+
+    std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    MockScriptRunner Runner;
+    const SpaceTransform Transform = { csp::common::Vector3::Zero(), csp::common::Vector4::Identity(), csp::common::Vector3::One() };
+    const uint64_t LocalClientId = 5;
+
+    SpaceEntity Avatar { RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Avatar, 1, "Avatar", Transform, LocalClientId, {}, true, false };
+    SpaceEntity Selected { RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, 2, "Selected", Transform, 0, {}, true, false };
+    SpaceEntity Prop { RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, 3, "Prop", Transform, 0, {}, true, false };
+
+    Avatar.GetStatePatcher()->SetTimeOfLastPatch(900ms);
+    Selected.GetStatePatcher()->SetTimeOfLastPatch(950ms);
+    Prop.GetStatePatcher()->SetTimeOfLastPatch(850ms);
+
+    const std::set<SpaceEntity*> Pending { &Avatar, &Selected, &Prop };
+    std::vector<SpaceEntity*> Ready;
+
+    OutgoingPatchScheduler Scheduler { 90ms };
+    Scheduler.SetEntityPriority(Selected.GetId(), EntityPatchPriority::High);
+
+    // Selected has only waited 50ms, so isn't ready yet.
+    Scheduler.SelectReadyEntities(Pending, 1000ms, LocalClientId, true, Ready);
+    EXPECT_EQ(Scheduler.GetPriority(&Avatar, LocalClientId), EntityPatchPriority::Critical);
+    EXPECT_EQ(Ready, (std::vector<SpaceEntity*> { &Avatar, &Prop }));
+
+    // Selected scores 50ms x 4 against Prop's 150ms x 2.
+    Scheduler.SetEntityInterval(Selected.GetId(), 10ms);
+    Scheduler.SelectReadyEntities(Pending, 1000ms, LocalClientId, true, Ready);
+    EXPECT_EQ(Ready, (std::vector<SpaceEntity*> { &Avatar, &Prop, &Selected }));
+
+    // Prop drops to 150ms x 1.
+    Scheduler.SetEntityPriority(Prop.GetId(), EntityPatchPriority::Low);
+    Scheduler.SelectReadyEntities(Pending, 1000ms, LocalClientId, true, Ready);
+    EXPECT_EQ(Ready, (std::vector<SpaceEntity*> { &Avatar, &Selected, &Prop }));
+
+    // With no rate limit, everything is ready regardless of interval.
+    Scheduler.ResetEntity(Selected.GetId());
+    Scheduler.SelectReadyEntities(Pending, 1000ms, LocalClientId, false, Ready);
+    EXPECT_EQ(Ready.size(), 3);
+
+    // A dirty component with a shorter interval makes the entity ready sooner.
+    Prop.AddComponent(ComponentType::Light);
+    Prop.GetStatePatcher()->SetTimeOfLastPatch(990ms);
+    Scheduler.SetComponentTypeInterval(ComponentType::Light, 5ms);
+    Scheduler.SelectReadyEntities(Pending, 1000ms, LocalClientId, true, Ready);
+    EXPECT_EQ(Ready, (std::vector<SpaceEntity*> { &Avatar, &Prop }));
+}
+
+// Checks that patches which don't fit in the byte budget are held back, and are sent on the following ticks.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, OutgoingPatchByteBudgetDefersPatchesTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto* LogSystem = SystemsManager.GetLogSystem();
+
+    std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    size_t SendObjectPatchesCount = 0;
+
+    EXPECT_CALL(*SignalRMock, Invoke)
+        .WillRepeatedly(
+            [&SendObjectPatchesCount](
+                const std::string& Method, const signalr::value&, std::function<void(const signalr::value&, std::exception_ptr)> Callback)
+            {
+                csp::multiplayer::MultiplayerHubMethodMap HubMethods;
+
+                if (Method == HubMethods.Get(csp::multiplayer::MultiplayerHubMethod::SEND_OBJECT_PATCHES))
+                {
+                    ++SendObjectPatchesCount;
+                }
+
+                const auto ExceptionPtr = std::exception_ptr { nullptr };
+                Callback(signalr::value {}, ExceptionPtr);
+
+                return async::make_task(std::make_tuple(signalr::value {}, ExceptionPtr));
+            });
+
+    MockScriptRunner Runner;
+    const SpaceTransform Transform = { csp::common::Vector3::Zero(), csp::common::Vector4::Identity(), csp::common::Vector3::One() };
+
+    for (uint64_t i = 1; i <= 3; ++i)
+    {
+        RealtimeEngine->GetPendingAdds()->push_back(
+            new SpaceEntity(RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, i, "Entity", Transform, 0, {}, true, false));
+    }
+
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    for (uint64_t i = 1; i <= 3; ++i)
+    {
+        SpaceEntity* Entity = RealtimeEngine->FindSpaceEntityById(i);
+        Entity->SetName("Renamed");
+        Entity->QueueUpdate();
+    }
+
+    // Any patch is bigger than a single byte, so only the one patch that is always allowed through is sent each tick.
+    RealtimeEngine->SetPatchByteBudget(1);
+
+    RealtimeEngine->ProcessPendingEntityOperations();
+    EXPECT_EQ(RealtimeEngine->GetOutgoingPatchMetrics().Sent, 1);
+    EXPECT_EQ(RealtimeEngine->GetOutgoingPatchMetrics().DeferredByBudget, 2);
+
+    RealtimeEngine->ProcessPendingEntityOperations();
+    RealtimeEngine->ProcessPendingEntityOperations();
+    EXPECT_EQ(RealtimeEngine->GetOutgoingPatchMetrics().Sent, 3);
+    EXPECT_EQ(SendObjectPatchesCount, 3);
+
+    for (uint64_t i = 1; i <= 3; ++i)
+    {
+        EXPECT_EQ(RealtimeEngine->FindSpaceEntityById(i)->GetName(), "Renamed");
+    }
+}
+
+// Checks that the per-entity patch settings warn about, rather than dereference, a null entity.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, EntityPatchSettingsRejectNullEntityTest)
+{
+    RAIIMockLogger MockLogger {};
+    csp::systems::SystemsManager::Get().GetLogSystem()->SetSystemLevel(csp::common::LogLevel::Log);
+
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    const csp::common::String PriorityMsg = "Attempting to set the patch priority of a null entity. Aborting operation.";
+    const csp::common::String IntervalMsg = "Attempting to set the patch interval of a null entity. Aborting operation.";
+    const csp::common::String ResetMsg = "Attempting to reset the patch settings of a null entity. Aborting operation.";
+
+    EXPECT_CALL(MockLogger.MockLogCallback, Call(csp::common::LogLevel::Warning, PriorityMsg)).Times(1);
+    EXPECT_CALL(MockLogger.MockLogCallback, Call(csp::common::LogLevel::Warning, IntervalMsg)).Times(1);
+    EXPECT_CALL(MockLogger.MockLogCallback, Call(csp::common::LogLevel::Warning, ResetMsg)).Times(1);
+
+    RealtimeEngine->SetEntityPatchPriority(nullptr, EntityPatchPriority::High);
+    RealtimeEngine->SetEntityPatchInterval(nullptr, 10);
+    RealtimeEngine->ResetEntityPatchSettings(nullptr);
+}
+
+// Checks that patches for entities outside the interest radius are held back and merged, and are applied once the entity comes back into range.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, InterestManagementDefersOutOfRangePatchesTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto* LogSystem = SystemsManager.GetLogSystem();
+
+    std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    MockScriptRunner Runner;
+    const uint64_t LocalClientId = RealtimeEngine->GetMultiplayerConnectionInstance()->GetClientId();
+
+    const auto AddEntity = [&](SpaceEntityType Type, uint64_t Id, const csp::common::Vector3& Position, uint64_t OwnerId)
+    {
+        const SpaceTransform Transform = { Position, csp::common::Vector4::Identity(), csp::common::Vector3::One() };
+        RealtimeEngine->GetPendingAdds()->push_back(
+            new SpaceEntity(RealtimeEngine.get(), Runner, LogSystem, Type, Id, "Entity", Transform, OwnerId, {}, true, false));
+    };
+
+    const auto ReceivePatch = [&](uint64_t Id, SpaceEntityComponentKey Key, const auto& Value)
+    {
+        MCSComponentPacker Packer;
+        Packer.WriteValue(Key, Value);
+
+        SignalRSerializer Serializer;
+        const uint64_t OwnerId = RealtimeEngine->FindSpaceEntityById(Id)->GetOwnerId();
+        Serializer.WriteValue(mcs::ObjectPatch { Id, OwnerId, false, false, std::nullopt, Packer.GetComponents() });
+
+        RealtimeEngine->OnObjectPatch(signalr::value { std::vector<signalr::value> { Serializer.Get() } });
+        RealtimeEngine->ProcessPendingEntityOperations();
+    };
+
+    AddEntity(SpaceEntityType::Avatar, 1, csp::common::Vector3::Zero(), LocalClientId);
+    AddEntity(SpaceEntityType::Object, 2, { 5.0f, 0.0f, 0.0f }, LocalClientId + 1);
+    AddEntity(SpaceEntityType::Object, 3, { 100.0f, 0.0f, 0.0f }, LocalClientId + 1);
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    SpaceEntity* Near = RealtimeEngine->FindSpaceEntityById(2);
+    SpaceEntity* Far = RealtimeEngine->FindSpaceEntityById(3);
+
+    RealtimeEngine->SetInterestRadius(20.0f);
+    RealtimeEngine->SetInterestCatchUpInterval(60000);
+
+    ReceivePatch(2, SpaceEntityComponentKey::Name, csp::common::String("Near"));
+    ReceivePatch(3, SpaceEntityComponentKey::Name, csp::common::String("First"));
+    ReceivePatch(3, SpaceEntityComponentKey::Name, csp::common::String("Second"));
+
+    EXPECT_EQ(Near->GetName(), "Near");
+    EXPECT_EQ(Far->GetName(), "Entity");
+    EXPECT_EQ(RealtimeEngine->GetInterestManagementMetrics().DeferredPatches, 2);
+
+    // A move into range is applied straight away, after the patch held for the entity.
+    ReceivePatch(3, SpaceEntityComponentKey::Position, csp::common::Vector3 { 10.0f, 0.0f, 0.0f });
+
+    EXPECT_EQ(Far->GetName(), "Second");
+    EXPECT_EQ(Far->GetPosition().X, 10.0f);
+    EXPECT_EQ(RealtimeEngine->GetInterestManagementMetrics().CaughtUpPatches, 1);
+
+    // Moving back out of range is applied, as the entity was in range when it arrived, but the next patch is held.
+    ReceivePatch(3, SpaceEntityComponentKey::Position, csp::common::Vector3 { 200.0f, 0.0f, 0.0f });
+    ReceivePatch(3, SpaceEntityComponentKey::Name, csp::common::String("Third"));
+
+    EXPECT_EQ(Far->GetName(), "Second");
+    EXPECT_EQ(RealtimeEngine->GetInterestManagementMetrics().DeferredPatches, 3);
+
+    // When the local avatar moves close to the entity, the held patch is applied on the following tick.
+    ReceivePatch(1, SpaceEntityComponentKey::Position, csp::common::Vector3 { 190.0f, 0.0f, 0.0f });
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    EXPECT_EQ(Far->GetName(), "Third");
+    EXPECT_EQ(RealtimeEngine->GetInterestManagementMetrics().CaughtUpPatches, 2);
+
+    // Once the catch-up interval has passed, held patches are applied whatever the distance.
+    RealtimeEngine->SetInterestCatchUpInterval(0);
+    ReceivePatch(2, SpaceEntityComponentKey::Name, csp::common::String("Caught up"));
+    RealtimeEngine->ProcessPendingEntityOperations();
+
+    EXPECT_EQ(Near->GetName(), "Caught up");
+    EXPECT_EQ(RealtimeEngine->GetInterestManagementMetrics().DeferredPatches, 4);
+    EXPECT_EQ(RealtimeEngine->GetInterestManagementMetrics().CaughtUpPatches, 3);
+}
+
+// Checks that out-of-range entities skip their script ticks until the catch-up interval, and are then ticked by the full time they missed.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, InterestManagementSkipsOutOfRangeScriptTicksTest)
+{
+    using namespace std::chrono_literals;
+
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto* LogSystem = SystemsManager.GetLogSystem();
+
+    std::unique_ptr<OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    MockScriptRunner Runner;
+
+    const auto MakeTransform
+        = [](float X) { return SpaceTransform { { X, 0.0f, 0.0f }, csp::common::Vector4::Identity(), csp::common::Vector3::One() }; };
+
+    SpaceEntity Avatar { RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Avatar, 1, "Avatar", MakeTransform(0.0f), 0, {}, true, false };
+    SpaceEntity Near { RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, 2, "Near", MakeTransform(15.0f), 0, {}, true, false };
+    SpaceEntity Far { RealtimeEngine.get(), Runner, LogSystem, SpaceEntityType::Object, 3, "Far", MakeTransform(-40.0f), 0, {}, true, false };
+
+    SpaceEntitySpatialIndex SpatialIndex;
+    SpatialIndex.Add(&Avatar);
+    SpatialIndex.Add(&Near);
+    SpatialIndex.Add(&Far);
+
+    std::vector<SpaceEntity*> InRange;
+    SpatialIndex.QueryRadius(csp::common::Vector3::Zero(), 20.0f, InRange);
+    std::sort(InRange.begin(), InRange.end(), [](const SpaceEntity* A, const SpaceEntity* B) { return A->GetId() < B->GetId(); });
+    EXPECT_EQ(InRange, (std::vector<SpaceEntity*> { &Avatar, &Near }));
+
+    EntityInterestManager InterestManager;
+    InterestManager.SetRadius(20.0f);
+
+    const std::chrono::system_clock::time_point Start {};
+    std::vector<mcs::ObjectPatch> DuePatches;
+    InterestManager.Update(SpatialIndex, &Avatar, Start, DuePatches);
+
+    EXPECT_EQ(InterestManager.GetScriptTickDelta(&Near, Start - 20ms, Start), std::make_optional<std::chrono::system_clock::duration>(20ms));
+    EXPECT_EQ(InterestManager.GetScriptTickDelta(&Far, Start - 20ms, Start), std::nullopt);
+    EXPECT_EQ(InterestManager.GetScriptTickDelta(&Far, Start, Start + 500ms), std::nullopt);
+    EXPECT_EQ(InterestManager.GetScriptTickDelta(&Far, Start + 500ms, Start + 1000ms),
+        std::make_optional<std::chrono::system_clock::duration>(1020ms));
+    EXPECT_EQ(InterestManager.GetMetrics().SkippedScriptTicks, 2);
+
+    // Without a local avatar to measure from, every entity is ticked as usual.
+    InterestManager.Update(SpatialIndex, nullptr, Start + 1100ms, DuePatches);
+    EXPECT_EQ(InterestManager.GetScriptTickDelta(&Far, Start + 1100ms, Start + 1120ms),
+        std::make_optional<std::chrono::system_clock::duration>(120ms));
+}
+
+// Pages are materialised on the worker pool and the next page is requested before the current one is committed,
+// so this checks that entities still arrive in server order, and that an entity that fails to decode doesn't stall the fetch.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, TestRetrieveAllEntitiesCommitsPagesInOrder)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    std::unique_ptr<csp::multiplayer::OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    constexpr uint64_t EntityCount = 250;
+    constexpr uint64_t BadEntityIndex = 120;
+
+    std::vector<signalr::value> ServerEntities;
+    MockScriptRunner Runner;
+
+    for (uint64_t i = 0; i < EntityCount; ++i)
+    {
+        if (i == BadEntityIndex)
+        {
+            ServerEntities.emplace_back("Not an object message");
+        }
+
+        SpaceEntity Entity { RealtimeEngine.get(), Runner, SystemsManager.GetLogSystem(), SpaceEntityType::Object, i + 1,
+            ("Entity " + std::to_string(i + 1)).c_str(), SpaceTransform {}, 1, nullptr, true, true };
+
+        SignalRSerializer Serializer;
+        Serializer.WriteValue(Entity.GetStatePatcher()->CreateObjectMessage());
+        ServerEntities.push_back(Serializer.Get());
+    }
+
+    int PageRequests = 0;
+
+    EXPECT_CALL(*SignalRMock, Invoke)
+        .WillRepeatedly(
+            [&ServerEntities, &PageRequests](const std::string& Method, const signalr::value& Params,
+                std::function<void(const signalr::value&, std::exception_ptr)> Callback)
+            {
+                csp::multiplayer::MultiplayerHubMethodMap HubMethods;
+                signalr::value Result {};
+
+                if (Method == HubMethods.Get(csp::multiplayer::MultiplayerHubMethod::PAGE_SCOPED_OBJECTS))
+                {
+                    ++PageRequests;
+
+                    const auto Skip = static_cast<size_t>(Params.as_array()[2].as_uinteger());
+                    const auto Limit = static_cast<size_t>(Params.as_array()[3].as_uinteger());
+                    const auto End = std::min(Skip + Limit, ServerEntities.size());
+
+                    std::vector<signalr::value> Items(ServerEntities.begin() + Skip, ServerEntities.begin() + End);
+                    Result = signalr::value { std::vector<signalr::value> { signalr::value { std::move(Items) },
+                        signalr::value { static_cast<uint64_t>(ServerEntities.size()) } } };
+                }
+
+                if (Callback)
+                {
+                    Callback(Result, nullptr);
+                }
+
+                return async::make_task(std::make_tuple(Result, std::exception_ptr(nullptr)));
+            });
+
+    std::vector<uint64_t> CreatedIds;
+    RealtimeEngine->SetRemoteEntityCreatedCallback([&CreatedIds](SpaceEntity* Entity) { CreatedIds.push_back(Entity->GetId()); });
+
+    bool FetchCompleted = false;
+    RealtimeEngine->RetrieveAllEntities(
+        [&FetchCompleted, &ServerEntities](uint32_t FetchedCount)
+        {
+            FetchCompleted = true;
+            EXPECT_EQ(FetchedCount, ServerEntities.size());
+        });
+
+    ASSERT_TRUE(FetchCompleted);
+    EXPECT_EQ(PageRequests, 3);
+
+    ASSERT_EQ(CreatedIds.size(), EntityCount);
+
+    for (uint64_t i = 0; i < EntityCount; ++i)
+    {
+        EXPECT_EQ(CreatedIds[i], i + 1);
+    }
+
+    EXPECT_EQ(RealtimeEngine->GetNumEntities(), EntityCount);
+    EXPECT_EQ(RealtimeEngine->FindSpaceEntityById(42)->GetName(), "Entity 42");
+
+    const EntityFetchMetrics Metrics = RealtimeEngine->GetLastEntityFetchMetrics();
+    EXPECT_EQ(Metrics.PageCount, 3);
+    EXPECT_EQ(Metrics.EntityCount, ServerEntities.size());
+}
+
+// A page request that fails should still complete the fetch, with the entities from the pages that did arrive.
+CSP_PUBLIC_TEST_WITH_MOCKS(CSPEngine, OnlineRealtimeEngineTests, TestRetrieveAllEntitiesCompletesWhenAPageFails)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+
+    std::unique_ptr<csp::multiplayer::OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+
+    constexpr uint64_t EntityCount = 250;
+
+    std::vector<signalr::value> ServerEntities;
+    MockScriptRunner Runner;
+
+    for (uint64_t i = 0; i < EntityCount; ++i)
+    {
+        SpaceEntity Entity { RealtimeEngine.get(), Runner, SystemsManager.GetLogSystem(), SpaceEntityType::Object, i + 1,
+            ("Entity " + std::to_string(i + 1)).c_str(), SpaceTransform {}, 1, nullptr, true, true };
+
+        SignalRSerializer Serializer;
+        Serializer.WriteValue(Entity.GetStatePatcher()->CreateObjectMessage());
+        ServerEntities.push_back(Serializer.Get());
+    }
+
+    size_t FirstPageSize = 0;
+
+    EXPECT_CALL(*SignalRMock, Invoke)
+        .WillRepeatedly(
+            [&ServerEntities, &FirstPageSize](const std::string& Method, const signalr::value& Params,
+                std::function<void(const signalr::value&, std::exception_ptr)> Callback)
+            {
+                csp::multiplayer::MultiplayerHubMethodMap HubMethods;
+                signalr::value Result {};
+                std::exception_ptr Except = nullptr;
+
+                if (Method == HubMethods.Get(csp::multiplayer::MultiplayerHubMethod::PAGE_SCOPED_OBJECTS))
+                {
+                    const auto Skip = static_cast<size_t>(Params.as_array()[2].as_uinteger());
+                    const auto Limit = static_cast<size_t>(Params.as_array()[3].as_uinteger());
+
+                    if (Skip == 0)
+                    {
+                        FirstPageSize = std::min(Limit, ServerEntities.size());
+
+                        std::vector<signalr::value> Items(ServerEntities.begin(), ServerEntities.begin() + FirstPageSize);
+                        Result = signalr::value { std::vector<signalr::value> { signalr::value { std::move(Items) },
+                            signalr::value { static_cast<uint64_t>(ServerEntities.size()) } } };
+                    }
+                    else
+                    {
+                        Except = std::make_exception_ptr(std::runtime_error("Page request failed"));
+                    }
+                }
+
+                if (Callback)
+                {
+                    Callback(Result, Except);
+                }
+
+                return async::make_task(std::make_tuple(Result, Except));
+            });
+
+    bool FetchCompleted = false;
+    uint32_t FetchedCount = 0;
+
+    RealtimeEngine->RetrieveAllEntities(
+        [&FetchCompleted, &FetchedCount](uint32_t Count)
+        {
+            FetchCompleted = true;
+            FetchedCount = Count;
+        });
+
+    ASSERT_TRUE(FetchCompleted);
+    ASSERT_GT(FirstPageSize, 0);
+    ASSERT_LT(FirstPageSize, EntityCount);
+
+    EXPECT_EQ(FetchedCount, FirstPageSize);
+    EXPECT_EQ(RealtimeEngine->GetNumEntities(), FirstPageSize);
+}
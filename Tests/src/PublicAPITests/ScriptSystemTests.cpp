@@ -68,6 +68,10 @@ class ScriptBinding : public PublicTestBaseWithParam<csp::common::RealtimeEngine
 {
 };
 
+class ScriptMessageCallback : public PublicTestBaseWithParam<csp::common::RealtimeEngineType>
+{
+};
+
 class CreateScript : public PublicTestBaseWithParam<csp::common::RealtimeEngineType>
 {
 };
@@ -161,6 +165,120 @@ TEST_P(ScriptBinding, ScriptBindingTest)
     ScriptSystem.Shutdown();
 }
 
+// Message callbacks are called directly rather than via generated source, so check arguments are passed through
+// and that redefining a callback is picked up despite callbacks being cached.
+TEST_P(ScriptMessageCallback, ScriptMessageCallbackTest)
+{
+    auto& SystemsManager = csp::systems::SystemsManager::Get();
+    auto& ScriptSystem = *SystemsManager.GetScriptSystem();
+
+    std::string TestMessage;
+
+    ScriptSystem.Initialise();
+
+    auto Fn = [&TestMessage](const char* Str) { TestMessage = Str; };
+
+    constexpr int ContextId = 0;
+
+    ScriptSystem.CreateContext(ContextId);
+
+    qjs::Context::Module* Module = (qjs::Context::Module*)ScriptSystem.GetModule(ContextId, "CSPTest");
+
+    Module->function("RunFunction", Fn);
+
+    std::string ScriptText = R"xx(
+
+        import * as CSPTest from "CSPTest";
+
+        globalThis.onMessage = function(message, params)
+        {
+            CSPTest.RunFunction(message + ':' + JSON.parse(params).value);
+        }
+
+    )xx";
+
+    EXPECT_TRUE(ScriptSystem.RunScript(ContextId, ScriptText.c_str()));
+
+    EXPECT_TRUE(ScriptSystem.CallMessageCallback(ContextId, "onMessage", "testMessage", "{\"value\": 1}"));
+    EXPECT_EQ(TestMessage, "testMessage:1");
+
+    // Same message with new parameters
+    EXPECT_TRUE(ScriptSystem.CallMessageCallback(ContextId, "onMessage", "testMessage", "{\"value\": 2}"));
+    EXPECT_EQ(TestMessage, "testMessage:2");
+
+    std::string RedefineScriptText = R"xx(
+
+        import * as CSPTest from "CSPTest";
+
+        globalThis.onMessage = function(message, params)
+        {
+            CSPTest.RunFunction('redefined:' + message);
+        }
+
+    )xx";
+
+    EXPECT_TRUE(ScriptSystem.RunScript(ContextId, RedefineScriptText.c_str()));
+
+    EXPECT_TRUE(ScriptSystem.CallMessageCallback(ContextId, "onMessage", "testMessage", "{\"value\": 3}"));
+    EXPECT_EQ(TestMessage, "redefined:testMessage");
+
+    // Unknown callbacks fail without running anything
+    EXPECT_FALSE(ScriptSystem.CallMessageCallback(ContextId, "missingCallback", "testMessage", "{}"));
+    EXPECT_EQ(TestMessage, "redefined:testMessage");
+
+    std::string SelfReassignScriptText = R"xx(
+
+        import * as CSPTest from "CSPTest";
+
+        globalThis.onMessage = function(message, params)
+        {
+            CSPTest.RunFunction('first:' + message);
+
+            globalThis.onMessage = function(message, params)
+            {
+                CSPTest.RunFunction('second:' + message);
+            }
+        }
+
+    )xx";
+
+    EXPECT_TRUE(ScriptSystem.RunScript(ContextId, SelfReassignScriptText.c_str()));
+
+    EXPECT_TRUE(ScriptSystem.CallMessageCallback(ContextId, "onMessage", "testMessage", "{}"));
+    EXPECT_EQ(TestMessage, "first:testMessage");
+
+    // The resolved callback is cached, so reassigning it from inside a callback has no effect until new source is run
+    EXPECT_TRUE(ScriptSystem.CallMessageCallback(ContextId, "onMessage", "testMessage", "{}"));
+    EXPECT_EQ(TestMessage, "first:testMessage");
+
+    EXPECT_TRUE(ScriptSystem.RunScript(ContextId, "globalThis.reloaded = true;"));
+
+    EXPECT_TRUE(ScriptSystem.CallMessageCallback(ContextId, "onMessage", "testMessage", "{}"));
+    EXPECT_EQ(TestMessage, "second:testMessage");
+
+    std::string NestedScriptText = R"xx(
+
+        import * as CSPTest from "CSPTest";
+
+        globalThis.handlers = {
+            onMessage: function(message, params)
+            {
+                CSPTest.RunFunction('nested:' + message);
+            }
+        };
+
+    )xx";
+
+    EXPECT_TRUE(ScriptSystem.RunScript(ContextId, NestedScriptText.c_str()));
+
+    // Callbacks that aren't plain global names still work
+    EXPECT_TRUE(ScriptSystem.CallMessageCallback(ContextId, "handlers.onMessage", "testMessage", "{}"));
+    EXPECT_EQ(TestMessage, "nested:testMessage");
+
+    ScriptSystem.DestroyContext(ContextId);
+    ScriptSystem.Shutdown();
+}
+
 TEST_P(CreateScript, CreateScriptTest)
 {
     SetRandSeed();
@@ -1351,6 +1469,7 @@ TEST_P(ModifyExistingScript, ModifyExistingScriptTest)
 INSTANTIATE_TEST_SUITE_P(ScriptSystemTests, ScriptBinding,
     testing::Values(csp::common::RealtimeEngineType::Offline)); // Dosent actually use the realtime engine, but stick to the pattern because
                                                                 // everything else does
+INSTANTIATE_TEST_SUITE_P(ScriptSystemTests, ScriptMessageCallback, testing::Values(csp::common::RealtimeEngineType::Offline));
 INSTANTIATE_TEST_SUITE_P(
     ScriptSystemTests, CreateScript, testing::Values(csp::common::RealtimeEngineType::Offline, csp::common::RealtimeEngineType::Online));
 INSTANTIATE_TEST_SUITE_P(
@@ -2608,6 +2608,57 @@ CSP_PUBLIC_TEST(CSPEngine, SpaceSystemTests, EnterSpaceTest)
     LogOut(UserSystem);
 }
 
+CSP_PUBLIC_TEST(CSPEngine, SpaceSystemTests, EnterSpaceMetricsTest)
+{
+    SetRandSeed();
+
+    auto& SystemsManager = ::SystemsManager::Get();
+    auto* UserSystem = SystemsManager.GetUserSystem();
+    auto* SpaceSystem = SystemsManager.GetSpaceSystem();
+
+    const char* TestSpaceName = "CSP-UNITTEST-SPACE-MAG";
+    const char* TestSpaceDescription = "CSP-UNITTEST-SPACEDESC-MAG";
+
+    char UniqueSpaceName[256];
+    SPRINTF(UniqueSpaceName, "%s-%s", TestSpaceName, GetUniqueString().c_str());
+
+    String PrimaryUserId;
+    csp::systems::Profile PrimaryUser = CreateTestUser();
+    LogIn(UserSystem, PrimaryUserId, PrimaryUser.Email, GeneratedTestAccountPassword);
+
+    ::Space Space;
+    CreateSpace(SpaceSystem, UniqueSpaceName, TestSpaceDescription, SpaceAttributes::Private, nullptr, nullptr, nullptr, nullptr, Space);
+
+    {
+        std::unique_ptr<csp::multiplayer::OnlineRealtimeEngine> RealtimeEngine { SystemsManager.MakeOnlineRealtimeEngine() };
+        RealtimeEngine->SetEntityFetchCompleteCallback([](uint32_t) {});
+
+        auto [Result] = AWAIT(SpaceSystem, EnterSpace, Space.Id, RealtimeEngine.get());
+
+        EXPECT_EQ(Result.GetResultCode(), csp::systems::EResultCode::Success);
+
+        const auto& Metrics = Result.GetEnterSpaceMetrics();
+
+        EXPECT_GT(Metrics.DiscoverSpace.Duration.count(), 0);
+        EXPECT_GT(Metrics.LookupScopes.Duration.count(), 0);
+        EXPECT_GT(Metrics.RefreshConnection.Duration.count(), 0);
+
+        // The scopes are looked up and the connection is refreshed once the user has been added, alongside each other.
+        // The entity fetch starts once both have finished.
+        EXPECT_GE(Metrics.LookupScopes.Start, Metrics.AddUser.Start + Metrics.AddUser.Duration);
+        EXPECT_GE(Metrics.RefreshConnection.Start, Metrics.AddUser.Start + Metrics.AddUser.Duration);
+        EXPECT_LT(Metrics.LookupScopes.Start, Metrics.RefreshConnection.Start + Metrics.RefreshConnection.Duration);
+        EXPECT_GE(Metrics.StartEntityFetch.Start, Metrics.RefreshConnection.Start + Metrics.RefreshConnection.Duration);
+        EXPECT_GE(Metrics.StartEntityFetch.Start, Metrics.LookupScopes.Start + Metrics.LookupScopes.Duration);
+        EXPECT_GE(Metrics.Total, Metrics.StartEntityFetch.Start + Metrics.StartEntityFetch.Duration);
+
+        auto [ExitSpaceResult] = AWAIT_PRE(SpaceSystem, ExitSpace, RequestPredicate);
+    }
+
+    DeleteSpace(SpaceSystem, Space.Id);
+    LogOut(UserSystem);
+}
+
 CSP_PUBLIC_TEST(CSPEngine, SpaceSystemTests, EnterSpaceAsNonModeratorTest)
 {
     SetRandSeed();
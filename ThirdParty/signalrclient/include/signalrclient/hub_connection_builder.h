@@ -7,6 +7,8 @@
 #include "_exports.h"
 #include "hub_connection.h"
 #include <memory>
+#include <string>
+#include <vector>
 #include "websocket_client.h"
 #include "http_client.h"
 
@@ -37,6 +39,12 @@ namespace signalr
 
 #ifdef USE_MSGPACK
         SIGNALRCLIENT_API hub_connection_builder& with_messagepack_hub_protocol();
+
+        /**
+         * Use the messagepack hub protocol, but hand the arguments of invocations of the given targets to their handlers still encoded,
+         * as value_type::messagepack values, rather than decoding them into values. This lets handlers decode large payloads themselves.
+         */
+        SIGNALRCLIENT_API hub_connection_builder& with_messagepack_hub_protocol(const std::vector<std::string>& encoded_argument_targets);
 #endif
 
         SIGNALRCLIENT_API hub_connection build();
@@ -50,5 +58,6 @@ namespace signalr
         std::function<std::shared_ptr<http_client>(const signalr_client_config&)> m_http_client_factory;
         bool m_skip_negotiation = false;
         bool m_use_messagepack = false;
+        std::vector<std::string> m_encoded_argument_targets;
     };
 }
@@ -27,7 +27,8 @@ namespace signalr
         uinteger,
         float64,
         null,
-        boolean
+        boolean,
+        messagepack
     };
 
     /**
@@ -106,6 +107,12 @@ namespace signalr
          */
         SIGNALRCLIENT_API value(const uint8_t* val, size_t len);
 
+        /**
+         * Create an object representing a value_type::messagepack from a buffer that already holds a single, complete MessagePack object.
+         * The messagepack hub protocol writes the buffer verbatim, which lets callers encode large payloads without building a value tree.
+         */
+        SIGNALRCLIENT_API static value from_messagepack(const char* data, size_t len);
+
         /**
          * Create an object representing a value_type::map with the given map of string-value's.
          */
@@ -196,6 +203,11 @@ namespace signalr
          */
         SIGNALRCLIENT_API bool is_raw() const;
 
+        /**
+         * True if the object stored is an already encoded MessagePack buffer.
+         */
+        SIGNALRCLIENT_API bool is_messagepack() const;
+
         /**
          * True if the object stored is a bool.
          */
@@ -236,6 +248,11 @@ namespace signalr
          */
         SIGNALRCLIENT_API const uint8_t* as_raw(size_t& len) const;
 
+        /**
+         * Returns the stored object as an encoded MessagePack buffer. This will throw if the underlying object is not a signalr::type::messagepack.
+         */
+        SIGNALRCLIENT_API const std::string& as_messagepack() const;
+
         /**
          * Returns the stored object as a map of property name to signalr::value. This will throw if the underlying object is not a signalr::type::string_map.
          */
@@ -29,6 +29,25 @@ public:
 	}
 };
 
+// Re-packs each argument on its own, which is far cheaper than building a value tree for it, as only the buffer is allocated.
+signalr::value createEncodedArguments(const msgpack::object& arguments)
+{
+	std::vector<signalr::value> vec;
+	vec.reserve(arguments.via.array.size);
+
+	string_wrapper buffer;
+	msgpack::packer<string_wrapper> packer(buffer);
+
+	for (uint32_t i = 0; i < arguments.via.array.size; ++i)
+	{
+		buffer.str.clear();
+		packer.pack(*(arguments.via.array.ptr + i));
+		vec.push_back(signalr::value::from_messagepack(buffer.str.data(), buffer.str.size()));
+	}
+
+	return signalr::value(std::move(vec));
+}
+
 signalr::value createValue(const msgpack::object& v)
 {
 	switch (v.type)
@@ -159,6 +178,13 @@ void pack_messagepack(const signalr::value& v, msgpack::packer<string_wrapper>&
 			packer.pack_bin_body((char*) ptr, static_cast<uint32_t>(len));
 			return;
 		}
+		case signalr::value_type::messagepack:
+		{
+			// Already encoded by the caller, so append the bytes as they are. pack_bin_body writes its input without a header.
+			const auto& encoded = v.as_messagepack();
+			packer.pack_bin_body(encoded.data(), static_cast<uint32_t>(encoded.size()));
+			return;
+		}
 		case signalr::value_type::string_map:
 		{
 			const auto& obj = v.as_string_map();
@@ -374,8 +400,9 @@ std::vector<std::unique_ptr<hub_message>> messagepack_hub_protocol::parse_messag
 					throw signalr_exception("reading 'arguments' as array failed");
 				}
 
-				vec.emplace_back(std::unique_ptr<hub_message>(
-					new invocation_message(std::move(invocation_id), std::move(target), createValue(*msgpack_obj_index))));
+				const bool keep_encoded = m_encoded_argument_targets.find(target) != m_encoded_argument_targets.end();
+				vec.emplace_back(std::unique_ptr<hub_message>(new invocation_message(std::move(invocation_id), std::move(target),
+					keep_encoded ? createEncodedArguments(*msgpack_obj_index) : createValue(*msgpack_obj_index))));
 
 				if (num_elements_of_message > 5)
 				{
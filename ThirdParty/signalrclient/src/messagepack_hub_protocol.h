@@ -8,12 +8,23 @@
 
 #include "signalrclient/signalr_value.h"
 #include "hub_protocol.h"
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace signalr
 {
     class messagepack_hub_protocol : public hub_protocol
     {
     public:
+        messagepack_hub_protocol() = default;
+
+        // Invocations of these targets keep each of their arguments encoded, as a value_type::messagepack value.
+        explicit messagepack_hub_protocol(const std::vector<std::string>& encoded_argument_targets)
+            : m_encoded_argument_targets(encoded_argument_targets.begin(), encoded_argument_targets.end())
+        {
+        }
+
         std::string write_message(const hub_message*) const;
         std::vector<std::unique_ptr<hub_message>> parse_messages(const std::string&) const;
 
@@ -35,6 +46,7 @@ namespace signalr
         ~messagepack_hub_protocol() {}
     private:
         std::string m_protocol_name = "messagepack";
+        std::unordered_set<std::string> m_encoded_argument_targets;
     };
 }
 
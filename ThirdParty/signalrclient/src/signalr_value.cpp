@@ -21,6 +21,8 @@ namespace signalr
             return "array";
         case signalr::value_type::string:
             return "string";
+        case signalr::value_type::messagepack:
+            return "messagepack";
         case signalr::value_type::integer:
             return "integer";
         case signalr::value_type::uinteger:
@@ -47,6 +49,7 @@ namespace signalr
         case value_type::array:
             new (&mStorage.array) std::vector<value>();
             break;
+        case value_type::messagepack:
         case value_type::string:
             new (&mStorage.string) std::string();
             break;
@@ -131,6 +134,14 @@ namespace signalr
         memcpy(mStorage.buffer.ptr, val, len);
     }
 
+    value value::from_messagepack(const char* data, size_t len)
+    {
+        value encoded;
+        encoded.mType = value_type::messagepack;
+        new (&encoded.mStorage.string) std::string(data, len);
+        return encoded;
+    }
+
     value::value(const std::map<std::string, value>& map) : mType(value_type::string_map)
     {
         new (&mStorage.string_map) std::map<std::string, value>(map);
@@ -164,6 +175,7 @@ namespace signalr
             mStorage.buffer.ptr = (uint8_t*)malloc(rhs.mStorage.buffer.len);
             memcpy(mStorage.buffer.ptr, rhs.mStorage.buffer.ptr, rhs.mStorage.buffer.len);
             break;
+        case value_type::messagepack:
         case value_type::string:
             new (&mStorage.string) std::string(rhs.mStorage.string);
             break;
@@ -204,6 +216,7 @@ namespace signalr
             mStorage.buffer.ptr = (uint8_t*)malloc(rhs.mStorage.buffer.len);
             memmove(mStorage.buffer.ptr, rhs.mStorage.buffer.ptr, rhs.mStorage.buffer.len);
             break;
+        case value_type::messagepack:
         case value_type::string:
             new (&mStorage.string) std::string(std::move(rhs.mStorage.string));
             break;
@@ -249,6 +262,7 @@ namespace signalr
                 free(mStorage.buffer.ptr);
             }
             break;
+        case value_type::messagepack:
         case value_type::string:
             mStorage.string.~basic_string();
             break;
@@ -283,6 +297,7 @@ namespace signalr
             mStorage.buffer.ptr = (uint8_t*)malloc(rhs.mStorage.buffer.len);
             memcpy(mStorage.buffer.ptr, rhs.mStorage.buffer.ptr, rhs.mStorage.buffer.len);
             break;
+        case value_type::messagepack:
         case value_type::string:
             new (&mStorage.string) std::string(rhs.mStorage.string);
             break;
@@ -327,6 +342,7 @@ namespace signalr
             mStorage.buffer.ptr = (uint8_t*)malloc(rhs.mStorage.buffer.len);
             memmove(mStorage.buffer.ptr, rhs.mStorage.buffer.ptr, rhs.mStorage.buffer.len);
             break;
+        case value_type::messagepack:
         case value_type::string:
             new (&mStorage.string) std::string(std::move(rhs.mStorage.string));
             break;
@@ -401,6 +417,11 @@ namespace signalr
         return mType == signalr::value_type::raw;
     }
 
+    bool value::is_messagepack() const
+    {
+        return mType == signalr::value_type::messagepack;
+    }
+
     bool value::is_bool() const
     {
         return mType == signalr::value_type::boolean;
@@ -478,6 +499,16 @@ namespace signalr
         return mStorage.buffer.ptr;
     }
 
+    const std::string& value::as_messagepack() const
+    {
+        if (!is_messagepack())
+        {
+            throw signalr_exception("object is a '" + value_type_to_string(mType) + "' expected it to be a 'messagepack'");
+        }
+
+        return mStorage.string;
+    }
+
     const std::map<std::string, value>& value::as_string_map() const
     {
         if (!is_string_map())